@@ -0,0 +1,51 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+
+#include "CameraLaunchCmd.h"
+#include "MockMaya.h"
+
+// Runs cameraLaunch against the mock scene and reports, per step, the time taken and the
+// Maya API calls made per camera. The mock is far cheaper than Maya, so the call counts are
+// the figure to watch; the timings only show the command's own overhead.
+int main(int argc, char** argv)
+{
+	int cameraCount = (argc > 1) ? std::atoi(argv[1]) : 200;
+	const char* options = (argc > 2) ? argv[2] : "";
+
+	MockMaya::resetScene();
+	MockMaya::registerCommand(CameraLaunchCmd::commandName, CameraLaunchCmd::creator);
+
+	std::string cameras;
+	for (int i = 0; i < cameraCount; ++i) {
+		std::string name = "camera" + std::to_string(i);
+		MockMaya::createCamera(name, i * 2.0, 0.0, 0.0);
+		cameras += " -c " + name;
+	}
+
+	using Clock = std::chrono::steady_clock;
+
+	auto step = [cameraCount](const char* name, const std::function<bool()>& run) {
+		MockMaya::resetCalls();
+		Clock::time_point start = Clock::now();
+		bool ok = run();
+		double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		std::printf("%-10s %s %9.3f ms %8.1f calls/camera %6.1f findPlug/camera\n", name, ok ? "ok  " : "FAIL", ms,
+			(double)MockMaya::totalCalls() / cameraCount,
+			(double)MockMaya::calls("MFnDependencyNode::findPlug") / cameraCount);
+	};
+
+	std::printf("cameras: %d %s\n", cameraCount, options);
+	step("launch", [&]() { return (bool)MockMaya::runCommand("cameraLaunch" + cameras + " -v 8 12 0 " + options); });
+	step("relaunch", [&]() { return (bool)MockMaya::runCommand("cameraLaunch" + cameras + " -v 6 15 0 " + options); });
+	step("undo", []() { return MockMaya::undo(); });
+	step("redo", []() { return MockMaya::redo(); });
+	step("undo", []() { return MockMaya::undo(); });
+	step("undo", []() { return MockMaya::undo(); });
+
+	CameraLaunchCmd::shutdownAsync();
+	return 0;
+}
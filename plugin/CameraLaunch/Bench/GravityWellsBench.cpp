@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "GravityWells.h"
+
+using namespace LaunchCore;
+
+// Compares the Barnes-Hut octree against summing every attractor, over a growing asteroid
+// field, reporting the time per lookup and the largest relative error of the tree.
+int main(int argc, char** argv)
+{
+	int lookups = (argc > 1) ? std::atoi(argv[1]) : 2000;
+	double theta = (argc > 2) ? std::atof(argv[2]) : 0.5;
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<double> coordinate(-100.0, 100.0);
+	std::uniform_real_distribution<double> mass(0.5, 4.0);
+
+	std::vector<Vec3> positions;
+	for (int i = 0; i < lookups; ++i) {
+		positions.push_back(Vec3(coordinate(rng), coordinate(rng), coordinate(rng)));
+	}
+
+	using Clock = std::chrono::steady_clock;
+
+	std::printf("%9s %12s %12s %12s\n", "attractors", "direct us", "tree us", "max error");
+	for (size_t count : { 16, 256, 4096, 65536 }) {
+		std::vector<Attractor> attractors;
+		for (size_t i = 0; i < count; ++i) {
+			attractors.push_back(Attractor(Vec3(coordinate(rng), coordinate(rng) * 0.2, coordinate(rng)), mass(rng)));
+		}
+
+		AttractorTree tree;
+		tree.build(attractors);
+
+		std::vector<Vec3> exact(positions.size());
+		Clock::time_point directStart = Clock::now();
+		for (size_t i = 0; i < positions.size(); ++i) {
+			exact[i] = tree.directAcceleration(positions[i], 0.1);
+		}
+		double directUs = std::chrono::duration<double, std::micro>(Clock::now() - directStart).count() / positions.size();
+
+		std::vector<Vec3> approximate(positions.size());
+		Clock::time_point treeStart = Clock::now();
+		for (size_t i = 0; i < positions.size(); ++i) {
+			approximate[i] = tree.acceleration(positions[i], 0.1, theta);
+		}
+		double treeUs = std::chrono::duration<double, std::micro>(Clock::now() - treeStart).count() / positions.size();
+
+		double maxError = 0.0;
+		for (size_t i = 0; i < positions.size(); ++i) {
+			double length = exact[i].length();
+			if (length > 0.0) {
+				maxError = std::max(maxError, (approximate[i] - exact[i]).length() / length);
+			}
+		}
+
+		std::printf("%9zu %12.3f %12.3f %12.3e\n", count, directUs, treeUs, maxError);
+	}
+
+	return 0;
+}
@@ -0,0 +1,51 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "KeyAccuracy.h"
+
+using namespace LaunchCore;
+
+// Keys a sweep of launches with the three-key scheme and reports the largest sub-frame
+// deviation of the keyed curves from the closed-form flight.
+int main(int argc, char** argv)
+{
+	int launchCount = (argc > 1) ? std::atoi(argv[1]) : 500;
+	int subdivisions = (argc > 2) ? std::atoi(argv[2]) : 16;
+
+	const double rates[] = { 24.0, 25.0, 29.97, 30.0, 60.0 };
+
+	KeyDeviation worst;
+	size_t evaluations = 0;
+	size_t fractionalApexes = 0;
+	for (int i = 0; i < launchCount; ++i) {
+		LaunchParams params;
+		params.startPosition = Vec3(0.0, (i % 5) * 1.5, 0.0);
+		params.velocity = Vec3(-8.0 + (i % 17), 2.0 + 0.37 * (i % 53), -3.0 + (i % 7));
+		params.framesPerSecond = rates[i % 5];
+		params.startFrame = i % 11;
+
+		std::vector<ParabolicKey> keys = calculateParabolicKeys(params);
+		if (std::fabs(keys[1].frame - std::round(keys[1].frame)) > 1e-9) {
+			++fractionalApexes;
+		}
+
+		KeyDeviation deviation = measureKeyDeviation(keys, params, subdivisions);
+		evaluations += deviation.evaluations;
+		if (deviation.translate > worst.translate) {
+			worst.translate = deviation.translate;
+			worst.translateFrame = deviation.translateFrame;
+		}
+		if (deviation.rotate > worst.rotate) {
+			worst.rotate = deviation.rotate;
+			worst.rotateFrame = deviation.rotateFrame;
+		}
+	}
+
+	std::printf("launches:            %d (%zu with a fractional apex)\n", launchCount, fractionalApexes);
+	std::printf("evaluations:         %zu (%d per frame)\n", evaluations, subdivisions);
+	std::printf("max |translate|:     %.3e at frame %.4f\n", worst.translate, worst.translateFrame);
+	std::printf("max |rotateX| (rad): %.3e at frame %.4f\n", worst.rotate, worst.rotateFrame);
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+#include "AnimExport.h"
+#include "KeyAccuracy.h"
+
+#include <cstdio>
+
+namespace LaunchCore {
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const char* MAYA_VERSION = "2024";
+
+// Enough digits for the value to read back exactly
+std::string formatNumber(double value)
+{
+	char text[32];
+	std::snprintf(text, sizeof(text), "%.17g", value);
+	return text;
+}
+
+// Maya key tangents are (seconds, value) vectors three times the Bezier handle, stored as an
+// angle and a length. A key without a handle on one side mirrors the other side's length.
+void tangentAngleWeight(double slope, double weight, double otherWeight, double secondsPerFrame,
+	double valueScale, double& angle, double& length)
+{
+	double handle = (weight > 0.0) ? weight : otherWeight;
+	double x = 3.0 * handle * secondsPerFrame;
+	double y = 3.0 * handle * slope * valueScale;
+	angle = std::atan2(y, x) * 180.0 / PI;
+	length = std::sqrt(x * x + y * y);
+}
+
+void writeChannelData(std::ostream& out, const AnimChannel& channel, double framesPerSecond,
+	const char* indent, bool atom)
+{
+	const double secondsPerFrame = 1.0 / framesPerSecond;
+	const double valueScale = channel.angular ? 180.0 / PI : 1.0;
+
+	out << indent << "animData {\n";
+	out << indent << "  input time;\n";
+	out << indent << "  output " << (channel.angular ? "angular" : "linear") << ";\n";
+	out << indent << "  weighted " << (channel.linear ? 0 : 1) << ";\n";
+	if (atom) {
+		out << indent << "  inputUnit " << timeUnitName(framesPerSecond) << ";\n";
+		out << indent << "  outputUnit " << (channel.angular ? "deg" : "cm") << ";\n";
+	}
+	out << indent << "  preInfinity constant;\n";
+	out << indent << "  postInfinity constant;\n";
+	out << indent << "  keys {\n";
+
+	for (const ReducedKey& key : channel.keys) {
+		out << indent << "    " << formatNumber(key.frame) << " " << formatNumber(key.value * valueScale);
+		if (channel.linear) {
+			out << " linear linear 1 1 0;\n";
+			continue;
+		}
+
+		double inAngle, inLength, outAngle, outLength;
+		tangentAngleWeight(key.inSlope, key.inWeight, key.outWeight, secondsPerFrame, valueScale, inAngle, inLength);
+		tangentAngleWeight(key.outSlope, key.outWeight, key.inWeight, secondsPerFrame, valueScale, outAngle, outLength);
+
+		// Broken tangents (a bounce contact) are unlocked so they keep both slopes
+		bool locked = key.inSlope == key.outSlope;
+		out << " fixed fixed " << (locked ? 1 : 0) << " 0 0 "
+			<< formatNumber(inAngle) << " " << formatNumber(inLength) << " "
+			<< formatNumber(outAngle) << " " << formatNumber(outLength) << ";\n";
+	}
+
+	out << indent << "  }\n";
+	out << indent << "}\n";
+}
+
+void writeHeader(std::ostream& out, const AnimClip& clip, const char* versionLine)
+{
+	double startTime = 0.0, endTime = 0.0;
+	bool first = true;
+	for (const AnimChannel& channel : clip.channels) {
+		if (channel.keys.empty()) continue;
+		if (first || channel.keys.front().frame < startTime) startTime = channel.keys.front().frame;
+		if (first || channel.keys.back().frame > endTime) endTime = channel.keys.back().frame;
+		first = false;
+	}
+
+	out << versionLine << "\n";
+	out << "mayaVersion " << MAYA_VERSION << ";\n";
+	out << "timeUnit " << timeUnitName(clip.framesPerSecond) << ";\n";
+	out << "linearUnit cm;\n";
+	out << "angularUnit deg;\n";
+	out << "startTime " << formatNumber(startTime) << ";\n";
+	out << "endTime " << formatNumber(endTime) << ";\n";
+}
+
+}
+
+void buildLaunchClip(const std::string& node, const std::vector<ParabolicKey>& keys, double framesPerSecond,
+	AnimClip& clip)
+{
+	struct ChannelInfo {
+		const char* attribute;
+		const char* leafAttribute;
+		KeyChannel channel;
+		bool angular;
+	};
+	const ChannelInfo channels[] = {
+		{ "translate.translateX", "translateX", KeyChannel::TRANSLATE_X, false },
+		{ "translate.translateY", "translateY", KeyChannel::TRANSLATE_Y, false },
+		{ "translate.translateZ", "translateZ", KeyChannel::TRANSLATE_Z, false },
+		{ "rotate.rotateX", "rotateX", KeyChannel::ROTATE_X, true },
+		{ "rotate.rotateY", "rotateY", KeyChannel::ROTATE_Y, true }
+	};
+
+	clip.node = node;
+	clip.framesPerSecond = framesPerSecond;
+	clip.channels.clear();
+	for (const ChannelInfo& info : channels) {
+		AnimChannel channel;
+		channel.attribute = info.attribute;
+		channel.leafAttribute = info.leafAttribute;
+		channel.angular = info.angular;
+		channel.linear = info.angular;
+		channelKeys(keys, info.channel, channel.keys);
+		clip.channels.push_back(std::move(channel));
+	}
+}
+
+std::string timeUnitName(double framesPerSecond)
+{
+	struct NamedRate {
+		double framesPerSecond;
+		const char* name;
+	};
+	const NamedRate rates[] = {
+		{ 15.0, "game" }, { 24.0, "film" }, { 25.0, "pal" }, { 30.0, "ntsc" },
+		{ 48.0, "show" }, { 50.0, "palf" }, { 60.0, "ntscf" }
+	};
+
+	for (const NamedRate& rate : rates) {
+		if (std::fabs(framesPerSecond - rate.framesPerSecond) < 1e-9) {
+			return rate.name;
+		}
+	}
+
+	char text[32];
+	std::snprintf(text, sizeof(text), "%gfps", framesPerSecond);
+	return text;
+}
+
+void writeAnim(std::ostream& out, const AnimClip& clip)
+{
+	writeHeader(out, clip, "animVersion 1.1;");
+
+	for (size_t i = 0; i < clip.channels.size(); ++i) {
+		const AnimChannel& channel = clip.channels[i];
+		out << "anim " << channel.attribute << " " << channel.leafAttribute << " " << clip.node << " 0 0 " << i << ";\n";
+		writeChannelData(out, channel, clip.framesPerSecond, "", false);
+	}
+}
+
+void writeAtom(std::ostream& out, const AnimClip& clip)
+{
+	writeHeader(out, clip, "atomVersion 1.0;");
+
+	out << "dagNode {\n";
+	out << "  " << clip.node << " 0 0;\n";
+	for (size_t i = 0; i < clip.channels.size(); ++i) {
+		const AnimChannel& channel = clip.channels[i];
+		out << "  anim " << channel.attribute << " " << channel.leafAttribute << " " << i << ";\n";
+		writeChannelData(out, channel, clip.framesPerSecond, "  ", true);
+	}
+	out << "}\n";
+}
+
+void writeClip(std::ostream& out, const AnimClip& clip, AnimFormat format)
+{
+	if (format == AnimFormat::ATOM) {
+		writeAtom(out, clip);
+	}
+	else {
+		writeAnim(out, clip);
+	}
+}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "KeyReducer.h"
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+enum class AnimFormat {
+	// animImportExport's .anim
+	ANIM,
+	// atomImportExport's .atom
+	ATOM
+};
+
+// One keyed attribute. Values and slopes are in internal units (radians for angular channels)
+// and converted to the file's units on write.
+struct AnimChannel {
+	// Full and leaf attribute names, eg. "translate.translateX" and "translateX"
+	std::string attribute;
+	std::string leafAttribute;
+	bool angular = false;
+	// Linear tangents; otherwise the keys' slopes and weights are written as fixed tangents
+	bool linear = false;
+	std::vector<ReducedKey> keys;
+};
+
+// Every keyed channel of one node
+struct AnimClip {
+	std::string node;
+	double framesPerSecond = 24.0;
+	std::vector<AnimChannel> channels;
+};
+
+// Translation as exact weighted arcs and rotateX/Y with linear tangents, as the command keys them
+void buildLaunchClip(const std::string& node, const std::vector<ParabolicKey>& keys, double framesPerSecond,
+	AnimClip& clip);
+
+// Maya's timeUnit name for a frame rate, eg. "film" for 24 or "48fps"
+std::string timeUnitName(double framesPerSecond);
+
+// Streams 'clip' to 'out' in centimetres and degrees. Nothing is buffered here beyond what
+// 'out' buffers itself.
+void writeAnim(std::ostream& out, const AnimClip& clip);
+void writeAtom(std::ostream& out, const AnimClip& clip);
+void writeClip(std::ostream& out, const AnimClip& clip, AnimFormat format);
+
+}
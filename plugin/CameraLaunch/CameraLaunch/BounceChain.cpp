@@ -0,0 +1,222 @@
+#include "BounceChain.h"
+#include "CollisionSweep.h"
+
+#include <algorithm>
+
+namespace LaunchCore {
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// Heading the three-key scheme gives a launch, including the half turn for a vertical one
+double launchYaw(const LaunchParams& launch)
+{
+	Vec3 direction = launch.velocity.normal();
+	return std::atan2(direction.x, direction.z) + PI;
+}
+
+}
+
+void chainBounces(const LaunchParams& launch, const BounceSettings& settings, const TriangleBVH* collision,
+	double frameStep, std::vector<FlightSegment>& segments)
+{
+	segments.clear();
+
+	const bool colliding = collision && !collision->empty();
+	const double fps = launch.framesPerSecond;
+
+	// Without geometry every arc comes down on the height the first one lands at
+	double floorHeight = launch.startPosition.y;
+	if (launch.flightTime > 0.0) {
+		floorHeight = positionAtTime(launch, launch.flightTime).y;
+	}
+
+	FlightSegment segment;
+	segment.params = launch;
+	segment.params.startFrame = 0;
+	segment.params.flightTime = 0.0;
+
+	for (int bounce = 0; ; ++bounce) {
+		bool contact = false;
+		Vec3 normal(0.0, 1.0, 0.0);
+		Vec3 contactPoint;
+
+		if (colliding) {
+			// Same search as a single collision flight: down to the bottom of the geometry
+			double bottom = std::min(segment.params.startPosition.y, collision->boundsMin().y);
+			double fallTime = timeToHeight(segment.params, bottom);
+			double totalFrames = (fallTime > 0.0)
+				? std::ceil(fallTime * fps)
+				: calculateFlightFrames(segment.params);
+
+			TrajectorySamples samples;
+			sampleTrajectory(segment.params, frameStep, totalFrames, samples);
+			CollisionHit hit = findFirstHit(samples, *collision);
+
+			segment.duration = (hit.hit ? hit.frame : totalFrames) / fps;
+			contact = hit.hit;
+			normal = hit.normal;
+			contactPoint = hit.position;
+		}
+		else {
+			double fallTime = (bounce == 0 && launch.flightTime > 0.0)
+				? launch.flightTime
+				: timeToHeight(segment.params, floorHeight);
+
+			// Only a camera coming down onto the floor bounces off it
+			contact = fallTime > 0.0 && velocityAtTime(segment.params, fallTime).y < 0.0;
+			segment.duration = (fallTime > 0.0) ? fallTime : landingTime(segment.params);
+			contactPoint = positionAtTime(segment.params, segment.duration);
+		}
+
+		// Face the normal against the incoming velocity, whichever side of a triangle was hit
+		Vec3 incoming = velocityAtTime(segment.params, segment.duration);
+		if (incoming.dot(normal) > 0.0) {
+			normal = -normal;
+		}
+
+		segment.contact = contact;
+		segment.contactNormal = normal;
+		segment.endPosition = contact ? contactPoint : positionAtTime(segment.params, segment.duration);
+		segments.push_back(segment);
+		if (!contact || bounce >= settings.bounces) {
+			break;
+		}
+
+		// Split the incoming velocity against the surface it came down on
+		Vec3 normalVelocity = normal * incoming.dot(normal);
+		Vec3 tangentVelocity = incoming - normalVelocity;
+		Vec3 rebound = tangentVelocity * (1.0 - settings.friction) - normalVelocity * settings.restitution;
+
+		// Nothing left to bounce with, so the camera stays on the contact
+		if (rebound.dot(normal) <= 1e-9 * (1.0 + incoming.length())) {
+			break;
+		}
+
+		FlightSegment next;
+		next.params = segment.params;
+		next.params.startPosition = segment.endPosition;
+		next.params.velocity = rebound;
+		next.startTime = segment.startTime + segment.duration;
+		segment = next;
+	}
+}
+
+void buildBounceKeys(const LaunchParams& launch, const std::vector<FlightSegment>& segments, std::vector<ParabolicKey>& keys)
+{
+	keys.clear();
+	if (segments.empty()) {
+		return;
+	}
+
+	const double fps = launch.framesPerSecond;
+	double yaw = launchYaw(launch);
+
+	for (size_t s = 0; s < segments.size(); ++s) {
+		const FlightSegment& segment = segments[s];
+		const double startFrame = launch.startFrame + segment.startTime * fps;
+		const Vec3& launchVelocity = segment.params.velocity;
+
+		if (s == 0) {
+			ParabolicKey start;
+			start.frame = startFrame;
+			start.position = segment.params.startPosition;
+			start.rotation = lookAlongVelocity(launchVelocity, yaw);
+			start.type = KeyframeType::START;
+			start.inSlope = start.outSlope = launchVelocity * (1.0 / fps);
+			keys.push_back(start);
+			yaw = start.rotation.y;
+		}
+		else {
+			// The contact closing the previous segment leaves with this segment's velocity
+			keys.back().outSlope = launchVelocity * (1.0 / fps);
+		}
+
+		double apexTime = timeToApex(segment.params);
+		if (apexTime > 0.0 && apexTime < segment.duration) {
+			Vec3 apexVelocity = velocityAtTime(segment.params, apexTime);
+			ParabolicKey apex;
+			apex.frame = startFrame + apexTime * fps;
+			apex.position = positionAtTime(segment.params, apexTime);
+			apex.rotation = lookAlongVelocity(apexVelocity, yaw);
+			apex.type = KeyframeType::MIDDLE;
+			apex.inSlope = apex.outSlope = apexVelocity * (1.0 / fps);
+			keys.push_back(apex);
+			yaw = apex.rotation.y;
+		}
+
+		// Contacts look along the arc coming in; the rebound heading starts on the next key
+		Vec3 endVelocity = velocityAtTime(segment.params, segment.duration);
+		ParabolicKey end;
+		end.frame = startFrame + segment.duration * fps;
+		end.position = segment.endPosition;
+		end.rotation = lookAlongVelocity(endVelocity, yaw);
+		end.type = (s + 1 < segments.size()) ? KeyframeType::CONTACT : KeyframeType::END;
+		end.inSlope = end.outSlope = endVelocity * (1.0 / fps);
+		keys.push_back(end);
+		yaw = end.rotation.y;
+	}
+
+	setParabolicWeights(keys);
+}
+
+void sampleBounces(const LaunchParams& launch, const std::vector<FlightSegment>& segments, double frameStep,
+	TrajectorySamples& samples)
+{
+	samples.resize(0);
+	if (frameStep <= 0.0 || segments.empty()) {
+		return;
+	}
+
+	const double fps = launch.framesPerSecond;
+	const double firstFrame = launch.startFrame;
+
+	// Frames on the launch's grid, with the exact contact frames slotted in between
+	std::vector<size_t> owners;
+	std::vector<char> contacts;
+	for (size_t s = 0; s < segments.size(); ++s) {
+		const FlightSegment& segment = segments[s];
+		double startFrame = firstFrame + segment.startTime * fps;
+		double endFrame = startFrame + segment.duration * fps;
+
+		if (s == 0) {
+			samples.frames.push_back(startFrame);
+			owners.push_back(s);
+			contacts.push_back(0);
+		}
+
+		double step = std::floor((startFrame - firstFrame) / frameStep + 1e-9) + 1.0;
+		while (firstFrame + step * frameStep < endFrame - 1e-9) {
+			samples.frames.push_back(firstFrame + step * frameStep);
+			owners.push_back(s);
+			contacts.push_back(0);
+			step += 1.0;
+		}
+
+		samples.frames.push_back(endFrame);
+		owners.push_back(s);
+		contacts.push_back(1);
+	}
+
+	const size_t count = samples.frames.size();
+	samples.resize(count);
+
+	double yaw = launchYaw(launch);
+	for (size_t i = 0; i < count; ++i) {
+		const FlightSegment& segment = segments[owners[i]];
+		double t = (samples.frames[i] - firstFrame) / fps - segment.startTime;
+
+		Vec3 position = contacts[i] ? segment.endPosition : positionAtTime(segment.params, t);
+		Euler rotation = lookAlongVelocity(velocityAtTime(segment.params, t), yaw);
+		yaw = rotation.y;
+
+		samples.translateX[i] = position.x;
+		samples.translateY[i] = position.y;
+		samples.translateZ[i] = position.z;
+		samples.rotateX[i] = rotation.x;
+		samples.rotateY[i] = rotation.y;
+	}
+}
+
+}
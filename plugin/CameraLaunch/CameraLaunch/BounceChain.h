@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+#include "TrajectoryCore.h"
+#include "TrajectorySampler.h"
+#include "TriangleBVH.h"
+
+namespace LaunchCore {
+
+struct BounceSettings {
+	int bounces = 0;
+	// Share of the speed into the floor that comes back out of it
+	double restitution = 0.5;
+	// Share of the speed along the floor lost at each contact
+	double friction = 0.0;
+};
+
+// One closed-form parabola of a bouncing flight
+struct FlightSegment {
+	// Launch state of this segment (startFrame is unused, see startTime)
+	LaunchParams params;
+	// Seconds after the original launch
+	double startTime = 0.0;
+	double duration = 0.0;
+	// Where the segment ends; on geometry this is the hit point rather than the arc
+	Vec3 endPosition;
+	// Whether the segment ends on the floor, and the floor's normal facing the camera when it
+	// bounced off it
+	bool contact = false;
+	Vec3 contactNormal;
+};
+
+// Chains parabolic segments from 'launch', reflecting the velocity at each contact. Without
+// collision the floor is the height the first arc lands at (the launch height, or the end of a
+// fixed flightTime) and each segment is solved in closed form, so the cost is O(bounces).
+// With collision each arc is swept against the geometry every 'frameStep' frames instead.
+void chainBounces(const LaunchParams& launch, const BounceSettings& settings, const TriangleBVH* collision,
+	double frameStep, std::vector<FlightSegment>& segments);
+
+// Start, apex and contact keys of every segment in frame order, weighted to reproduce each arc.
+// Contacts carry broken slopes (coming in and going out) and look along the arc coming in.
+void buildBounceKeys(const LaunchParams& launch, const std::vector<FlightSegment>& segments, std::vector<ParabolicKey>& keys);
+
+// Samples the whole chain every 'frameStep' frames on the launch's frame grid, plus a sample
+// exactly on each contact
+void sampleBounces(const LaunchParams& launch, const std::vector<FlightSegment>& segments, double frameStep,
+	TrajectorySamples& samples);
+
+}
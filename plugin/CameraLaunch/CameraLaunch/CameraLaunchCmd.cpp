@@ -10,14 +10,130 @@ const char* CameraLaunchCmd::gravityFlag = "-g";
 const char* CameraLaunchCmd::gravityFlagLong = "-gravity";
 const char* CameraLaunchCmd::startFrameFlag = "-s";
 const char* CameraLaunchCmd::startFrameLongFlag = "-startFrame";
+const char* CameraLaunchCmd::bakeFlag = "-b";
+const char* CameraLaunchCmd::bakeFlagLong = "-bake";
+const char* CameraLaunchCmd::bakeStepFlag = "-bs";
+const char* CameraLaunchCmd::bakeStepFlagLong = "-bakeStep";
+const char* CameraLaunchCmd::dragFlag = "-d";
+const char* CameraLaunchCmd::dragFlagLong = "-drag";
+const char* CameraLaunchCmd::massFlag = "-m";
+const char* CameraLaunchCmd::massFlagLong = "-mass";
+const char* CameraLaunchCmd::collideFlag = "-col";
+const char* CameraLaunchCmd::collideFlagLong = "-collide";
+const char* CameraLaunchCmd::targetFlag = "-t";
+const char* CameraLaunchCmd::targetFlagLong = "-target";
+const char* CameraLaunchCmd::targetObjectFlag = "-to";
+const char* CameraLaunchCmd::targetObjectFlagLong = "-targetObject";
+const char* CameraLaunchCmd::flightTimeFlag = "-ft";
+const char* CameraLaunchCmd::flightTimeFlagLong = "-flightTime";
+const char* CameraLaunchCmd::apexHeightFlag = "-ah";
+const char* CameraLaunchCmd::apexHeightFlagLong = "-apexHeight";
+const char* CameraLaunchCmd::toleranceFlag = "-tol";
+const char* CameraLaunchCmd::toleranceFlagLong = "-tolerance";
+const char* CameraLaunchCmd::profileFlag = "-prf";
+const char* CameraLaunchCmd::profileFlagLong = "-profile";
+const char* CameraLaunchCmd::profileHistoryFlag = "-ph";
+const char* CameraLaunchCmd::profileHistoryFlagLong = "-profileHistory";
+const char* CameraLaunchCmd::orientFlag = "-ori";
+const char* CameraLaunchCmd::orientFlagLong = "-orient";
+const char* CameraLaunchCmd::bankFlag = "-bk";
+const char* CameraLaunchCmd::bankFlagLong = "-bank";
+const char* CameraLaunchCmd::upVectorFlag = "-up";
+const char* CameraLaunchCmd::upVectorFlagLong = "-upVector";
+const char* CameraLaunchCmd::bouncesFlag = "-bn";
+const char* CameraLaunchCmd::bouncesFlagLong = "-bounces";
+const char* CameraLaunchCmd::restitutionFlag = "-rst";
+const char* CameraLaunchCmd::restitutionFlagLong = "-restitution";
+const char* CameraLaunchCmd::frictionFlag = "-fr";
+const char* CameraLaunchCmd::frictionFlagLong = "-friction";
+const char* CameraLaunchCmd::samplesPerFrameFlag = "-spf";
+const char* CameraLaunchCmd::samplesPerFrameFlagLong = "-samplesPerFrame";
+const char* CameraLaunchCmd::cacheFlag = "-ch";
+const char* CameraLaunchCmd::cacheFlagLong = "-cache";
+const char* CameraLaunchCmd::backgroundFlag = "-bg";
+const char* CameraLaunchCmd::backgroundFlagLong = "-background";
+const char* CameraLaunchCmd::jobProgressFlag = "-jp";
+const char* CameraLaunchCmd::jobProgressFlagLong = "-jobProgress";
+const char* CameraLaunchCmd::cancelJobFlag = "-cj";
+const char* CameraLaunchCmd::cancelJobFlagLong = "-cancelJob";
+const char* CameraLaunchCmd::applyJobFlag = "-aj";
+const char* CameraLaunchCmd::applyJobFlagLong = "-applyJob";
+const char* CameraLaunchCmd::metricsFlag = "-mt";
+const char* CameraLaunchCmd::metricsFlagLong = "-metrics";
+const char* CameraLaunchCmd::windFlag = "-wd";
+const char* CameraLaunchCmd::windFlagLong = "-wind";
+const char* CameraLaunchCmd::forceFieldFlag = "-ff";
+const char* CameraLaunchCmd::forceFieldFlagLong = "-forceField";
+const char* CameraLaunchCmd::fieldScaleFlag = "-fs";
+const char* CameraLaunchCmd::fieldScaleFlagLong = "-fieldScale";
+const char* CameraLaunchCmd::attractorFlag = "-at";
+const char* CameraLaunchCmd::attractorFlagLong = "-attractor";
+const char* CameraLaunchCmd::gravityConstantFlag = "-gc";
+const char* CameraLaunchCmd::gravityConstantFlagLong = "-gravityConstant";
+const char* CameraLaunchCmd::softeningFlag = "-sof";
+const char* CameraLaunchCmd::softeningFlagLong = "-softening";
+const char* CameraLaunchCmd::objectFlag = "-obj";
+const char* CameraLaunchCmd::objectFlagLong = "-object";
+const char* CameraLaunchCmd::emitFlag = "-em";
+const char* CameraLaunchCmd::emitFlagLong = "-emit";
+const char* CameraLaunchCmd::emitFromFlag = "-ef";
+const char* CameraLaunchCmd::emitFromFlagLong = "-emitFrom";
+const char* CameraLaunchCmd::coneAngleFlag = "-ca";
+const char* CameraLaunchCmd::coneAngleFlagLong = "-coneAngle";
+const char* CameraLaunchCmd::speedRangeFlag = "-sr";
+const char* CameraLaunchCmd::speedRangeFlagLong = "-speedRange";
+const char* CameraLaunchCmd::seedFlag = "-sd";
+const char* CameraLaunchCmd::seedFlagLong = "-seed";
+const char* CameraLaunchCmd::inheritVelocityFlag = "-iv";
+const char* CameraLaunchCmd::inheritVelocityFlagLong = "-inheritVelocity";
+const char* CameraLaunchCmd::lookAtFlag = "-la";
+const char* CameraLaunchCmd::lookAtFlagLong = "-lookAt";
+const char* CameraLaunchCmd::upObjectFlag = "-uo";
+const char* CameraLaunchCmd::upObjectFlagLong = "-upObject";
+const char* CameraLaunchCmd::framingOffsetFlag = "-fo";
+const char* CameraLaunchCmd::framingOffsetFlagLong = "-framingOffset";
+
+std::unique_ptr<LaunchCore::ComputeQueue> CameraLaunchCmd::computeQueue;
+std::map<uint64_t, std::shared_ptr<CameraLaunchCmd::AsyncLaunch>> CameraLaunchCmd::asyncLaunches;
+MCallbackId CameraLaunchCmd::collectCallbackId = 0;
+std::unique_ptr<LaunchCore::ThreadPool> CameraLaunchCmd::bakePool;
+
+// Dynamic attribute marking the anim curves this command created
+static const char* launchCurveTag = "cameraLaunchCurve";
+static const char* launchCurveTagShort = "clc";
+
+// Transforms directly under the world have a path of one node
+static bool hasParent(const MDagPath& path)
+{
+	MDagPath transformPath;
+	return MDagPath::getAPathTo(path.transform(), transformPath) && transformPath.length() > 1;
+}
 
 CameraLaunchCmd::CameraLaunchCmd()
 {
-	//CameraLaunchCmd::m_cameraPath is null
-	CameraLaunchCmd::m_velocity = MVector(0, 0, 0);
 	CameraLaunchCmd::m_gravity = -9.81;
-	CameraLaunchCmd::m_startFrame = 0;
+	CameraLaunchCmd::m_bake = false;
+	CameraLaunchCmd::m_bakeStep = 1.0;
+	CameraLaunchCmd::m_samplesPerFrame = 1;
+	CameraLaunchCmd::m_timeUnit = MTime::kFilm;
+	CameraLaunchCmd::m_tolerance = 0.0;
+	CameraLaunchCmd::m_orient = false;
+	CameraLaunchCmd::m_fieldKind = LaunchCore::FieldKind::WIND;
+	CameraLaunchCmd::m_fieldScale = 1.0;
+	CameraLaunchCmd::m_gravityConstant = 1.0;
+	CameraLaunchCmd::m_softening = 0.1;
+	CameraLaunchCmd::m_emittedInScene = false;
+	CameraLaunchCmd::m_inheritVelocity = false;
+	CameraLaunchCmd::m_targetConstraint = LaunchCore::TargetConstraint::FLIGHT_TIME;
+	CameraLaunchCmd::m_targetValue = 0.0;
+	CameraLaunchCmd::m_metricsQuery = false;
+	CameraLaunchCmd::m_background = false;
+	CameraLaunchCmd::m_asyncSubmitted = false;
+	CameraLaunchCmd::m_jobAction = JobAction::NONE;
+	CameraLaunchCmd::m_jobId = 0;
 	CameraLaunchCmd::m_hasValidData = false;
+	CameraLaunchCmd::m_profileEnabled = false;
+	CameraLaunchCmd::m_profileHistoryQuery = false;
 }
 
 CameraLaunchCmd::~CameraLaunchCmd()
@@ -25,308 +141,1817 @@ CameraLaunchCmd::~CameraLaunchCmd()
 
 }
 
-void* CameraLaunchCmd::creator()
+void* CameraLaunchCmd::creator()
+{
+	return new CameraLaunchCmd();
+}
+
+MSyntax CameraLaunchCmd::newSyntax()
+{
+	MSyntax syntax;
+	syntax.addFlag(velocityFlag, velocityFlagLong, MSyntax::kDouble, MSyntax::kDouble, MSyntax::kDouble);
+	syntax.addFlag(cameraFlag, cameraFlagLong, MSyntax::kString);
+	syntax.addFlag(gravityFlag, gravityFlagLong, MSyntax::kDouble);
+	syntax.addFlag(startFrameFlag, startFrameLongFlag, MSyntax::kDouble);
+	syntax.addFlag(bakeFlag, bakeFlagLong);
+	syntax.addFlag(bakeStepFlag, bakeStepFlagLong, MSyntax::kDouble);
+	syntax.addFlag(dragFlag, dragFlagLong, MSyntax::kDouble, MSyntax::kDouble);
+	syntax.addFlag(massFlag, massFlagLong, MSyntax::kDouble);
+	syntax.addFlag(collideFlag, collideFlagLong, MSyntax::kString);
+	syntax.addFlag(targetFlag, targetFlagLong, MSyntax::kDouble, MSyntax::kDouble, MSyntax::kDouble);
+	syntax.addFlag(targetObjectFlag, targetObjectFlagLong, MSyntax::kString);
+	syntax.addFlag(flightTimeFlag, flightTimeFlagLong, MSyntax::kDouble);
+	syntax.addFlag(apexHeightFlag, apexHeightFlagLong, MSyntax::kDouble);
+	syntax.addFlag(toleranceFlag, toleranceFlagLong, MSyntax::kDouble);
+	syntax.addFlag(profileFlag, profileFlagLong);
+	syntax.addFlag(profileHistoryFlag, profileHistoryFlagLong);
+	syntax.addFlag(orientFlag, orientFlagLong);
+	syntax.addFlag(bankFlag, bankFlagLong, MSyntax::kDouble);
+	syntax.addFlag(upVectorFlag, upVectorFlagLong, MSyntax::kDouble, MSyntax::kDouble, MSyntax::kDouble);
+	syntax.addFlag(bouncesFlag, bouncesFlagLong, MSyntax::kLong);
+	syntax.addFlag(restitutionFlag, restitutionFlagLong, MSyntax::kDouble);
+	syntax.addFlag(frictionFlag, frictionFlagLong, MSyntax::kDouble);
+	syntax.addFlag(samplesPerFrameFlag, samplesPerFrameFlagLong, MSyntax::kLong);
+	syntax.addFlag(cacheFlag, cacheFlagLong, MSyntax::kString);
+	syntax.addFlag(backgroundFlag, backgroundFlagLong);
+	syntax.addFlag(jobProgressFlag, jobProgressFlagLong, MSyntax::kLong);
+	syntax.addFlag(cancelJobFlag, cancelJobFlagLong, MSyntax::kLong);
+	syntax.addFlag(applyJobFlag, applyJobFlagLong, MSyntax::kLong);
+	syntax.addFlag(metricsFlag, metricsFlagLong);
+	syntax.addFlag(windFlag, windFlagLong, MSyntax::kString);
+	syntax.addFlag(forceFieldFlag, forceFieldFlagLong, MSyntax::kString);
+	syntax.addFlag(fieldScaleFlag, fieldScaleFlagLong, MSyntax::kDouble);
+	syntax.addFlag(attractorFlag, attractorFlagLong, MSyntax::kString, MSyntax::kDouble);
+	syntax.addFlag(gravityConstantFlag, gravityConstantFlagLong, MSyntax::kDouble);
+	syntax.addFlag(softeningFlag, softeningFlagLong, MSyntax::kDouble);
+	syntax.addFlag(objectFlag, objectFlagLong, MSyntax::kString);
+	syntax.addFlag(emitFlag, emitFlagLong, MSyntax::kLong);
+	syntax.addFlag(emitFromFlag, emitFromFlagLong, MSyntax::kString);
+	syntax.addFlag(coneAngleFlag, coneAngleFlagLong, MSyntax::kDouble);
+	syntax.addFlag(speedRangeFlag, speedRangeFlagLong, MSyntax::kDouble, MSyntax::kDouble);
+	syntax.addFlag(seedFlag, seedFlagLong, MSyntax::kLong);
+	syntax.addFlag(inheritVelocityFlag, inheritVelocityFlagLong);
+	syntax.addFlag(lookAtFlag, lookAtFlagLong, MSyntax::kString);
+	syntax.addFlag(upObjectFlag, upObjectFlagLong, MSyntax::kString);
+	syntax.addFlag(framingOffsetFlag, framingOffsetFlagLong, MSyntax::kDouble, MSyntax::kDouble, MSyntax::kDouble);
+
+	// -camera, -object, -velocity, -startFrame and the targets may be repeated to launch several objects at once
+	syntax.makeFlagMultiUse(cameraFlag);
+	syntax.makeFlagMultiUse(objectFlag);
+	syntax.makeFlagMultiUse(velocityFlag);
+	syntax.makeFlagMultiUse(startFrameFlag);
+	syntax.makeFlagMultiUse(collideFlag);
+	syntax.makeFlagMultiUse(targetFlag);
+	syntax.makeFlagMultiUse(targetObjectFlag);
+	syntax.makeFlagMultiUse(attractorFlag);
+	return syntax;
+}
+
+MStatus CameraLaunchCmd::doIt(const MArgList& args)
+{
+	MStatus status = parseArguments(args);
+	if (!status) return status;
+
+	// Recent profiles are returned without launching anything
+	if (m_profileHistoryQuery) {
+		setResult(MString(LaunchCore::ProfileHistory::global().toJson().c_str()));
+		return MS::kSuccess;
+	}
+
+	// Launches on the compute queue are polled, cancelled and keyed by job id
+	if (m_jobAction != JobAction::NONE) {
+		return runJobAction();
+	}
+
+	// The frame rate is read once; redo replays the launch at the rate it was made with
+	m_timeUnit = MTime::uiUnit();
+	m_timeBase = LaunchCore::TimeBase(1.0 / MTime(1.0, m_timeUnit).asUnits(MTime::kSeconds), m_samplesPerFrame);
+
+	// Objects on a rig launch from where it carries them at the launch frame; resolved once for redo
+	status = resolveParents();
+	if (!status) return status;
+
+	// Targets are solved once against the cameras' current positions, so redo replays the same launch
+	status = solveLaunchTargets();
+	if (!status) return status;
+
+	// Metrics come straight from the closed form, without touching the DG or the undo queue
+	if (m_metricsQuery) {
+		return queryFlightMetrics();
+	}
+
+	// Baking is left to the compute queue, and the keys are written by -applyJob when it is done
+	if (m_background) {
+		if (bakesFlights()) {
+			return submitAsyncLaunch();
+		}
+		MGlobal::displayWarning("-background only applies to launches that bake; launching now");
+	}
+
+	status = createEmittedObjects();
+	if (!status) return status;
+
+	return redoIt();
+}
+
+MStatus CameraLaunchCmd::redoIt()
+{
+	if (!m_hasValidData) {
+		return MS::kFailure;
+	}
+
+	// Locators emitted by the first run come back as the same nodes before they are keyed again
+	if (m_emittedObjects && !m_emittedInScene) {
+		m_emittedObjects->doIt();
+		m_emittedInScene = true;
+	}
+
+	beginProfile("redoIt");
+	MStatus status = executeCommand();
+	endProfile();
+
+	return status;
+}
+
+MStatus CameraLaunchCmd::undoIt()
+{
+	if (!m_hasValidData) {
+		return MS::kFailure;
+	}
+
+	MStatus status;
+	beginProfile("undoIt");
+
+	// Put back the keys of the curves an earlier launch left behind
+	if (m_curveEdits) {
+		LaunchCore::ScopedPhase phase(m_profile.get(), "revertCurveEdits");
+		status = m_curveEdits->undoIt();
+		if (status != MS::kSuccess) {
+			MGlobal::displayWarning("Failed to revert animation curve edits during undo");
+		}
+		m_curveEdits.reset();
+	}
+
+	// Clear created curves
+	{
+		LaunchCore::ScopedPhase phase(m_profile.get(), "clearCreatedCurves");
+		MDGModifier createdCurves;
+		for (unsigned int i = 0; i < m_createdCurves.length(); ++i) {
+			createdCurves.deleteNode(m_createdCurves[i]);
+		}
+		status = createdCurves.doIt();
+		if (status != MS::kSuccess) {
+			MGlobal::displayWarning("Failed to clear animation curves during undo");
+		}
+		m_createdCurves.clear();
+	}
+
+	// Bring back the replaced curves exactly as they were, keys and connections included
+	if (m_replacedCurves) {
+		LaunchCore::ScopedPhase phase(m_profile.get(), "restoreReplacedCurves");
+		status = m_replacedCurves->undoIt();
+		if (status != MS::kSuccess) {
+			MGlobal::displayWarning("Failed to restore animation curves during undo");
+		}
+		m_replacedCurves.reset();
+	}
+
+	// Restore selection
+	{
+		LaunchCore::ScopedPhase phase(m_profile.get(), "restoreSelection");
+		MGlobal::setActiveSelectionList(m_originalSelection);
+	}
+
+	// Emitted locators leave the scene along with their keys
+	if (m_emittedObjects && m_emittedInScene) {
+		LaunchCore::ScopedPhase phase(m_profile.get(), "removeEmittedObjects");
+		status = m_emittedObjects->undoIt();
+		if (status != MS::kSuccess) {
+			MGlobal::displayWarning("Failed to remove emitted locators during undo");
+		}
+		m_emittedInScene = false;
+	}
+
+	{
+		LaunchCore::ScopedPhase phase(m_profile.get(), "refresh");
+		M3dView::active3dView().refresh();
+	}
+
+	endProfile();
+	return MS::kSuccess;
+}
+
+bool CameraLaunchCmd::isUndoable() const
+{
+	// Submitting, polling and cancelling a job leave the scene alone; applying it is the undoable step
+	return !m_profileHistoryQuery && !m_metricsQuery && !m_asyncSubmitted
+		&& (m_jobAction == JobAction::NONE || m_jobAction == JobAction::APPLY);
+}
+
+void CameraLaunchCmd::beginProfile(const char* command)
+{
+	if (!m_profileEnabled) {
+		return;
+	}
+
+	m_profile.reset(new LaunchCore::ProfileRecord());
+	m_profile->command = command;
+	m_profile->cameras = m_launches.size();
+	m_profileStart = std::chrono::steady_clock::now();
+}
+
+void CameraLaunchCmd::endProfile()
+{
+	if (!m_profile) {
+		return;
+	}
+
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_profileStart;
+	m_profile->totalMilliseconds = elapsed.count();
+
+	LaunchCore::ProfileHistory::global().push(*m_profile);
+	setResult(MString(m_profile->toJson().c_str()));
+	m_profile.reset();
+}
+
+MStatus CameraLaunchCmd::parseArguments(const MArgList& args)
+{
+	MStatus status;
+	MArgDatabase argData(newSyntax(), args, &status);
+	if (!status) return status;
+
+	m_profileHistoryQuery = argData.isFlagSet(profileHistoryFlag);
+	if (m_profileHistoryQuery) {
+		return MS::kSuccess;
+	}
+
+	// Job flags act on an earlier -background launch and take nothing else
+	const char* jobFlags[] = { jobProgressFlag, cancelJobFlag, applyJobFlag };
+	const JobAction jobActions[] = { JobAction::PROGRESS, JobAction::CANCEL, JobAction::APPLY };
+	m_jobAction = JobAction::NONE;
+	for (int i = 0; i < 3; ++i) {
+		if (!argData.isFlagSet(jobFlags[i])) continue;
+		if (m_jobAction != JobAction::NONE) {
+			MGlobal::displayError("Use only one of -jobProgress, -cancelJob or -applyJob");
+			return MS::kFailure;
+		}
+
+		m_jobAction = jobActions[i];
+		m_jobId = (uint64_t)argData.flagArgumentInt(jobFlags[i], 0);
+	}
+	if (m_jobAction != JobAction::NONE) {
+		return MS::kSuccess;
+	}
+	m_background = argData.isFlagSet(backgroundFlag);
+	m_metricsQuery = argData.isFlagSet(metricsFlag);
+	m_profileEnabled = argData.isFlagSet(profileFlag);
+
+	m_launches.clear();
+
+	// Extract Cameras, resolving every DAG path up front
+	unsigned int numCameras = argData.numberOfFlagUses(cameraFlag);
+	for (unsigned int i = 0; i < numCameras; ++i) {
+		MArgList flagArgs;
+		argData.getFlagArgumentList(cameraFlag, i, flagArgs);
+		MString cameraName = flagArgs.asString(0);
+
+		MSelectionList selList;
+		selList.add(cameraName);
+
+		LaunchTarget launch;
+		launch.emitted = false;
+		launch.velocity = MVector(0, 0, 0);
+		launch.startFrame = 0.0;
+		launch.hasTarget = false;
+		launch.flightTime = 0.0;
+
+		status = selList.getDagPath(0, launch.cameraPath);
+		if (!status) {
+			MGlobal::displayError(MString("Could not find camera ") + cameraName);
+			return MS::kFailure;
+		}
+		if (!launch.cameraPath.hasFn(MFn::kCamera)) {
+			MGlobal::displayError(cameraName + " is not a camera");
+			return MS::kFailure;
+		}
+		if (hasParent(launch.cameraPath)) {
+			launch.parentMatrices = std::make_shared<LaunchCore::ParentMatrices>();
+		}
+
+		m_launches.push_back(launch);
+	}
+
+	// Extract Objects, any transform launched the same way as a camera
+	unsigned int numObjects = argData.numberOfFlagUses(objectFlag);
+	for (unsigned int i = 0; i < numObjects; ++i) {
+		MArgList flagArgs;
+		argData.getFlagArgumentList(objectFlag, i, flagArgs);
+		MString objectName = flagArgs.asString(0);
+
+		MSelectionList selList;
+		selList.add(objectName);
+
+		LaunchTarget launch;
+		launch.emitted = false;
+		launch.velocity = MVector(0, 0, 0);
+		launch.startFrame = 0.0;
+		launch.hasTarget = false;
+		launch.flightTime = 0.0;
+
+		status = selList.getDagPath(0, launch.cameraPath);
+		if (!status) {
+			MGlobal::displayError(MString("Could not find object ") + objectName);
+			return MS::kFailure;
+		}
+		if (!launch.cameraPath.hasFn(MFn::kTransform)) {
+			MGlobal::displayError(objectName + " is not a transform");
+			return MS::kFailure;
+		}
+		if (hasParent(launch.cameraPath)) {
+			launch.parentMatrices = std::make_shared<LaunchCore::ParentMatrices>();
+		}
+
+		m_launches.push_back(launch);
+	}
+
+	// Extract Emitter. -emit makes that many locators, launched from the -emitFrom object or the origin.
+	// They are only created once the launch is known to be valid, in doIt.
+	if (argData.isFlagSet(emitFlag)) {
+		int emitCount = argData.flagArgumentInt(emitFlag, 0);
+		if (emitCount < 1) {
+			MGlobal::displayError("-emit must be at least 1");
+			return MS::kFailure;
+		}
+		if (m_background) {
+			MGlobal::displayError("-emit cannot be combined with -background");
+			return MS::kFailure;
+		}
+
+		LaunchTarget launch;
+		launch.emitted = true;
+		launch.velocity = MVector(0, 0, 0);
+		launch.startFrame = 0.0;
+		launch.hasTarget = false;
+		launch.flightTime = 0.0;
+
+		if (argData.isFlagSet(emitFromFlag)) {
+			MString emitterName = argData.flagArgumentString(emitFromFlag, 0);
+
+			MSelectionList selList;
+			selList.add(emitterName);
+			status = selList.getDagPath(0, launch.cameraPath);
+			if (!status) {
+				MGlobal::displayError(MString("Could not find emitter ") + emitterName);
+				return MS::kFailure;
+			}
+		}
+
+		m_launches.insert(m_launches.end(), (size_t)emitCount, launch);
+	}
+	else if (argData.isFlagSet(emitFromFlag)) {
+		MGlobal::displayWarning("-emitFrom only applies with -emit");
+	}
+
+	if (m_launches.empty() && !m_metricsQuery) {
+		MGlobal::displayError("No camera or object specified");
+		return MS::kFailure;
+	}
+
+	// Extract Velocity, either one per camera or one shared by all cameras
+	unsigned int numVelocities = argData.numberOfFlagUses(velocityFlag);
+
+	// -metrics scores every velocity from the same start: the one camera given, or the origin
+	if (m_metricsQuery && m_launches.size() <= 1 && numVelocities > 0) {
+		LaunchTarget launch;
+		if (m_launches.empty()) {
+			launch.emitted = false;
+			launch.velocity = MVector(0, 0, 0);
+			launch.startFrame = 0.0;
+			launch.hasTarget = false;
+			launch.flightTime = 0.0;
+		}
+		else {
+			launch = m_launches.front();
+		}
+		m_launches.assign(numVelocities, launch);
+	}
+	if (m_launches.empty()) {
+		MGlobal::displayError("-metrics needs a -camera or at least one -velocity");
+		return MS::kFailure;
+	}
+
+	if (numVelocities > 1 && numVelocities != m_launches.size()) {
+		MGlobal::displayError("Expected one -velocity, or one -velocity per -camera");
+		return MS::kFailure;
+	}
+	for (unsigned int i = 0; i < numVelocities; ++i) {
+		MArgList flagArgs;
+		argData.getFlagArgumentList(velocityFlag, i, flagArgs);
+		double vx = flagArgs.asDouble(0);
+		double vy = flagArgs.asDouble(1);
+		double vz = flagArgs.asDouble(2);
+
+		MVector velocity(vx, vy, vz);
+		if (numVelocities == 1) {
+			for (LaunchTarget& launch : m_launches) {
+				launch.velocity = velocity;
+			}
+		}
+		else {
+			m_launches[i].velocity = velocity;
+		}
+	}
+
+	// Extract Velocity Spread. Each launch's velocity becomes the axis of a cone, and its speed the
+	// speed range, that a velocity of its own is drawn from.
+	bool spread = argData.isFlagSet(coneAngleFlag) || argData.isFlagSet(speedRangeFlag) || argData.isFlagSet(seedFlag);
+	LaunchCore::EmitterSettings emitter;
+	if (argData.isFlagSet(coneAngleFlag)) {
+		double coneAngle = argData.flagArgumentDouble(coneAngleFlag, 0);
+		if (coneAngle < 0.0 || coneAngle > 180.0) {
+			MGlobal::displayError("-coneAngle must be between 0 and 180 degrees");
+			return MS::kFailure;
+		}
+
+		emitter.coneAngle = MAngle(coneAngle, MAngle::kDegrees).asRadians();
+	}
+
+	if (argData.isFlagSet(speedRangeFlag)) {
+		emitter.minSpeed = argData.flagArgumentDouble(speedRangeFlag, 0);
+		emitter.maxSpeed = argData.flagArgumentDouble(speedRangeFlag, 1);
+		if (emitter.minSpeed < 0.0 || emitter.maxSpeed < emitter.minSpeed) {
+			MGlobal::displayError("-speedRange needs a minimum of at least zero and a maximum no smaller than it");
+			return MS::kFailure;
+		}
+	}
+
+	if (argData.isFlagSet(seedFlag)) {
+		emitter.seed = (uint64_t)(int64_t)argData.flagArgumentInt(seedFlag, 0);
+	}
+
+	// Drawn by launch index, so the same seed gives every launch the same velocity on every run
+	for (size_t i = 0; spread && i < m_launches.size(); ++i) {
+		LaunchTarget& launch = m_launches[i];
+		LaunchCore::EmitterSettings settings = emitter;
+		settings.direction = LaunchCore::Vec3(launch.velocity.x, launch.velocity.y, launch.velocity.z);
+		if (!argData.isFlagSet(speedRangeFlag)) {
+			settings.minSpeed = settings.maxSpeed = launch.velocity.length();
+		}
+
+		LaunchCore::Vec3 velocity = LaunchCore::sampleEmitterVelocity(settings, i);
+		launch.velocity = MVector(velocity.x, velocity.y, velocity.z);
+	}
+
+	m_inheritVelocity = argData.isFlagSet(inheritVelocityFlag);
+
+	// Extract Gravity
+	if (argData.isFlagSet(gravityFlag)) {
+		double gravity = argData.flagArgumentDouble(gravityFlag, 0);
+
+		m_gravity = gravity;
+	}
+
+	// Extract Start Frame, either one per camera or one shared by all cameras
+	unsigned int numStartFrames = argData.numberOfFlagUses(startFrameFlag);
+	if (numStartFrames > 1 && numStartFrames != m_launches.size()) {
+		MGlobal::displayError("Expected one -startFrame, or one -startFrame per -camera");
+		return MS::kFailure;
+	}
+	for (unsigned int i = 0; i < numStartFrames; ++i) {
+		MArgList flagArgs;
+		argData.getFlagArgumentList(startFrameFlag, i, flagArgs);
+		double startFrame = flagArgs.asDouble(0);
+
+		if (numStartFrames == 1) {
+			for (LaunchTarget& launch : m_launches) {
+				launch.startFrame = startFrame;
+			}
+		}
+		else {
+			m_launches[i].startFrame = startFrame;
+		}
+	}
+
+	// Extract Bake
+	m_bake = argData.isFlagSet(bakeFlag);
+
+	if (argData.isFlagSet(bakeStepFlag)) {
+		double bakeStep = argData.flagArgumentDouble(bakeStepFlag, 0);
+		if (bakeStep <= 0.0) {
+			MGlobal::displayError("-bakeStep must be greater than zero");
+			return MS::kFailure;
+		}
+
+		m_bakeStep = bakeStep;
+	}
+
+	// Extract Samples Per Frame. Sub-frame samples only exist on a baked flight, so this bakes.
+	if (argData.isFlagSet(samplesPerFrameFlag)) {
+		int samplesPerFrame = argData.flagArgumentInt(samplesPerFrameFlag, 0);
+		if (samplesPerFrame < 1) {
+			MGlobal::displayError("-samplesPerFrame must be at least 1");
+			return MS::kFailure;
+		}
+
+		m_samplesPerFrame = samplesPerFrame;
+		m_bake = m_bake || samplesPerFrame > 1;
+	}
+
+	// Extract Cache Directory, shared by every launch that bakes
+	m_cacheDirectory = argData.isFlagSet(cacheFlag) ? argData.flagArgumentString(cacheFlag, 0) : MString();
+
+	// Extract Tolerance, in scene units for translation and degrees for rotation
+	if (argData.isFlagSet(toleranceFlag)) {
+		double tolerance = argData.flagArgumentDouble(toleranceFlag, 0);
+		if (tolerance <= 0.0) {
+			MGlobal::displayError("-tolerance must be greater than zero");
+			return MS::kFailure;
+		}
+
+		m_tolerance = tolerance;
+	}
+
+	// Extract Orientation. -bank and -upVector shape the per-frame orientation, so they turn it on too.
+	m_orient = argData.isFlagSet(orientFlag) || argData.isFlagSet(bankFlag) || argData.isFlagSet(upVectorFlag);
+
+	if (argData.isFlagSet(bankFlag)) {
+		m_orientation.banking = argData.flagArgumentDouble(bankFlag, 0);
+	}
+
+	if (argData.isFlagSet(upVectorFlag)) {
+		MVector up(argData.flagArgumentDouble(upVectorFlag, 0),
+			argData.flagArgumentDouble(upVectorFlag, 1),
+			argData.flagArgumentDouble(upVectorFlag, 2));
+		if (up.length() == 0.0) {
+			MGlobal::displayError("-upVector must not be zero");
+			return MS::kFailure;
+		}
+
+		m_orientation.up = LaunchCore::Vec3(up.x, up.y, up.z);
+	}
+
+	// Extract Look At. It replaces the aim along the velocity, so -orient and -bank have nothing to do.
+	if (argData.isFlagSet(lookAtFlag)) {
+		MString targetName = argData.flagArgumentString(lookAtFlag, 0);
+		MSelectionList selList;
+		selList.add(targetName);
+		if (!selList.getDagPath(0, m_lookAt.target)) {
+			MGlobal::displayError(MString("Could not find look-at target ") + targetName);
+			return MS::kFailure;
+		}
+		m_lookAt.targetMatrices = std::make_shared<LaunchCore::ParentMatrices>();
+
+		if (argData.isFlagSet(upObjectFlag)) {
+			MString upObjectName = argData.flagArgumentString(upObjectFlag, 0);
+			MSelectionList upList;
+			upList.add(upObjectName);
+			if (!upList.getDagPath(0, m_lookAt.upObject)) {
+				MGlobal::displayError(MString("Could not find up object ") + upObjectName);
+				return MS::kFailure;
+			}
+			m_lookAt.upMatrices = std::make_shared<LaunchCore::ParentMatrices>();
+		}
+
+		if (argData.isFlagSet(framingOffsetFlag)) {
+			m_lookAt.settings.offset = LaunchCore::Vec3(argData.flagArgumentDouble(framingOffsetFlag, 0),
+				argData.flagArgumentDouble(framingOffsetFlag, 1),
+				argData.flagArgumentDouble(framingOffsetFlag, 2));
+		}
+		m_lookAt.settings.up = m_orientation.up;
+
+		if (argData.isFlagSet(orientFlag) || argData.isFlagSet(bankFlag)) {
+			MGlobal::displayWarning("-orient and -bank are ignored with -lookAt");
+		}
+		m_orient = false;
+	}
+	else if (argData.isFlagSet(upObjectFlag) || argData.isFlagSet(framingOffsetFlag)) {
+		MGlobal::displayWarning("-upObject and -framingOffset only apply with -lookAt");
+	}
+
+	// Extract Drag (linear and quadratic coefficients)
+	if (argData.isFlagSet(dragFlag)) {
+		double linear = argData.flagArgumentDouble(dragFlag, 0);
+		double quadratic = argData.flagArgumentDouble(dragFlag, 1);
+		// Negative drag adds energy and the integrator runs away with it
+		if (linear < 0.0 || quadratic < 0.0) {
+			MGlobal::displayError("-drag coefficients must not be negative");
+			return MS::kFailure;
+		}
+
+		m_drag.linear = linear;
+		m_drag.quadratic = quadratic;
+	}
+
+	// Extract Mass
+	if (argData.isFlagSet(massFlag)) {
+		double mass = argData.flagArgumentDouble(massFlag, 0);
+		if (mass <= 0.0) {
+			MGlobal::displayError("-mass must be greater than zero");
+			return MS::kFailure;
+		}
+
+		m_drag.mass = mass;
+	}
+
+	// Extract Bounces
+	if (argData.isFlagSet(bouncesFlag)) {
+		int bounces = argData.flagArgumentInt(bouncesFlag, 0);
+		if (bounces < 0) {
+			MGlobal::displayError("-bounces must not be negative");
+			return MS::kFailure;
+		}
+
+		m_bounces.bounces = bounces;
+	}
+
+	if (argData.isFlagSet(restitutionFlag)) {
+		double restitution = argData.flagArgumentDouble(restitutionFlag, 0);
+		if (restitution < 0.0 || restitution > 1.0) {
+			MGlobal::displayError("-restitution must be between 0 and 1");
+			return MS::kFailure;
+		}
+
+		m_bounces.restitution = restitution;
+	}
+
+	if (argData.isFlagSet(frictionFlag)) {
+		double friction = argData.flagArgumentDouble(frictionFlag, 0);
+		if (friction < 0.0 || friction > 1.0) {
+			MGlobal::displayError("-friction must be between 0 and 1");
+			return MS::kFailure;
+		}
+
+		m_bounces.friction = friction;
+	}
+
+	// Extract the Wind or Force Field, from an FGA file or a fluid container
+	m_field.reset();
+	if (argData.isFlagSet(windFlag) && argData.isFlagSet(forceFieldFlag)) {
+		MGlobal::displayError("Use either -wind or -forceField, not both");
+		return MS::kFailure;
+	}
+
+	if (argData.isFlagSet(windFlag) || argData.isFlagSet(forceFieldFlag)) {
+		m_fieldKind = argData.isFlagSet(windFlag) ? LaunchCore::FieldKind::WIND : LaunchCore::FieldKind::FORCE;
+		MString source = argData.flagArgumentString(argData.isFlagSet(windFlag) ? windFlag : forceFieldFlag, 0);
+
+		std::shared_ptr<LaunchCore::VectorField> field = std::make_shared<LaunchCore::VectorField>();
+		status = loadVectorField(source, *field);
+		if (!status) return status;
+		m_field = field;
+	}
+
+	if (argData.isFlagSet(fieldScaleFlag)) {
+		m_fieldScale = argData.flagArgumentDouble(fieldScaleFlag, 0);
+	}
+
+	// Extract Attractors, each an object whose current world position is a point mass
+	m_attractors.reset();
+	unsigned int numAttractors = argData.numberOfFlagUses(attractorFlag);
+	if (numAttractors > 0) {
+		std::vector<LaunchCore::Attractor> attractors;
+		attractors.reserve(numAttractors);
+		for (unsigned int i = 0; i < numAttractors; ++i) {
+			MArgList flagArgs;
+			argData.getFlagArgumentList(attractorFlag, i, flagArgs);
+			MString objectName = flagArgs.asString(0);
+			double mass = flagArgs.asDouble(1);
+			if (mass <= 0.0) {
+				MGlobal::displayError(MString("Attractor ") + objectName + " needs a mass greater than zero");
+				return MS::kFailure;
+			}
+
+			MSelectionList selList;
+			selList.add(objectName);
+
+			MDagPath objectPath;
+			status = selList.getDagPath(0, objectPath);
+			if (!status) {
+				MGlobal::displayError(MString("Could not find attractor ") + objectName);
+				return MS::kFailure;
+			}
+
+			MPoint position = objectPath.inclusiveMatrix() * MPoint::origin;
+			attractors.push_back(LaunchCore::Attractor(LaunchCore::Vec3(position.x, position.y, position.z), mass));
+		}
+
+		std::shared_ptr<LaunchCore::AttractorTree> tree = std::make_shared<LaunchCore::AttractorTree>();
+		tree->build(attractors);
+		m_attractors = tree;
+	}
+
+	if (argData.isFlagSet(gravityConstantFlag)) {
+		m_gravityConstant = argData.flagArgumentDouble(gravityConstantFlag, 0);
+	}
+
+	if (argData.isFlagSet(softeningFlag)) {
+		double softening = argData.flagArgumentDouble(softeningFlag, 0);
+		if (softening <= 0.0) {
+			MGlobal::displayError("-softening must be greater than zero");
+			return MS::kFailure;
+		}
+
+		m_softening = softening;
+	}
+
+	if (m_bounces.bounces > 0 && integratesFlights()) {
+		MGlobal::displayWarning("-bounces only applies to launches without drag, fields or attractors and will be ignored");
+	}
+
+	if (m_metricsQuery && (m_drag.enabled() || m_bounces.bounces > 0 || argData.isFlagSet(collideFlag) || m_field || m_attractors)) {
+		MGlobal::displayWarning("-metrics describes the drag-free arc; -drag, -bounces, -collide, fields and attractors are ignored");
+	}
+
+	// Extract Collision Meshes
+	m_collisionMeshes.clear();
+	unsigned int numMeshes = argData.numberOfFlagUses(collideFlag);
+	for (unsigned int i = 0; i < numMeshes; ++i) {
+		MArgList flagArgs;
+		argData.getFlagArgumentList(collideFlag, i, flagArgs);
+		MString meshName = flagArgs.asString(0);
+
+		MSelectionList selList;
+		selList.add(meshName);
+
+		MDagPath meshPath;
+		status = selList.getDagPath(0, meshPath);
+		if (!status || !meshPath.extendToShape() || !meshPath.hasFn(MFn::kMesh)) {
+			MGlobal::displayError(meshName + " is not a mesh");
+			return MS::kFailure;
+		}
+
+		m_collisionMeshes.append(meshPath);
+	}
+
+	// Extract Targets, given as points or as objects whose current world position is used
+	unsigned int numTargetPoints = argData.numberOfFlagUses(targetFlag);
+	unsigned int numTargetObjects = argData.numberOfFlagUses(targetObjectFlag);
+	if (numTargetPoints > 0 && numTargetObjects > 0) {
+		MGlobal::displayError("Use either -target or -targetObject, not both");
+		return MS::kFailure;
+	}
+
+	unsigned int numTargets = numTargetPoints + numTargetObjects;
+	if (numTargets > 0 && spread) {
+		MGlobal::displayError("-coneAngle, -speedRange and -seed cannot be combined with a target");
+		return MS::kFailure;
+	}
+	if (numTargets > 1 && numTargets != m_launches.size()) {
+		MGlobal::displayError("Expected one target, or one target per -camera");
+		return MS::kFailure;
+	}
+
+	for (unsigned int i = 0; i < numTargets; ++i) {
+		MArgList flagArgs;
+		MVector targetPoint;
+		if (numTargetPoints > 0) {
+			argData.getFlagArgumentList(targetFlag, i, flagArgs);
+			targetPoint = MVector(flagArgs.asDouble(0), flagArgs.asDouble(1), flagArgs.asDouble(2));
+		}
+		else {
+			argData.getFlagArgumentList(targetObjectFlag, i, flagArgs);
+			MString objectName = flagArgs.asString(0);
+
+			MSelectionList selList;
+			selList.add(objectName);
+
+			MDagPath objectPath;
+			status = selList.getDagPath(0, objectPath);
+			if (!status) {
+				MGlobal::displayError(MString("Could not find target ") + objectName);
+				return MS::kFailure;
+			}
+			targetPoint = objectPath.inclusiveMatrix() * MPoint::origin;
+		}
+
+		for (unsigned int j = 0; j < m_launches.size(); ++j) {
+			if (numTargets == 1 || j == i) {
+				m_launches[j].hasTarget = true;
+				m_launches[j].targetPoint = targetPoint;
+			}
+		}
+	}
+
+	// Extract Flight Time / Apex Height, which shape the arc to the target
+	bool hasFlightTime = argData.isFlagSet(flightTimeFlag);
+	bool hasApexHeight = argData.isFlagSet(apexHeightFlag);
+	if (numTargets > 0) {
+		if (hasFlightTime == hasApexHeight) {
+			MGlobal::displayError("A target needs exactly one of -flightTime or -apexHeight");
+			return MS::kFailure;
+		}
+		if (numVelocities > 0) {
+			MGlobal::displayWarning("-velocity is ignored when launching at a target");
+		}
+		if (m_inheritVelocity) {
+			MGlobal::displayWarning("-inheritVelocity is ignored when launching at a target");
+		}
+
+		if (hasFlightTime) {
+			m_targetConstraint = LaunchCore::TargetConstraint::FLIGHT_TIME;
+			m_targetValue = argData.flagArgumentDouble(flightTimeFlag, 0);
+			if (m_targetValue <= 0.0) {
+				MGlobal::displayError("-flightTime must be greater than zero");
+				return MS::kFailure;
+			}
+		}
+		else {
+			m_targetConstraint = LaunchCore::TargetConstraint::APEX_HEIGHT;
+			m_targetValue = argData.flagArgumentDouble(apexHeightFlag, 0);
+		}
+	}
+	else if (hasFlightTime && m_attractors && !m_metricsQuery) {
+		// Flights through gravity wells may never come back down, so -flightTime sets their length
+		double flightTime = argData.flagArgumentDouble(flightTimeFlag, 0);
+		if (flightTime <= 0.0) {
+			MGlobal::displayError("-flightTime must be greater than zero");
+			return MS::kFailure;
+		}
+
+		for (LaunchTarget& launch : m_launches) {
+			launch.flightTime = flightTime;
+		}
+		if (hasApexHeight) {
+			MGlobal::displayWarning("-apexHeight only applies with -target or -targetObject");
+		}
+	}
+	else if (hasFlightTime || hasApexHeight) {
+		MGlobal::displayWarning("-flightTime and -apexHeight only apply with -target or -targetObject");
+	}
+
+	m_hasValidData = true;
+	return MS::kSuccess;
+}
+
+MStatus CameraLaunchCmd::resolveParents()
+{
+	bool warnedInherit = false;
+	for (LaunchTarget& launch : m_launches) {
+		if (!launch.parentMatrices) {
+			if (m_inheritVelocity && !launch.hasTarget && !warnedInherit) {
+				MGlobal::displayWarning("-inheritVelocity is ignored for objects without a parent");
+				warnedInherit = true;
+			}
+			continue;
+		}
+
+		// The object keeps its place on the rig, which carries it to wherever it is at the launch frame
+		MVector current = launch.cameraPath.inclusiveMatrix() * MPoint::origin;
+		MMatrix parentNow = launch.cameraPath.exclusiveMatrix();
+		LaunchCore::Vec3 local = LaunchCore::inverseTransformPoint(&parentNow.matrix[0][0], LaunchCore::Vec3(current.x, current.y, current.z));
+
+		// The rig's velocity is differentiated over the frames either side of the launch
+		bool inherits = m_inheritVelocity && !launch.hasTarget;
+		const double frames[] = { launch.startFrame, launch.startFrame - 1.0, launch.startFrame + 1.0 };
+		MStatus status = evaluateMatrices(launch.cameraPath, "parentMatrix", *launch.parentMatrices, frames, inherits ? 3 : 1);
+		if (!status) return status;
+
+		const LaunchCore::ParentMatrices& parent = *launch.parentMatrices;
+		LaunchCore::Vec3 start = LaunchCore::transformPoint(parent.find(launch.startFrame), local);
+		launch.startPosition = MVector(start.x, start.y, start.z);
+
+		if (inherits) {
+			LaunchCore::Vec3 carried = LaunchCore::inheritedVelocity(parent, local, launch.startFrame, 1.0, m_timeBase.framesPerSecond());
+			launch.velocity += MVector(carried.x, carried.y, carried.z);
+		}
+	}
+
+	return MS::kSuccess;
+}
+
+MStatus CameraLaunchCmd::evaluateMatrices(const MDagPath& path, const char* attribute, LaunchCore::ParentMatrices& cache,
+	const double* frames, size_t count)
+{
+	std::vector<double> missing;
+	cache.missingFrames(frames, count, missing);
+	if (missing.empty()) {
+		return MS::kSuccess;
+	}
+
+	MStatus status;
+	MFnDependencyNode transformFn(path.transform());
+	MPlug matrixPlug = transformFn.findPlug(attribute, false, &status);
+	if (status) {
+		matrixPlug = matrixPlug.elementByLogicalIndex(path.instanceNumber(), &status);
+	}
+	if (!status) {
+		MGlobal::displayError(MString("Failed to read ") + attribute + " of " + path.partialPathName());
+		return status;
+	}
+
+	// Each frame is evaluated once, however many samples, channels and keys use it
+	std::vector<double> matrices(missing.size() * 16);
+	for (size_t i = 0; i < missing.size(); ++i) {
+		MDGContext context(MTime(missing[i], m_timeUnit));
+		MDGContextGuard guard(context);
+		MMatrix matrix = MFnMatrixData(matrixPlug.asMObject(&status)).matrix();
+		if (!status) {
+			MGlobal::displayError(MString("Failed to evaluate ") + attribute + " of " + path.partialPathName());
+			return status;
+		}
+
+		std::copy(&matrix.matrix[0][0], &matrix.matrix[0][0] + 16, &matrices[i * 16]);
+	}
+
+	cache.insert(missing, matrices);
+	return MS::kSuccess;
+}
+
+MStatus CameraLaunchCmd::solveLaunchTargets()
+{
+	std::vector<LaunchCore::TargetRequest> requests;
+	std::vector<size_t> launchIndices;
+	for (size_t i = 0; i < m_launches.size(); ++i) {
+		const LaunchTarget& launch = m_launches[i];
+		if (!launch.hasTarget) continue;
+
+		MVector startPos = getStartPosition(launch);
+
+		LaunchCore::TargetRequest request;
+		request.start = LaunchCore::Vec3(startPos.x, startPos.y, startPos.z);
+		request.target = LaunchCore::Vec3(launch.targetPoint.x, launch.targetPoint.y, launch.targetPoint.z);
+		request.constraint = m_targetConstraint;
+		request.value = m_targetValue;
+		requests.push_back(request);
+		launchIndices.push_back(i);
+	}
+
+	if (requests.empty()) {
+		return MS::kSuccess;
+	}
+
+	// Every camera is solved in one batch. With drag, a field or attractors the closed form is
+	// refined numerically; collision geometry is not part of the solve and only cuts the flight afterwards.
+	LaunchCore::TargetSolverSettings settings;
+	settings.framesPerSecond = m_timeBase.framesPerSecond();
+	settings.field = fieldSettings();
+	settings.wells = wellSettings();
+
+	std::vector<LaunchCore::TargetSolution> solutions;
+	LaunchCore::solveTargets(requests, m_gravity, m_drag, settings, solutions);
+
+	for (size_t i = 0; i < solutions.size(); ++i) {
+		LaunchTarget& launch = m_launches[launchIndices[i]];
+		const LaunchCore::TargetSolution& solution = solutions[i];
+		if (!solution.solved) {
+			MGlobal::displayError(MString("Could not solve a launch from ") + launch.cameraPath.partialPathName() + " to its target");
+			m_hasValidData = false;
+			return MS::kFailure;
+		}
+
+		launch.velocity = MVector(solution.velocity.x, solution.velocity.y, solution.velocity.z);
+		launch.flightTime = solution.flightTime;
+	}
+
+	return MS::kSuccess;
+}
+
+MStatus CameraLaunchCmd::createEmittedObjects()
+{
+	// One modifier for every locator, so undo and redo take them out and put them back together
+	std::vector<size_t> emitted;
+	std::vector<MObject> transforms;
+	for (size_t i = 0; i < m_launches.size(); ++i) {
+		if (!m_launches[i].emitted) continue;
+		if (!m_emittedObjects) {
+			m_emittedObjects.reset(new MDagModifier());
+		}
+
+		MStatus status;
+		MObject transform = m_emittedObjects->createNode("locator", MObject::kNullObj, &status);
+		if (!status) {
+			MGlobal::displayError("Failed to create an emitted locator");
+			m_emittedObjects.reset();
+			return status;
+		}
+		emitted.push_back(i);
+		transforms.push_back(transform);
+	}
+
+	if (!m_emittedObjects) {
+		return MS::kSuccess;
+	}
+
+	MStatus status = m_emittedObjects->doIt();
+	if (!status) {
+		MGlobal::displayError("Failed to create the emitted locators");
+		return status;
+	}
+	m_emittedInScene = true;
+
+	// Each locator starts where its emitter is now; from here on it is launched like any other object
+	for (size_t i = 0; i < emitted.size(); ++i) {
+		LaunchTarget& launch = m_launches[emitted[i]];
+		MVector start = getStartPosition(launch);
+		MFnTransform(transforms[i]).setTranslation(start, MSpace::kTransform);
+		MDagPath::getAPathTo(transforms[i], launch.cameraPath);
+		launch.emitted = false;
+	}
+
+	MGlobal::displayInfo(MString("Emitted ") + (int)emitted.size() + " locator(s)");
+	return MS::kSuccess;
+}
+
+MStatus CameraLaunchCmd::executeCommand()
+{
+	// Store current selection
+	{
+		LaunchCore::ScopedPhase phase(m_profile.get(), "storeSelection");
+		MGlobal::getActiveSelectionList(m_originalSelection);
+	}
+
+	// Clear existing keyframes. The modifier keeps the deleted curves alive for undo, so
+	// nothing needs to be copied out of them first. Curves from an earlier launch stay and
+	// have their keys edited in place, recorded in m_curveEdits.
+	{
+		LaunchCore::ScopedPhase phase(m_profile.get(), "clearCurves");
+		m_replacedCurves.reset(new MDGModifier());
+		m_curveEdits.reset(new MAnimCurveChange());
+		m_createdCurves.clear();
+		MStatus clearStatus = clearExistingAnimationCurves(*m_replacedCurves);
+		if (!clearStatus) {
+			MGlobal::displayWarning("Failed to clear existing animation curves");
+		}
+	}
+
+	// Generate keyframes
+	{
+		LaunchCore::ScopedPhase phase(m_profile.get(), "generateKeyframes");
+		MStatus keyframeStatus = generateKeyframes();
+		if (!keyframeStatus) {
+			return keyframeStatus;
+		}
+	}
+
+	// Clear selection and select cameras that were launched
+	{
+		LaunchCore::ScopedPhase phase(m_profile.get(), "selectCameras");
+		MSelectionList newSel;
+		for (const LaunchTarget& launch : m_launches) {
+			newSel.add(launch.cameraPath);
+		}
+		MGlobal::setActiveSelectionList(newSel);
+	}
+
+	// Redraw once for the whole batch
+	{
+		LaunchCore::ScopedPhase phase(m_profile.get(), "refresh");
+		M3dView::active3dView().refresh();
+	}
+
+	return MS::kSuccess;
+}
+
+MStatus CameraLaunchCmd::generateKeyframes()
+{
+	// Flights baked on the compute queue only need their keys written
+	if (m_computed) {
+		for (size_t i = 0; i < m_launches.size(); ++i) {
+			MStatus status = writeBakedFlight(m_launches[i], m_computed->flights[i]);
+			if (!status) return status;
+		}
+
+		MGlobal::displayInfo(MString("Successfully set baked camera trajectory on ") + (int)m_launches.size() + " camera(s)");
+		return MS::kSuccess;
+	}
+
+	// Triangles are pulled from the collision meshes once and shared by every camera
+	LaunchCore::TriangleBVH collisionBVH;
+	if (m_collisionMeshes.length() > 0) {
+		LaunchCore::ScopedPhase phase(m_profile.get(), "generateKeyframes/buildCollisionBVH");
+		MStatus status = buildCollisionBVH(collisionBVH);
+		if (!status) return status;
+	}
+
+	// Drag, field, gravity well and collision trajectories are not a single parabola, so they are
+	// always keyed per sample. Every flight is baked before the first key is written.
+	std::vector<LaunchCore::BakedFlight> flights;
+	if (bakesFlights()) {
+		LaunchCore::ScopedPhase phase(m_profile.get(), "generateKeyframes/bakeFlights");
+		bakeFlights(collisionBVH.empty() ? NULL : &collisionBVH, flights);
+	}
+
+	bool integrated = integratesFlights();
+	for (size_t i = 0; i < m_launches.size(); ++i) {
+		const LaunchTarget& launch = m_launches[i];
+		if (!flights.empty()) {
+			MStatus status = writeBakedFlight(launch, flights[i]);
+			if (!status) return status;
+			continue;
+		}
+
+		// Bouncing flights are a chain of parabolas, keyed at every apex and contact unless baked
+		if (m_bounces.bounces > 0 && !integrated && !m_bake && !m_orient) {
+			MStatus status = setBounceKeyframesOnCamera(launch, collisionBVH.empty() ? NULL : &collisionBVH);
+			if (!status) return status;
+			continue;
+		}
+
+		// Launches at a target land between frames; the keys sit on the exact apex and landing frames
+		MStatus status = setKeyframesOnCamera(launch);
+		if (!status) return status;
+	}
+
+	MGlobal::displayInfo(MString("Successfully set parabolic camera trajectory on ") + (int)m_launches.size() + " camera(s)");
+
+	return MS::kSuccess;
+}
+
+MStatus CameraLaunchCmd::queryFlightMetrics()
+{
+	std::vector<LaunchCore::LaunchParams> params;
+	params.reserve(m_launches.size());
+	for (const LaunchTarget& launch : m_launches) {
+		params.push_back(getLaunchParams(launch));
+	}
+
+	std::vector<LaunchCore::FlightMetrics> metrics;
+	LaunchCore::computeFlightMetrics(params, metrics);
+
+	// Flat, FLIGHT_METRIC_VALUES per launch in the order they were given
+	MDoubleArray result((unsigned int)(metrics.size() * LaunchCore::FLIGHT_METRIC_VALUES), 0.0);
+	double values[LaunchCore::FLIGHT_METRIC_VALUES];
+	for (size_t i = 0; i < metrics.size(); ++i) {
+		LaunchCore::packFlightMetrics(metrics[i], values);
+		for (size_t j = 0; j < LaunchCore::FLIGHT_METRIC_VALUES; ++j) {
+			result[(unsigned int)(i * LaunchCore::FLIGHT_METRIC_VALUES + j)] = values[j];
+		}
+	}
+
+	setResult(result);
+	return MS::kSuccess;
+}
+
+bool CameraLaunchCmd::bakesFlights() const
+{
+	// Whether generateKeyframes keys every launch from baked samples. Objects on a rig are keyed in
+	// its space, where the flight is no longer a parabola, so they always bake.
+	bool parented = std::any_of(m_launches.begin(), m_launches.end(), [](const LaunchTarget& launch) {
+		return launch.parentMatrices != nullptr;
+	});
+	bool looksAt = m_lookAt.target.isValid();
+	bool integrated = integratesFlights();
+	bool bounces = m_bounces.bounces > 0 && !integrated && !m_bake && !m_orient && !parented && !looksAt;
+	return !bounces && (m_bake || integrated || m_collisionMeshes.length() > 0 || m_orient || parented || looksAt);
+}
+
+MStatus CameraLaunchCmd::submitAsyncLaunch()
+{
+	std::shared_ptr<AsyncLaunch> job = std::make_shared<AsyncLaunch>();
+	job->launches = m_launches;
+	job->tolerance = m_tolerance;
+	job->orient = m_orient;
+	job->lookAt = m_lookAt;
+	job->timeBase = m_timeBase;
+	job->timeUnit = m_timeUnit;
+	job->field = m_field;
+	job->attractors = m_attractors;
+
+	// Everything read from the scene is read now; the worker never touches the DG
+	MStatus status = gatherCollisionTriangles(job->collisionVertices, job->collisionIndices);
+	if (!status) return status;
+
+	const LaunchCore::TriangleBVH* collision = job->collisionIndices.empty() ? NULL : &job->collision;
+	for (const LaunchTarget& launch : m_launches) {
+		job->requests.push_back(makeBakeRequest(launch, collision));
+	}
+	job->flights.resize(m_launches.size());
+
+	if (!computeQueue) {
+		computeQueue.reset(new LaunchCore::ComputeQueue());
+	}
+
+	// Building the BVH counts as one step of the progress, and every camera as another
+	uint64_t id = computeQueue->submit([job](LaunchCore::JobControl& control) {
+		const double steps = (double)job->requests.size() + 1.0;
+		control.setRange(0.0, 1.0 / steps);
+		if (!job->collisionIndices.empty()) {
+			job->collision.build(job->collisionVertices, job->collisionIndices);
+		}
+
+		for (size_t i = 0; i < job->requests.size(); ++i) {
+			control.setRange((i + 1.0) / steps, (i + 2.0) / steps);
+			if (!LaunchCore::bakeFlight(job->requests[i], job->flights[i], &control)) {
+				return false;
+			}
+		}
+		return true;
+	});
+	asyncLaunches[id] = job;
+
+	if (collectCallbackId == 0) {
+		collectCallbackId = MTimerMessage::addTimerCallback(0.1f, collectAsyncLaunches, NULL, &status);
+		if (!status) {
+			collectCallbackId = 0;
+			MGlobal::displayWarning("Could not watch the compute queue; key finished launches with -applyJob");
+		}
+	}
+
+	m_asyncSubmitted = true;
+	MGlobal::displayInfo(MString("cameraLaunch job ") + (int)id + " is baking " + (int)m_launches.size() + " camera(s)");
+	setResult((int)id);
+	return MS::kSuccess;
+}
+
+MStatus CameraLaunchCmd::runJobAction()
+{
+	// A job that has ended is still in the queue until it is collected, so only its state says whether it is baking
+	LaunchCore::JobState state = LaunchCore::JobState::FINISHED;
+	double progress = 0.0;
+	bool computing = computeQueue && computeQueue->status(m_jobId, state, progress)
+		&& (state == LaunchCore::JobState::QUEUED || state == LaunchCore::JobState::RUNNING);
+
+	// Ended jobs are collected here as well as on the timer, so -applyJob works without it and a
+	// finished job that is cancelled is never keyed
+	collectEndedJobs();
+	bool waiting = asyncLaunches.count(m_jobId) > 0;
+
+	switch (m_jobAction) {
+	case JobAction::PROGRESS:
+		// -1 for a job that is unknown, or already keyed, cancelled or failed
+		setResult(computing ? progress : waiting ? 1.0 : -1.0);
+		return MS::kSuccess;
+
+	case JobAction::CANCEL:
+		// A job that has finished baking can still be dropped before its keys are written
+		if (!computing && waiting) {
+			asyncLaunches.erase(m_jobId);
+			setResult(true);
+		}
+		else {
+			setResult(computing && computeQueue->cancel(m_jobId));
+		}
+		return MS::kSuccess;
+
+	case JobAction::APPLY:
+		if (computing || !waiting) {
+			MGlobal::displayError(MString("cameraLaunch job ") + (int)m_jobId + (computing ? " has not finished" : " does not exist"));
+			return MS::kFailure;
+		}
+
+		m_computed = asyncLaunches[m_jobId];
+		asyncLaunches.erase(m_jobId);
+
+		m_launches = m_computed->launches;
+		m_tolerance = m_computed->tolerance;
+		m_orient = m_computed->orient;
+		m_lookAt = m_computed->lookAt;
+		m_timeBase = m_computed->timeBase;
+		m_timeUnit = m_computed->timeUnit;
+		m_hasValidData = true;
+		return redoIt();
+
+	default:
+		return MS::kFailure;
+	}
+}
+
+void CameraLaunchCmd::collectEndedJobs()
 {
-	return new CameraLaunchCmd();
-}
+	if (!computeQueue) {
+		return;
+	}
 
-MSyntax CameraLaunchCmd::newSyntax()
-{
-	MSyntax syntax;
-	syntax.addFlag(velocityFlag, velocityFlagLong, MSyntax::kDouble, MSyntax::kDouble, MSyntax::kDouble);
-	syntax.addFlag(cameraFlag, cameraFlagLong, MSyntax::kString);
-	syntax.addFlag(gravityFlag, gravityFlagLong, MSyntax::kDouble);
-	syntax.addFlag(startFrameFlag, startFrameLongFlag, MSyntax::kDouble);
-	return syntax;
+	// Finished jobs stay in asyncLaunches until they are keyed or cancelled
+	for (const auto& ended : computeQueue->takeFinished()) {
+		uint64_t id = ended.first;
+		MString jobName = MString("cameraLaunch job ") + (int)id;
+
+		switch (ended.second) {
+		case LaunchCore::JobState::FINISHED:
+			break;
+		case LaunchCore::JobState::CANCELLED:
+			MGlobal::displayInfo(jobName + " was cancelled");
+			asyncLaunches.erase(id);
+			break;
+		default:
+			MGlobal::displayError(jobName + " failed");
+			asyncLaunches.erase(id);
+			break;
+		}
+	}
 }
 
-MStatus CameraLaunchCmd::doIt(const MArgList& args)
+void CameraLaunchCmd::collectAsyncLaunches(float, float, void*)
 {
-	MStatus status = parseArguments(args);
-	if (!status) return status;
+	if (!computeQueue) {
+		return;
+	}
 
-	return redoIt();
+	collectEndedJobs();
+
+	// Every launch the queue has let go of finished baking, whoever collected it
+	std::vector<uint64_t> finished;
+	for (const auto& job : asyncLaunches) {
+		LaunchCore::JobState state;
+		double progress = 0.0;
+		if (!computeQueue->status(job.first, state, progress)) {
+			finished.push_back(job.first);
+		}
+	}
+
+	// Keyed by its own command, so the whole launch is one step on the undo queue
+	for (uint64_t id : finished) {
+		MGlobal::executeCommand(MString(commandName) + " " + applyJobFlag + " " + (int)id, false, true);
+	}
+
+	if (computeQueue->pending() == 0 && collectCallbackId != 0) {
+		MMessage::removeCallback(collectCallbackId);
+		collectCallbackId = 0;
+	}
 }
 
-MStatus CameraLaunchCmd::redoIt()
+void CameraLaunchCmd::shutdownAsync()
 {
-	if (!m_hasValidData) {
-		return MS::kFailure;
+	if (collectCallbackId != 0) {
+		MMessage::removeCallback(collectCallbackId);
+		collectCallbackId = 0;
 	}
 
-	return executeCommand();
+	computeQueue.reset();
+	asyncLaunches.clear();
+	bakePool.reset();
 }
 
-MStatus CameraLaunchCmd::undoIt()
+MStatus CameraLaunchCmd::setKeyframesOnCamera(const LaunchTarget& launch)
 {
-	if (!m_hasValidData) {
+	std::vector<LaunchCore::ParabolicKey> keys = LaunchCore::calculateParabolicKeys(getLaunchParams(launch));
+	if (keys.size() != 3 || !(keys[2].frame > keys[0].frame)) {
+		MGlobal::displayError("Expected a start, apex and end key for parabolic trajectory");
 		return MS::kFailure;
 	}
 
-	MStatus status;
+	// Resolve the curves once for all three keys
+	CameraCurves curves;
+	MStatus status = getCameraCurves(launch, curves);
+	if (status != MS::kSuccess) return status;
 
-	// Clear created curves
-	status = clearExistingAnimationCurves();
+	status = addParabolicKeys(curves, keys);
 	if (status != MS::kSuccess) {
-		MGlobal::displayWarning("Failed to clear animation curves during undo");
+		MGlobal::displayError("Failed to set parabolic keyframes");
 	}
+	return status;
+}
 
-	// Get camera transform
-	MObject cameraTransform = m_cameraPath.transform(&status);
-	if (status != MS::kSuccess) return status;
-
-	MFnTransform transformFn(cameraTransform);
+void CameraLaunchCmd::bakeFlights(const LaunchCore::TriangleBVH* collision, std::vector<LaunchCore::BakedFlight>& flights)
+{
+	// Requests read the scene, so they are all made here on the main thread
+	std::vector<LaunchCore::BakeRequest> requests;
+	requests.reserve(m_launches.size());
+	for (const LaunchTarget& launch : m_launches) {
+		requests.push_back(makeBakeRequest(launch, collision));
+	}
+	flights.clear();
+	flights.resize(requests.size());
 
-	// Get the plugs we need to restore
-	std::vector<MPlug> plugsToRestore = {
-		transformFn.findPlug("translateX", false),
-		transformFn.findPlug("translateY", false),
-		transformFn.findPlug("translateZ", false),
-		transformFn.findPlug("rotateX", false),
-		transformFn.findPlug("rotateY", false)
-	};
+	// A single flight keeps its per-phase profile; the profile is not shared with the pool's threads
+	if (requests.size() == 1) {
+		LaunchCore::bakeFlight(requests[0], flights[0], NULL, m_profile.get());
+		return;
+	}
 
-	// Restore animation curves
-	for (unsigned int i = 0; i < m_savedAnimCurves.keyTimes.size(); ++i) {
-		if (i >= plugsToRestore.size()) break;
+	if (!bakePool) {
+		bakePool.reset(new LaunchCore::ThreadPool());
+	}
 
-		MPlug& plug = plugsToRestore[i];
+	// Drag, field and well flights are integrated side by side in lanes, split across the pool
+	LaunchCore::bakeFlights(requests, flights, bakePool.get());
+}
 
-		// Skip if no keys were saved for this curve
-		if (m_savedAnimCurves.keyTimes[i].length() == 0) {
-			continue;
-		}
+LaunchCore::BakeRequest CameraLaunchCmd::makeBakeRequest(const LaunchTarget& launch, const LaunchCore::TriangleBVH* collision)
+{
+	LaunchCore::BakeRequest request;
+	request.params = getLaunchParams(launch);
+	request.options.drag = m_drag;
+	request.options.frameStep = m_timeBase.sampleStep(m_bakeStep);
+	request.options.collision = collision;
+	request.options.bounces = m_bounces;
+	request.options.field = fieldSettings();
+	request.options.wells = wellSettings();
+
+	// Aim along the path on every sample, in the camera's own rotate order
+	request.orient = m_orient;
+	request.orientation = m_orientation;
+	if (m_orient) {
+		request.orientation.gravity = m_gravity;
+		request.orientation.framesPerSecond = m_timeBase.framesPerSecond();
+
+		request.orientation.rotateOrder = getRotateOrder(launch);
+	}
 
-		// Create new animation curve
-		MFnAnimCurve animCurve;
-		MObject animCurveObj = animCurve.create(plug, NULL, &status);
-		if (status != MS::kSuccess) {
-			MGlobal::displayWarning("Failed to recreate animation curve during undo");
-			continue;
+	// A flight already baked with the same inputs is mapped straight from the cache
+	MMatrix startMatrix = launch.cameraPath.inclusiveMatrix();
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			request.startMatrix[row * 4 + column] = startMatrix.matrix[row][column];
 		}
+	}
+	// On a rig the object keeps its local matrix and starts wherever the parent carries it at the
+	// launch frame, so neither the key nor the start orientation depend on the current time
+	const double* parentAtLaunch = launch.parentMatrices ? launch.parentMatrices->find(launch.startFrame) : nullptr;
+	if (parentAtLaunch) {
+		MMatrix parentNow = launch.cameraPath.exclusiveMatrix();
+		double world[16];
+		std::copy(request.startMatrix, request.startMatrix + 16, world);
+		LaunchCore::reparentMatrix(world, &parentNow.matrix[0][0], parentAtLaunch, request.startMatrix);
+	}
+	request.cacheDirectory = m_cacheDirectory.asChar();
+	return request;
+}
 
-		// Restore saved keyframes
-		const MTimeArray& times = m_savedAnimCurves.keyTimes[i];
-		const MDoubleArray& values = m_savedAnimCurves.keyValues[i];
-		const std::vector<MFnAnimCurve::TangentType>& inTangentTypes = m_savedAnimCurves.inTangentTypes[i];
-		const std::vector<MFnAnimCurve::TangentType>& outTangentTypes = m_savedAnimCurves.outTangentTypes[i];
-		const MDoubleArray& inTangentAngles = m_savedAnimCurves.inTangentAngles[i];
-		const MDoubleArray& outTangentAngles = m_savedAnimCurves.outTangentAngles[i];
-		const MDoubleArray& inTangentWeights = m_savedAnimCurves.inTangentWeights[i];
-		const MDoubleArray& outTangentWeights = m_savedAnimCurves.outTangentWeights[i];
-
-		for (unsigned int k = 0; k < times.length(); ++k) {
-			// Add the key
-			unsigned int keyIndex = animCurve.addKey(times[k], values[k]);
+MStatus CameraLaunchCmd::writeBakedFlight(const LaunchTarget& launch, const LaunchCore::BakedFlight& flight)
+{
+	const LaunchCore::CollisionHit& hit = flight.hit;
+	if (hit.hit) {
+		MGlobal::displayInfo(launch.cameraPath.partialPathName() + " hits geometry at frame " + hit.frame);
 
-			// Restore tangent types
-			animCurve.setInTangentType(keyIndex, inTangentTypes[k]);
-			animCurve.setOutTangentType(keyIndex, outTangentTypes[k]);
+		LaunchCore::Vec3 target(launch.targetPoint.x, launch.targetPoint.y, launch.targetPoint.z);
+		if (launch.hasTarget && (hit.position - target).length() > 1e-3) {
+			MGlobal::displayWarning(launch.cameraPath.partialPathName() + " is blocked by geometry before reaching its target");
+		}
+	}
+	if (!flight.cacheError.empty()) {
+		MGlobal::displayWarning(MString(flight.cacheError.c_str()));
+	}
 
-			// Restore tangent angles and weights
-			MAngle inAngle(inTangentAngles[k], MAngle::kRadians);
-			MAngle outAngle(outTangentAngles[k], MAngle::kRadians);
+	LaunchCore::TrajectoryView trajectory = flight.trajectory();
+	if (trajectory.count == 0) {
+		MGlobal::displayError("Nothing to bake, check -bakeStep");
+		return MS::kFailure;
+	}
 
-			animCurve.setTangent(keyIndex, inAngle, inTangentWeights[k], true);
-			animCurve.setTangent(keyIndex, outAngle, outTangentWeights[k], false);
+	// Aimed in world space at wherever the target is on each sample's frame. The target is sampled
+	// once per frame into a cache shared by every launch, then the whole flight is solved at once.
+	LaunchCore::OrientationSamples aim;
+	if (m_lookAt.target.isValid()) {
+		LaunchCore::ScopedPhase phase(m_profile.get(), "generateKeyframes/lookAt");
+		MStatus status = evaluateMatrices(m_lookAt.target, "worldMatrix", *m_lookAt.targetMatrices, trajectory.frames, trajectory.count);
+		if (status && m_lookAt.upMatrices) {
+			status = evaluateMatrices(m_lookAt.upObject, "worldMatrix", *m_lookAt.upMatrices, trajectory.frames, trajectory.count);
 		}
+		if (!status) return status;
+
+		LaunchCore::LookAtSettings settings = m_lookAt.settings;
+		settings.rotateOrder = getRotateOrder(launch);
+		LaunchCore::solveLookAt(trajectory, *m_lookAt.targetMatrices, m_lookAt.upMatrices.get(), settings, aim);
+		trajectory.rotateX = aim.rotateX.data();
+		trajectory.rotateY = aim.rotateY.data();
+		trajectory.rotateZ = aim.rotateZ.data();
 	}
 
-	// Restore selection
-	MGlobal::setActiveSelectionList(m_originalSelection);
-
-	M3dView::active3dView().refresh();
+	// Flights are baked in world space; objects on a rig are keyed in their parent's space at every sample
+	LaunchCore::LocalTrajectory local;
+	if (launch.parentMatrices) {
+		LaunchCore::ScopedPhase phase(m_profile.get(), "generateKeyframes/toParentSpace");
+		MStatus status = evaluateMatrices(launch.cameraPath, "parentMatrix", *launch.parentMatrices, trajectory.frames, trajectory.count);
+		if (!status) return status;
 
-	return MS::kSuccess;
-}
+		LaunchCore::toParentSpace(trajectory, *launch.parentMatrices, getRotateOrder(launch), local);
+		trajectory = local.view();
+	}
 
-bool CameraLaunchCmd::isUndoable() const
-{
-	return true;
-}
+	CameraCurves curves;
+	MStatus status = getCameraCurves(launch, curves);
+	if (status != MS::kSuccess) return status;
 
-MStatus CameraLaunchCmd::parseArguments(const MArgList& args)
-{
-	MArgDatabase argData(newSyntax(), args);
+	size_t count = trajectory.count;
 
-	// Extract Camera
-	if (argData.isFlagSet(cameraFlag)) {
-		MString cameraName = argData.flagArgumentString(cameraFlag, 0);
+	struct BakeChannel {
+		MFnAnimCurve* curve;
+		const double* values;
+		const char* name;
+		double tolerance;
+	};
 
-		MSelectionList selList;
-		selList.add(cameraName);
+	const double angleTolerance = MAngle(m_tolerance, MAngle::kDegrees).asRadians();
+	std::vector<BakeChannel> channels = {
+		{ &curves.translateX, trajectory.translateX, "translateX", m_tolerance },
+		{ &curves.translateY, trajectory.translateY, "translateY", m_tolerance },
+		{ &curves.translateZ, trajectory.translateZ, "translateZ", m_tolerance },
+		{ &curves.rotateX, trajectory.rotateX, "rotateX", angleTolerance },
+		{ &curves.rotateY, trajectory.rotateY, "rotateY", angleTolerance }
+	};
+	if (keysRotateZ(launch)) {
+		channels.push_back({ &curves.rotateZ, trajectory.rotateZ, "rotateZ", angleTolerance });
+	}
 
-		MStatus status = selList.getDagPath(0, m_cameraPath);
-		if (!status) {
-			return MS::kFailure;
+	LaunchCore::ScopedPhase phase(m_profile.get(), "generateKeyframes/writeKeys");
+	std::vector<LaunchCore::ReducedKey> linearKeys;
+	for (BakeChannel& channel : channels) {
+		if (m_tolerance > 0.0) {
+			status = addReducedKeys(*channel.curve, trajectory.frames, channel.values, count, channel.tolerance);
 		}
-		if (!m_cameraPath.hasFn(MFn::kCamera)) {
-			return MS::kFailure;
+		else {
+			linearKeys.resize(count);
+			for (size_t i = 0; i < count; ++i) {
+				linearKeys[i].frame = trajectory.frames[i];
+				linearKeys[i].value = channel.values[i];
+			}
+			status = writeChannelKeys(*channel.curve, linearKeys, false);
+		}
+		if (status != MS::kSuccess) {
+			MGlobal::displayError(MString("Failed to bake ") + channel.name + " keyframes");
+			return status;
 		}
 	}
 
-	// Extract Velocity
-	if (argData.isFlagSet(velocityFlag)) {
-		double vx = argData.flagArgumentDouble(velocityFlag, 0);
-		double vy = argData.flagArgumentDouble(velocityFlag, 1);
-		double vz = argData.flagArgumentDouble(velocityFlag, 2);
+	return MS::kSuccess;
+}
 
-		m_velocity = MVector(vx, vy, vz);
+MStatus CameraLaunchCmd::setBounceKeyframesOnCamera(const LaunchTarget& launch, const LaunchCore::TriangleBVH* collision)
+{
+	LaunchCore::LaunchParams params = getLaunchParams(launch);
+	std::vector<LaunchCore::FlightSegment> segments;
+	std::vector<LaunchCore::ParabolicKey> keys;
+	{
+		LaunchCore::ScopedPhase phase(m_profile.get(), "generateKeyframes/chainBounces");
+		LaunchCore::chainBounces(params, m_bounces, collision, m_bakeStep, segments);
+		LaunchCore::buildBounceKeys(params, segments, keys);
 	}
 
-	// Extract Gravity
-	if (argData.isFlagSet(gravityFlag)) {
-		double gravity = argData.flagArgumentDouble(gravityFlag, 0);
+	const LaunchCore::FlightSegment& first = segments.front();
+	if (collision && first.contact) {
+		double frame = params.startFrame + first.duration * params.framesPerSecond;
+		MGlobal::displayInfo(launch.cameraPath.partialPathName() + " hits geometry at frame " + frame);
 
-		m_gravity = gravity;
+		LaunchCore::Vec3 target(launch.targetPoint.x, launch.targetPoint.y, launch.targetPoint.z);
+		if (launch.hasTarget && (first.endPosition - target).length() > 1e-3) {
+			MGlobal::displayWarning(launch.cameraPath.partialPathName() + " is blocked by geometry before reaching its target");
+		}
 	}
 
-	// Extract Start Frame
-	if (argData.isFlagSet(startFrameFlag)) {
-		int startFrame = argData.flagArgumentInt(startFrameFlag, 0);
+	CameraCurves curves;
+	MStatus status = getCameraCurves(launch, curves);
+	if (status != MS::kSuccess) return status;
 
-		m_startFrame = startFrame;
+	LaunchCore::ScopedPhase phase(m_profile.get(), "generateKeyframes/writeKeys");
+	status = addParabolicKeys(curves, keys);
+	if (status != MS::kSuccess) {
+		MGlobal::displayError("Failed to set bounce keyframes");
 	}
-
-	m_hasValidData = true;
-	return MS::kSuccess;
+	return status;
 }
 
-MStatus CameraLaunchCmd::executeCommand()
+MStatus CameraLaunchCmd::addParabolicKeys(CameraCurves& curves, const std::vector<LaunchCore::ParabolicKey>& keys)
 {
-	// Save animation state
-	MStatus saveStatus = saveAnimationState();
-	if (!saveStatus) {
-		MGlobal::displayWarning("Failed to save animation state");
-	}
-
-	// Store current selection
-	MGlobal::getActiveSelectionList(m_originalSelection);
+	// Every translate channel follows the arc through weighted handles a third of the way to the
+	// neighbouring key, which makes each Bezier segment the parabola itself. Rotation is
+	// interpolated linearly between keys; -orient aims along the path on every frame instead.
+	struct ParabolicChannel {
+		MFnAnimCurve* curve;
+		LaunchCore::KeyChannel channel;
+		bool weighted;
+	};
 
-	// Clear existing keyframes
-	MStatus clearStatus = clearExistingAnimationCurves();
-	if (!clearStatus) {
-		MGlobal::displayWarning("Failed to clear existing animation curves");
-	}
+	const ParabolicChannel channels[] = {
+		{ &curves.rotateX, LaunchCore::KeyChannel::ROTATE_X, false },
+		{ &curves.rotateY, LaunchCore::KeyChannel::ROTATE_Y, false },
+		{ &curves.translateX, LaunchCore::KeyChannel::TRANSLATE_X, true },
+		{ &curves.translateY, LaunchCore::KeyChannel::TRANSLATE_Y, true },
+		{ &curves.translateZ, LaunchCore::KeyChannel::TRANSLATE_Z, true }
+	};
 
-	// Generate keyframes
-	MStatus keyframeStatus = generateKeyframes();
-	if (!keyframeStatus) {
-		return keyframeStatus;
+	std::vector<LaunchCore::ReducedKey> channelKeys;
+	for (const ParabolicChannel& channel : channels) {
+		LaunchCore::channelKeys(keys, channel.channel, channelKeys);
+		MStatus status = writeChannelKeys(*channel.curve, channelKeys, channel.weighted);
+		if (status != MS::kSuccess) return status;
 	}
 
-	// Clear selection and select camera that was launched
-	MSelectionList newSel;
-	newSel.add(m_cameraPath);
-	MGlobal::setActiveSelectionList(newSel);
-
 	return MS::kSuccess;
 }
 
-MStatus CameraLaunchCmd::generateKeyframes()
+MStatus CameraLaunchCmd::addReducedKeys(MFnAnimCurve& animCurve, const double* frames, const double* values, size_t sampleCount, double tolerance)
 {
-	std::vector<MVector> trajectoryPoints = calculateTrajectory();
-	std::vector<MEulerRotation> trajectoryRots = calculateRotations(trajectoryPoints);
-	return setKeyframesOnCamera(trajectoryPoints, trajectoryRots);
+	std::vector<LaunchCore::ReducedKey> keys;
+	LaunchCore::reduceKeys(frames, values, sampleCount, tolerance, keys);
+	return writeChannelKeys(animCurve, keys, true);
 }
 
-std::vector<MVector> CameraLaunchCmd::calculateTrajectory()
+MStatus CameraLaunchCmd::writeChannelKeys(MFnAnimCurve& animCurve, const std::vector<LaunchCore::ReducedKey>& keys, bool weighted)
 {
-	std::vector<MVector> keyframes;
+	MAnimCurveChange* change = m_curveEdits.get();
+	const MFnAnimCurve::TangentType tangentType = weighted ? MFnAnimCurve::kTangentFixed : MFnAnimCurve::kTangentLinear;
+	const unsigned int count = (unsigned int)keys.size();
+
+	// A curve left by an earlier launch keeps every key that can be moved into place, so a
+	// re-launch only adds or removes the keys the new flight needs on top of those
+	std::vector<double> currentFrames(animCurve.numKeys());
+	for (unsigned int i = 0; i < (unsigned int)currentFrames.size(); ++i) {
+		currentFrames[i] = animCurve.time(i).as(m_timeUnit);
+	}
+	std::vector<double> targetFrames(count);
+	for (unsigned int i = 0; i < count; ++i) {
+		targetFrames[i] = keys[i].frame;
+	}
+	LaunchCore::KeyUpdatePlan plan = LaunchCore::planKeyUpdate(currentFrames.data(), currentFrames.size(), targetFrames.data(), count);
 
-	MVector startPos = m_cameraPath.inclusiveMatrix() * MPoint::origin;
-	keyframes.push_back(startPos);
+	MStatus status;
+	if (plan.additions.size() == count) {
+		// Nothing to keep, so hand Maya the whole channel in one call instead of one addKey per key
+		MTimeArray times(count, MTime());
+		MDoubleArray values(count, 0.0);
+		for (unsigned int i = 0; i < count; ++i) {
+			times[i] = MTime(keys[i].frame, m_timeUnit);
+			values[i] = keys[i].value;
+		}
+		status = animCurve.addKeys(&times, &values, tangentType, tangentType, false, change);
+		if (status != MS::kSuccess) return status;
+	}
+	else {
+		for (size_t index : plan.removals) {
+			status = animCurve.remove((unsigned int)index, change);
+			if (status != MS::kSuccess) return status;
+		}
+		for (const LaunchCore::KeyUpdatePlan::Move& move : plan.moves) {
+			status = animCurve.setTime((unsigned int)move.key, MTime(keys[move.target].frame, m_timeUnit), change);
+			if (status != MS::kSuccess) return status;
+		}
+		for (size_t target : plan.additions) {
+			animCurve.addKey(MTime(keys[target].frame, m_timeUnit), keys[target].value, tangentType, tangentType, change, &status);
+			if (status != MS::kSuccess) return status;
+		}
 
-	double timeToApex = -m_velocity.y / m_gravity;
+		// Keys already holding the right value and tangent type are left alone
+		for (unsigned int i = 0; i < count; ++i) {
+			if (animCurve.value(i) != keys[i].value) {
+				animCurve.setValue(i, keys[i].value, change);
+			}
+			if (animCurve.inTangentType(i) != tangentType) {
+				animCurve.setInTangentType(i, tangentType, change);
+			}
+			if (animCurve.outTangentType(i) != tangentType) {
+				animCurve.setOutTangentType(i, tangentType, change);
+			}
+		}
+	}
+	if (m_profile) m_profile->keysWritten += count;
 
-	double apexX = startPos.x + m_velocity.x * timeToApex;
-	double apexY = startPos.y + m_velocity.y * timeToApex + 0.5 * m_gravity * timeToApex * timeToApex;
-	double apexZ = startPos.z + m_velocity.z * timeToApex;
-	keyframes.push_back(MVector(apexX, apexY, apexZ));
+	if (animCurve.isWeighted() != weighted) {
+		animCurve.setIsWeighted(weighted, change);
+	}
+	if (!weighted) {
+		return MS::kSuccess;
+	}
 
-	int totalFrames = calculateFlightFrames();
-	MTime::Unit timeUnit = MTime::uiUnit();
-	MTime oneFrame(1.0, timeUnit);
-	double secondsPerFrame = oneFrame.asUnits(MTime::kSeconds);
-	double totalTime = totalFrames * secondsPerFrame;
+	// Maya tangents are (seconds, value) vectors three times the length of the Bezier handle.
+	// Keys the slope jumps across, such as bounce contacts, get broken tangents.
+	double secondsPerFrame = m_timeBase.secondsPerFrame();
+	for (unsigned int i = 0; i < count; ++i) {
+		const LaunchCore::ReducedKey& key = keys[i];
+		bool broken = key.inWeight > 0.0 && key.outWeight > 0.0
+			&& std::fabs(key.inSlope - key.outSlope) > 1e-9 * std::max(1.0, std::fabs(key.inSlope));
+
+		animCurve.setWeightsLocked(i, false, change);
+		animCurve.setTangentsLocked(i, !broken, change);
+		if (key.inWeight > 0.0) {
+			animCurve.setTangent(i, 3.0 * key.inWeight * secondsPerFrame, 3.0 * key.inWeight * key.inSlope, true, change, false);
+		}
+		if (key.outWeight > 0.0) {
+			animCurve.setTangent(i, 3.0 * key.outWeight * secondsPerFrame, 3.0 * key.outWeight * key.outSlope, false, change, false);
+		}
+	}
 
-	double endX = startPos.x + m_velocity.x * totalTime;
-	double endY = startPos.y + m_velocity.y * totalTime + 0.5 * m_gravity * totalTime * totalTime;
-	double endZ = startPos.z + m_velocity.z * totalTime;
+	return MS::kSuccess;
+}
 
-	keyframes.push_back(MVector(endX, endY, endZ));
+MStatus CameraLaunchCmd::buildCollisionBVH(LaunchCore::TriangleBVH& bvh)
+{
+	std::vector<LaunchCore::Vec3> vertices;
+	std::vector<uint32_t> indices;
+	MStatus status = gatherCollisionTriangles(vertices, indices);
+	if (!status) return status;
 
-	return keyframes;
+	bvh.build(vertices, indices);
+	return MS::kSuccess;
 }
 
-std::vector<MEulerRotation> CameraLaunchCmd::calculateRotations(const std::vector<MVector> &points)
+MStatus CameraLaunchCmd::gatherCollisionTriangles(std::vector<LaunchCore::Vec3>& vertices, std::vector<uint32_t>& indices)
 {
-	std::vector<MEulerRotation> rotKeyframes;
-
-	MVector normalizeVelocity = m_velocity.normal();
+	for (unsigned int m = 0; m < m_collisionMeshes.length(); ++m) {
+		MStatus status;
+		MFnMesh meshFn(m_collisionMeshes[m], &status);
+		if (status != MS::kSuccess) {
+			MGlobal::displayError("Failed to read collision mesh " + m_collisionMeshes[m].partialPathName());
+			return status;
+		}
 
-	// Set start rotation to be facing the direction of the input velocity
-	const double PI = atan(1.0) * 4;
-	double yaw = std::atan2(normalizeVelocity.x, normalizeVelocity.z) + PI;
-	double pitch = std::asin(normalizeVelocity.y);
+		MPointArray points;
+		meshFn.getPoints(points, MSpace::kWorld);
 
-	rotKeyframes.push_back(MEulerRotation(pitch, yaw, 0));
+		MIntArray triangleCounts;
+		MIntArray triangleVertices;
+		meshFn.getTriangles(triangleCounts, triangleVertices);
 
-	// Set the middle rotation to be a pitch of zero, facing along the trajectory
-	rotKeyframes.push_back(MEulerRotation(0, yaw, 0));
+		uint32_t baseVertex = (uint32_t)vertices.size();
+		vertices.reserve(vertices.size() + points.length());
+		for (unsigned int i = 0; i < points.length(); ++i) {
+			vertices.push_back(LaunchCore::Vec3(points[i].x, points[i].y, points[i].z));
+		}
 
-	// Set the end rotation to be the negation of the input velocity
-	MVector flippedNormalizedVelocity = normalizeVelocity * -1;
-	pitch = std::asin(flippedNormalizedVelocity.y);
-	rotKeyframes.push_back(MEulerRotation(pitch, yaw, 0));
+		indices.reserve(indices.size() + triangleVertices.length());
+		for (unsigned int i = 0; i < triangleVertices.length(); ++i) {
+			indices.push_back(baseVertex + (uint32_t)triangleVertices[i]);
+		}
+	}
 
-	return rotKeyframes;
+	return MS::kSuccess;
 }
 
-MStatus CameraLaunchCmd::setKeyframesOnCamera(const std::vector<MVector>& points, const std::vector<MEulerRotation>& rots)
+MStatus CameraLaunchCmd::loadVectorField(const MString& source, LaunchCore::VectorField& field)
 {
-	if (points.size() != 3) {
-		MGlobal::displayError("Expected exactly 3 points for parabolic trajectory");
-		return MS::kFailure;
+	// A fluid container in the scene, otherwise a path to an FGA file
+	MSelectionList selList;
+	MDagPath fluidPath;
+	if (selList.add(source) && selList.getDagPath(0, fluidPath) && fluidPath.extendToShape() && fluidPath.hasFn(MFn::kFluid)) {
+		return readFluidVelocity(fluidPath, field);
 	}
 
-	std::vector<int> frameNumbers = getKeyFrameNumbers();
-	if (frameNumbers.size() != 3) {
-		MGlobal::displayError("Expected exactly 3 frame numbers");
+	std::string error;
+	if (!LaunchCore::loadFgaField(source.asChar(), field, error)) {
+		MGlobal::displayError(MString(error.c_str()));
 		return MS::kFailure;
 	}
+	return MS::kSuccess;
+}
 
+MStatus CameraLaunchCmd::readFluidVelocity(const MDagPath& fluidPath, LaunchCore::VectorField& field)
+{
 	MStatus status;
+	MFnFluid fluidFn(fluidPath, &status);
+	if (status != MS::kSuccess) {
+		MGlobal::displayError("Failed to read fluid " + fluidPath.partialPathName());
+		return status;
+	}
 
-	status = setKeyframeOnCamera(points[0], rots[0], frameNumbers[0], CameraKeyframeType::START,
-		points[0], points[1], points[2],
-		frameNumbers[0], frameNumbers[1], frameNumbers[2]);
-	if (status != MS::kSuccess) return status;
+	unsigned xres = 0, yres = 0, zres = 0;
+	double xdim = 0.0, ydim = 0.0, zdim = 0.0;
+	float* xvel = NULL;
+	float* yvel = NULL;
+	float* zvel = NULL;
+	fluidFn.getResolution(xres, yres, zres);
+	fluidFn.getDimensions(xdim, ydim, zdim);
+	status = fluidFn.getVelocity(xvel, yvel, zvel);
+	if (status != MS::kSuccess || !xvel || !yvel || !zvel || xres == 0 || yres == 0 || zres == 0) {
+		MGlobal::displayError(fluidPath.partialPathName() + " has no velocity grid");
+		return MS::kFailure;
+	}
 
-	status = setKeyframeOnCamera(points[1], rots[1], frameNumbers[1], CameraKeyframeType::MIDDLE,
-		points[0], points[1], points[2],
-		frameNumbers[0], frameNumbers[1], frameNumbers[2]);
-	if (status != MS::kSuccess) return status;
+	// Velocity is stored on voxel faces; the two faces of each voxel are averaged onto its centre
+	const int nx = (int)xres, ny = (int)yres, nz = (int)zres;
+	std::vector<LaunchCore::Vec3> values((size_t)nx * ny * nz);
+	for (int k = 0; k < nz; ++k) {
+		for (int j = 0; j < ny; ++j) {
+			for (int i = 0; i < nx; ++i) {
+				LaunchCore::Vec3& value = values[((size_t)k * ny + j) * nx + i];
+				value.x = 0.5 * (xvel[fluidFn.index(i, j, k, nx + 1, ny, nz)] + xvel[fluidFn.index(i + 1, j, k, nx + 1, ny, nz)]);
+				value.y = 0.5 * (yvel[fluidFn.index(i, j, k, nx, ny + 1, nz)] + yvel[fluidFn.index(i, j + 1, k, nx, ny + 1, nz)]);
+				value.z = 0.5 * (zvel[fluidFn.index(i, j, k, nx, ny, nz + 1)] + zvel[fluidFn.index(i, j, k + 1, nx, ny, nz + 1)]);
+			}
+		}
+	}
 
-	status = setKeyframeOnCamera(points[2], rots[2], frameNumbers[2], CameraKeyframeType::END,
-		points[0], points[1], points[2],
-		frameNumbers[0], frameNumbers[1], frameNumbers[2]);
-	if (status != MS::kSuccess) return status;
+	// The container is centred on its transform; only the translation is honoured
+	MPoint fluidCentre = fluidPath.inclusiveMatrix() * MPoint::origin;
+	LaunchCore::Vec3 centre(fluidCentre.x, fluidCentre.y, fluidCentre.z);
+	LaunchCore::Vec3 spacing(xdim / nx, ydim / ny, zdim / nz);
+	LaunchCore::Vec3 origin = centre - LaunchCore::Vec3(xdim, ydim, zdim) * 0.5 + spacing * 0.5;
+	if (!field.build(nx, ny, nz, origin, spacing, values)) {
+		MGlobal::displayError(fluidPath.partialPathName() + " has an empty container");
+		return MS::kFailure;
+	}
+	return MS::kSuccess;
+}
+
+LaunchCore::FieldSettings CameraLaunchCmd::fieldSettings() const
+{
+	LaunchCore::FieldSettings settings;
+	settings.field = m_field.get();
+	settings.kind = m_fieldKind;
+	settings.scale = m_fieldScale;
+	return settings;
+}
 
-	M3dView::active3dView().refresh();
-	MGlobal::displayInfo("Successfully set 3 keyframes for parabolic camera trajectory");
+LaunchCore::GravityWellSettings CameraLaunchCmd::wellSettings() const
+{
+	LaunchCore::GravityWellSettings settings;
+	settings.attractors = m_attractors.get();
+	settings.strength = m_gravityConstant;
+	settings.softening = m_softening;
+	return settings;
+}
 
-	return MS::kSuccess;
+bool CameraLaunchCmd::integratesFlights() const
+{
+	return m_drag.enabled() || fieldSettings().active() || wellSettings().active();
 }
 
-MStatus CameraLaunchCmd::setKeyframeOnCamera(const MVector& point, const MEulerRotation& rot, int frameNumber, CameraKeyframeType keyType,
-	const MVector& startPoint, const MVector& middlePoint, const MVector& endPoint,
-	int startFrame, int middleFrame, int endFrame)
+MStatus CameraLaunchCmd::getCameraCurves(const LaunchTarget& launch, CameraCurves& curves)
 {
 	MStatus status = MS::kSuccess;
 
 	// Get camera transform
-	MObject cameraTransform = m_cameraPath.transform(&status);
+	MObject cameraTransform = launch.cameraPath.transform(&status);
 	if (status != MS::kSuccess) {
 		MGlobal::displayError("Failed to get camera transform");
 		return status;
@@ -339,6 +1964,7 @@ MStatus CameraLaunchCmd::setKeyframeOnCamera(const MVector& point, const MEulerR
 
 	MPlug rotationXPlug = transformFn.findPlug("rotateX", false, &status);
 	MPlug rotationYPlug = transformFn.findPlug("rotateY", false, &status);
+	if (m_profile) m_profile->plugLookups += 5;
 
 	if (status != MS::kSuccess) {
 		MGlobal::displayError("Failed to get translate plugs");
@@ -346,143 +1972,38 @@ MStatus CameraLaunchCmd::setKeyframeOnCamera(const MVector& point, const MEulerR
 	}
 
 	// Get or create anim curves
-	MFnAnimCurve animCurveX, animCurveY, animCurveZ;
 	MObject animCurveObjX, animCurveObjY, animCurveObjZ;
-
-	MFnAnimCurve animCurveRotX, animCurveRotY;
 	MObject animCurveRotObjX, animCurveRotObjY;
 
-	if (!getOrCreateAnimCurve(translateXPlug, animCurveX, animCurveObjX)) {
+	if (!getOrCreateAnimCurve(translateXPlug, curves.translateX, animCurveObjX)) {
 		return MS::kFailure;
 	}
-	if (!getOrCreateAnimCurve(translateYPlug, animCurveY, animCurveObjY)) {
+	if (!getOrCreateAnimCurve(translateYPlug, curves.translateY, animCurveObjY)) {
 		return MS::kFailure;
 	}
-	if (!getOrCreateAnimCurve(translateZPlug, animCurveZ, animCurveObjZ)) {
+	if (!getOrCreateAnimCurve(translateZPlug, curves.translateZ, animCurveObjZ)) {
 		return MS::kFailure;
 	}
-	if (!getOrCreateAnimCurve(rotationXPlug, animCurveRotX, animCurveRotObjX)) {
+	if (!getOrCreateAnimCurve(rotationXPlug, curves.rotateX, animCurveRotObjX)) {
 		return MS::kFailure;
 	}
-	if (!getOrCreateAnimCurve(rotationYPlug, animCurveRotY, animCurveRotObjY)) {
+	if (!getOrCreateAnimCurve(rotationYPlug, curves.rotateY, animCurveRotObjY)) {
 		return MS::kFailure;
 	}
 
-	MTime currentTime(frameNumber, MTime::uiUnit());
-	MStatus keyStatus;
-
-	// Set X keyframe (linear)
-	unsigned int keyIndexX = animCurveX.addKey(currentTime, point.x,
-		MFnAnimCurve::kTangentLinear,
-		MFnAnimCurve::kTangentLinear,
-		NULL, &keyStatus);
-	if (keyStatus != MS::kSuccess) {
-		MGlobal::displayError(MString("Failed to set X keyframe at frame ") + frameNumber);
-		return keyStatus;
-	}
-
-	// Set Y keyframe with tangents for parabolic curve
-	unsigned int keyIndexY = animCurveY.addKey(currentTime, point.y,
-		MFnAnimCurve::kTangentFixed,
-		MFnAnimCurve::kTangentFixed,
-		NULL, &keyStatus);
-	if (keyStatus != MS::kSuccess) {
-		MGlobal::displayError(MString("Failed to set Y keyframe at frame ") + frameNumber);
-		return keyStatus;
-	}
-
-	// Set parabolic tangents for Y curve
-	setParabolicTangents(animCurveY, keyIndexY, keyType,
-		startPoint, middlePoint, endPoint,
-		startFrame, middleFrame, endFrame);
-
-	// Set Z keyframe (linear)
-	unsigned int keyIndexZ = animCurveZ.addKey(currentTime, point.z,
-		MFnAnimCurve::kTangentLinear,
-		MFnAnimCurve::kTangentLinear,
-		NULL, &keyStatus);
-	if (keyStatus != MS::kSuccess) {
-		MGlobal::displayError(MString("Failed to set Z keyframe at frame ") + frameNumber);
-		return keyStatus;
-	}
-
-	unsigned int keyIndexRotX = animCurveRotX.addKey(currentTime, rot.x,
-		MFnAnimCurve::kTangentLinear,
-		MFnAnimCurve::kTangentLinear,
-		NULL, &keyStatus);
-	if (keyStatus != MS::kSuccess) {
-		MGlobal::displayError(MString("Failed to set X rotation keyframe at frame ") + frameNumber);
-		return keyStatus;
-	}
+	if (keysRotateZ(launch)) {
+		MPlug rotationZPlug = transformFn.findPlug("rotateZ", false, &status);
+		if (m_profile) m_profile->plugLookups++;
 
-	unsigned int keyIndexRotY = animCurveRotY.addKey(currentTime, rot.y,
-		MFnAnimCurve::kTangentLinear,
-		MFnAnimCurve::kTangentLinear,
-		NULL, &keyStatus);
-	if (keyStatus != MS::kSuccess) {
-		MGlobal::displayError(MString("Failed to set Y rotation keyframe at frame ") + frameNumber);
-		return keyStatus;
+		MObject animCurveRotObjZ;
+		if (status != MS::kSuccess || !getOrCreateAnimCurve(rotationZPlug, curves.rotateZ, animCurveRotObjZ)) {
+			return MS::kFailure;
+		}
 	}
 
 	return MS::kSuccess;
 }
 
-void CameraLaunchCmd::setParabolicTangents(MFnAnimCurve& animCurve, unsigned int keyIndex, CameraKeyframeType keyType,
-	const MVector& startPoint, const MVector& middlePoint, const MVector& endPoint,
-	int startFrame, int middleFrame, int endFrame)
-{
-	// Calculate parabolic coefficients
-	MTime t0(startFrame, MTime::uiUnit());
-	MTime t1(middleFrame, MTime::uiUnit());
-	MTime t2(endFrame, MTime::uiUnit());
-
-	double y0 = startPoint.y;
-	double y1 = middlePoint.y;
-	double y2 = endPoint.y;
-
-	double dt1 = (t1 - t0).asUnits(MTime::uiUnit());
-	double dt2 = (t2 - t0).asUnits(MTime::uiUnit());
-
-	double denom = dt1 * dt2 * (dt2 - dt1);
-
-	// Handle potential division by zero
-	if (fabs(denom) < 1e-10) {
-		MGlobal::displayWarning("Invalid time intervals for parabolic calculation, defaulting to linear tangents");
-		return;
-	}
-
-	double a = (dt1 * (y2 - y0) - dt2 * (y1 - y0)) / denom;
-	double b = (dt2 * dt2 * (y1 - y0) - dt1 * dt1 * (y2 - y0)) / denom;
-
-	// Calculate slopes at start and end points
-	double startSlope = b;
-	double endSlope = 2.0 * a * dt2 + b;
-
-	MAngle startOutAngle = atan(startSlope);
-	MAngle endInAngle = atan(endSlope);
-	MAngle flatAngle(0.0);
-
-	double weight = 1.0;
-
-	switch (keyType) {
-	case CameraKeyframeType::START:
-		// Set Out-Tangent
-		animCurve.setTangent(keyIndex, startOutAngle, weight, false, NULL);
-		break;
-
-	case CameraKeyframeType::MIDDLE:
-		// Set both tangents to flat (0 degrees) for parabolic peak
-		animCurve.setTangent(keyIndex, flatAngle, weight, true, NULL);
-		animCurve.setTangent(keyIndex, flatAngle, weight, false, NULL);
-		break;
-
-	case CameraKeyframeType::END:
-		// Set In-tangent
-		animCurve.setTangent(keyIndex, endInAngle, weight, true, NULL);
-		break;
-	}
-}
-
 bool CameraLaunchCmd::getOrCreateAnimCurve(MPlug& plug, MFnAnimCurve& animCurve, MObject& animCurveObj)
 {
 	MStatus status;
@@ -495,6 +2016,7 @@ bool CameraLaunchCmd::getOrCreateAnimCurve(MPlug& plug, MFnAnimCurve& animCurve,
 			if (connectedNode.hasFn(MFn::kAnimCurve)) {
 				animCurveObj = connectedNode;
 				animCurve.setObject(animCurveObj);
+				if (m_profile) m_profile->curvesReused++;
 				return true;
 			}
 		}
@@ -502,174 +2024,152 @@ bool CameraLaunchCmd::getOrCreateAnimCurve(MPlug& plug, MFnAnimCurve& animCurve,
 
 	// Create new anim curve if none exists
 	animCurveObj = animCurve.create(plug, NULL, &status);
-	return (status == MS::kSuccess);
+	if (status != MS::kSuccess) {
+		return false;
+	}
+	if (m_profile) m_profile->curvesCreated++;
+	m_createdCurves.append(animCurveObj);
+
+	// Tag it so the next launch of this camera edits its keys instead of replacing it
+	MFnNumericAttribute tagFn;
+	MObject tag = tagFn.create(launchCurveTag, launchCurveTagShort, MFnNumericData::kBoolean, 1.0);
+	tagFn.setHidden(true);
+	MFnDependencyNode(animCurveObj).addAttribute(tag);
+	return true;
 }
 
-MStatus CameraLaunchCmd::clearExistingAnimationCurves()
+MStatus CameraLaunchCmd::clearExistingAnimationCurves(MDGModifier& dgModifier)
 {
 	MStatus status;
-	MObject cameraTransform = m_cameraPath.transform(&status);
-	if (status != MS::kSuccess) {
-		MGlobal::displayError("Failed to get camera transform");
-		return status;
-	}
 
-	MFnTransform transformFn(cameraTransform);
-	MPlug translateXPlug = transformFn.findPlug("translateX", false, &status);
-	MPlug translateYPlug = transformFn.findPlug("translateY", false, &status);
-	MPlug translateZPlug = transformFn.findPlug("translateZ", false, &status);
+	// Queue every deletion and commit them in a single DG edit
 
-	if (status != MS::kSuccess) {
-		MGlobal::displayError("Failed to get translate plugs");
-		return status;
-	}
+	for (const LaunchTarget& launch : m_launches) {
+		MObject cameraTransform = launch.cameraPath.transform(&status);
+		if (status != MS::kSuccess) {
+			MGlobal::displayError("Failed to get camera transform");
+			return status;
+		}
 
-	MPlug rotationXPlug = transformFn.findPlug("rotateX", false, &status);
-	MPlug rotationYPlug = transformFn.findPlug("rotateY", false, &status);
+		MFnTransform transformFn(cameraTransform);
+		MPlug translateXPlug = transformFn.findPlug("translateX", false, &status);
+		MPlug translateYPlug = transformFn.findPlug("translateY", false, &status);
+		MPlug translateZPlug = transformFn.findPlug("translateZ", false, &status);
 
-	if (status != MS::kSuccess) {
-		MGlobal::displayError("Failed to get rotation plugs");
-		return status;
-	}
+		if (status != MS::kSuccess) {
+			MGlobal::displayError("Failed to get translate plugs");
+			return status;
+		}
+
+		MPlug rotationXPlug = transformFn.findPlug("rotateX", false, &status);
+		MPlug rotationYPlug = transformFn.findPlug("rotateY", false, &status);
+		if (m_profile) m_profile->plugLookups += 5;
 
-	clearAnimCurveFromPlug(translateXPlug);
-	clearAnimCurveFromPlug(translateYPlug);
-	clearAnimCurveFromPlug(translateZPlug);
+		if (status != MS::kSuccess) {
+			MGlobal::displayError("Failed to get rotation plugs");
+			return status;
+		}
 
-	clearAnimCurveFromPlug(rotationXPlug);
-	clearAnimCurveFromPlug(rotationYPlug);
+		clearAnimCurveFromPlug(translateXPlug, dgModifier);
+		clearAnimCurveFromPlug(translateYPlug, dgModifier);
+		clearAnimCurveFromPlug(translateZPlug, dgModifier);
 
-	return MS::kSuccess;
+		clearAnimCurveFromPlug(rotationXPlug, dgModifier);
+		clearAnimCurveFromPlug(rotationYPlug, dgModifier);
+
+		// Roll from an earlier oriented, look-at or parented launch goes too when this one keys none
+		MPlug rotationZPlug = transformFn.findPlug("rotateZ", false, &status);
+		if (m_profile) m_profile->plugLookups++;
+		if (status == MS::kSuccess) {
+			if (keysRotateZ(launch)) {
+				clearAnimCurveFromPlug(rotationZPlug, dgModifier);
+			}
+			else {
+				clearLaunchCurveFromPlug(rotationZPlug, dgModifier);
+			}
+		}
+	}
+
+	return dgModifier.doIt();
 }
 
-void CameraLaunchCmd::clearAnimCurveFromPlug(MPlug& plug)
+void CameraLaunchCmd::clearAnimCurveFromPlug(MPlug& plug, MDGModifier& dgModifier)
 {
 	if (plug.isConnected()) {
 		MPlugArray connections;
 		plug.connectedTo(connections, true, false);
 		for (unsigned int i = 0; i < connections.length(); ++i) {
 			MObject connectedNode = connections[i].node();
-			if (connectedNode.hasFn(MFn::kAnimCurve)) {
-				MGlobal::deleteNode(connectedNode);
+			// Curves from an earlier launch are kept and rewritten in place
+			if (connectedNode.hasFn(MFn::kAnimCurve) && !isLaunchCurve(connectedNode)) {
+				dgModifier.deleteNode(connectedNode);
+				if (m_profile) m_profile->curvesDeleted++;
 			}
 		}
 	}
 }
 
-MStatus CameraLaunchCmd::saveAnimationState() {
-	MStatus status;
-	MObject cameraTransform = m_cameraPath.transform(&status);
-	if (status != MS::kSuccess) return status;
-
-	MFnTransform transformFn(cameraTransform);
-
-	std::vector<MPlug> plugsToSave = {
-		transformFn.findPlug("translateX", false),
-		transformFn.findPlug("translateY", false),
-		transformFn.findPlug("translateZ", false),
-		transformFn.findPlug("rotateX", false),
-		transformFn.findPlug("rotateY", false)
-	};
-
-	for (MPlug& plug : plugsToSave) {
-		if (plug.isConnected()) {
-			MPlugArray connections;
-			plug.connectedTo(connections, true, false);
-
-			for (unsigned int i = 0; i < connections.length(); ++i) {
-				MObject connectedNode = connections[i].node();
-				if (connectedNode.hasFn(MFn::kAnimCurve)) {
-					MFnAnimCurve animCurve(connectedNode);
-					
-					m_savedAnimCurves.animCurveObjects.append(connectedNode);
-
-					MTimeArray times;
-					MDoubleArray values;
-					std::vector<MFnAnimCurve::TangentType> inTangentTypes;
-					std::vector<MFnAnimCurve::TangentType> outTangentTypes;
-					MDoubleArray inTangentAngles;
-					MDoubleArray outTangentAngles;
-					MDoubleArray inTangentWeights;
-					MDoubleArray outTangentWeights;
-
-					unsigned int numKeys = animCurve.numKeys();
-					for (unsigned int k = 0; k < numKeys; ++k) {
-						// Key times and values
-						times.append(animCurve.time(k));
-						values.append(animCurve.value(k));
-
-						// Tangent Types
-						inTangentTypes.push_back(animCurve.inTangentType(k));
-						outTangentTypes.push_back(animCurve.outTangentType(k));
-
-						// Tangent angles/weights
-						MAngle inAngle, outAngle;
-						double inWeight, outWeight;
-
-						animCurve.getTangent(k, inAngle, inWeight, true);
-						animCurve.getTangent(k, outAngle, outWeight, false);
-
-						inTangentAngles.append(inAngle.asRadians());
-						outTangentAngles.append(outAngle.asRadians());
-						inTangentWeights.append(inWeight);
-						outTangentWeights.append(outWeight);
-					}
-
-					m_savedAnimCurves.keyTimes.push_back(times);
-					m_savedAnimCurves.keyValues.push_back(values);
-					m_savedAnimCurves.inTangentTypes.push_back(inTangentTypes);
-					m_savedAnimCurves.outTangentTypes.push_back(outTangentTypes);
-					m_savedAnimCurves.inTangentAngles.push_back(inTangentAngles);
-					m_savedAnimCurves.outTangentAngles.push_back(outTangentAngles);
-					m_savedAnimCurves.inTangentWeights.push_back(inTangentWeights);
-					m_savedAnimCurves.outTangentWeights.push_back(outTangentWeights);
-				}
+void CameraLaunchCmd::clearLaunchCurveFromPlug(MPlug& plug, MDGModifier& dgModifier)
+{
+	if (plug.isConnected()) {
+		MPlugArray connections;
+		plug.connectedTo(connections, true, false);
+		for (unsigned int i = 0; i < connections.length(); ++i) {
+			MObject connectedNode = connections[i].node();
+			// The user's own curves on a channel this launch doesn't key are left alone
+			if (connectedNode.hasFn(MFn::kAnimCurve) && isLaunchCurve(connectedNode)) {
+				dgModifier.deleteNode(connectedNode);
+				if (m_profile) m_profile->curvesDeleted++;
 			}
 		}
 	}
+}
 
-	return MS::kSuccess;
+bool CameraLaunchCmd::isLaunchCurve(const MObject& animCurveObj)
+{
+	return MFnDependencyNode(animCurveObj).hasAttribute(launchCurveTag);
 }
 
-int CameraLaunchCmd::calculateFlightFrames()
+MVector CameraLaunchCmd::getStartPosition(const LaunchTarget& launch)
 {
-	// Handle case where there's no vertical velocity or gravity is positive
-	if (m_velocity.y <= 0.0 || m_gravity >= 0.0) {
-		// Default to 120 frames
-		return 120;
+	// -metrics launches without a camera start at the origin
+	if (!launch.cameraPath.isValid()) {
+		return MVector::zero;
 	}
-
-	// Calculate flight time using projectile motion
-	double flightTime = (2.0 * m_velocity.y) / fabs(m_gravity);
-
-	// Get the current frame rate
-	MTime::Unit timeUnit = MTime::uiUnit();
-	MTime oneFrame(1.0, timeUnit);
-	double secondsPerFrame = oneFrame.asUnits(MTime::kSeconds);
-	double fps = 1.0 / secondsPerFrame;
-
-	int flightFrames = (int)(flightTime * fps) + 1; // Add one to include the frame where it has "hit" the ground
-
-	// Ensure we have at least a few frames
-	return (flightFrames > 0) ? flightFrames : 60;
+	if (launch.parentMatrices) {
+		return launch.startPosition;
+	}
+	return launch.cameraPath.inclusiveMatrix() * MPoint::origin;
 }
 
-std::vector<int> CameraLaunchCmd::getKeyFrameNumbers()
+// Roll comes from the per-frame orientation, from an up object or off-axis target, or from a rig's
+// rotation; plain launches look along the velocity with rotateZ left alone
+bool CameraLaunchCmd::keysRotateZ(const LaunchTarget& launch) const
 {
-	std::vector<int> frameNumbers;
+	return m_orient || m_lookAt.target.isValid() || launch.parentMatrices;
+}
 
-	frameNumbers.push_back(m_startFrame);
+LaunchCore::RotateOrder CameraLaunchCmd::getRotateOrder(const LaunchTarget& launch)
+{
+	MFnTransform transformFn(launch.cameraPath.transform());
+	int rotateOrder = (int)transformFn.rotationOrder() - (int)MTransformationMatrix::kXYZ;
+	if (rotateOrder >= 0 && rotateOrder <= (int)LaunchCore::RotateOrder::ZYX) {
+		return (LaunchCore::RotateOrder)rotateOrder;
+	}
+	return LaunchCore::RotateOrder::XYZ;
+}
 
-	// Apex frame
-	double timeToApex = -m_velocity.y / m_gravity;
-	MTime::Unit timeUnit = MTime::uiUnit();
-	MTime oneFrame(1.0, timeUnit);
-	double secondsPerFrame = oneFrame.asUnits(MTime::kSeconds);
-	int apexFrame = m_startFrame + (int)(timeToApex / secondsPerFrame);
-	frameNumbers.push_back(apexFrame);
+LaunchCore::LaunchParams CameraLaunchCmd::getLaunchParams(const LaunchTarget& launch)
+{
+	LaunchCore::LaunchParams params;
 
-	int totalFrames = calculateFlightFrames();
-	frameNumbers.push_back(m_startFrame + totalFrames);
+	MVector startPos = getStartPosition(launch);
+	params.startPosition = LaunchCore::Vec3(startPos.x, startPos.y, startPos.z);
+	params.velocity = LaunchCore::Vec3(launch.velocity.x, launch.velocity.y, launch.velocity.z);
+	params.gravity = m_gravity;
+	params.startFrame = launch.startFrame;
+	params.flightTime = launch.flightTime;
+	params.framesPerSecond = m_timeBase.framesPerSecond();
 
-	return frameNumbers;
+	return params;
 }
\ No newline at end of file
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
 #include <vector>
 #include <maya/MGlobal.h>
 #include <maya/MPxCommand.h>
@@ -15,18 +20,52 @@
 #include <maya/MFnTransform.h>
 #include <maya/MPlug.h>
 #include <maya/MFnAnimCurve.h>
+#include <maya/MAnimCurveChange.h>
+#include <maya/MFnNumericAttribute.h>
 #include <maya/M3dView.h>
 #include <maya/MMatrix.h>
 #include <maya/MFnDependencyNode.h>
 #include <maya/MPlugArray.h>
 #include <maya/MObjectArray.h>
+#include <maya/MTimeArray.h>
+#include <maya/MDoubleArray.h>
 #include <maya/MAngle.h>
+#include <maya/MDGModifier.h>
+#include <maya/MDagModifier.h>
+#include <maya/MDGContext.h>
+#include <maya/MDGContextGuard.h>
+#include <maya/MFnMatrixData.h>
+#include <maya/MDagPathArray.h>
+#include <maya/MFnMesh.h>
+#include <maya/MFnFluid.h>
+#include <maya/MPointArray.h>
+#include <maya/MIntArray.h>
+#include <maya/MTimerMessage.h>
 
-enum class CameraKeyframeType {
-	START,
-	MIDDLE,
-	END
-};
+#include "TrajectoryCore.h"
+#include "TrajectorySampler.h"
+#include "BounceChain.h"
+#include "DragIntegrator.h"
+#include "FlightPath.h"
+#include "InverseSolver.h"
+#include "KeyReducer.h"
+#include "LaunchProfiler.h"
+#include "OrientationSolver.h"
+#include "TimeBase.h"
+#include "TrajectoryCache.h"
+#include "CurveUpdate.h"
+#include "ComputeQueue.h"
+#include "FlightBake.h"
+#include "FlightMetrics.h"
+#include "KeyAccuracy.h"
+#include "VectorField.h"
+#include "GravityWells.h"
+#include "EmitterSampler.h"
+#include "ParentSpace.h"
+#include "LookAtSolver.h"
+#include "ThreadPool.h"
+
+using CameraKeyframeType = LaunchCore::KeyframeType;
 
 class CameraLaunchCmd : public MPxCommand
 {
@@ -45,6 +84,9 @@ public:
 
 	static MSyntax newSyntax();
 
+	// Cancels launches still computing and drops the ones waiting to be keyed
+	static void shutdownAsync();
+
 private:
 	static const char* cameraFlag;
 	static const char* cameraFlagLong;
@@ -54,46 +96,270 @@ private:
 	static const char* gravityFlagLong;
 	static const char* startFrameFlag;
 	static const char* startFrameLongFlag;
+	static const char* bakeFlag;
+	static const char* bakeFlagLong;
+	static const char* bakeStepFlag;
+	static const char* bakeStepFlagLong;
+	static const char* dragFlag;
+	static const char* dragFlagLong;
+	static const char* massFlag;
+	static const char* massFlagLong;
+	static const char* collideFlag;
+	static const char* collideFlagLong;
+	static const char* targetFlag;
+	static const char* targetFlagLong;
+	static const char* targetObjectFlag;
+	static const char* targetObjectFlagLong;
+	static const char* flightTimeFlag;
+	static const char* flightTimeFlagLong;
+	static const char* apexHeightFlag;
+	static const char* apexHeightFlagLong;
+	static const char* toleranceFlag;
+	static const char* toleranceFlagLong;
+	static const char* profileFlag;
+	static const char* profileFlagLong;
+	static const char* profileHistoryFlag;
+	static const char* profileHistoryFlagLong;
+	static const char* orientFlag;
+	static const char* orientFlagLong;
+	static const char* bankFlag;
+	static const char* bankFlagLong;
+	static const char* upVectorFlag;
+	static const char* upVectorFlagLong;
+	static const char* bouncesFlag;
+	static const char* bouncesFlagLong;
+	static const char* restitutionFlag;
+	static const char* restitutionFlagLong;
+	static const char* frictionFlag;
+	static const char* frictionFlagLong;
+	static const char* samplesPerFrameFlag;
+	static const char* samplesPerFrameFlagLong;
+	static const char* cacheFlag;
+	static const char* cacheFlagLong;
+	static const char* backgroundFlag;
+	static const char* backgroundFlagLong;
+	static const char* jobProgressFlag;
+	static const char* jobProgressFlagLong;
+	static const char* cancelJobFlag;
+	static const char* cancelJobFlagLong;
+	static const char* applyJobFlag;
+	static const char* applyJobFlagLong;
+	static const char* metricsFlag;
+	static const char* metricsFlagLong;
+	static const char* windFlag;
+	static const char* windFlagLong;
+	static const char* forceFieldFlag;
+	static const char* forceFieldFlagLong;
+	static const char* fieldScaleFlag;
+	static const char* fieldScaleFlagLong;
+	static const char* attractorFlag;
+	static const char* attractorFlagLong;
+	static const char* gravityConstantFlag;
+	static const char* gravityConstantFlagLong;
+	static const char* softeningFlag;
+	static const char* softeningFlagLong;
+	static const char* objectFlag;
+	static const char* objectFlagLong;
+	static const char* emitFlag;
+	static const char* emitFlagLong;
+	static const char* emitFromFlag;
+	static const char* emitFromFlagLong;
+	static const char* coneAngleFlag;
+	static const char* coneAngleFlagLong;
+	static const char* speedRangeFlag;
+	static const char* speedRangeFlagLong;
+	static const char* seedFlag;
+	static const char* seedFlagLong;
+	static const char* inheritVelocityFlag;
+	static const char* inheritVelocityFlagLong;
+	static const char* lookAtFlag;
+	static const char* lookAtFlagLong;
+	static const char* upObjectFlag;
+	static const char* upObjectFlagLong;
+	static const char* framingOffsetFlag;
+	static const char* framingOffsetFlagLong;
 
-	MDagPath m_cameraPath;
-	MVector m_velocity;
+	// One camera, or any other transform, launched by this command
+	struct LaunchTarget {
+		MDagPath cameraPath;
+		// Waiting for its locator from -emit; until then cameraPath is the object it is emitted from
+		bool emitted;
+		MVector velocity;
+		double startFrame;
+		// World-space point the launch has to reach, when solving for the velocity
+		bool hasTarget;
+		MVector targetPoint;
+		// Seconds until the target is reached, zero to land back at launch height
+		double flightTime;
+		// Parent's world matrix at every frame evaluated so far, null under the world. Shared with
+		// background jobs, so the rig is evaluated once per frame however often the launch is keyed.
+		std::shared_ptr<LaunchCore::ParentMatrices> parentMatrices;
+		// World position the parent carries the object to at the launch frame
+		MVector startPosition;
+	};
+
+	// Anim curves driving the channels a launch writes to
+	struct CameraCurves {
+		MFnAnimCurve translateX;
+		MFnAnimCurve translateY;
+		MFnAnimCurve translateZ;
+		MFnAnimCurve rotateX;
+		MFnAnimCurve rotateY;
+		// Only resolved when the launch is keyed with roll, see keysRotateZ
+		MFnAnimCurve rotateZ;
+	};
+
+	// Object every launch keeps in frame with -lookAt
+	struct LookAt {
+		MDagPath target;
+		// Invalid when the camera's up leans towards -upVector instead
+		MDagPath upObject;
+		LaunchCore::LookAtSettings settings;
+		// World matrices at every frame evaluated so far, shared by all launches and background jobs
+		std::shared_ptr<LaunchCore::ParentMatrices> targetMatrices;
+		std::shared_ptr<LaunchCore::ParentMatrices> upMatrices;
+	};
+
+	// Launch baked on the compute queue, waiting for -applyJob to key it
+	struct AsyncLaunch {
+		std::vector<LaunchTarget> launches;
+		std::vector<LaunchCore::BakeRequest> requests;
+		std::vector<LaunchCore::BakedFlight> flights;
+		// Triangles are read from the meshes up front; the BVH over them is built in the background
+		std::vector<LaunchCore::Vec3> collisionVertices;
+		std::vector<uint32_t> collisionIndices;
+		LaunchCore::TriangleBVH collision;
+		// Held here so the field outlives the command that loaded it
+		std::shared_ptr<const LaunchCore::VectorField> field;
+		std::shared_ptr<const LaunchCore::AttractorTree> attractors;
+		// Settings the keys are written with
+		double tolerance;
+		bool orient;
+		LookAt lookAt;
+		LaunchCore::TimeBase timeBase;
+		MTime::Unit timeUnit;
+	};
+
+	// What a -jobProgress, -cancelJob or -applyJob call does instead of launching
+	enum class JobAction {
+		NONE,
+		PROGRESS,
+		CANCEL,
+		APPLY
+	};
+
+	// Shared by every invocation; only touched on the main thread
+	static std::unique_ptr<LaunchCore::ComputeQueue> computeQueue;
+	static std::map<uint64_t, std::shared_ptr<AsyncLaunch>> asyncLaunches;
+	static MCallbackId collectCallbackId;
+	// Bakes the flights of a launch across every core before their keys are written
+	static std::unique_ptr<LaunchCore::ThreadPool> bakePool;
+
+	std::vector<LaunchTarget> m_launches;
 	double m_gravity;
-	int m_startFrame;
+	bool m_bake;
+	double m_bakeStep;
+	// Baked samples per frame; above one bakes sub-frame samples for motion blur
+	int m_samplesPerFrame;
+	// Scene frame rate, resolved once in doIt and kept for redo
+	LaunchCore::TimeBase m_timeBase;
+	MTime::Unit m_timeUnit;
+	// Directory of baked trajectory caches, empty to always bake from scratch
+	MString m_cacheDirectory;
+	// Sampled paths are reduced to the fewest keys within this deviation, zero keys every sample
+	double m_tolerance;
+	// Per-frame orientation along the velocity, keyed on all three rotate channels
+	bool m_orient;
+	LaunchCore::OrientationSettings m_orientation;
+	LaunchCore::DragParams m_drag;
+	// Floor contacts the flight carries on past, each one a new parabola
+	LaunchCore::BounceSettings m_bounces;
+	MDagPathArray m_collisionMeshes;
+	// Wind or force field from -wind or -forceField, shared with background jobs
+	std::shared_ptr<const LaunchCore::VectorField> m_field;
+	LaunchCore::FieldKind m_fieldKind;
+	double m_fieldScale;
+	// Gravity wells from -attractor, in an octree shared with background jobs
+	std::shared_ptr<const LaunchCore::AttractorTree> m_attractors;
+	double m_gravityConstant;
+	double m_softening;
+	// Locators made by -emit. Undo takes them out of the scene and redo puts the same nodes back.
+	std::unique_ptr<MDagModifier> m_emittedObjects;
+	bool m_emittedInScene;
+	// Add the parent's velocity at the launch frame to objects launched off a moving rig
+	bool m_inheritVelocity;
+	// Aims every launch at an object instead of along its velocity
+	LookAt m_lookAt;
+	LaunchCore::TargetConstraint m_targetConstraint;
+	double m_targetValue;
+	// Return the flight metrics of every launch instead of keying anything
+	bool m_metricsQuery;
+	// Bake on the compute queue and return a job id instead of keying now
+	bool m_background;
+	bool m_asyncSubmitted;
+	JobAction m_jobAction;
+	uint64_t m_jobId;
+	// Flights baked in the background, keyed instead of baking them again
+	std::shared_ptr<AsyncLaunch> m_computed;
 
 	bool m_hasValidData;
 	MSelectionList m_originalSelection;
 
-	struct AnimCurveData {
-		MObjectArray animCurveObjects;
-		std::vector<MTimeArray> keyTimes;
-		std::vector<MDoubleArray> keyValues;
-		std::vector<std::vector<MFnAnimCurve::TangentType>> inTangentTypes;
-		std::vector<std::vector<MFnAnimCurve::TangentType>> outTangentTypes;
-		std::vector<MDoubleArray> inTangentAngles;
-		std::vector<MDoubleArray> outTangentAngles;
-		std::vector<MDoubleArray> inTangentWeights;
-		std::vector<MDoubleArray> outTangentWeights;
-	};
+	// Deletion of the curves this launch replaced; undoing it restores them untouched
+	std::unique_ptr<MDGModifier> m_replacedCurves;
+	// Key edits on curves left by an earlier launch, which are rewritten instead of replaced
+	std::unique_ptr<MAnimCurveChange> m_curveEdits;
+	MObjectArray m_createdCurves;
+
+	// -profile times every run of the command; m_profile is only set while one is in progress
+	bool m_profileEnabled;
+	bool m_profileHistoryQuery;
+	std::unique_ptr<LaunchCore::ProfileRecord> m_profile;
+	std::chrono::steady_clock::time_point m_profileStart;
 
-	AnimCurveData m_savedAnimCurves;
-
-	std::vector<MVector> calculateTrajectory();
-	std::vector<MEulerRotation> calculateRotations(const std::vector<MVector>& points);
-	MStatus setKeyframesOnCamera(const std::vector<MVector>& points, const std::vector<MEulerRotation>& rots);
-	MStatus setKeyframeOnCamera(const MVector& point, const MEulerRotation& rot, int frameNumber, CameraKeyframeType keyType,
-		const MVector& startPoint, const MVector& middlePoint, const MVector& endPoint,
-		int startFrame, int middleFrame, int endFrame);
-	void setParabolicTangents(MFnAnimCurve& animCurve, unsigned int keyIndex, CameraKeyframeType keyType,
-		const MVector& startPoint, const MVector& middlePoint, const MVector& endPoint,
-		int startFrame, int middleFrame, int endFrame);
+	void beginProfile(const char* command);
+	void endProfile();
+
+	MStatus setKeyframesOnCamera(const LaunchTarget& launch);
+	void bakeFlights(const LaunchCore::TriangleBVH* collision, std::vector<LaunchCore::BakedFlight>& flights);
+	LaunchCore::BakeRequest makeBakeRequest(const LaunchTarget& launch, const LaunchCore::TriangleBVH* collision);
+	MStatus writeBakedFlight(const LaunchTarget& launch, const LaunchCore::BakedFlight& flight);
+	MStatus setBounceKeyframesOnCamera(const LaunchTarget& launch, const LaunchCore::TriangleBVH* collision);
+	MStatus addParabolicKeys(CameraCurves& curves, const std::vector<LaunchCore::ParabolicKey>& keys);
+	MStatus addReducedKeys(MFnAnimCurve& animCurve, const double* frames, const double* values, size_t sampleCount, double tolerance);
+	MStatus writeChannelKeys(MFnAnimCurve& animCurve, const std::vector<LaunchCore::ReducedKey>& keys, bool weighted);
+	MStatus buildCollisionBVH(LaunchCore::TriangleBVH& bvh);
+	MStatus gatherCollisionTriangles(std::vector<LaunchCore::Vec3>& vertices, std::vector<uint32_t>& indices);
+	MStatus loadVectorField(const MString& source, LaunchCore::VectorField& field);
+	MStatus readFluidVelocity(const MDagPath& fluidPath, LaunchCore::VectorField& field);
+	LaunchCore::FieldSettings fieldSettings() const;
+	LaunchCore::GravityWellSettings wellSettings() const;
+	// Drag, fields and gravity wells all need the integrator
+	bool integratesFlights() const;
+	MStatus getCameraCurves(const LaunchTarget& launch, CameraCurves& curves);
 	bool getOrCreateAnimCurve(MPlug& plug, MFnAnimCurve& animCurve, MObject& animCurveObj);
-	MStatus clearExistingAnimationCurves();
-	void clearAnimCurveFromPlug(MPlug& plug);
-	MStatus saveAnimationState();
-	int calculateFlightFrames();
-	std::vector<int> getKeyFrameNumbers();
+	MStatus clearExistingAnimationCurves(MDGModifier& dgModifier);
+	void clearAnimCurveFromPlug(MPlug& plug, MDGModifier& dgModifier);
+	void clearLaunchCurveFromPlug(MPlug& plug, MDGModifier& dgModifier);
+	static bool isLaunchCurve(const MObject& animCurveObj);
+	MVector getStartPosition(const LaunchTarget& launch);
+	LaunchCore::LaunchParams getLaunchParams(const LaunchTarget& launch);
 
 	MStatus parseArguments(const MArgList& args);
+	MStatus solveLaunchTargets();
+	MStatus createEmittedObjects();
+	MStatus resolveParents();
+	MStatus evaluateMatrices(const MDagPath& path, const char* attribute, LaunchCore::ParentMatrices& cache,
+		const double* frames, size_t count);
+	bool keysRotateZ(const LaunchTarget& launch) const;
+	LaunchCore::RotateOrder getRotateOrder(const LaunchTarget& launch);
 	MStatus executeCommand();
 	MStatus generateKeyframes();
+	bool bakesFlights() const;
+
+	MStatus queryFlightMetrics();
+	MStatus submitAsyncLaunch();
+	MStatus runJobAction();
+	static void collectEndedJobs();
+	static void collectAsyncLaunches(float elapsedTime, float lastTime, void* clientData);
 };
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "CameraLaunchNode.h"
+
+const char* CameraLaunchNode::nodeName = "cameraLaunchNode";
+const MTypeId CameraLaunchNode::id(0x0007F001);
+
+MObject CameraLaunchNode::aStartPosition;
+MObject CameraLaunchNode::aVelocity;
+MObject CameraLaunchNode::aGravity;
+MObject CameraLaunchNode::aStartFrame;
+MObject CameraLaunchNode::aTime;
+
+MObject CameraLaunchNode::aOutputTranslate;
+MObject CameraLaunchNode::aOutputRotate;
+MObject CameraLaunchNode::aOutputRotateX;
+MObject CameraLaunchNode::aOutputRotateY;
+MObject CameraLaunchNode::aOutputRotateZ;
+
+CameraLaunchNode::CameraLaunchNode()
+{
+	m_hasEvaluator = false;
+	m_hasTimeBase = false;
+	m_timeUnit = MTime::kFilm;
+}
+
+CameraLaunchNode::~CameraLaunchNode()
+{
+
+}
+
+void* CameraLaunchNode::creator()
+{
+	return new CameraLaunchNode();
+}
+
+MStatus CameraLaunchNode::initialize()
+{
+	MFnNumericAttribute numericFn;
+	MFnUnitAttribute unitFn;
+	MFnCompoundAttribute compoundFn;
+
+	// Inputs
+	aStartPosition = numericFn.create("startPosition", "sp", MFnNumericData::k3Double, 0.0);
+	numericFn.setKeyable(true);
+
+	aVelocity = numericFn.create("velocity", "vel", MFnNumericData::k3Double, 0.0);
+	numericFn.setKeyable(true);
+
+	aGravity = numericFn.create("gravity", "grv", MFnNumericData::kDouble, -9.81);
+	numericFn.setKeyable(true);
+
+	aStartFrame = numericFn.create("startFrame", "sf", MFnNumericData::kDouble, 0.0);
+	numericFn.setKeyable(true);
+
+	aTime = unitFn.create("time", "tm", MFnUnitAttribute::kTime, 0.0);
+
+	// Outputs
+	aOutputTranslate = numericFn.create("outputTranslate", "ot", MFnNumericData::k3Double, 0.0);
+	numericFn.setWritable(false);
+	numericFn.setStorable(false);
+
+	aOutputRotateX = unitFn.create("outputRotateX", "orx", MFnUnitAttribute::kAngle, 0.0);
+	aOutputRotateY = unitFn.create("outputRotateY", "ory", MFnUnitAttribute::kAngle, 0.0);
+	aOutputRotateZ = unitFn.create("outputRotateZ", "orz", MFnUnitAttribute::kAngle, 0.0);
+	aOutputRotate = compoundFn.create("outputRotate", "or");
+	compoundFn.addChild(aOutputRotateX);
+	compoundFn.addChild(aOutputRotateY);
+	compoundFn.addChild(aOutputRotateZ);
+	compoundFn.setWritable(false);
+	compoundFn.setStorable(false);
+
+	addAttribute(aStartPosition);
+	addAttribute(aVelocity);
+	addAttribute(aGravity);
+	addAttribute(aStartFrame);
+	addAttribute(aTime);
+	addAttribute(aOutputTranslate);
+	addAttribute(aOutputRotate);
+
+	MObject inputs[] = { aStartPosition, aVelocity, aGravity, aStartFrame, aTime };
+	for (const MObject& input : inputs) {
+		attributeAffects(input, aOutputTranslate);
+		attributeAffects(input, aOutputRotate);
+	}
+
+	return MS::kSuccess;
+}
+
+bool CameraLaunchNode::launchChanged(const LaunchCore::LaunchParams& params) const
+{
+	if (!m_hasEvaluator) {
+		return true;
+	}
+
+	const LaunchCore::LaunchParams& cached = m_evaluator.params();
+	return cached.startPosition.x != params.startPosition.x
+		|| cached.startPosition.y != params.startPosition.y
+		|| cached.startPosition.z != params.startPosition.z
+		|| cached.velocity.x != params.velocity.x
+		|| cached.velocity.y != params.velocity.y
+		|| cached.velocity.z != params.velocity.z
+		|| cached.gravity != params.gravity
+		|| cached.startFrame != params.startFrame
+		|| cached.framesPerSecond != params.framesPerSecond;
+}
+
+MStatus CameraLaunchNode::compute(const MPlug& plug, MDataBlock& data)
+{
+	MPlug target = plug.isChild() ? plug.parent() : plug;
+	if (target != aOutputTranslate && target != aOutputRotate) {
+		return MS::kUnknownParameter;
+	}
+
+	LaunchCore::LaunchParams params;
+
+	const double3& startPosition = data.inputValue(aStartPosition).asDouble3();
+	params.startPosition = LaunchCore::Vec3(startPosition[0], startPosition[1], startPosition[2]);
+
+	const double3& velocity = data.inputValue(aVelocity).asDouble3();
+	params.velocity = LaunchCore::Vec3(velocity[0], velocity[1], velocity[2]);
+
+	params.gravity = data.inputValue(aGravity).asDouble();
+	params.startFrame = data.inputValue(aStartFrame).asDouble();
+
+	// The frame rate only needs converting again when the scene's time unit changes
+	MTime::Unit timeUnit = MTime::uiUnit();
+	if (!m_hasTimeBase || timeUnit != m_timeUnit) {
+		m_timeBase = LaunchCore::TimeBase(1.0 / MTime(1.0, timeUnit).asUnits(MTime::kSeconds));
+		m_timeUnit = timeUnit;
+		m_hasTimeBase = true;
+	}
+	params.framesPerSecond = m_timeBase.framesPerSecond();
+
+	// Only scrubbing time? Reuse the cached launch constants.
+	if (launchChanged(params)) {
+		m_evaluator = LaunchCore::LaunchEvaluator(params);
+		m_hasEvaluator = true;
+	}
+
+	double frame = data.inputValue(aTime).asTime().asUnits(timeUnit);
+
+	LaunchCore::Vec3 position;
+	LaunchCore::Euler rotation;
+	m_evaluator.evaluate(frame, position, rotation);
+
+	MDataHandle translateHandle = data.outputValue(aOutputTranslate);
+	translateHandle.set3Double(position.x, position.y, position.z);
+	translateHandle.setClean();
+
+	data.outputValue(aOutputRotateX).setMAngle(MAngle(rotation.x, MAngle::kRadians));
+	data.outputValue(aOutputRotateY).setMAngle(MAngle(rotation.y, MAngle::kRadians));
+	data.outputValue(aOutputRotateZ).setMAngle(MAngle(rotation.z, MAngle::kRadians));
+	data.setClean(aOutputRotate);
+
+	return MS::kSuccess;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <maya/MPxNode.h>
+#include <maya/MTypeId.h>
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MStatus.h>
+#include <maya/MTime.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MFnCompoundAttribute.h>
+#include <maya/MAngle.h>
+
+#include "LaunchEvaluator.h"
+#include "TimeBase.h"
+
+// Evaluates a launch lazily for whatever time the DG asks for, instead of writing anim curves.
+// Connect time1.outTime to .time and .outputTranslate/.outputRotate to the camera transform.
+class CameraLaunchNode : public MPxNode
+{
+public:
+	static const char* nodeName;
+	static const MTypeId id;
+
+	static MObject aStartPosition;
+	static MObject aVelocity;
+	static MObject aGravity;
+	static MObject aStartFrame;
+	static MObject aTime;
+
+	static MObject aOutputTranslate;
+	static MObject aOutputRotate;
+	static MObject aOutputRotateX;
+	static MObject aOutputRotateY;
+	static MObject aOutputRotateZ;
+
+	CameraLaunchNode();
+	virtual ~CameraLaunchNode();
+
+	virtual MStatus compute(const MPlug& plug, MDataBlock& data) override;
+
+	static void* creator();
+	static MStatus initialize();
+
+private:
+	// Constants for the last launch inputs seen; rebuilt only when those inputs change
+	LaunchCore::LaunchEvaluator m_evaluator;
+	bool m_hasEvaluator;
+	// Frame rate of the last time unit seen
+	LaunchCore::TimeBase m_timeBase;
+	MTime::Unit m_timeUnit;
+	bool m_hasTimeBase;
+
+	bool launchChanged(const LaunchCore::LaunchParams& params) const;
+};
@@ -0,0 +1,57 @@
+#include "CollisionSweep.h"
+
+namespace LaunchCore {
+
+CollisionHit findFirstHit(const TrajectorySamples& samples, const TriangleBVH& bvh)
+{
+	CollisionHit result;
+	if (bvh.empty() || samples.size() < 2) {
+		return result;
+	}
+
+	const double launchEpsilon = 1e-6;
+
+	for (size_t i = 0; i + 1 < samples.size(); ++i) {
+		Vec3 a(samples.translateX[i], samples.translateY[i], samples.translateZ[i]);
+		Vec3 b(samples.translateX[i + 1], samples.translateY[i + 1], samples.translateZ[i + 1]);
+
+		SegmentHit hit;
+		if (bvh.intersectSegment(a, b, hit, (i == 0) ? launchEpsilon : 0.0)) {
+			result.hit = true;
+			result.segment = i;
+			result.fraction = hit.fraction;
+			result.frame = samples.frames[i] + (samples.frames[i + 1] - samples.frames[i]) * hit.fraction;
+			result.position = hit.point;
+			result.normal = hit.normal;
+			return result;
+		}
+	}
+
+	return result;
+}
+
+void truncateAtHit(TrajectorySamples& samples, const CollisionHit& hit)
+{
+	if (!hit.hit || hit.segment + 1 >= samples.size()) {
+		return;
+	}
+
+	size_t next = hit.segment + 1;
+	double s = hit.fraction;
+
+	double rotateX = samples.rotateX[hit.segment] + (samples.rotateX[next] - samples.rotateX[hit.segment]) * s;
+	double rotateY = samples.rotateY[hit.segment] + (samples.rotateY[next] - samples.rotateY[hit.segment]) * s;
+
+	// A hit exactly on a sample replaces it rather than adding a duplicate key time
+	size_t keep = (s > 0.0) ? next : hit.segment;
+	samples.resize(keep + 1);
+
+	samples.frames[keep] = hit.frame;
+	samples.translateX[keep] = hit.position.x;
+	samples.translateY[keep] = hit.position.y;
+	samples.translateZ[keep] = hit.position.z;
+	samples.rotateX[keep] = rotateX;
+	samples.rotateY[keep] = rotateY;
+}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "TrajectorySampler.h"
+#include "TriangleBVH.h"
+
+namespace LaunchCore {
+
+struct CollisionHit {
+	bool hit = false;
+	// Index of the sample the hit segment starts from
+	size_t segment = 0;
+	// Fraction along that segment
+	double fraction = 0.0;
+	// Frame (possibly fractional) at which the hit happens
+	double frame = 0.0;
+	Vec3 position;
+	Vec3 normal;
+};
+
+// Walks the sampled path chord by chord and returns the first triangle it passes through.
+// Hits right at the launch point are ignored so a camera resting on geometry can take off.
+CollisionHit findFirstHit(const TrajectorySamples& samples, const TriangleBVH& bvh);
+
+// Drops every sample after the hit and ends the path with a sample at the hit point
+void truncateAtHit(TrajectorySamples& samples, const CollisionHit& hit);
+
+}
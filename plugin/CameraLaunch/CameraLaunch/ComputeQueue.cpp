@@ -0,0 +1,135 @@
+#include "ComputeQueue.h"
+
+#include <algorithm>
+
+namespace LaunchCore {
+
+JobControl::JobControl()
+	: m_cancelled(false)
+	, m_progress(0.0)
+	, m_rangeBegin(0.0)
+	, m_rangeEnd(1.0)
+{
+}
+
+void JobControl::setProgress(double fraction)
+{
+	fraction = std::min(std::max(fraction, 0.0), 1.0);
+	m_progress = m_rangeBegin + (m_rangeEnd - m_rangeBegin) * fraction;
+}
+
+void JobControl::setRange(double begin, double end)
+{
+	m_rangeBegin = begin;
+	m_rangeEnd = end;
+	m_progress = begin;
+}
+
+ComputeQueue::ComputeQueue(size_t threadCount)
+	: m_nextId(1)
+	, m_pool(threadCount)
+{
+}
+
+ComputeQueue::~ComputeQueue()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& job : m_jobs) {
+			job.second.control->cancel();
+		}
+	}
+	m_pool.wait();
+}
+
+uint64_t ComputeQueue::submit(Job job)
+{
+	std::shared_ptr<JobControl> control = std::make_shared<JobControl>();
+	uint64_t id;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		id = m_nextId++;
+		m_jobs[id].control = control;
+	}
+
+	m_pool.submit([this, id, job, control]() {
+		run(id, job, *control);
+	});
+	return id;
+}
+
+void ComputeQueue::run(uint64_t id, const Job& job, JobControl& control)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (control.cancelled()) {
+			m_jobs[id].state = JobState::CANCELLED;
+			m_finished.emplace_back(id, JobState::CANCELLED);
+			return;
+		}
+		m_jobs[id].state = JobState::RUNNING;
+	}
+
+	bool succeeded = job(control);
+
+	JobState state = control.cancelled() ? JobState::CANCELLED
+		: succeeded ? JobState::FINISHED
+		: JobState::FAILED;
+	if (state == JobState::FINISHED) {
+		control.setRange(0.0, 1.0);
+		control.setProgress(1.0);
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_jobs[id].state = state;
+	m_finished.emplace_back(id, state);
+}
+
+bool ComputeQueue::cancel(uint64_t id)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_jobs.find(id);
+	if (it == m_jobs.end()) {
+		return false;
+	}
+
+	it->second.control->cancel();
+	return true;
+}
+
+bool ComputeQueue::status(uint64_t id, JobState& state, double& progress) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_jobs.find(id);
+	if (it == m_jobs.end()) {
+		return false;
+	}
+
+	state = it->second.state;
+	progress = it->second.control->progress();
+	return true;
+}
+
+size_t ComputeQueue::pending() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_jobs.size();
+}
+
+std::vector<std::pair<uint64_t, JobState>> ComputeQueue::takeFinished()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::vector<std::pair<uint64_t, JobState>> finished;
+	finished.swap(m_finished);
+	for (const auto& job : finished) {
+		m_jobs.erase(job.first);
+	}
+	return finished;
+}
+
+void ComputeQueue::wait()
+{
+	m_pool.wait();
+}
+
+}
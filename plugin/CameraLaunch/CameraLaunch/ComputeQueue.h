@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace LaunchCore {
+
+// Progress and cancellation shared between a background job and the thread that submitted it.
+// Jobs poll cancelled() between steps; nothing is interrupted mid-step.
+class JobControl
+{
+public:
+	JobControl();
+
+	void cancel() { m_cancelled = true; }
+	bool cancelled() const { return m_cancelled; }
+
+	// Fraction of the current range done, 0 to 1
+	void setProgress(double fraction);
+	// Fraction of the whole job done
+	double progress() const { return m_progress; }
+
+	// Maps later setProgress calls onto [begin, end] of the whole job, so a step can report its
+	// own 0 to 1 without knowing where it sits. Only the job's own thread may call this.
+	void setRange(double begin, double end);
+
+private:
+	std::atomic<bool> m_cancelled;
+	std::atomic<double> m_progress;
+	double m_rangeBegin;
+	double m_rangeEnd;
+};
+
+enum class JobState {
+	QUEUED,
+	RUNNING,
+	FINISHED,
+	CANCELLED,
+	FAILED
+};
+
+// Runs jobs on a worker pool and hands their outcome back to the thread that collects them.
+// Results go through state the job owns; the queue only tracks ids, progress and outcome.
+class ComputeQueue
+{
+public:
+	// Returns false when the job failed. A cancelled job ends as CANCELLED whatever it returns.
+	using Job = std::function<bool(JobControl& control)>;
+
+	explicit ComputeQueue(size_t threadCount = 0);
+	// Cancels everything still outstanding and waits for the workers
+	~ComputeQueue();
+
+	ComputeQueue(const ComputeQueue&) = delete;
+	ComputeQueue& operator=(const ComputeQueue&) = delete;
+
+	// Ids start at 1 and are never reused
+	uint64_t submit(Job job);
+
+	// False when the id has already been collected or never existed
+	bool cancel(uint64_t id);
+	bool status(uint64_t id, JobState& state, double& progress) const;
+
+	// Jobs submitted and not yet collected
+	size_t pending() const;
+
+	// Jobs that have ended since the last call, in the order they ended. Collected jobs are forgotten.
+	std::vector<std::pair<uint64_t, JobState>> takeFinished();
+
+	// Blocks until every submitted job has ended
+	void wait();
+
+private:
+	struct Entry {
+		std::shared_ptr<JobControl> control;
+		JobState state = JobState::QUEUED;
+	};
+
+	void run(uint64_t id, const Job& job, JobControl& control);
+
+	mutable std::mutex m_mutex;
+	std::map<uint64_t, Entry> m_jobs;
+	std::vector<std::pair<uint64_t, JobState>> m_finished;
+	uint64_t m_nextId;
+	// Declared last so the workers are joined before the bookkeeping above goes away
+	ThreadPool m_pool;
+};
+
+}
@@ -0,0 +1,82 @@
+#include "CurveUpdate.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace LaunchCore {
+
+namespace {
+
+// Unmatched keys and targets between two anchors, or before the first / after the last
+struct Gap {
+	std::vector<size_t> keys;
+	std::vector<size_t> targets;
+};
+
+}
+
+KeyUpdatePlan planKeyUpdate(const double* currentFrames, size_t currentCount,
+	const double* targetFrames, size_t targetCount, double epsilon)
+{
+	std::vector<Gap> gaps(1);
+	size_t i = 0;
+	size_t j = 0;
+	while (i < currentCount || j < targetCount) {
+		if (i < currentCount && j < targetCount && std::fabs(currentFrames[i] - targetFrames[j]) <= epsilon) {
+			gaps.emplace_back();
+			++i;
+			++j;
+		}
+		else if (j >= targetCount || (i < currentCount && currentFrames[i] < targetFrames[j])) {
+			gaps.back().keys.push_back(i++);
+		}
+		else {
+			gaps.back().targets.push_back(j++);
+		}
+	}
+
+	KeyUpdatePlan plan;
+	std::vector<bool> removed(currentCount, false);
+	for (const Gap& gap : gaps) {
+		for (size_t k = gap.targets.size(); k < gap.keys.size(); ++k) {
+			removed[gap.keys[k]] = true;
+		}
+		for (size_t k = gap.keys.size(); k < gap.targets.size(); ++k) {
+			plan.additions.push_back(gap.targets[k]);
+		}
+	}
+
+	// Where each current key ends up once the removals are done
+	std::vector<size_t> survivorIndex(currentCount, 0);
+	size_t survivors = 0;
+	for (size_t k = 0; k < currentCount; ++k) {
+		survivorIndex[k] = survivors;
+		if (removed[k]) {
+			plan.removals.push_back(k);
+		}
+		else {
+			++survivors;
+		}
+	}
+	std::reverse(plan.removals.begin(), plan.removals.end());
+
+	// Within a gap, keys heading left go first from the left end, then keys heading right from the
+	// right end. Each one only ever moves towards a neighbour that has already cleared the way.
+	for (const Gap& gap : gaps) {
+		size_t pairs = std::min(gap.keys.size(), gap.targets.size());
+		for (size_t k = 0; k < pairs; ++k) {
+			if (targetFrames[gap.targets[k]] < currentFrames[gap.keys[k]]) {
+				plan.moves.push_back({ survivorIndex[gap.keys[k]], gap.targets[k] });
+			}
+		}
+		for (size_t k = pairs; k-- > 0;) {
+			if (targetFrames[gap.targets[k]] > currentFrames[gap.keys[k]]) {
+				plan.moves.push_back({ survivorIndex[gap.keys[k]], gap.targets[k] });
+			}
+		}
+	}
+
+	return plan;
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace LaunchCore {
+
+// Edits that turn a curve keyed at one set of frames into a curve keyed at another while keeping
+// as many of its keys as possible. Apply the removals, then the moves, then the additions; after
+// that key i of the curve sits at target frame i and only its value and tangents need setting.
+struct KeyUpdatePlan {
+	struct Move {
+		// Index of the key once the removals are done
+		size_t key = 0;
+		size_t target = 0;
+	};
+
+	// Current key indices, highest first so each removal leaves the remaining indices valid
+	std::vector<size_t> removals;
+	// Ordered so that no key is ever moved onto or past a neighbour
+	std::vector<Move> moves;
+	// Target indices with no key to reuse, lowest first
+	std::vector<size_t> additions;
+
+	bool empty() const { return removals.empty() && moves.empty() && additions.empty(); }
+};
+
+// Keys within 'epsilon' frames of a target frame stay where they are. The remaining keys between
+// two such anchors are moved onto the remaining targets in order, and only the surplus on either
+// side is removed or added. Both frame lists must be increasing.
+KeyUpdatePlan planKeyUpdate(const double* currentFrames, size_t currentCount,
+	const double* targetFrames, size_t targetCount, double epsilon = 1e-6);
+
+}
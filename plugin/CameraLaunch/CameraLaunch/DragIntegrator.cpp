@@ -0,0 +1,448 @@
+#include "DragIntegrator.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace LaunchCore {
+
+namespace {
+
+// Per-lane state, one array per component
+struct LaneArrays {
+	std::vector<double> px, py, pz;
+	std::vector<double> vx, vy, vz;
+
+	void resize(size_t count)
+	{
+		px.resize(count); py.resize(count); pz.resize(count);
+		vx.resize(count); vy.resize(count); vz.resize(count);
+	}
+};
+
+inline void dragAcceleration(double vx, double vy, double vz, double linear, double quadratic, double gravity,
+	double& ax, double& ay, double& az)
+{
+	double speed = std::sqrt(vx * vx + vy * vy + vz * vz);
+	double k = linear + quadratic * speed;
+	ax = -k * vx;
+	ay = gravity - k * vy;
+	az = -k * vz;
+}
+
+// One RK4 step for every lane. Acceleration only depends on velocity, so each stage
+// just needs the velocity estimate from the previous one.
+void rk4Step(LaneArrays& s, const std::vector<double>& linear, const std::vector<double>& quadratic,
+	const std::vector<double>& gravity, const std::vector<double>& stepSeconds)
+{
+	const size_t count = s.px.size();
+	double* px = s.px.data(); double* py = s.py.data(); double* pz = s.pz.data();
+	double* vx = s.vx.data(); double* vy = s.vy.data(); double* vz = s.vz.data();
+	const double* k1 = linear.data();
+	const double* k2 = quadratic.data();
+	const double* g = gravity.data();
+	const double* step = stepSeconds.data();
+
+	for (size_t i = 0; i < count; ++i) {
+		const double h = step[i];
+		const double halfH = 0.5 * h;
+
+		double ax1, ay1, az1;
+		dragAcceleration(vx[i], vy[i], vz[i], k1[i], k2[i], g[i], ax1, ay1, az1);
+
+		double vx2 = vx[i] + halfH * ax1, vy2 = vy[i] + halfH * ay1, vz2 = vz[i] + halfH * az1;
+		double ax2, ay2, az2;
+		dragAcceleration(vx2, vy2, vz2, k1[i], k2[i], g[i], ax2, ay2, az2);
+
+		double vx3 = vx[i] + halfH * ax2, vy3 = vy[i] + halfH * ay2, vz3 = vz[i] + halfH * az2;
+		double ax3, ay3, az3;
+		dragAcceleration(vx3, vy3, vz3, k1[i], k2[i], g[i], ax3, ay3, az3);
+
+		double vx4 = vx[i] + h * ax3, vy4 = vy[i] + h * ay3, vz4 = vz[i] + h * az3;
+		double ax4, ay4, az4;
+		dragAcceleration(vx4, vy4, vz4, k1[i], k2[i], g[i], ax4, ay4, az4);
+
+		const double sixthH = h / 6.0;
+		px[i] += sixthH * (vx[i] + 2.0 * vx2 + 2.0 * vx3 + vx4);
+		py[i] += sixthH * (vy[i] + 2.0 * vy2 + 2.0 * vy3 + vy4);
+		pz[i] += sixthH * (vz[i] + 2.0 * vz2 + 2.0 * vz3 + vz4);
+		vx[i] += sixthH * (ax1 + 2.0 * ax2 + 2.0 * ax3 + ax4);
+		vy[i] += sixthH * (ay1 + 2.0 * ay2 + 2.0 * ay3 + ay4);
+		vz[i] += sixthH * (az1 + 2.0 * az2 + 2.0 * az3 + az4);
+	}
+}
+
+// Scratch space for rk4SpatialStep, kept across steps to avoid reallocating
+struct SpatialStages {
+	// Stage position, velocity and acceleration
+	std::vector<double> qx, qy, qz;
+	std::vector<double> ux, uy, uz;
+	std::vector<double> ax, ay, az;
+	// Field and gravity well pull at the stage positions
+	std::vector<double> wx, wy, wz;
+	std::vector<double> gx, gy, gz;
+	// Weighted sums of the stage velocities and accelerations
+	std::vector<double> sumVx, sumVy, sumVz;
+	std::vector<double> sumAx, sumAy, sumAz;
+
+	void resize(size_t count)
+	{
+		for (std::vector<double>* lane : { &qx, &qy, &qz, &ux, &uy, &uz, &ax, &ay, &az, &wx, &wy, &wz, &gx, &gy, &gz,
+			&sumVx, &sumVy, &sumVz, &sumAx, &sumAy, &sumAz }) {
+			lane->resize(count);
+		}
+	}
+};
+
+// Forces that depend on where the camera is. Wind is subtracted from the velocity drag sees
+// and a force field is added to the acceleration, with a per-lane strength; only one of the
+// two is non-zero for a given field. Gravity wells pull every lane alike.
+struct SpatialForces {
+	const VectorField* field = nullptr;
+	std::vector<double> windScale;
+	std::vector<double> forceScale;
+	GravityWellSettings wells;
+
+	bool active() const { return field || wells.active(); }
+};
+
+// One RK4 step for every lane when a vector field or gravity wells are present. They depend
+// on position, so each stage also needs a position estimate; all lanes' stage positions are
+// looked up in one batch call per stage.
+void rk4SpatialStep(LaneArrays& s, const std::vector<double>& linear, const std::vector<double>& quadratic,
+	const std::vector<double>& gravity, const std::vector<double>& stepSeconds, const SpatialForces& forces,
+	SpatialStages& t)
+{
+	const size_t count = s.px.size();
+	t.resize(count);
+
+	const double stageStep[4] = { 0.0, 0.5, 0.5, 1.0 };
+	const double stageWeight[4] = { 1.0, 2.0, 2.0, 1.0 };
+
+	for (int stage = 0; stage < 4; ++stage) {
+		for (size_t i = 0; i < count; ++i) {
+			const double c = stageStep[stage] * stepSeconds[i];
+			if (stage == 0) {
+				t.qx[i] = s.px[i]; t.qy[i] = s.py[i]; t.qz[i] = s.pz[i];
+				t.ux[i] = s.vx[i]; t.uy[i] = s.vy[i]; t.uz[i] = s.vz[i];
+			}
+			else {
+				// Position from the previous stage's velocity, velocity from its acceleration
+				t.qx[i] = s.px[i] + c * t.ux[i]; t.qy[i] = s.py[i] + c * t.uy[i]; t.qz[i] = s.pz[i] + c * t.uz[i];
+				t.ux[i] = s.vx[i] + c * t.ax[i]; t.uy[i] = s.vy[i] + c * t.ay[i]; t.uz[i] = s.vz[i] + c * t.az[i];
+			}
+		}
+
+		if (forces.field) {
+			forces.field->sample(t.qx.data(), t.qy.data(), t.qz.data(), count, t.wx.data(), t.wy.data(), t.wz.data());
+		}
+		if (forces.wells.active()) {
+			forces.wells.attractors->acceleration(t.qx.data(), t.qy.data(), t.qz.data(), count,
+				forces.wells.softening, forces.wells.theta, t.gx.data(), t.gy.data(), t.gz.data());
+		}
+
+		const double weight = stageWeight[stage];
+		const double strength = forces.wells.active() ? forces.wells.strength : 0.0;
+		for (size_t i = 0; i < count; ++i) {
+			const double wind = forces.field ? forces.windScale[i] : 0.0;
+			const double force = forces.field ? forces.forceScale[i] : 0.0;
+			const double wx = forces.field ? t.wx[i] : 0.0;
+			const double wy = forces.field ? t.wy[i] : 0.0;
+			const double wz = forces.field ? t.wz[i] : 0.0;
+			const double gx = strength != 0.0 ? strength * t.gx[i] : 0.0;
+			const double gy = strength != 0.0 ? strength * t.gy[i] : 0.0;
+			const double gz = strength != 0.0 ? strength * t.gz[i] : 0.0;
+			double ax, ay, az;
+			dragAcceleration(t.ux[i] - wind * wx, t.uy[i] - wind * wy, t.uz[i] - wind * wz,
+				linear[i], quadratic[i], gravity[i], ax, ay, az);
+			t.ax[i] = ax + force * wx + gx;
+			t.ay[i] = ay + force * wy + gy;
+			t.az[i] = az + force * wz + gz;
+
+			if (stage == 0) {
+				t.sumVx[i] = t.ux[i]; t.sumVy[i] = t.uy[i]; t.sumVz[i] = t.uz[i];
+				t.sumAx[i] = t.ax[i]; t.sumAy[i] = t.ay[i]; t.sumAz[i] = t.az[i];
+			}
+			else {
+				t.sumVx[i] += weight * t.ux[i]; t.sumVy[i] += weight * t.uy[i]; t.sumVz[i] += weight * t.uz[i];
+				t.sumAx[i] += weight * t.ax[i]; t.sumAy[i] += weight * t.ay[i]; t.sumAz[i] += weight * t.az[i];
+			}
+		}
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		const double sixthH = stepSeconds[i] / 6.0;
+		s.px[i] += sixthH * t.sumVx[i]; s.py[i] += sixthH * t.sumVy[i]; s.pz[i] += sixthH * t.sumVz[i];
+		s.vx[i] += sixthH * t.sumAx[i]; s.vy[i] += sixthH * t.sumAy[i]; s.vz[i] += sixthH * t.sumAz[i];
+	}
+}
+
+SpatialForces makeSpatialForces(const FieldSettings& field, const GravityWellSettings& wells, const std::vector<double>& mass)
+{
+	SpatialForces lanes;
+	lanes.wells = wells;
+	if (!field.active()) {
+		return lanes;
+	}
+
+	lanes.field = field.field;
+	lanes.windScale.assign(mass.size(), 0.0);
+	lanes.forceScale.assign(mass.size(), 0.0);
+	for (size_t i = 0; i < mass.size(); ++i) {
+		if (field.kind == FieldKind::WIND) {
+			lanes.windScale[i] = field.scale;
+		}
+		else {
+			lanes.forceScale[i] = field.scale / mass[i];
+		}
+	}
+	return lanes;
+}
+
+// Cubic Hermite interpolation across one step, s in [0, 1]
+inline double hermite(double p0, double v0, double p1, double v1, double h, double s)
+{
+	double s2 = s * s;
+	double s3 = s2 * s;
+	return (2.0 * s3 - 3.0 * s2 + 1.0) * p0 + (s3 - 2.0 * s2 + s) * h * v0
+		+ (-2.0 * s3 + 3.0 * s2) * p1 + (s3 - s2) * h * v1;
+}
+
+inline Vec3 hermite(const Vec3& p0, const Vec3& v0, const Vec3& p1, const Vec3& v1, double h, double s)
+{
+	return Vec3(
+		hermite(p0.x, v0.x, p1.x, v1.x, h, s),
+		hermite(p0.y, v0.y, p1.y, v1.y, h, s),
+		hermite(p0.z, v0.z, p1.z, v1.z, h, s));
+}
+
+// Fraction of the step where the interpolated height crosses 'height' going down
+double findDescendingCrossing(double p0, double v0, double p1, double v1, double h, double height)
+{
+	double lo = 0.0;
+	double hi = 1.0;
+	for (int i = 0; i < 48; ++i) {
+		double mid = 0.5 * (lo + hi);
+		if (hermite(p0, v0, p1, v1, h, mid) >= height) {
+			lo = mid;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	return 0.5 * (lo + hi);
+}
+
+// Looks along the sample's own velocity; 'yaw' carries the heading from sample to sample so a
+// field or well that turns the flight turns the camera with it, without wrapping
+void appendSample(TrajectorySamples& samples, double frame, const Vec3& position, const Vec3& velocity, double& yaw)
+{
+	Euler rotation = lookAlongVelocity(velocity, yaw);
+	yaw = rotation.y;
+
+	samples.frames.push_back(frame);
+	samples.translateX.push_back(position.x);
+	samples.translateY.push_back(position.y);
+	samples.translateZ.push_back(position.z);
+	samples.rotateX.push_back(rotation.x);
+	samples.rotateY.push_back(rotation.y);
+}
+
+}
+
+void integrateFlights(const std::vector<LaunchParams>& launches, const std::vector<DragParams>& drag,
+	const IntegratorSettings& settings, std::vector<FlightEvents>& events,
+	std::vector<TrajectorySamples>* samples)
+{
+	const size_t count = launches.size();
+	events.assign(count, FlightEvents());
+	if (samples) {
+		samples->assign(count, TrajectorySamples());
+	}
+	if (count == 0 || drag.empty() || settings.frameStep <= 0.0 || settings.substeps <= 0) {
+		return;
+	}
+
+	const double PI = std::atan(1.0) * 4;
+	const int substeps = settings.substeps;
+
+	LaneArrays state;
+	state.resize(count);
+	std::vector<double> linear(count), quadratic(count), gravity(count), stepSeconds(count), yaw(count), frameLimit(count), landingHeight(count), endTime(count), masses(count);
+	std::vector<char> apexFound(count), canLand(count), active(count, 1);
+
+	for (size_t i = 0; i < count; ++i) {
+		const LaunchParams& params = launches[i];
+		const DragParams& d = drag[drag.size() == 1 ? 0 : i];
+		double mass = (d.mass > 0.0) ? d.mass : 1.0;
+
+		state.px[i] = params.startPosition.x;
+		state.py[i] = params.startPosition.y;
+		state.pz[i] = params.startPosition.z;
+		state.vx[i] = params.velocity.x;
+		state.vy[i] = params.velocity.y;
+		state.vz[i] = params.velocity.z;
+
+		masses[i] = mass;
+		linear[i] = d.linear / mass;
+		quadratic[i] = d.quadratic / mass;
+		gravity[i] = params.gravity;
+		stepSeconds[i] = params.secondsPerFrame() * settings.frameStep / substeps;
+
+		Vec3 direction = params.velocity.normal();
+		yaw[i] = std::atan2(direction.x, direction.z) + PI;
+
+		// Same rule as landingTime: a launch that cannot come back down runs for 120 frames
+		landingHeight[i] = settings.useLandingHeight ? settings.landingHeight : params.startPosition.y;
+		endTime[i] = params.flightTime;
+		canLand[i] = params.gravity < 0.0 && (params.velocity.y > 0.0 || landingHeight[i] < params.startPosition.y);
+		frameLimit[i] = canLand[i] ? (double)settings.maxFrames : std::min(120.0, (double)settings.maxFrames);
+		if (endTime[i] > 0.0) {
+			canLand[i] = 0;
+			frameLimit[i] = (double)settings.maxFrames;
+		}
+
+		apexFound[i] = (params.velocity.y <= 0.0);
+		events[i].apexTime = 0.0;
+		events[i].apexPosition = params.startPosition;
+
+		if (samples) {
+			appendSample((*samples)[i], params.startFrame, params.startPosition, params.velocity, yaw[i]);
+		}
+	}
+
+	const SpatialForces forces = makeSpatialForces(settings.field, settings.wells, masses);
+	SpatialStages stages;
+
+	LaneArrays previous;
+	size_t activeCount = count;
+	long long stepIndex = 0;
+
+	while (activeCount > 0) {
+		for (int sub = 0; sub < substeps && activeCount > 0; ++sub) {
+			previous = state;
+			if (forces.active()) {
+				rk4SpatialStep(state, linear, quadratic, gravity, stepSeconds, forces, stages);
+			}
+			else {
+				rk4Step(state, linear, quadratic, gravity, stepSeconds);
+			}
+			++stepIndex;
+
+			// Event detection is branchy, so it runs as a separate scalar pass
+			for (size_t i = 0; i < count; ++i) {
+				if (!active[i]) continue;
+
+				const double h = stepSeconds[i];
+				const double t0 = (double)(stepIndex - 1) * h;
+				Vec3 p0(previous.px[i], previous.py[i], previous.pz[i]);
+				Vec3 v0(previous.vx[i], previous.vy[i], previous.vz[i]);
+				Vec3 p1(state.px[i], state.py[i], state.pz[i]);
+				Vec3 v1(state.vx[i], state.vy[i], state.vz[i]);
+
+				if (!apexFound[i] && v0.y > 0.0 && v1.y <= 0.0) {
+					double s = v0.y / (v0.y - v1.y);
+					events[i].apexTime = t0 + s * h;
+					events[i].apexPosition = hermite(p0, v0, p1, v1, h, s);
+					apexFound[i] = 1;
+				}
+
+				const double height = landingHeight[i];
+				bool reachedEndTime = endTime[i] > 0.0 && t0 + h >= endTime[i];
+				if (reachedEndTime || (canLand[i] && apexFound[i] && p0.y >= height && p1.y < height)) {
+					double s = reachedEndTime
+						? (endTime[i] - t0) / h
+						: findDescendingCrossing(p0.y, v0.y, p1.y, v1.y, h, height);
+					Vec3 landingPosition = hermite(p0, v0, p1, v1, h, s);
+					if (!reachedEndTime) {
+						landingPosition.y = height;
+					}
+
+					events[i].landed = true;
+					events[i].landingTime = t0 + s * h;
+					events[i].landingPosition = landingPosition;
+
+					if (samples) {
+						Vec3 landingVelocity = v0 + (v1 - v0) * s;
+						double frame = launches[i].startFrame + events[i].landingTime * launches[i].framesPerSecond;
+						appendSample((*samples)[i], frame, landingPosition, landingVelocity, yaw[i]);
+					}
+
+					active[i] = 0;
+					--activeCount;
+				}
+			}
+		}
+
+		// Record the sample at the end of this frame step, or cut the flight off at its limit
+		double elapsedFrames = (double)(stepIndex / substeps) * settings.frameStep;
+		for (size_t i = 0; i < count; ++i) {
+			if (!active[i]) continue;
+
+			Vec3 position(state.px[i], state.py[i], state.pz[i]);
+			Vec3 velocity(state.vx[i], state.vy[i], state.vz[i]);
+
+			if (samples) {
+				appendSample((*samples)[i], launches[i].startFrame + elapsedFrames, position, velocity, yaw[i]);
+			}
+
+			if (elapsedFrames >= frameLimit[i]) {
+				events[i].landed = false;
+				events[i].landingTime = elapsedFrames * launches[i].secondsPerFrame();
+				events[i].landingPosition = position;
+				active[i] = 0;
+				--activeCount;
+			}
+		}
+	}
+}
+
+void integrateState(Vec3& position, Vec3& velocity, const DragParams& drag, double gravity,
+	double seconds, int steps, const FieldSettings& field, const GravityWellSettings& wells)
+{
+	if (steps <= 0) {
+		return;
+	}
+
+	double mass = (drag.mass > 0.0) ? drag.mass : 1.0;
+	std::vector<double> linear(1, drag.linear / mass);
+	std::vector<double> quadratic(1, drag.quadratic / mass);
+	std::vector<double> gravityLane(1, gravity);
+	std::vector<double> stepSeconds(1, seconds / steps);
+	const SpatialForces forces = makeSpatialForces(field, wells, std::vector<double>(1, mass));
+	SpatialStages stages;
+
+	LaneArrays state;
+	state.resize(1);
+	state.px[0] = position.x; state.py[0] = position.y; state.pz[0] = position.z;
+	state.vx[0] = velocity.x; state.vy[0] = velocity.y; state.vz[0] = velocity.z;
+
+	for (int i = 0; i < steps; ++i) {
+		if (forces.active()) {
+			rk4SpatialStep(state, linear, quadratic, gravityLane, stepSeconds, forces, stages);
+		}
+		else {
+			rk4Step(state, linear, quadratic, gravityLane, stepSeconds);
+		}
+	}
+
+	position = Vec3(state.px[0], state.py[0], state.pz[0]);
+	velocity = Vec3(state.vx[0], state.vy[0], state.vz[0]);
+}
+
+FlightEvents integrateFlight(const LaunchParams& params, const DragParams& drag,
+	const IntegratorSettings& settings, TrajectorySamples* samples)
+{
+	std::vector<FlightEvents> events;
+	std::vector<TrajectorySamples> laneSamples;
+
+	integrateFlights(std::vector<LaunchParams>(1, params), std::vector<DragParams>(1, drag),
+		settings, events, samples ? &laneSamples : nullptr);
+
+	if (samples && !laneSamples.empty()) {
+		*samples = std::move(laneSamples[0]);
+	}
+
+	return events.empty() ? FlightEvents() : events[0];
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include "GravityWells.h"
+#include "TrajectoryCore.h"
+#include "TrajectorySampler.h"
+#include "VectorField.h"
+
+namespace LaunchCore {
+
+// Aerodynamic drag: F = -linear * v - quadratic * |v| * v
+struct DragParams {
+	double linear = 0.0;
+	double quadratic = 0.0;
+	double mass = 1.0;
+
+	bool enabled() const { return linear != 0.0 || quadratic != 0.0; }
+};
+
+struct IntegratorSettings {
+	// Frames between recorded samples
+	double frameStep = 1.0;
+	// RK4 steps taken per recorded sample
+	int substeps = 4;
+	// Hard stop for launches that never come back down
+	int maxFrames = 100000;
+	// Land when coming down through 'landingHeight' instead of the launch height
+	bool useLandingHeight = false;
+	double landingHeight = 0.0;
+	// Wind or force field applied along the whole flight
+	FieldSettings field;
+	// Point masses pulling on the flight on top of the uniform gravity
+	GravityWellSettings wells;
+};
+
+// Apex and landing found numerically along an integrated flight. Times are seconds after launch.
+struct FlightEvents {
+	double apexTime = 0.0;
+	Vec3 apexPosition;
+	// False when the camera never comes back down to the landing height and the flight was cut off
+	bool landed = false;
+	double landingTime = 0.0;
+	Vec3 landingPosition;
+};
+
+// Integrates every launch side by side with fixed-step RK4. State is kept as one array per
+// component across launches so each step is a flat loop over lanes. 'drag' holds either one
+// entry shared by all launches or one entry per launch. When 'samples' is given it receives
+// one TrajectorySamples per launch, with a final sample at the (sub-frame) landing time.
+// Launches with a flightTime set end exactly at that time instead of at a landing height.
+void integrateFlights(const std::vector<LaunchParams>& launches, const std::vector<DragParams>& drag,
+	const IntegratorSettings& settings, std::vector<FlightEvents>& events,
+	std::vector<TrajectorySamples>* samples = nullptr);
+
+// Advances one state by 'seconds' using 'steps' RK4 steps, without any landing checks
+void integrateState(Vec3& position, Vec3& velocity, const DragParams& drag, double gravity,
+	double seconds, int steps, const FieldSettings& field = FieldSettings(),
+	const GravityWellSettings& wells = GravityWellSettings());
+
+// Single launch convenience wrapper around integrateFlights
+FlightEvents integrateFlight(const LaunchParams& params, const DragParams& drag,
+	const IntegratorSettings& settings, TrajectorySamples* samples = nullptr);
+
+}
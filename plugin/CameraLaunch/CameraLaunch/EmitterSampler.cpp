@@ -0,0 +1,67 @@
+#include "EmitterSampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace LaunchCore {
+
+namespace {
+
+const double kTwoPi = 6.28318530717958647692;
+
+// splitmix64 finaliser: a bijection that spreads every input bit over the whole output
+inline uint64_t mix(uint64_t z)
+{
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+}
+
+uint64_t counterRandom(uint64_t seed, uint64_t counter, uint32_t stream)
+{
+	// Each word goes through its own round, so neighbouring counters and seeds decorrelate
+	uint64_t z = mix(seed + 0x9e3779b97f4a7c15ull);
+	z = mix(z ^ (counter * 0x9e3779b97f4a7c15ull + 0x632be59bd9b4e019ull));
+	return mix(z ^ ((uint64_t)stream * 0xd1b54a32d192ed03ull + 0x8cb92ba72f3d8dd7ull));
+}
+
+double counterUniform(uint64_t seed, uint64_t counter, uint32_t stream)
+{
+	// Top 53 bits, so the result is exact in a double and never reaches 1
+	return (double)(counterRandom(seed, counter, stream) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+Vec3 sampleEmitterVelocity(const EmitterSettings& settings, uint64_t index)
+{
+	Vec3 axis = settings.direction.normal();
+	if (axis.length() == 0.0) {
+		axis = Vec3(0.0, 1.0, 0.0);
+	}
+
+	// Uniform over the spherical cap: cos(theta) is uniform between cos(coneAngle) and 1
+	double cone = std::min(std::max(settings.coneAngle, 0.0), kTwoPi * 0.5);
+	double cosTheta = 1.0 - counterUniform(settings.seed, index, 0) * (1.0 - std::cos(cone));
+	double sinTheta = std::sqrt(std::max(0.0, 1.0 - cosTheta * cosTheta));
+	double phi = kTwoPi * counterUniform(settings.seed, index, 1);
+
+	// Any basis perpendicular to the axis; built from the least aligned world axis
+	Vec3 helper = (std::fabs(axis.x) < 0.9) ? Vec3(1.0, 0.0, 0.0) : Vec3(0.0, 1.0, 0.0);
+	Vec3 u = axis.cross(helper).normal();
+	Vec3 v = axis.cross(u);
+	Vec3 direction = axis * cosTheta + (u * std::cos(phi) + v * std::sin(phi)) * sinTheta;
+
+	double speed = settings.minSpeed + (settings.maxSpeed - settings.minSpeed) * counterUniform(settings.seed, index, 2);
+	return direction * speed;
+}
+
+void sampleEmitterVelocities(const EmitterSettings& settings, uint64_t firstIndex, size_t count, std::vector<Vec3>& velocities)
+{
+	velocities.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		velocities[i] = sampleEmitterVelocity(settings, firstIndex + i);
+	}
+}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+// Spread of launch velocities for an emitter: directions uniform over a cone around
+// 'direction', speeds uniform between minSpeed and maxSpeed
+struct EmitterSettings {
+	Vec3 direction = Vec3(0.0, 1.0, 0.0);
+	// Half angle of the cone, in radians. Zero launches everything along 'direction'.
+	double coneAngle = 0.0;
+	double minSpeed = 1.0;
+	double maxSpeed = 1.0;
+	uint64_t seed = 0;
+};
+
+// Counter-based random numbers: the value depends only on (seed, counter, stream), never on
+// what was drawn before, so any object can be sampled on any thread in any order
+uint64_t counterRandom(uint64_t seed, uint64_t counter, uint32_t stream);
+// Uniform in [0, 1)
+double counterUniform(uint64_t seed, uint64_t counter, uint32_t stream);
+
+// Launch velocity of emitted object 'index'
+Vec3 sampleEmitterVelocity(const EmitterSettings& settings, uint64_t index);
+// Velocities for objects firstIndex .. firstIndex + count - 1
+void sampleEmitterVelocities(const EmitterSettings& settings, uint64_t firstIndex, size_t count, std::vector<Vec3>& velocities);
+
+}
@@ -0,0 +1,221 @@
+#include "FlightBake.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace LaunchCore {
+
+namespace {
+
+bool checkpoint(JobControl* control, double fraction)
+{
+	if (!control) {
+		return true;
+	}
+
+	control->setProgress(fraction);
+	return !control->cancelled();
+}
+
+// Clears 'flight' for a new bake of 'request'
+void resetFlight(const BakeRequest& request, BakedFlight& flight)
+{
+	flight.samples = TrajectorySamples();
+	flight.orientation = OrientationSamples();
+	flight.hit = CollisionHit();
+	flight.cache.reset();
+	flight.cacheError.clear();
+	flight.oriented = request.orient;
+}
+
+// Maps the flight when an up-to-date cache exists. Otherwise leaves 'cachePath' and 'cacheKey' set
+// for the cache to be written, or 'cachePath' empty when this flight is not cached.
+bool mapCachedFlight(const BakeRequest& request, BakedFlight& flight, std::string& cachePath, uint64_t& cacheKey,
+	ProfileRecord* profile)
+{
+	cachePath.clear();
+	cacheKey = 0;
+	if (request.cacheDirectory.empty() || request.options.collision) {
+		return false;
+	}
+
+	ScopedPhase phase(profile, "generateKeyframes/readCache");
+	CacheKey key = flightCacheKey(request.params, request.startMatrix, request.options);
+	if (request.orient) {
+		addOrientationToKey(key, request.orientation);
+	}
+
+	cacheKey = key.value();
+	cachePath = request.cacheDirectory + "/" + key.fileName();
+
+	std::unique_ptr<MappedTrajectoryCache> cache(new MappedTrajectoryCache());
+	if (cache->open(cachePath) && cache->key() == cacheKey && cache->trajectory().count > 0) {
+		flight.cache = std::move(cache);
+		return true;
+	}
+	return false;
+}
+
+void orientFlight(const BakeRequest& request, BakedFlight& flight, ProfileRecord* profile)
+{
+	if (request.orient && flight.samples.size() > 0) {
+		ScopedPhase phase(profile, "generateKeyframes/solveOrientations");
+		solveOrientations(flight.samples, request.orientation, flight.orientation);
+	}
+}
+
+void writeCachedFlight(const BakeRequest& request, BakedFlight& flight, const std::string& cachePath, uint64_t cacheKey,
+	ProfileRecord* profile)
+{
+	if (!cachePath.empty() && flight.samples.size() > 0) {
+		ScopedPhase phase(profile, "generateKeyframes/writeCache");
+		writeTrajectoryCache(cachePath, cacheKey, request.params.framesPerSecond, flight.trajectory(), &flight.cacheError);
+	}
+}
+
+// Flights sampleFlight would integrate, without collision geometry, so nothing but the
+// integrator shapes them
+bool integratesInLanes(const FlightOptions& options)
+{
+	bool integrated = options.drag.enabled() || options.field.active() || options.wells.active();
+	return integrated && !options.collision;
+}
+
+// Whether two such flights can share one integrateFlights call; drag may differ per lane
+bool sameIntegration(const FlightOptions& a, const FlightOptions& b)
+{
+	return a.frameStep == b.frameStep
+		&& a.field.field == b.field.field && a.field.kind == b.field.kind && a.field.scale == b.field.scale
+		&& a.wells.attractors == b.wells.attractors && a.wells.strength == b.wells.strength
+		&& a.wells.softening == b.wells.softening && a.wells.theta == b.wells.theta;
+}
+
+}
+
+TrajectoryView BakedFlight::trajectory() const
+{
+	if (cache && cache->isOpen()) {
+		return cache->trajectory();
+	}
+	return viewTrajectory(samples, oriented ? &orientation : nullptr);
+}
+
+bool bakeFlight(const BakeRequest& request, BakedFlight& flight, JobControl* control, ProfileRecord* profile)
+{
+	resetFlight(request, flight);
+	if (!checkpoint(control, 0.0)) {
+		return false;
+	}
+
+	// A flight already baked with the same inputs is mapped straight from the cache
+	std::string cachePath;
+	uint64_t cacheKey = 0;
+	if (mapCachedFlight(request, flight, cachePath, cacheKey, profile)) {
+		return checkpoint(control, 1.0);
+	}
+
+	{
+		ScopedPhase phase(profile, "generateKeyframes/sampleFlight");
+		sampleFlight(request.params, request.options, flight.samples, &flight.hit);
+	}
+	if (flight.samples.size() == 0) {
+		return true;
+	}
+	if (!checkpoint(control, 0.6)) {
+		return false;
+	}
+
+	orientFlight(request, flight, profile);
+	if (request.orient && !checkpoint(control, 0.9)) {
+		return false;
+	}
+
+	writeCachedFlight(request, flight, cachePath, cacheKey, profile);
+	return checkpoint(control, 1.0);
+}
+
+void bakeFlights(const std::vector<BakeRequest>& requests, std::vector<BakedFlight>& flights, ThreadPool* pool)
+{
+	const size_t count = requests.size();
+	flights.clear();
+	flights.resize(count);
+
+	std::vector<std::string> cachePaths(count);
+	std::vector<uint64_t> cacheKeys(count, 0);
+	std::vector<size_t> lanes;
+	std::vector<size_t> singles;
+
+	for (size_t i = 0; i < count; ++i) {
+		resetFlight(requests[i], flights[i]);
+		if (mapCachedFlight(requests[i], flights[i], cachePaths[i], cacheKeys[i], nullptr)) {
+			continue;
+		}
+
+		bool joinsLanes = integratesInLanes(requests[i].options)
+			&& (lanes.empty() || sameIntegration(requests[lanes.front()].options, requests[i].options));
+		(joinsLanes ? lanes : singles).push_back(i);
+	}
+
+	// A lone integrated flight gains nothing from lanes
+	if (lanes.size() == 1) {
+		singles.push_back(lanes.front());
+		lanes.clear();
+	}
+
+	// Each task writes only the flights it was given
+	std::vector<std::function<void()>> tasks;
+
+	size_t groups = pool ? std::min(std::max(pool->threadCount(), (size_t)1), lanes.size()) : (lanes.empty() ? 0 : 1);
+	for (size_t group = 0; group < groups; ++group) {
+		size_t begin = lanes.size() * group / groups;
+		size_t end = lanes.size() * (group + 1) / groups;
+		std::vector<size_t> indices(lanes.begin() + begin, lanes.begin() + end);
+
+		tasks.push_back([&requests, &flights, &cachePaths, &cacheKeys, indices] {
+			const FlightOptions& options = requests[indices.front()].options;
+			IntegratorSettings settings;
+			settings.frameStep = options.frameStep;
+			settings.field = options.field;
+			settings.wells = options.wells;
+
+			std::vector<LaunchParams> launches;
+			std::vector<DragParams> drag;
+			for (size_t i : indices) {
+				launches.push_back(requests[i].params);
+				drag.push_back(requests[i].options.drag);
+			}
+
+			std::vector<FlightEvents> events;
+			std::vector<TrajectorySamples> samples;
+			integrateFlights(launches, drag, settings, events, &samples);
+
+			for (size_t lane = 0; lane < indices.size(); ++lane) {
+				size_t i = indices[lane];
+				flights[i].samples = std::move(samples[lane]);
+				orientFlight(requests[i], flights[i], nullptr);
+				writeCachedFlight(requests[i], flights[i], cachePaths[i], cacheKeys[i], nullptr);
+			}
+		});
+	}
+
+	for (size_t i : singles) {
+		tasks.push_back([&requests, &flights, &cachePaths, &cacheKeys, i] {
+			sampleFlight(requests[i].params, requests[i].options, flights[i].samples, &flights[i].hit);
+			orientFlight(requests[i], flights[i], nullptr);
+			writeCachedFlight(requests[i], flights[i], cachePaths[i], cacheKeys[i], nullptr);
+		});
+	}
+
+	if (!pool) {
+		for (const std::function<void()>& task : tasks) {
+			task();
+		}
+		return;
+	}
+	for (const std::function<void()>& task : tasks) {
+		pool->submit(task);
+	}
+	pool->wait();
+}
+
+}
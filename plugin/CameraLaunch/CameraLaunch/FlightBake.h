@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ComputeQueue.h"
+#include "FlightPath.h"
+#include "LaunchProfiler.h"
+#include "OrientationSolver.h"
+#include "ThreadPool.h"
+#include "TrajectoryCache.h"
+
+namespace LaunchCore {
+
+// Everything a baked flight depends on, gathered from the scene up front so the bake itself
+// can run away from it
+struct BakeRequest {
+	LaunchParams params;
+	FlightOptions options;
+	// Solve a per-sample orientation along the path instead of the look-along pitch and yaw
+	bool orient = false;
+	OrientationSettings orientation;
+	// World matrix of the camera at launch, row-major; part of the cache key
+	double startMatrix[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+	// Directory of trajectory caches, empty to always sample. Flights against collision
+	// geometry are never cached.
+	std::string cacheDirectory;
+};
+
+// Result of baking one flight, either sampled here or mapped from the cache
+struct BakedFlight {
+	TrajectorySamples samples;
+	// Only filled in when the request orients the flight
+	OrientationSamples orientation;
+	bool oriented = false;
+	CollisionHit hit;
+	std::unique_ptr<MappedTrajectoryCache> cache;
+	// Set when the sampled flight could not be written to the cache
+	std::string cacheError;
+
+	// Channels to key, valid as long as this flight is
+	TrajectoryView trajectory() const;
+};
+
+// Maps the flight from the cache when an up-to-date one exists, and otherwise samples it, solves
+// the orientation and writes the cache. Progress is reported to 'control', which is checked for
+// cancellation between steps; a cancelled bake returns false and leaves 'flight' incomplete.
+bool bakeFlight(const BakeRequest& request, BakedFlight& flight, JobControl* control = nullptr,
+	ProfileRecord* profile = nullptr);
+
+// Bakes every request into the flight of the same index. Cached flights are mapped; drag, field
+// and gravity well flights without collision geometry that share their integration settings go
+// through integrateFlights together, their lanes split across 'pool'; the rest are baked one by
+// one like bakeFlight. Runs on the calling thread when 'pool' is null.
+void bakeFlights(const std::vector<BakeRequest>& requests, std::vector<BakedFlight>& flights, ThreadPool* pool = nullptr);
+
+}
@@ -0,0 +1,46 @@
+#include "FlightMetrics.h"
+
+namespace LaunchCore {
+
+FlightMetrics computeFlightMetrics(const LaunchParams& params)
+{
+	// Landing at the exact touchdown (2 vy / |g| back at launch height), as calculateParabolicKeys keys it
+	const double flightTime = landingTime(params);
+
+	FlightMetrics metrics;
+	metrics.flightFrames = flightTime * params.framesPerSecond;
+	metrics.landingFrame = params.startFrame + metrics.flightFrames;
+	metrics.landingPosition = positionAtTime(params, flightTime);
+
+	double apexTime = (params.gravity < 0.0) ? timeToApex(params) : -1.0;
+	if (!(apexTime > 0.0 && apexTime < flightTime)) {
+		apexTime = (metrics.landingPosition.y > params.startPosition.y) ? flightTime : 0.0;
+	}
+	metrics.apexFrame = params.startFrame + apexTime * params.framesPerSecond;
+	metrics.apexPosition = positionAtTime(params, apexTime);
+
+	return metrics;
+}
+
+void computeFlightMetrics(const std::vector<LaunchParams>& params, std::vector<FlightMetrics>& metrics)
+{
+	metrics.resize(params.size());
+	for (size_t i = 0; i < params.size(); ++i) {
+		metrics[i] = computeFlightMetrics(params[i]);
+	}
+}
+
+void packFlightMetrics(const FlightMetrics& metrics, double* out)
+{
+	out[0] = metrics.apexFrame;
+	out[1] = metrics.apexPosition.x;
+	out[2] = metrics.apexPosition.y;
+	out[3] = metrics.apexPosition.z;
+	out[4] = metrics.flightFrames;
+	out[5] = metrics.landingFrame;
+	out[6] = metrics.landingPosition.x;
+	out[7] = metrics.landingPosition.y;
+	out[8] = metrics.landingPosition.z;
+}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+// Summary of a closed-form flight as the three-key launch keys it
+struct FlightMetrics {
+	// Exact frame of the highest point; the start or landing frame when the arc never peaks in between
+	double apexFrame = 0.0;
+	Vec3 apexPosition;
+	// Frames from launch to the exact touchdown, not rounded to a whole frame
+	double flightFrames = 0.0;
+	double landingFrame = 0.0;
+	Vec3 landingPosition;
+};
+
+// Values per flight in packFlightMetrics: apexFrame, apex x/y/z, flightFrames, landingFrame, landing x/y/z
+const size_t FLIGHT_METRIC_VALUES = 9;
+
+FlightMetrics computeFlightMetrics(const LaunchParams& params);
+
+// One result per launch, in order
+void computeFlightMetrics(const std::vector<LaunchParams>& params, std::vector<FlightMetrics>& metrics);
+
+// Writes FLIGHT_METRIC_VALUES doubles to 'out'
+void packFlightMetrics(const FlightMetrics& metrics, double* out);
+
+}
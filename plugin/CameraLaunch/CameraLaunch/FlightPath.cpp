@@ -0,0 +1,74 @@
+#include "FlightPath.h"
+
+#include <algorithm>
+
+namespace LaunchCore {
+
+void sampleFlight(const LaunchParams& params, const FlightOptions& options, TrajectorySamples& samples,
+	CollisionHit* hit)
+{
+	bool colliding = options.collision && !options.collision->empty();
+
+	// Anything below the geometry can never be hit, so that is as far as the search needs to go
+	double floorHeight = params.startPosition.y;
+	if (colliding) {
+		floorHeight = std::min(floorHeight, options.collision->boundsMin().y);
+	}
+
+	bool integrated = options.drag.enabled() || options.field.active() || options.wells.active();
+
+	if (options.bounces.bounces > 0 && !integrated) {
+		std::vector<FlightSegment> segments;
+		chainBounces(params, options.bounces, colliding ? options.collision : nullptr, options.frameStep, segments);
+		sampleBounces(params, segments, options.frameStep, samples);
+
+		if (hit) {
+			*hit = CollisionHit();
+			const FlightSegment& first = segments.front();
+			if (colliding && first.contact && samples.size() > 1) {
+				double frame = params.startFrame + first.duration * params.framesPerSecond;
+				size_t contact = std::lower_bound(samples.frames.begin(), samples.frames.end(), frame - 1e-9) - samples.frames.begin();
+				hit->hit = true;
+				hit->segment = (contact > 0) ? contact - 1 : 0;
+				hit->fraction = 1.0;
+				hit->frame = frame;
+				hit->position = first.endPosition;
+				hit->normal = first.contactNormal;
+			}
+		}
+		return;
+	}
+
+	if (integrated) {
+		IntegratorSettings settings;
+		settings.frameStep = options.frameStep;
+		settings.field = options.field;
+		settings.wells = options.wells;
+		settings.useLandingHeight = colliding;
+		settings.landingHeight = floorHeight;
+		integrateFlight(params, options.drag, settings, &samples);
+	}
+	else {
+		// A fixed flight time ends exactly on its (possibly sub-frame) end point
+		double totalFrames = calculateFlightFrames(params);
+		if (colliding && params.flightTime <= 0.0) {
+			double fallTime = timeToHeight(params, floorHeight);
+			if (fallTime > 0.0) {
+				totalFrames = std::max(totalFrames, std::ceil(fallTime * params.framesPerSecond));
+			}
+		}
+		sampleTrajectory(params, options.frameStep, totalFrames, samples);
+	}
+
+	CollisionHit firstHit;
+	if (colliding) {
+		firstHit = findFirstHit(samples, *options.collision);
+		truncateAtHit(samples, firstHit);
+	}
+
+	if (hit) {
+		*hit = firstHit;
+	}
+}
+
+}
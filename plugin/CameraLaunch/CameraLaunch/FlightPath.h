@@ -0,0 +1,32 @@
+#pragma once
+
+#include "BounceChain.h"
+#include "CollisionSweep.h"
+#include "DragIntegrator.h"
+#include "TrajectorySampler.h"
+#include "TriangleBVH.h"
+
+namespace LaunchCore {
+
+// Everything that shapes a sampled flight beyond the basic launch parameters
+struct FlightOptions {
+	DragParams drag;
+	double frameStep = 1.0;
+	// Geometry the flight ends on, or null to land at launch height
+	const TriangleBVH* collision = nullptr;
+	// Bounces off the floor or the collision geometry; ignored with drag, a field or gravity wells
+	BounceSettings bounces;
+	// Wind or force field; integrated like drag
+	FieldSettings field;
+	// Point masses pulling on the camera; integrated like drag
+	GravityWellSettings wells;
+};
+
+// Samples a flight from launch to landing, using the closed form when there is no drag, field
+// or gravity well and the RK4 integrator otherwise. With collision geometry the flight is extended down to the
+// bottom of the geometry and cut at the first hit. With bounces the flight carries on past each
+// contact and 'hit' reports the first one.
+void sampleFlight(const LaunchParams& params, const FlightOptions& options, TrajectorySamples& samples,
+	CollisionHit* hit = nullptr);
+
+}
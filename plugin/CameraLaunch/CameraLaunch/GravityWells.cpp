@@ -0,0 +1,234 @@
+#include "GravityWells.h"
+#include "TrajectoryCache.h"
+
+#include <algorithm>
+
+namespace LaunchCore {
+
+namespace {
+
+const uint32_t kLeafSize = 8;
+// Coincident attractors cannot be split apart, so they end up in one leaf at this depth
+const int kMaxDepth = 32;
+
+inline int octant(const Vec3& p, const Vec3& centre)
+{
+	return (p.x >= centre.x ? 1 : 0) | (p.y >= centre.y ? 2 : 0) | (p.z >= centre.z ? 4 : 0);
+}
+
+}
+
+void AttractorTree::build(const std::vector<Attractor>& attractors)
+{
+	clear();
+
+	std::vector<uint32_t> order;
+	order.reserve(attractors.size());
+	Vec3 boundsMin, boundsMax;
+	for (uint32_t i = 0; i < (uint32_t)attractors.size(); ++i) {
+		const Attractor& a = attractors[i];
+		if (!(a.mass > 0.0)) continue;
+
+		const Vec3& p = a.position;
+		if (order.empty()) {
+			boundsMin = boundsMax = p;
+		}
+		boundsMin = Vec3(std::min(boundsMin.x, p.x), std::min(boundsMin.y, p.y), std::min(boundsMin.z, p.z));
+		boundsMax = Vec3(std::max(boundsMax.x, p.x), std::max(boundsMax.y, p.y), std::max(boundsMax.z, p.z));
+		order.push_back(i);
+	}
+	if (order.empty()) {
+		return;
+	}
+
+	// The root is a cube around everything, so every child is half its parent's size
+	Vec3 extent = boundsMax - boundsMin;
+	double halfSize = 0.5 * std::max(extent.x, std::max(extent.y, extent.z));
+	halfSize = std::max(halfSize * (1.0 + 1e-9), 1e-9);
+
+	m_nodes.push_back(Node());
+	buildNode(0, order, attractors, 0, (uint32_t)order.size(), (boundsMin + boundsMax) * 0.5, halfSize, 0);
+
+	m_x.resize(order.size());
+	m_y.resize(order.size());
+	m_z.resize(order.size());
+	m_mass.resize(order.size());
+	for (size_t i = 0; i < order.size(); ++i) {
+		const Attractor& a = attractors[order[i]];
+		m_x[i] = a.position.x;
+		m_y[i] = a.position.y;
+		m_z[i] = a.position.z;
+		m_mass[i] = a.mass;
+	}
+
+	// Hashed in input order, so the same attractors always give the same key
+	CacheKey key;
+	for (const Attractor& a : attractors) {
+		if (!(a.mass > 0.0)) continue;
+		key.add(a.position).add(a.mass);
+	}
+	m_fingerprint = key.value();
+}
+
+void AttractorTree::buildNode(uint32_t nodeIndex, std::vector<uint32_t>& order, const std::vector<Attractor>& attractors,
+	uint32_t first, uint32_t count, const Vec3& centre, double halfSize, int depth)
+{
+	double mass = 0.0;
+	Vec3 weighted;
+	for (uint32_t i = first; i < first + count; ++i) {
+		const Attractor& a = attractors[order[i]];
+		mass += a.mass;
+		weighted = weighted + a.position * a.mass;
+	}
+	Vec3 centreOfMass = weighted * (1.0 / mass);
+
+	{
+		Node& node = m_nodes[nodeIndex];
+		node.centreOfMass[0] = centreOfMass.x;
+		node.centreOfMass[1] = centreOfMass.y;
+		node.centreOfMass[2] = centreOfMass.z;
+		node.mass = mass;
+		node.sizeSquared = 4.0 * halfSize * halfSize;
+		node.offset = first;
+		node.count = count;
+		node.childCount = 0;
+	}
+
+	if (count <= kLeafSize || depth >= kMaxDepth) {
+		return;
+	}
+
+	// Sort this node's attractors by octant so each child gets a contiguous range
+	std::stable_sort(order.begin() + first, order.begin() + first + count, [&](uint32_t a, uint32_t b) {
+		return octant(attractors[a].position, centre) < octant(attractors[b].position, centre);
+	});
+
+	uint32_t childFirst[8];
+	uint32_t childCount[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	for (uint32_t i = first; i < first + count; ++i) {
+		int o = octant(attractors[order[i]].position, centre);
+		if (childCount[o] == 0) {
+			childFirst[o] = i;
+		}
+		++childCount[o];
+	}
+
+	// Children are allocated together before any of them is built
+	uint32_t firstChild = (uint32_t)m_nodes.size();
+	uint32_t children = 0;
+	for (int o = 0; o < 8; ++o) {
+		if (childCount[o] > 0) ++children;
+	}
+	m_nodes.resize(m_nodes.size() + children);
+	m_nodes[nodeIndex].offset = firstChild;
+	m_nodes[nodeIndex].count = 0;
+	m_nodes[nodeIndex].childCount = children;
+
+	const double quarter = 0.5 * halfSize;
+	uint32_t child = firstChild;
+	for (int o = 0; o < 8; ++o) {
+		if (childCount[o] == 0) continue;
+		Vec3 childCentre(
+			centre.x + ((o & 1) ? quarter : -quarter),
+			centre.y + ((o & 2) ? quarter : -quarter),
+			centre.z + ((o & 4) ? quarter : -quarter));
+		buildNode(child++, order, attractors, childFirst[o], childCount[o], childCentre, quarter, depth + 1);
+	}
+}
+
+void AttractorTree::clear()
+{
+	m_nodes.clear();
+	m_x.clear();
+	m_y.clear();
+	m_z.clear();
+	m_mass.clear();
+	m_fingerprint = 0;
+}
+
+void AttractorTree::accelerationAt(double x, double y, double z, double softening, double theta,
+	double& outX, double& outY, double& outZ) const
+{
+	const double softeningSquared = softening * softening;
+	const double thetaSquared = theta * theta;
+	double ax = 0.0, ay = 0.0, az = 0.0;
+
+	uint32_t stack[kMaxDepth * 8 + 8];
+	int top = 0;
+	stack[top++] = 0;
+
+	while (top > 0) {
+		const Node& node = m_nodes[stack[--top]];
+		double dx = node.centreOfMass[0] - x;
+		double dy = node.centreOfMass[1] - y;
+		double dz = node.centreOfMass[2] - z;
+		double distanceSquared = dx * dx + dy * dy + dz * dz;
+
+		if (node.childCount == 0) {
+			for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+				double bx = m_x[i] - x;
+				double by = m_y[i] - y;
+				double bz = m_z[i] - z;
+				double r2 = bx * bx + by * by + bz * bz + softeningSquared;
+				double s = m_mass[i] / (r2 * std::sqrt(r2));
+				ax += s * bx;
+				ay += s * by;
+				az += s * bz;
+			}
+		}
+		else if (node.sizeSquared < thetaSquared * distanceSquared) {
+			double r2 = distanceSquared + softeningSquared;
+			double s = node.mass / (r2 * std::sqrt(r2));
+			ax += s * dx;
+			ay += s * dy;
+			az += s * dz;
+		}
+		else {
+			for (uint32_t c = 0; c < node.childCount; ++c) {
+				stack[top++] = node.offset + c;
+			}
+		}
+	}
+
+	outX = ax;
+	outY = ay;
+	outZ = az;
+}
+
+Vec3 AttractorTree::acceleration(const Vec3& position, double softening, double theta) const
+{
+	Vec3 result;
+	if (!empty()) {
+		accelerationAt(position.x, position.y, position.z, softening, theta, result.x, result.y, result.z);
+	}
+	return result;
+}
+
+void AttractorTree::acceleration(const double* x, const double* y, const double* z, size_t count, double softening, double theta,
+	double* outX, double* outY, double* outZ) const
+{
+	if (empty()) {
+		std::fill(outX, outX + count, 0.0);
+		std::fill(outY, outY + count, 0.0);
+		std::fill(outZ, outZ + count, 0.0);
+		return;
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		accelerationAt(x[i], y[i], z[i], softening, theta, outX[i], outY[i], outZ[i]);
+	}
+}
+
+Vec3 AttractorTree::directAcceleration(const Vec3& position, double softening) const
+{
+	const double softeningSquared = softening * softening;
+	Vec3 result;
+	for (size_t i = 0; i < m_mass.size(); ++i) {
+		Vec3 d(m_x[i] - position.x, m_y[i] - position.y, m_z[i] - position.z);
+		double r2 = d.dot(d) + softeningSquared;
+		result = result + d * (m_mass[i] / (r2 * std::sqrt(r2)));
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+// Point mass the camera is pulled towards
+struct Attractor {
+	Vec3 position;
+	double mass = 0.0;
+
+	Attractor() = default;
+	Attractor(const Vec3& position, double mass) : position(position), mass(mass) {}
+};
+
+// Barnes-Hut octree over a set of attractors. Nodes are stored in one flat array with the
+// children of a node next to each other, and attractors are reordered so every leaf
+// references a contiguous range. A node far enough away is evaluated as one mass at its
+// centre of mass, so each lookup costs O(log N) instead of O(N).
+class AttractorTree
+{
+public:
+	AttractorTree() = default;
+
+	// Attractors without a positive mass are dropped
+	void build(const std::vector<Attractor>& attractors);
+	void clear();
+
+	bool empty() const { return m_nodes.empty(); }
+	size_t attractorCount() const { return m_mass.size(); }
+	size_t nodeCount() const { return m_nodes.size(); }
+
+	// Acceleration towards the attractors divided by the gravitational constant:
+	// sum of m * d / (|d|^2 + softening^2)^1.5. 'theta' is the largest node size to distance
+	// ratio treated as a single mass; zero visits every attractor.
+	Vec3 acceleration(const Vec3& position, double softening, double theta) const;
+	// Evaluates 'count' positions given as one array per component
+	void acceleration(const double* x, const double* y, const double* z, size_t count, double softening, double theta,
+		double* outX, double* outY, double* outZ) const;
+	// Sums every attractor directly, for checking the tree
+	Vec3 directAcceleration(const Vec3& position, double softening) const;
+
+	// Hash of every attractor, for cache keys
+	uint64_t fingerprint() const { return m_fingerprint; }
+
+private:
+	struct Node {
+		double centreOfMass[3];
+		double mass;
+		// Edge length of the node's cube, squared
+		double sizeSquared;
+		// Leaves: first attractor. Interior nodes: first child.
+		uint32_t offset;
+		// Leaves: attractor count. Interior nodes: zero.
+		uint32_t count;
+		uint32_t childCount;
+	};
+
+	std::vector<Node> m_nodes;
+	// Attractors in leaf order, one array per component
+	std::vector<double> m_x, m_y, m_z, m_mass;
+	uint64_t m_fingerprint = 0;
+
+	void buildNode(uint32_t nodeIndex, std::vector<uint32_t>& order, const std::vector<Attractor>& attractors,
+		uint32_t first, uint32_t count, const Vec3& centre, double halfSize, int depth);
+	void accelerationAt(double x, double y, double z, double softening, double theta,
+		double& outX, double& outY, double& outZ) const;
+};
+
+// Gravity wells acting on a flight, on top of the uniform gravity
+struct GravityWellSettings {
+	const AttractorTree* attractors = nullptr;
+	// Gravitational constant; the pull of each attractor is strength * mass / distance^2
+	double strength = 1.0;
+	// Distance added in quadrature so a camera passing through an attractor is not flung away
+	double softening = 0.1;
+	// Barnes-Hut opening angle
+	double theta = 0.5;
+
+	bool active() const { return attractors && !attractors->empty() && strength != 0.0; }
+};
+
+}
@@ -0,0 +1,293 @@
+#include "InverseSolver.h"
+
+#include <algorithm>
+
+namespace LaunchCore {
+
+namespace {
+
+// Solves a x = b for a 3x3 matrix by Cramer's rule
+bool solve3x3(const double a[3][3], const double b[3], double x[3])
+{
+	double det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1])
+		- a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0])
+		+ a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+	if (std::fabs(det) < 1e-300) {
+		return false;
+	}
+
+	for (int column = 0; column < 3; ++column) {
+		double m[3][3];
+		for (int r = 0; r < 3; ++r) {
+			for (int c = 0; c < 3; ++c) {
+				m[r][c] = (c == column) ? b[r] : a[r][c];
+			}
+		}
+		x[column] = (m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+			- m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+			+ m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0])) / det;
+	}
+	return true;
+}
+
+int simulationSteps(double seconds, const TargetSolverSettings& settings)
+{
+	return std::max(1, (int)std::ceil(seconds * settings.framesPerSecond * std::max(1, settings.substeps)));
+}
+
+// Position reached after 'seconds' with drag
+Vec3 simulatePosition(const Vec3& start, const Vec3& velocity, double gravity, const DragParams& drag,
+	double seconds, const TargetSolverSettings& settings)
+{
+	Vec3 position = start;
+	Vec3 v = velocity;
+	integrateState(position, v, drag, gravity, seconds, simulationSteps(seconds, settings), settings.field, settings.wells);
+	return position;
+}
+
+TargetSolution solveFlightTimeWithDrag(const TargetRequest& request, double gravity, const DragParams& drag,
+	const TargetSolverSettings& settings, TargetSolution solution)
+{
+	const double seconds = request.value;
+	Vec3 velocity = solution.velocity;
+	Vec3 residual = simulatePosition(request.start, velocity, gravity, drag, seconds, settings) - request.target;
+
+	for (int iteration = 0; iteration < settings.maxIterations; ++iteration) {
+		if (residual.length() <= settings.tolerance) {
+			break;
+		}
+		solution.iterations = iteration + 1;
+
+		// Jacobian of the end position with respect to the launch velocity, one column per component
+		double jacobian[3][3];
+		double epsilon = 1e-6 * std::max(1.0, velocity.length());
+		for (int column = 0; column < 3; ++column) {
+			Vec3 nudged = velocity;
+			if (column == 0) nudged.x += epsilon;
+			else if (column == 1) nudged.y += epsilon;
+			else nudged.z += epsilon;
+
+			Vec3 d = (simulatePosition(request.start, nudged, gravity, drag, seconds, settings) - request.target - residual) * (1.0 / epsilon);
+			jacobian[0][column] = d.x;
+			jacobian[1][column] = d.y;
+			jacobian[2][column] = d.z;
+		}
+
+		double rhs[3] = { -residual.x, -residual.y, -residual.z };
+		double delta[3];
+		if (!solve3x3(jacobian, rhs, delta)) {
+			break;
+		}
+
+		// Halve the step until it actually brings the end point closer
+		Vec3 step(delta[0], delta[1], delta[2]);
+		double scale = 1.0;
+		for (int halving = 0; halving < 8; ++halving) {
+			Vec3 candidate = velocity + step * scale;
+			Vec3 candidateResidual = simulatePosition(request.start, candidate, gravity, drag, seconds, settings) - request.target;
+			if (candidateResidual.length() < residual.length() || halving == 7) {
+				velocity = candidate;
+				residual = candidateResidual;
+				break;
+			}
+			scale *= 0.5;
+		}
+	}
+
+	solution.velocity = velocity;
+	solution.flightTime = seconds;
+	solution.error = residual.length();
+	solution.solved = solution.error <= settings.tolerance;
+	return solution;
+}
+
+struct ApexResidual {
+	bool valid = false;
+	double apex = 0.0;
+	double distance = 0.0;
+	double landingTime = 0.0;
+	Vec3 landingPosition;
+};
+
+// Integrates one candidate down to the target height and reports the apex height error and
+// the horizontal distance error along 'direction'
+ApexResidual measureApexFlight(const TargetRequest& request, double gravity, const DragParams& drag,
+	const TargetSolverSettings& settings, const Vec3& direction, double distance, double verticalSpeed, double horizontalSpeed)
+{
+	LaunchParams params;
+	params.startPosition = request.start;
+	params.velocity = direction * horizontalSpeed + Vec3(0.0, verticalSpeed, 0.0);
+	params.gravity = gravity;
+	params.framesPerSecond = settings.framesPerSecond;
+
+	IntegratorSettings integrator;
+	integrator.substeps = std::max(1, settings.substeps);
+	integrator.useLandingHeight = true;
+	integrator.landingHeight = request.target.y;
+	integrator.field = settings.field;
+	integrator.wells = settings.wells;
+
+	FlightEvents events = integrateFlight(params, drag, integrator);
+
+	ApexResidual result;
+	result.valid = events.landed;
+	result.apex = events.apexPosition.y - (request.start.y + request.value);
+	result.distance = (events.landingPosition - request.start).dot(direction) - distance;
+	result.landingTime = events.landingTime;
+	result.landingPosition = events.landingPosition;
+	return result;
+}
+
+TargetSolution solveApexHeightWithDrag(const TargetRequest& request, double gravity, const DragParams& drag,
+	const TargetSolverSettings& settings, TargetSolution solution)
+{
+	// Unknowns are the vertical speed and the speed towards the target, which keeps the
+	// launch in the vertical plane through the start and the target
+	Vec3 offset = request.target - request.start;
+	Vec3 direction = Vec3(offset.x, 0.0, offset.z).normal();
+	double distance = std::sqrt(offset.x * offset.x + offset.z * offset.z);
+	bool vertical = distance < 1e-9;
+
+	double verticalSpeed = solution.velocity.y;
+	double horizontalSpeed = vertical ? 0.0 : solution.velocity.dot(direction);
+
+	auto measure = [&](double vy, double vh) {
+		return measureApexFlight(request, gravity, drag, settings, direction, distance, vy, vh);
+	};
+	auto norm = [](const ApexResidual& r) {
+		return r.valid ? std::sqrt(r.apex * r.apex + r.distance * r.distance) : 1e300;
+	};
+
+	ApexResidual residual = measure(verticalSpeed, horizontalSpeed);
+
+	for (int iteration = 0; iteration < settings.maxIterations; ++iteration) {
+		if (!residual.valid || norm(residual) <= settings.tolerance) {
+			break;
+		}
+		solution.iterations = iteration + 1;
+
+		double epsilon = 1e-6 * std::max(1.0, std::fabs(verticalSpeed) + std::fabs(horizontalSpeed));
+		ApexResidual dVertical = measure(verticalSpeed + epsilon, horizontalSpeed);
+		if (!dVertical.valid) {
+			break;
+		}
+
+		double stepVertical = 0.0;
+		double stepHorizontal = 0.0;
+		double a = (dVertical.apex - residual.apex) / epsilon;
+		if (vertical) {
+			if (a == 0.0) break;
+			stepVertical = -residual.apex / a;
+		}
+		else {
+			ApexResidual dHorizontal = measure(verticalSpeed, horizontalSpeed + epsilon);
+			if (!dHorizontal.valid) {
+				break;
+			}
+			double b = (dHorizontal.apex - residual.apex) / epsilon;
+			double c = (dVertical.distance - residual.distance) / epsilon;
+			double d = (dHorizontal.distance - residual.distance) / epsilon;
+			double det = a * d - b * c;
+			if (std::fabs(det) < 1e-300) {
+				break;
+			}
+			stepVertical = (-residual.apex * d + residual.distance * b) / det;
+			stepHorizontal = (-residual.distance * a + residual.apex * c) / det;
+		}
+
+		double scale = 1.0;
+		for (int halving = 0; halving < 8; ++halving) {
+			ApexResidual candidate = measure(verticalSpeed + stepVertical * scale, horizontalSpeed + stepHorizontal * scale);
+			if (norm(candidate) < norm(residual) || halving == 7) {
+				verticalSpeed += stepVertical * scale;
+				horizontalSpeed += stepHorizontal * scale;
+				residual = candidate;
+				break;
+			}
+			scale *= 0.5;
+		}
+	}
+
+	solution.velocity = direction * horizontalSpeed + Vec3(0.0, verticalSpeed, 0.0);
+	solution.flightTime = residual.landingTime;
+	solution.error = residual.valid ? (residual.landingPosition - request.target).length() : -1.0;
+	solution.solved = residual.valid && norm(residual) <= settings.tolerance;
+	return solution;
+}
+
+}
+
+TargetSolution solveTarget(const TargetRequest& request, double gravity)
+{
+	TargetSolution solution;
+	Vec3 offset = request.target - request.start;
+
+	if (request.constraint == TargetConstraint::FLIGHT_TIME) {
+		double seconds = request.value;
+		if (seconds <= 0.0) {
+			return solution;
+		}
+
+		// offset = v t + 0.5 g t^2 on the vertical axis, v t on the others
+		solution.velocity = Vec3(
+			offset.x / seconds,
+			(offset.y - 0.5 * gravity * seconds * seconds) / seconds,
+			offset.z / seconds);
+		solution.flightTime = seconds;
+		solution.solved = true;
+		return solution;
+	}
+
+	// The apex has to be above the start and no lower than the target, and only a downward
+	// gravity brings the camera back from it
+	double apexHeight = request.value;
+	if (gravity >= 0.0 || apexHeight <= 0.0 || apexHeight < offset.y) {
+		return solution;
+	}
+
+	double verticalSpeed = std::sqrt(-2.0 * gravity * apexHeight);
+	double riseTime = verticalSpeed / -gravity;
+	double fallTime = std::sqrt(2.0 * (apexHeight - offset.y) / -gravity);
+	double seconds = riseTime + fallTime;
+
+	solution.velocity = Vec3(offset.x / seconds, verticalSpeed, offset.z / seconds);
+	solution.flightTime = seconds;
+	solution.solved = true;
+	return solution;
+}
+
+TargetSolution solveTarget(const TargetRequest& request, double gravity, const DragParams& drag,
+	const TargetSolverSettings& settings)
+{
+	// The closed form without drag is the starting guess. Anything it rejects (an apex below
+	// the target, a non-positive flight time) is just as unreachable with drag.
+	TargetSolution solution = solveTarget(request, gravity);
+	if (!settings.simulated(drag) || !solution.solved) {
+		return solution;
+	}
+
+	if (request.constraint == TargetConstraint::FLIGHT_TIME) {
+		return solveFlightTimeWithDrag(request, gravity, drag, settings, solution);
+	}
+	return solveApexHeightWithDrag(request, gravity, drag, settings, solution);
+}
+
+void solveTargets(const std::vector<TargetRequest>& requests, double gravity, const DragParams& drag,
+	const TargetSolverSettings& settings, std::vector<TargetSolution>& solutions)
+{
+	const size_t count = requests.size();
+	solutions.assign(count, TargetSolution());
+
+	if (settings.simulated(drag)) {
+		for (size_t i = 0; i < count; ++i) {
+			solutions[i] = solveTarget(requests[i], gravity, drag, settings);
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		solutions[i] = solveTarget(requests[i], gravity);
+	}
+}
+
+}
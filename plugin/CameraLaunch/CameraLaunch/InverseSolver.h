@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "DragIntegrator.h"
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+// What fixes the shape of the arc between the start and the target
+enum class TargetConstraint {
+	FLIGHT_TIME,
+	APEX_HEIGHT
+};
+
+struct TargetRequest {
+	Vec3 start;
+	Vec3 target;
+	TargetConstraint constraint = TargetConstraint::FLIGHT_TIME;
+	// Seconds for FLIGHT_TIME, height of the apex above the start for APEX_HEIGHT
+	double value = 1.0;
+};
+
+struct TargetSolution {
+	bool solved = false;
+	Vec3 velocity;
+	// Seconds from launch until the target is reached
+	double flightTime = 0.0;
+	// Distance between the simulated end point and the target
+	double error = 0.0;
+	int iterations = 0;
+};
+
+struct TargetSolverSettings {
+	double framesPerSecond = 24.0;
+	// RK4 steps per frame when simulating drag
+	int substeps = 4;
+	int maxIterations = 20;
+	// World units
+	double tolerance = 1e-6;
+	// Wind or force field the flight passes through; refined numerically like drag
+	FieldSettings field;
+	// Gravity wells the flight passes; refined numerically like drag
+	GravityWellSettings wells;
+
+	bool simulated(const DragParams& drag) const { return drag.enabled() || field.active() || wells.active(); }
+};
+
+// Closed-form launch velocity without drag. Fails when the constraint cannot reach the
+// target, eg. an apex below the target or a non-positive flight time.
+TargetSolution solveTarget(const TargetRequest& request, double gravity);
+
+// Refines the closed-form guess with Newton iterations on a finite-difference Jacobian,
+// simulating each candidate through the drag integrator
+TargetSolution solveTarget(const TargetRequest& request, double gravity, const DragParams& drag,
+	const TargetSolverSettings& settings);
+
+// Solves every request in one call. Without drag this is a flat loop over the requests;
+// with drag each request is refined from its closed-form guess.
+void solveTargets(const std::vector<TargetRequest>& requests, double gravity, const DragParams& drag,
+	const TargetSolverSettings& settings, std::vector<TargetSolution>& solutions);
+
+}
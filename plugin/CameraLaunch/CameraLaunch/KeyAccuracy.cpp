@@ -0,0 +1,107 @@
+#include "KeyAccuracy.h"
+#include "LaunchEvaluator.h"
+
+#include <cmath>
+
+namespace LaunchCore {
+
+void channelKeys(const std::vector<ParabolicKey>& keys, KeyChannel channel, std::vector<ReducedKey>& curve)
+{
+	curve.resize(keys.size());
+	for (size_t i = 0; i < keys.size(); ++i) {
+		const ParabolicKey& key = keys[i];
+		ReducedKey& out = curve[i];
+		out.frame = key.frame;
+		out.inWeight = key.inWeight;
+		out.outWeight = key.outWeight;
+
+		switch (channel) {
+		case KeyChannel::TRANSLATE_X:
+			out.value = key.position.x;
+			out.inSlope = key.inSlope.x;
+			out.outSlope = key.outSlope.x;
+			break;
+		case KeyChannel::TRANSLATE_Y:
+			out.value = key.position.y;
+			out.inSlope = key.inSlope.y;
+			out.outSlope = key.outSlope.y;
+			break;
+		case KeyChannel::TRANSLATE_Z:
+			out.value = key.position.z;
+			out.inSlope = key.inSlope.z;
+			out.outSlope = key.outSlope.z;
+			break;
+		case KeyChannel::ROTATE_X:
+			out.value = key.rotation.x;
+			break;
+		case KeyChannel::ROTATE_Y:
+			out.value = key.rotation.y;
+			break;
+		}
+	}
+
+	// Rotation is keyed with linear tangents, so its slopes point at the neighbouring keys
+	if (channel == KeyChannel::ROTATE_X || channel == KeyChannel::ROTATE_Y) {
+		for (size_t i = 0; i < curve.size(); ++i) {
+			if (i > 0) {
+				curve[i].inSlope = (curve[i].value - curve[i - 1].value) / (curve[i].frame - curve[i - 1].frame);
+			}
+			if (i + 1 < curve.size()) {
+				curve[i].outSlope = (curve[i + 1].value - curve[i].value) / (curve[i + 1].frame - curve[i].frame);
+			}
+		}
+	}
+}
+
+KeyDeviation measureKeyDeviation(const std::vector<ParabolicKey>& keys, const PoseFunction& reference, int subdivisions)
+{
+	KeyDeviation deviation;
+	if (keys.size() < 2 || subdivisions < 1) {
+		return deviation;
+	}
+
+	std::vector<ReducedKey> curveX, curveY, curveZ, curvePitch;
+	channelKeys(keys, KeyChannel::TRANSLATE_X, curveX);
+	channelKeys(keys, KeyChannel::TRANSLATE_Y, curveY);
+	channelKeys(keys, KeyChannel::TRANSLATE_Z, curveZ);
+	channelKeys(keys, KeyChannel::ROTATE_X, curvePitch);
+
+	const double firstFrame = keys.front().frame;
+	const double lastFrame = keys.back().frame;
+	const size_t steps = (size_t)std::ceil((lastFrame - firstFrame) * subdivisions);
+
+	for (size_t k = 0; k <= steps; ++k) {
+		double frame = firstFrame + (double)k / subdivisions;
+		if (frame > lastFrame) frame = lastFrame;
+
+		Vec3 position;
+		Euler rotation;
+		reference(frame, position, rotation);
+
+		Vec3 keyed(evaluateKeys(curveX, frame), evaluateKeys(curveY, frame), evaluateKeys(curveZ, frame));
+		double translate = (keyed - position).length();
+		if (translate > deviation.translate) {
+			deviation.translate = translate;
+			deviation.translateFrame = frame;
+		}
+
+		double rotate = std::fabs(evaluateKeys(curvePitch, frame) - rotation.x);
+		if (rotate > deviation.rotate) {
+			deviation.rotate = rotate;
+			deviation.rotateFrame = frame;
+		}
+		++deviation.evaluations;
+	}
+
+	return deviation;
+}
+
+KeyDeviation measureKeyDeviation(const std::vector<ParabolicKey>& keys, const LaunchParams& params, int subdivisions)
+{
+	LaunchEvaluator evaluator(params);
+	return measureKeyDeviation(keys, [&evaluator](double frame, Vec3& position, Euler& rotation) {
+		evaluator.evaluate(frame, position, rotation);
+	}, subdivisions);
+}
+
+}
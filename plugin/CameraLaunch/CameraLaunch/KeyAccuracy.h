@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "KeyReducer.h"
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+enum class KeyChannel {
+	TRANSLATE_X,
+	TRANSLATE_Y,
+	TRANSLATE_Z,
+	ROTATE_X,
+	ROTATE_Y
+};
+
+struct KeyDeviation {
+	// Largest distance between the keyed and the true position, and the frame it happens at
+	double translate = 0.0;
+	double translateFrame = 0.0;
+	// Largest pitch difference in radians, and the frame it happens at. The three-key scheme
+	// only approximates the pitch; -orient keys it per frame.
+	double rotate = 0.0;
+	double rotateFrame = 0.0;
+	size_t evaluations = 0;
+};
+
+// True pose of the flight at a (possibly fractional) frame
+using PoseFunction = std::function<void(double frame, Vec3& position, Euler& rotation)>;
+
+// One channel of parabolic keys as the weighted anim curve Maya ends up holding, with the
+// rotation channels keyed linearly
+void channelKeys(const std::vector<ParabolicKey>& keys, KeyChannel channel, std::vector<ReducedKey>& curve);
+
+// Evaluates the keyed curves 'subdivisions' times per frame from the first key to the last and
+// reports how far they stray from 'reference'
+KeyDeviation measureKeyDeviation(const std::vector<ParabolicKey>& keys, const PoseFunction& reference, int subdivisions);
+
+// Same as above against the closed-form flight of 'params'
+KeyDeviation measureKeyDeviation(const std::vector<ParabolicKey>& keys, const LaunchParams& params, int subdivisions);
+
+}
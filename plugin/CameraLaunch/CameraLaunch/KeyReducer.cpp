@@ -0,0 +1,238 @@
+#include "KeyReducer.h"
+#include "TrajectorySampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace LaunchCore {
+
+namespace {
+
+// One Bezier segment between two keys, in (frame, value) space
+struct Segment {
+	double x0, y0, x1, y1;
+	double slope0, slope1;
+	double weight0, weight1;
+
+	double controlX1() const { return x0 + weight0; }
+	double controlX2() const { return x1 - weight1; }
+	double controlY1() const { return y0 + slope0 * weight0; }
+	double controlY2() const { return y1 - slope1 * weight1; }
+};
+
+inline double bezier(double p0, double p1, double p2, double p3, double u)
+{
+	double v = 1.0 - u;
+	return v * v * v * p0 + 3.0 * v * v * u * p1 + 3.0 * v * u * u * p2 + u * u * u * p3;
+}
+
+inline double bezierDerivative(double p0, double p1, double p2, double p3, double u)
+{
+	double v = 1.0 - u;
+	return 3.0 * (v * v * (p1 - p0) + 2.0 * v * u * (p2 - p1) + u * u * (p3 - p2));
+}
+
+// Curve parameter where the segment reaches 'frame'. Weights within [0, segment length] keep
+// x(u) monotonic, so Newton with a bisection fallback always converges.
+double parameterAtFrame(const Segment& s, double frame)
+{
+	const double cx1 = s.controlX1();
+	const double cx2 = s.controlX2();
+
+	double lo = 0.0;
+	double hi = 1.0;
+	double u = (frame - s.x0) / (s.x1 - s.x0);
+	for (int i = 0; i < 32; ++i) {
+		double x = bezier(s.x0, cx1, cx2, s.x1, u) - frame;
+		if (std::fabs(x) < 1e-12) {
+			break;
+		}
+		if (x < 0.0) lo = u; else hi = u;
+
+		double dx = bezierDerivative(s.x0, cx1, cx2, s.x1, u);
+		double next = (dx > 0.0) ? u - x / dx : -1.0;
+		u = (next > lo && next < hi) ? next : 0.5 * (lo + hi);
+	}
+	return u;
+}
+
+double evaluateSegment(const Segment& s, double frame)
+{
+	double u = parameterAtFrame(s, frame);
+	return bezier(s.y0, s.controlY1(), s.controlY2(), s.y1, u);
+}
+
+double maxSegmentError(const Segment& s, const double* frames, const double* values, size_t first, size_t last)
+{
+	double maxError = 0.0;
+	for (size_t k = first + 1; k < last; ++k) {
+		maxError = std::max(maxError, std::fabs(evaluateSegment(s, frames[k]) - values[k]));
+	}
+	return maxError;
+}
+
+// Fits the segment between samples 'first' and 'last' and reports whether it stays in tolerance
+bool fitSegment(const double* frames, const double* values, const std::vector<double>& slopes,
+	size_t first, size_t last, double tolerance, Segment& segment)
+{
+	double length = frames[last] - frames[first];
+	segment.x0 = frames[first];
+	segment.y0 = values[first];
+	segment.x1 = frames[last];
+	segment.y1 = values[last];
+	segment.slope0 = slopes[first];
+	segment.slope1 = slopes[last];
+	segment.weight0 = length / 3.0;
+	segment.weight1 = length / 3.0;
+
+	double error = maxSegmentError(segment, frames, values, first, last);
+	if (error <= tolerance) {
+		return true;
+	}
+
+	// With the parameters of the samples held fixed the value curve is linear in both weights,
+	// so alternate a 2x2 least-squares solve with re-solving the parameters
+	Segment best = segment;
+	double bestError = error;
+	for (int iteration = 0; iteration < 4; ++iteration) {
+		double a00 = 0.0, a01 = 0.0, a11 = 0.0, b0 = 0.0, b1 = 0.0;
+		for (size_t k = first + 1; k < last; ++k) {
+			double u = parameterAtFrame(segment, frames[k]);
+			double v = 1.0 - u;
+			double basis1 = 3.0 * v * v * u;
+			double basis2 = 3.0 * v * u * u;
+
+			double c0 = basis1 * segment.slope0;
+			double c1 = -basis2 * segment.slope1;
+			double r = values[k] - (v * v * v + basis1) * segment.y0 - (basis2 + u * u * u) * segment.y1;
+
+			a00 += c0 * c0; a01 += c0 * c1; a11 += c1 * c1;
+			b0 += c0 * r; b1 += c1 * r;
+		}
+
+		double det = a00 * a11 - a01 * a01;
+		if (std::fabs(det) < 1e-300) {
+			break;
+		}
+
+		const double minWeight = 1e-3 * length;
+		segment.weight0 = std::min(std::max((b0 * a11 - b1 * a01) / det, minWeight), length);
+		segment.weight1 = std::min(std::max((b1 * a00 - b0 * a01) / det, minWeight), length);
+
+		error = maxSegmentError(segment, frames, values, first, last);
+		if (error < bestError) {
+			best = segment;
+			bestError = error;
+		}
+		if (bestError <= tolerance) {
+			break;
+		}
+	}
+
+	segment = best;
+	return bestError <= tolerance;
+}
+
+}
+
+void reduceKeys(const double* frames, const double* values, size_t count, double tolerance,
+	std::vector<ReducedKey>& keys)
+{
+	keys.clear();
+	if (count == 0) {
+		return;
+	}
+
+	std::vector<double> slopes;
+	differentiateSamples(frames, values, count, slopes);
+
+	ReducedKey key;
+	key.frame = frames[0];
+	key.value = values[0];
+	key.inSlope = key.outSlope = slopes[0];
+	keys.push_back(key);
+
+	size_t first = 0;
+	while (first + 1 < count) {
+		// Grow the segment geometrically until it stops fitting, then binary search the longest fit
+		Segment segment;
+		fitSegment(frames, values, slopes, first, first + 1, tolerance, segment);
+		size_t good = first + 1;
+		size_t bad = count;
+
+		size_t span = 2;
+		while (first + span < count) {
+			Segment candidate;
+			if (!fitSegment(frames, values, slopes, first, first + span, tolerance, candidate)) {
+				bad = first + span;
+				break;
+			}
+			good = first + span;
+			segment = candidate;
+			span *= 2;
+		}
+		if (bad == count && good != count - 1) {
+			Segment candidate;
+			if (fitSegment(frames, values, slopes, first, count - 1, tolerance, candidate)) {
+				good = count - 1;
+				segment = candidate;
+			}
+			else {
+				bad = count - 1;
+			}
+		}
+		while (bad - good > 1) {
+			size_t middle = good + (bad - good) / 2;
+			Segment candidate;
+			if (fitSegment(frames, values, slopes, first, middle, tolerance, candidate)) {
+				good = middle;
+				segment = candidate;
+			}
+			else {
+				bad = middle;
+			}
+		}
+
+		keys.back().outWeight = segment.weight0;
+
+		ReducedKey next;
+		next.frame = frames[good];
+		next.value = values[good];
+		next.inSlope = next.outSlope = slopes[good];
+		next.inWeight = segment.weight1;
+		keys.push_back(next);
+
+		first = good;
+	}
+}
+
+double evaluateKeys(const std::vector<ReducedKey>& keys, double frame)
+{
+	if (keys.empty()) {
+		return 0.0;
+	}
+	if (frame <= keys.front().frame) {
+		return keys.front().value;
+	}
+	if (frame >= keys.back().frame) {
+		return keys.back().value;
+	}
+
+	size_t next = std::upper_bound(keys.begin(), keys.end(), frame,
+		[](double f, const ReducedKey& key) { return f < key.frame; }) - keys.begin();
+	const ReducedKey& a = keys[next - 1];
+	const ReducedKey& b = keys[next];
+
+	Segment segment;
+	segment.x0 = a.frame;
+	segment.y0 = a.value;
+	segment.x1 = b.frame;
+	segment.y1 = b.value;
+	segment.slope0 = a.outSlope;
+	segment.slope1 = b.inSlope;
+	segment.weight0 = a.outWeight;
+	segment.weight1 = b.inWeight;
+	return evaluateSegment(segment, frame);
+}
+
+}
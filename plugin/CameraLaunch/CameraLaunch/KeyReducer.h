@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace LaunchCore {
+
+// One key of a weighted Bezier anim curve. Slopes are in value units per frame and weights
+// are the length of each tangent handle along the time axis, in frames.
+struct ReducedKey {
+	double frame = 0.0;
+	double value = 0.0;
+	double inSlope = 0.0;
+	double outSlope = 0.0;
+	double inWeight = 0.0;
+	double outWeight = 0.0;
+};
+
+// Replaces a densely sampled channel with the fewest keys whose weighted Bezier segments stay
+// within 'tolerance' of every sample. Keys are placed on sample frames, taking the longest
+// segment that fits from each key; tangent slopes follow the samples and the handle weights
+// are least-squares fitted when the default third-of-a-segment handles miss the tolerance.
+// 'frames' must be increasing.
+void reduceKeys(const double* frames, const double* values, size_t count, double tolerance,
+	std::vector<ReducedKey>& keys);
+
+// Value of the curve defined by 'keys' at 'frame', held constant outside the keyed range
+double evaluateKeys(const std::vector<ReducedKey>& keys, double frame);
+
+}
@@ -0,0 +1,42 @@
+#include "LaunchEvaluator.h"
+
+namespace LaunchCore {
+
+LaunchEvaluator::LaunchEvaluator() : LaunchEvaluator(LaunchParams())
+{
+}
+
+LaunchEvaluator::LaunchEvaluator(const LaunchParams& params)
+	: m_params(params)
+{
+	const double PI = std::atan(1.0) * 4;
+	const Vec3& v = params.velocity;
+	Vec3 direction = v.normal();
+
+	m_halfGravity = 0.5 * params.gravity;
+	m_horizontalSpeed = std::sqrt(v.x * v.x + v.z * v.z);
+	m_yaw = std::atan2(direction.x, direction.z) + PI;
+	m_landingFrame = params.startFrame + calculateFlightFrames(params);
+}
+
+void LaunchEvaluator::evaluate(double frame, Vec3& position, Euler& rotation) const
+{
+	double clampedFrame = frame;
+	if (clampedFrame < m_params.startFrame) clampedFrame = m_params.startFrame;
+	if (clampedFrame > m_landingFrame) clampedFrame = m_landingFrame;
+
+	double t = (clampedFrame - m_params.startFrame) * m_params.secondsPerFrame();
+	const Vec3& p = m_params.startPosition;
+	const Vec3& v = m_params.velocity;
+
+	position.x = p.x + v.x * t;
+	position.y = p.y + v.y * t + m_halfGravity * t * t;
+	position.z = p.z + v.z * t;
+
+	double vy = v.y + m_params.gravity * t;
+	rotation.x = (vy == 0.0 && m_horizontalSpeed == 0.0) ? 0.0 : std::atan2(vy, m_horizontalSpeed);
+	rotation.y = m_yaw;
+	rotation.z = 0.0;
+}
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+// Closed-form evaluation of a single frame. The per-launch constants (yaw, horizontal speed,
+// landing frame) are computed once up front, so each evaluate() is a handful of multiply-adds.
+class LaunchEvaluator
+{
+public:
+	LaunchEvaluator();
+	explicit LaunchEvaluator(const LaunchParams& params);
+
+	const LaunchParams& params() const { return m_params; }
+	double landingFrame() const { return m_landingFrame; }
+
+	// Frames before launch hold the start pose and frames after landing hold the landing pose
+	void evaluate(double frame, Vec3& position, Euler& rotation) const;
+
+private:
+	LaunchParams m_params;
+	double m_halfGravity;
+	double m_horizontalSpeed;
+	double m_yaw;
+	double m_landingFrame;
+};
+
+}
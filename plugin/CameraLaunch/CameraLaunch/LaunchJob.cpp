@@ -0,0 +1,361 @@
+#include "LaunchJob.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace LaunchCore {
+
+namespace {
+
+bool parseNumber(const std::string& text, double& value)
+{
+	if (text.empty()) {
+		return false;
+	}
+
+	char* end = nullptr;
+	value = std::strtod(text.c_str(), &end);
+	return end == text.c_str() + text.size();
+}
+
+std::string trim(const std::string& text)
+{
+	size_t first = text.find_first_not_of(" \t\r\n");
+	if (first == std::string::npos) {
+		return std::string();
+	}
+	size_t last = text.find_last_not_of(" \t\r\n");
+	return text.substr(first, last - first + 1);
+}
+
+// Just enough JSON for job files: no \u escapes beyond ASCII, numbers read as doubles
+struct JsonValue {
+	enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+	Type type = Type::NUL;
+	double number = 0.0;
+	std::string string;
+	std::vector<JsonValue> items;
+	std::vector<std::pair<std::string, JsonValue>> members;
+
+	const JsonValue* find(const char* key) const
+	{
+		for (const auto& member : members) {
+			if (member.first == key) {
+				return &member.second;
+			}
+		}
+		return nullptr;
+	}
+};
+
+class JsonReader
+{
+public:
+	explicit JsonReader(const std::string& text) : m_text(text), m_pos(0) {}
+
+	bool read(JsonValue& value, std::string& error)
+	{
+		if (!readValue(value) || (skipSpace(), m_pos != m_text.size())) {
+			error = "Invalid JSON at offset " + std::to_string(m_pos);
+			return false;
+		}
+		return true;
+	}
+
+private:
+	const std::string& m_text;
+	size_t m_pos;
+
+	void skipSpace()
+	{
+		while (m_pos < m_text.size() && std::isspace((unsigned char)m_text[m_pos])) ++m_pos;
+	}
+
+	bool consume(char c)
+	{
+		skipSpace();
+		if (m_pos < m_text.size() && m_text[m_pos] == c) {
+			++m_pos;
+			return true;
+		}
+		return false;
+	}
+
+	bool readLiteral(const char* literal)
+	{
+		size_t length = std::char_traits<char>::length(literal);
+		if (m_text.compare(m_pos, length, literal) != 0) {
+			return false;
+		}
+		m_pos += length;
+		return true;
+	}
+
+	bool readString(std::string& out)
+	{
+		if (!consume('"')) {
+			return false;
+		}
+
+		out.clear();
+		while (m_pos < m_text.size()) {
+			char c = m_text[m_pos++];
+			if (c == '"') {
+				return true;
+			}
+			if (c != '\\') {
+				out += c;
+				continue;
+			}
+			if (m_pos >= m_text.size()) {
+				return false;
+			}
+
+			char escaped = m_text[m_pos++];
+			switch (escaped) {
+			case 'n': out += '\n'; break;
+			case 't': out += '\t'; break;
+			case 'r': out += '\r'; break;
+			case 'b': out += '\b'; break;
+			case 'f': out += '\f'; break;
+			case 'u':
+				if (m_pos + 4 > m_text.size()) return false;
+				out += (char)std::strtol(m_text.substr(m_pos, 4).c_str(), nullptr, 16);
+				m_pos += 4;
+				break;
+			default: out += escaped; break;
+			}
+		}
+		return false;
+	}
+
+	bool readValue(JsonValue& value)
+	{
+		skipSpace();
+		if (m_pos >= m_text.size()) {
+			return false;
+		}
+
+		char c = m_text[m_pos];
+		if (c == '{') {
+			++m_pos;
+			value.type = JsonValue::Type::OBJECT;
+			if (consume('}')) return true;
+			do {
+				std::pair<std::string, JsonValue> member;
+				if (!readString(member.first) || !consume(':') || !readValue(member.second)) return false;
+				value.members.push_back(std::move(member));
+			} while (consume(','));
+			return consume('}');
+		}
+		if (c == '[') {
+			++m_pos;
+			value.type = JsonValue::Type::ARRAY;
+			if (consume(']')) return true;
+			do {
+				value.items.emplace_back();
+				if (!readValue(value.items.back())) return false;
+			} while (consume(','));
+			return consume(']');
+		}
+		if (c == '"') {
+			value.type = JsonValue::Type::STRING;
+			return readString(value.string);
+		}
+		if (readLiteral("true")) {
+			value.type = JsonValue::Type::BOOLEAN;
+			value.number = 1.0;
+			return true;
+		}
+		if (readLiteral("false")) {
+			value.type = JsonValue::Type::BOOLEAN;
+			return true;
+		}
+		if (readLiteral("null")) {
+			value.type = JsonValue::Type::NUL;
+			return true;
+		}
+
+		char* end = nullptr;
+		value.type = JsonValue::Type::NUMBER;
+		value.number = std::strtod(m_text.c_str() + m_pos, &end);
+		if (end == m_text.c_str() + m_pos) {
+			return false;
+		}
+		m_pos = end - m_text.c_str();
+		return true;
+	}
+};
+
+bool readNumbers(const JsonValue* value, double* out, size_t count)
+{
+	if (!value || value->type != JsonValue::Type::ARRAY || value->items.size() != count) {
+		return false;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		if (value->items[i].type != JsonValue::Type::NUMBER) {
+			return false;
+		}
+		out[i] = value->items[i].number;
+	}
+	return true;
+}
+
+}
+
+LaunchParams LaunchJob::launchParams(double framesPerSecond) const
+{
+	LaunchParams params;
+	params.startPosition = startPosition();
+	params.velocity = velocity;
+	params.gravity = gravity;
+	params.startFrame = startFrame;
+	params.framesPerSecond = framesPerSecond;
+	return params;
+}
+
+bool parseJobsCsv(std::istream& in, std::vector<LaunchJob>& jobs, std::string& error)
+{
+	jobs.clear();
+
+	std::string line;
+	for (int lineNumber = 1; std::getline(in, line); ++lineNumber) {
+		line = trim(line);
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+
+		std::vector<std::string> fields;
+		std::stringstream stream(line);
+		std::string field;
+		while (std::getline(stream, field, ',')) {
+			fields.push_back(trim(field));
+		}
+
+		std::vector<double> numbers(fields.size() - 1, 0.0);
+		bool numeric = fields.size() >= 4;
+		for (size_t i = 1; i < fields.size() && numeric; ++i) {
+			numeric = parseNumber(fields[i], numbers[i - 1]);
+		}
+
+		// A header row names the columns instead of holding numbers
+		if (!numeric && jobs.empty() && fields.size() >= 4 && !parseNumber(fields[1], numbers[0])) {
+			continue;
+		}
+
+		size_t count = numbers.size();
+		if (!numeric || fields[0].empty() || (count != 3 && count != 4 && count != 5 && count != 21)) {
+			error = "Line " + std::to_string(lineNumber) + ": expected camera, vx, vy, vz[, gravity[, startFrame[, 16 matrix values]]]";
+			return false;
+		}
+
+		LaunchJob job;
+		job.camera = fields[0];
+		job.velocity = Vec3(numbers[0], numbers[1], numbers[2]);
+		if (count > 3) job.gravity = numbers[3];
+		if (count > 4) job.startFrame = numbers[4];
+		if (count > 5) {
+			for (int i = 0; i < 16; ++i) {
+				job.startMatrix[i] = numbers[5 + i];
+			}
+		}
+		jobs.push_back(job);
+	}
+
+	return true;
+}
+
+bool parseJobsJson(std::istream& in, std::vector<LaunchJob>& jobs, std::string& error)
+{
+	jobs.clear();
+
+	std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	JsonValue root;
+	if (!JsonReader(text).read(root, error)) {
+		return false;
+	}
+
+	const JsonValue* list = &root;
+	if (root.type == JsonValue::Type::OBJECT) {
+		list = root.find("jobs");
+	}
+	if (!list || list->type != JsonValue::Type::ARRAY) {
+		error = "Expected an array of jobs, or an object with a \"jobs\" array";
+		return false;
+	}
+
+	for (size_t i = 0; i < list->items.size(); ++i) {
+		const JsonValue& entry = list->items[i];
+		std::string where = "Job " + std::to_string(i);
+		if (entry.type != JsonValue::Type::OBJECT) {
+			error = where + ": expected an object";
+			return false;
+		}
+
+		LaunchJob job;
+		const JsonValue* camera = entry.find("camera");
+		if (!camera || camera->type != JsonValue::Type::STRING || camera->string.empty()) {
+			error = where + ": missing \"camera\"";
+			return false;
+		}
+		job.camera = camera->string;
+
+		double velocity[3];
+		if (!readNumbers(entry.find("velocity"), velocity, 3)) {
+			error = where + ": \"velocity\" must be three numbers";
+			return false;
+		}
+		job.velocity = Vec3(velocity[0], velocity[1], velocity[2]);
+
+		const JsonValue* gravity = entry.find("gravity");
+		if (gravity) {
+			if (gravity->type != JsonValue::Type::NUMBER) {
+				error = where + ": \"gravity\" must be a number";
+				return false;
+			}
+			job.gravity = gravity->number;
+		}
+
+		const JsonValue* startFrame = entry.find("startFrame");
+		if (startFrame) {
+			if (startFrame->type != JsonValue::Type::NUMBER) {
+				error = where + ": \"startFrame\" must be a number";
+				return false;
+			}
+			job.startFrame = startFrame->number;
+		}
+
+		const JsonValue* startMatrix = entry.find("startMatrix");
+		if (startMatrix && !readNumbers(startMatrix, job.startMatrix, 16)) {
+			error = where + ": \"startMatrix\" must be 16 numbers";
+			return false;
+		}
+
+		jobs.push_back(job);
+	}
+
+	return true;
+}
+
+bool loadJobFile(const std::string& path, std::vector<LaunchJob>& jobs, std::string& error)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		error = "Could not open " + path;
+		return false;
+	}
+
+	size_t dot = path.find_last_of('.');
+	std::string extension = (dot == std::string::npos) ? std::string() : path.substr(dot + 1);
+	for (char& c : extension) {
+		c = (char)std::tolower((unsigned char)c);
+	}
+
+	return (extension == "json") ? parseJobsJson(in, jobs, error) : parseJobsCsv(in, jobs, error);
+}
+
+}
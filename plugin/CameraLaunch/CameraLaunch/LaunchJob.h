@@ -0,0 +1,37 @@
+#pragma once
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+// One launch of a headless batch, with what the cameraLaunch command would read from the scene
+struct LaunchJob {
+	std::string camera;
+	Vec3 velocity;
+	double gravity = -9.81;
+	double startFrame = 0.0;
+	// World matrix of the camera at launch, row-major like MMatrix (translation in the last row).
+	// Only the translation is used; the launch faces along its velocity.
+	double startMatrix[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+	Vec3 startPosition() const { return Vec3(startMatrix[12], startMatrix[13], startMatrix[14]); }
+	LaunchParams launchParams(double framesPerSecond) const;
+};
+
+// One launch per line: camera, vx, vy, vz[, gravity[, startFrame[, 16 matrix values]]]. Blank
+// lines, lines starting with '#' and a leading header row are skipped.
+bool parseJobsCsv(std::istream& in, std::vector<LaunchJob>& jobs, std::string& error);
+
+// An array of launches, or an object holding one under "jobs". Each launch is an object with
+// "camera" and "velocity" ([x, y, z]) and optionally "gravity", "startFrame" and "startMatrix"
+// (16 numbers).
+bool parseJobsJson(std::istream& in, std::vector<LaunchJob>& jobs, std::string& error);
+
+// Picks the parser from the extension: .json is JSON, anything else is CSV
+bool loadJobFile(const std::string& path, std::vector<LaunchJob>& jobs, std::string& error);
+
+}
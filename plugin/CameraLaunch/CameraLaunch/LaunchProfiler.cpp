@@ -0,0 +1,137 @@
+#include "LaunchProfiler.h"
+
+#include <cstdio>
+
+namespace LaunchCore {
+
+void ProfileRecord::addPhase(const char* name, double milliseconds)
+{
+	for (Phase& phase : phases) {
+		if (phase.name == name) {
+			phase.milliseconds += milliseconds;
+			return;
+		}
+	}
+
+	Phase phase;
+	phase.name = name;
+	phase.milliseconds = milliseconds;
+	phases.push_back(phase);
+}
+
+double ProfileRecord::phaseMilliseconds(const char* name) const
+{
+	for (const Phase& phase : phases) {
+		if (phase.name == name) {
+			return phase.milliseconds;
+		}
+	}
+	return 0.0;
+}
+
+std::string ProfileRecord::toJson() const
+{
+	// Phase and command names are fixed identifiers, so nothing here needs escaping
+	char number[64];
+	std::string json = "{\"command\":\"" + command + "\"";
+
+	std::snprintf(number, sizeof(number), "%.6f", totalMilliseconds);
+	json += ",\"totalMs\":";
+	json += number;
+
+	json += ",\"phases\":[";
+	for (size_t i = 0; i < phases.size(); ++i) {
+		std::snprintf(number, sizeof(number), "%.6f", phases[i].milliseconds);
+		if (i > 0) json += ",";
+		json += "{\"name\":\"" + phases[i].name + "\",\"ms\":" + number + "}";
+	}
+	json += "]";
+
+	json += ",\"cameras\":" + std::to_string(cameras);
+	json += ",\"keysWritten\":" + std::to_string(keysWritten);
+	json += ",\"curvesCreated\":" + std::to_string(curvesCreated);
+	json += ",\"curvesDeleted\":" + std::to_string(curvesDeleted);
+	json += ",\"curvesReused\":" + std::to_string(curvesReused);
+	json += ",\"plugLookups\":" + std::to_string(plugLookups);
+	json += "}";
+	return json;
+}
+
+ScopedPhase::ScopedPhase(ProfileRecord* record, const char* name)
+	: m_record(record)
+	, m_name(name)
+{
+	if (m_record) {
+		m_start = std::chrono::steady_clock::now();
+	}
+}
+
+ScopedPhase::~ScopedPhase()
+{
+	if (m_record) {
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_start;
+		m_record->addPhase(m_name, elapsed.count());
+	}
+}
+
+ProfileHistory::ProfileHistory(size_t capacity)
+	: m_capacity(capacity > 0 ? capacity : 1)
+	, m_next(0)
+{
+}
+
+void ProfileHistory::push(const ProfileRecord& record)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_records.size() < m_capacity) {
+		m_records.push_back(record);
+	}
+	else {
+		m_records[m_next] = record;
+	}
+	m_next = (m_next + 1) % m_capacity;
+}
+
+void ProfileHistory::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_records.clear();
+	m_next = 0;
+}
+
+std::vector<ProfileRecord> ProfileHistory::records() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_records.size() < m_capacity) {
+		return m_records;
+	}
+
+	// Full ring: the oldest record is the one about to be overwritten
+	std::vector<ProfileRecord> ordered;
+	ordered.reserve(m_records.size());
+	for (size_t i = 0; i < m_records.size(); ++i) {
+		ordered.push_back(m_records[(m_next + i) % m_capacity]);
+	}
+	return ordered;
+}
+
+std::string ProfileHistory::toJson() const
+{
+	std::vector<ProfileRecord> ordered = records();
+
+	std::string json = "[";
+	for (size_t i = 0; i < ordered.size(); ++i) {
+		if (i > 0) json += ",";
+		json += ordered[i].toJson();
+	}
+	json += "]";
+	return json;
+}
+
+ProfileHistory& ProfileHistory::global()
+{
+	static ProfileHistory history;
+	return history;
+}
+
+}
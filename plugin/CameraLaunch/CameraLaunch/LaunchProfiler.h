@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace LaunchCore {
+
+// Timings and counters for one run of the command (doIt/redoIt or undoIt)
+struct ProfileRecord {
+	struct Phase {
+		std::string name;
+		double milliseconds = 0.0;
+	};
+
+	std::string command;
+	double totalMilliseconds = 0.0;
+	// In the order they first ran; a phase that runs repeatedly accumulates into one entry
+	std::vector<Phase> phases;
+
+	size_t cameras = 0;
+	size_t keysWritten = 0;
+	size_t curvesCreated = 0;
+	size_t curvesDeleted = 0;
+	// Curves from an earlier launch whose keys were edited in place
+	size_t curvesReused = 0;
+	size_t plugLookups = 0;
+
+	void addPhase(const char* name, double milliseconds);
+	double phaseMilliseconds(const char* name) const;
+
+	std::string toJson() const;
+};
+
+// Times a scope into 'record'. A null record makes this a no-op without reading the clock,
+// so phases can be left in place when profiling is off.
+class ScopedPhase
+{
+public:
+	ScopedPhase(ProfileRecord* record, const char* name);
+	~ScopedPhase();
+
+	ScopedPhase(const ScopedPhase&) = delete;
+	ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+	ProfileRecord* m_record;
+	const char* m_name;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+// Fixed-size ring of the most recent records, shared by every command invocation in the process
+class ProfileHistory
+{
+public:
+	explicit ProfileHistory(size_t capacity = 64);
+
+	void push(const ProfileRecord& record);
+	void clear();
+
+	// Oldest first
+	std::vector<ProfileRecord> records() const;
+	size_t capacity() const { return m_capacity; }
+
+	// JSON array of every record, oldest first
+	std::string toJson() const;
+
+	static ProfileHistory& global();
+
+private:
+	mutable std::mutex m_mutex;
+	size_t m_capacity;
+	size_t m_next;
+	std::vector<ProfileRecord> m_records;
+};
+
+}
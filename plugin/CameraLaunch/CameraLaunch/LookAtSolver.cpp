@@ -0,0 +1,64 @@
+#include "LookAtSolver.h"
+
+namespace LaunchCore {
+
+namespace {
+
+// Positions of a cached object at every frame, falling back to its nearest earlier sample
+void gatherPositions(const ParentMatrices& matrices, const Vec3& local, const double* frames, size_t count,
+	std::vector<double>& x, std::vector<double>& y, std::vector<double>& z)
+{
+	x.resize(count);
+	y.resize(count);
+	z.resize(count);
+
+	Vec3 last;
+	for (size_t n = 0; n < count; ++n) {
+		const double* matrix = matrices.find(frames[n]);
+		if (matrix) {
+			last = transformPoint(matrix, local);
+		}
+		x[n] = last.x;
+		y[n] = last.y;
+		z[n] = last.z;
+	}
+}
+
+}
+
+void solveLookAt(const TrajectoryView& flight, const ParentMatrices& target, const ParentMatrices* upObject,
+	const LookAtSettings& settings, OrientationSamples& orientation)
+{
+	const size_t count = flight.count;
+	AimAxes axes;
+	axes.resize(count);
+
+	// Forward runs from the camera to the aim point
+	std::vector<double> tx, ty, tz;
+	gatherPositions(target, settings.offset, flight.frames, count, tx, ty, tz);
+	for (size_t n = 0; n < count; ++n) {
+		axes.fx[n] = tx[n] - flight.translateX[n];
+		axes.fy[n] = ty[n] - flight.translateY[n];
+		axes.fz[n] = tz[n] - flight.translateZ[n];
+	}
+
+	// Up leans towards the up object, like an aim constraint's object up
+	if (upObject) {
+		gatherPositions(*upObject, Vec3(), flight.frames, count, tx, ty, tz);
+		for (size_t n = 0; n < count; ++n) {
+			axes.ux[n] = tx[n] - flight.translateX[n];
+			axes.uy[n] = ty[n] - flight.translateY[n];
+			axes.uz[n] = tz[n] - flight.translateZ[n];
+		}
+	}
+	else {
+		axes.ux.assign(count, settings.up.x);
+		axes.uy.assign(count, settings.up.y);
+		axes.uz.assign(count, settings.up.z);
+	}
+
+	completeAimAxes(axes);
+	axesToOrientation(axes, settings.rotateOrder, orientation);
+}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "OrientationSolver.h"
+#include "ParentSpace.h"
+
+namespace LaunchCore {
+
+struct LookAtSettings {
+	// Point aimed at, in the target's space, so the framing turns with the target
+	Vec3 offset;
+	// World direction the camera's up axis leans towards when there is no up object
+	Vec3 up = Vec3(0.0, 1.0, 0.0);
+	RotateOrder rotateOrder = RotateOrder::XYZ;
+};
+
+// Aims the camera (-Z forward, +Y up) from every sample of a world-space flight at the target.
+// 'target' holds the target's world matrix at every sample frame, in the same per-frame cache
+// parents use; with 'upObject' the camera's up leans towards that object instead of
+// 'settings.up'. Aim points are gathered into flat arrays first, so the aim math runs as
+// plain loops over samples.
+void solveLookAt(const TrajectoryView& flight, const ParentMatrices& target, const ParentMatrices* upObject,
+	const LookAtSettings& settings, OrientationSamples& orientation);
+
+}
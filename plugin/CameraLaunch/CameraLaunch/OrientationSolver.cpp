@@ -0,0 +1,348 @@
+#include "OrientationSolver.h"
+
+#include <cmath>
+
+namespace LaunchCore {
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// Axes in the order they are applied: i first, then j, then k
+struct AxisOrder {
+	int i, j, k;
+	bool odd;
+};
+
+AxisOrder axisOrder(RotateOrder order)
+{
+	switch (order) {
+	case RotateOrder::YZX: return { 1, 2, 0, false };
+	case RotateOrder::ZXY: return { 2, 0, 1, false };
+	case RotateOrder::XZY: return { 0, 2, 1, true };
+	case RotateOrder::YXZ: return { 1, 0, 2, true };
+	case RotateOrder::ZYX: return { 2, 1, 0, true };
+	case RotateOrder::XYZ:
+	default:
+		return { 0, 1, 2, false };
+	}
+}
+
+inline double& axisAngle(Euler& euler, int axis)
+{
+	return (axis == 0) ? euler.x : (axis == 1) ? euler.y : euler.z;
+}
+
+inline double axisAngle(const Euler& euler, int axis)
+{
+	return (axis == 0) ? euler.x : (axis == 1) ? euler.y : euler.z;
+}
+
+void axisRotation(int axis, double angle, double r[3][3])
+{
+	double c = std::cos(angle);
+	double s = std::sin(angle);
+	for (int row = 0; row < 3; ++row) {
+		for (int col = 0; col < 3; ++col) {
+			r[row][col] = (row == col) ? 1.0 : 0.0;
+		}
+	}
+
+	int a = (axis + 1) % 3;
+	int b = (axis + 2) % 3;
+	r[a][a] = c; r[a][b] = -s;
+	r[b][a] = s; r[b][b] = c;
+}
+
+void multiply(const double a[3][3], const double b[3][3], double out[3][3])
+{
+	for (int row = 0; row < 3; ++row) {
+		for (int col = 0; col < 3; ++col) {
+			out[row][col] = a[row][0] * b[0][col] + a[row][1] * b[1][col] + a[row][2] * b[2][col];
+		}
+	}
+}
+
+// Whole turns added to 'angle' to bring it closest to 'reference'
+inline double nearestTurn(double angle, double reference)
+{
+	return angle + 2.0 * PI * std::round((reference - angle) / (2.0 * PI));
+}
+
+}
+
+void eulerToMatrix(const Euler& euler, RotateOrder order, double m[3][3])
+{
+	AxisOrder axes = axisOrder(order);
+
+	double ri[3][3], rj[3][3], rk[3][3], kj[3][3];
+	axisRotation(axes.i, axisAngle(euler, axes.i), ri);
+	axisRotation(axes.j, axisAngle(euler, axes.j), rj);
+	axisRotation(axes.k, axisAngle(euler, axes.k), rk);
+
+	// The first axis applies first, so it sits rightmost
+	multiply(rk, rj, kj);
+	multiply(kj, ri, m);
+}
+
+Euler matrixToEuler(const double m[3][3], RotateOrder order)
+{
+	AxisOrder axes = axisOrder(order);
+	const int i = axes.i, j = axes.j, k = axes.k;
+	const double sign = axes.odd ? -1.0 : 1.0;
+
+	Euler euler;
+	double sinMiddle = -sign * m[k][i];
+	sinMiddle = (sinMiddle > 1.0) ? 1.0 : (sinMiddle < -1.0) ? -1.0 : sinMiddle;
+	axisAngle(euler, j) = std::asin(sinMiddle);
+
+	if (std::fabs(sinMiddle) < 1.0 - 1e-12) {
+		axisAngle(euler, i) = std::atan2(sign * m[k][j], m[k][k]);
+		axisAngle(euler, k) = std::atan2(sign * m[j][i], m[i][i]);
+	}
+	else {
+		// Gimbal lock: the first and last axes line up, so put all of it on the first
+		axisAngle(euler, i) = std::atan2(-sign * m[j][k], m[j][j]);
+		axisAngle(euler, k) = 0.0;
+	}
+
+	return euler;
+}
+
+Quaternion matrixToQuaternion(const double m[3][3])
+{
+	Quaternion q;
+	double trace = m[0][0] + m[1][1] + m[2][2];
+	if (trace > 0.0) {
+		double s = 2.0 * std::sqrt(trace + 1.0);
+		q.w = 0.25 * s;
+		q.x = (m[2][1] - m[1][2]) / s;
+		q.y = (m[0][2] - m[2][0]) / s;
+		q.z = (m[1][0] - m[0][1]) / s;
+	}
+	else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+		double s = 2.0 * std::sqrt(1.0 + m[0][0] - m[1][1] - m[2][2]);
+		q.w = (m[2][1] - m[1][2]) / s;
+		q.x = 0.25 * s;
+		q.y = (m[0][1] + m[1][0]) / s;
+		q.z = (m[0][2] + m[2][0]) / s;
+	}
+	else if (m[1][1] > m[2][2]) {
+		double s = 2.0 * std::sqrt(1.0 + m[1][1] - m[0][0] - m[2][2]);
+		q.w = (m[0][2] - m[2][0]) / s;
+		q.x = (m[0][1] + m[1][0]) / s;
+		q.y = 0.25 * s;
+		q.z = (m[1][2] + m[2][1]) / s;
+	}
+	else {
+		double s = 2.0 * std::sqrt(1.0 + m[2][2] - m[0][0] - m[1][1]);
+		q.w = (m[1][0] - m[0][1]) / s;
+		q.x = (m[0][2] + m[2][0]) / s;
+		q.y = (m[1][2] + m[2][1]) / s;
+		q.z = 0.25 * s;
+	}
+	return q;
+}
+
+Euler unwrapEuler(const Euler& euler, const Euler& previous, RotateOrder order)
+{
+	AxisOrder axes = axisOrder(order);
+
+	// Every Tait-Bryan order has a second solution: half a turn more on the outer axes and
+	// the middle angle mirrored
+	Euler flipped = euler;
+	axisAngle(flipped, axes.i) += PI;
+	axisAngle(flipped, axes.j) = PI - axisAngle(euler, axes.j);
+	axisAngle(flipped, axes.k) += PI;
+
+	Euler candidates[2] = { euler, flipped };
+	Euler best;
+	double bestDistance = -1.0;
+	for (Euler& candidate : candidates) {
+		candidate.x = nearestTurn(candidate.x, previous.x);
+		candidate.y = nearestTurn(candidate.y, previous.y);
+		candidate.z = nearestTurn(candidate.z, previous.z);
+
+		double distance = std::fabs(candidate.x - previous.x) + std::fabs(candidate.y - previous.y) + std::fabs(candidate.z - previous.z);
+		if (bestDistance < 0.0 || distance < bestDistance) {
+			best = candidate;
+			bestDistance = distance;
+		}
+	}
+	return best;
+}
+
+void AimAxes::resize(size_t count)
+{
+	for (std::vector<double>* component : { &fx, &fy, &fz, &rx, &ry, &rz, &ux, &uy, &uz }) {
+		component->resize(count);
+	}
+}
+
+void completeAimAxes(AimAxes& axes)
+{
+	const size_t count = axes.size();
+	std::vector<double>& fx = axes.fx; std::vector<double>& fy = axes.fy; std::vector<double>& fz = axes.fz;
+	std::vector<double>& rx = axes.rx; std::vector<double>& ry = axes.ry; std::vector<double>& rz = axes.rz;
+	std::vector<double>& ux = axes.ux; std::vector<double>& uy = axes.uy; std::vector<double>& uz = axes.uz;
+
+	// Forward and right axes, flagging samples where the forward runs along the up direction
+	std::vector<char> degenerate(count);
+	for (size_t n = 0; n < count; ++n) {
+		double length = std::sqrt(fx[n] * fx[n] + fy[n] * fy[n] + fz[n] * fz[n]);
+		double inverse = (length > 0.0) ? 1.0 / length : 0.0;
+		fx[n] *= inverse;
+		fy[n] *= inverse;
+		fz[n] *= inverse;
+
+		double upLength = std::sqrt(ux[n] * ux[n] + uy[n] * uy[n] + uz[n] * uz[n]);
+		double upInverse = (upLength > 0.0) ? 1.0 / upLength : 0.0;
+		double upX = ux[n] * upInverse, upY = uy[n] * upInverse, upZ = uz[n] * upInverse;
+
+		rx[n] = fy[n] * upZ - fz[n] * upY;
+		ry[n] = fz[n] * upX - fx[n] * upZ;
+		rz[n] = fx[n] * upY - fy[n] * upX;
+		double rightLength = std::sqrt(rx[n] * rx[n] + ry[n] * ry[n] + rz[n] * rz[n]);
+		degenerate[n] = rightLength < 1e-9 || length == 0.0;
+		double rightInverse = degenerate[n] ? 0.0 : 1.0 / rightLength;
+		rx[n] *= rightInverse;
+		ry[n] *= rightInverse;
+		rz[n] *= rightInverse;
+	}
+
+	// Straight along the up direction: carry the right axis over from the nearest usable sample
+	for (size_t n = 0; n < count; ++n) {
+		if (!degenerate[n]) continue;
+
+		Vec3 forward(fx[n], fy[n], fz[n]);
+		if (forward.length() == 0.0) {
+			forward = Vec3(0.0, 0.0, -1.0);
+			fx[n] = forward.x; fy[n] = forward.y; fz[n] = forward.z;
+		}
+
+		Vec3 right;
+		for (size_t offset = 1; offset < count && right.length() == 0.0; ++offset) {
+			if (n >= offset && !degenerate[n - offset]) {
+				size_t m = n - offset;
+				right = Vec3(rx[m], ry[m], rz[m]);
+			}
+			else if (n + offset < count && !degenerate[n + offset]) {
+				size_t m = n + offset;
+				right = Vec3(rx[m], ry[m], rz[m]);
+			}
+		}
+
+		right = right - forward * right.dot(forward);
+		if (right.length() < 1e-9) {
+			// Matches the yaw of half a turn that a vertical launch gets elsewhere
+			right = forward.cross(Vec3(0.0, 0.0, -1.0));
+			if (right.length() < 1e-9) right = Vec3(1.0, 0.0, 0.0);
+		}
+		right = right.normal();
+		rx[n] = right.x; ry[n] = right.y; rz[n] = right.z;
+	}
+
+	// Camera up, square to forward and right
+	for (size_t n = 0; n < count; ++n) {
+		ux[n] = ry[n] * fz[n] - rz[n] * fy[n];
+		uy[n] = rz[n] * fx[n] - rx[n] * fz[n];
+		uz[n] = rx[n] * fy[n] - ry[n] * fx[n];
+	}
+}
+
+void axesToOrientation(const AimAxes& axes, RotateOrder order, OrientationSamples& orientation)
+{
+	const size_t count = axes.size();
+	orientation.rotateX.resize(count);
+	orientation.rotateY.resize(count);
+	orientation.rotateZ.resize(count);
+	orientation.rotations.resize(count);
+
+	// Camera axes as matrix columns: X right, Y up, Z backwards
+	Euler previous;
+	for (size_t n = 0; n < count; ++n) {
+		double m[3][3] = {
+			{ axes.rx[n], axes.ux[n], -axes.fx[n] },
+			{ axes.ry[n], axes.uy[n], -axes.fy[n] },
+			{ axes.rz[n], axes.uz[n], -axes.fz[n] }
+		};
+
+		Quaternion q = matrixToQuaternion(m);
+		Euler euler = matrixToEuler(m, order);
+
+		// The first sample takes the smaller of the two solutions, the rest follow their neighbour
+		euler = unwrapEuler(euler, previous, order);
+		if (n > 0) {
+			const Quaternion& last = orientation.rotations[n - 1];
+			if (q.x * last.x + q.y * last.y + q.z * last.z + q.w * last.w < 0.0) {
+				q = Quaternion(-q.x, -q.y, -q.z, -q.w);
+			}
+		}
+
+		orientation.rotations[n] = q;
+		orientation.rotateX[n] = euler.x;
+		orientation.rotateY[n] = euler.y;
+		orientation.rotateZ[n] = euler.z;
+		previous = euler;
+	}
+}
+
+void solveOrientations(const TrajectorySamples& samples, const OrientationSettings& settings,
+	OrientationSamples& orientation)
+{
+	const size_t count = samples.size();
+	orientation.rotateX.assign(count, 0.0);
+	orientation.rotateY.assign(count, 0.0);
+	orientation.rotateZ.assign(count, 0.0);
+	orientation.rotations.assign(count, Quaternion());
+	if (count < 2) {
+		return;
+	}
+
+	const double* frames = samples.frames.data();
+
+	// Velocity in units per frame; only its direction matters for the aim
+	AimAxes axes;
+	differentiateSamples(frames, samples.translateX.data(), count, axes.fx);
+	differentiateSamples(frames, samples.translateY.data(), count, axes.fy);
+	differentiateSamples(frames, samples.translateZ.data(), count, axes.fz);
+	const std::vector<double> vx = axes.fx, vy = axes.fy, vz = axes.fz;
+
+	const Vec3 up = settings.up.normal();
+	axes.ux.assign(count, up.x);
+	axes.uy.assign(count, up.y);
+	axes.uz.assign(count, up.z);
+	axes.rx.resize(count);
+	axes.ry.resize(count);
+	axes.rz.resize(count);
+	completeAimAxes(axes);
+
+	// Rolled about the forward axis when banking
+	if (settings.banking != 0.0) {
+		std::vector<double> ax, ay, az;
+		differentiateSamples(frames, vx.data(), count, ax);
+		differentiateSamples(frames, vy.data(), count, ay);
+		differentiateSamples(frames, vz.data(), count, az);
+
+		// Per frame squared to per second squared
+		const double scale = settings.framesPerSecond * settings.framesPerSecond;
+		const double reference = std::fabs(settings.gravity);
+		std::vector<double>& rx = axes.rx; std::vector<double>& ry = axes.ry; std::vector<double>& rz = axes.rz;
+		std::vector<double>& ux = axes.ux; std::vector<double>& uy = axes.uy; std::vector<double>& uz = axes.uz;
+		for (size_t n = 0; n < count; ++n) {
+			double lateral = (ax[n] * rx[n] + ay[n] * ry[n] + az[n] * rz[n]) * scale;
+			double roll = settings.banking * std::atan2(lateral, reference);
+			double c = std::cos(roll);
+			double s = std::sin(roll);
+
+			double nrx = rx[n] * c - ux[n] * s, nry = ry[n] * c - uy[n] * s, nrz = rz[n] * c - uz[n] * s;
+			double nux = ux[n] * c + rx[n] * s, nuy = uy[n] * c + ry[n] * s, nuz = uz[n] * c + rz[n] * s;
+			rx[n] = nrx; ry[n] = nry; rz[n] = nrz;
+			ux[n] = nux; uy[n] = nuy; uz[n] = nuz;
+		}
+	}
+
+	axesToOrientation(axes, settings.rotateOrder, orientation);
+}
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "TrajectoryCore.h"
+#include "TrajectorySampler.h"
+
+namespace LaunchCore {
+
+// Same order and numbering as MEulerRotation::RotationOrder
+enum class RotateOrder {
+	XYZ,
+	YZX,
+	ZXY,
+	XZY,
+	YXZ,
+	ZYX
+};
+
+struct Quaternion {
+	double x = 0.0;
+	double y = 0.0;
+	double z = 0.0;
+	double w = 1.0;
+
+	Quaternion() = default;
+	Quaternion(double x, double y, double z, double w) : x(x), y(y), z(z), w(w) {}
+};
+
+struct OrientationSettings {
+	// World direction the camera's up axis leans towards
+	Vec3 up = Vec3(0.0, 1.0, 0.0);
+	// 0 keeps the horizon level; 1 rolls into sideways acceleration like a coordinated turn
+	double banking = 0.0;
+	// Acceleration the bank angle is measured against, in units per second squared
+	double gravity = -9.81;
+	double framesPerSecond = 24.0;
+	RotateOrder rotateOrder = RotateOrder::XYZ;
+};
+
+// Per-sample camera orientation, one array per channel
+struct OrientationSamples {
+	std::vector<double> rotateX;
+	std::vector<double> rotateY;
+	std::vector<double> rotateZ;
+	// Kept in one hemisphere from sample to sample
+	std::vector<Quaternion> rotations;
+
+	size_t size() const { return rotateX.size(); }
+};
+
+// Rotation matrix (column vectors, world = m * local) for Euler angles applied in 'order'
+void eulerToMatrix(const Euler& euler, RotateOrder order, double m[3][3]);
+
+// One Euler solution for a rotation matrix, in 'order'
+Euler matrixToEuler(const double m[3][3], RotateOrder order);
+
+Quaternion matrixToQuaternion(const double m[3][3]);
+
+// Picks the Euler triple equivalent to 'euler' that is closest to 'previous', trying both
+// solutions of the order and whole turns on each angle
+Euler unwrapEuler(const Euler& euler, const Euler& previous, RotateOrder order);
+
+// Camera axes for every sample, one array per component
+struct AimAxes {
+	std::vector<double> fx, fy, fz;
+	std::vector<double> rx, ry, rz;
+	std::vector<double> ux, uy, uz;
+
+	void resize(size_t count);
+	size_t size() const { return fx.size(); }
+};
+
+// Turns forward directions (f, any length) and the world directions the camera's up leans
+// towards (u) into an orthonormal forward, right and up for every sample. Samples aiming
+// along their up, or without a forward at all, borrow the right axis of the nearest sample
+// that has one.
+void completeAimAxes(AimAxes& axes);
+
+// Rotations of cameras (-Z forward, +Y up) with the given axes, kept continuous from sample to sample
+void axesToOrientation(const AimAxes& axes, RotateOrder order, OrientationSamples& orientation);
+
+// Aims the camera (-Z forward, +Y up) along the velocity of every sample. Velocity and, for
+// banking, acceleration are differentiated from the sampled positions. Each stage is a flat
+// loop over samples; only hemisphere and Euler continuity run as a sequential pass.
+void solveOrientations(const TrajectorySamples& samples, const OrientationSettings& settings,
+	OrientationSamples& orientation);
+
+}
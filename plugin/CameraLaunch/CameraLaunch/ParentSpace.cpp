@@ -0,0 +1,211 @@
+#include "ParentSpace.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace LaunchCore {
+
+namespace {
+
+// Frames computed the same way on both sides compare equal; this only absorbs rounding
+const double kFrameTolerance = 1e-9;
+
+const double kIdentity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+// Inverse of the upper 3x3 of a row-major 4x4 matrix
+bool invertLinear(const double matrix[16], double inverse[3][3])
+{
+	const double a = matrix[0], b = matrix[1], c = matrix[2];
+	const double d = matrix[4], e = matrix[5], f = matrix[6];
+	const double g = matrix[8], h = matrix[9], i = matrix[10];
+
+	double determinant = a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+	if (determinant == 0.0) {
+		return false;
+	}
+
+	double s = 1.0 / determinant;
+	inverse[0][0] = (e * i - f * h) * s; inverse[0][1] = (c * h - b * i) * s; inverse[0][2] = (b * f - c * e) * s;
+	inverse[1][0] = (f * g - d * i) * s; inverse[1][1] = (a * i - c * g) * s; inverse[1][2] = (c * d - a * f) * s;
+	inverse[2][0] = (d * h - e * g) * s; inverse[2][1] = (b * g - a * h) * s; inverse[2][2] = (a * e - b * d) * s;
+	return true;
+}
+
+}
+
+void ParentMatrices::missingFrames(const double* frames, size_t count, std::vector<double>& missing) const
+{
+	missing.clear();
+	for (size_t i = 0; i < count; ++i) {
+		if (!find(frames[i])) {
+			missing.push_back(frames[i]);
+		}
+	}
+
+	std::sort(missing.begin(), missing.end());
+	missing.erase(std::unique(missing.begin(), missing.end(), [](double a, double b) {
+		return std::fabs(a - b) <= kFrameTolerance;
+	}), missing.end());
+}
+
+void ParentMatrices::insert(const std::vector<double>& frames, const std::vector<double>& matrices)
+{
+	// Merged in one pass so the arrays stay in frame order
+	std::vector<double> mergedFrames;
+	std::vector<double> mergedMatrices;
+	mergedFrames.reserve(m_frames.size() + frames.size());
+	mergedMatrices.reserve(m_matrices.size() + matrices.size());
+
+	size_t a = 0, b = 0;
+	while (a < m_frames.size() || b < frames.size()) {
+		bool takeOwn = b == frames.size() || (a < m_frames.size() && m_frames[a] < frames[b]);
+		const double* matrix = takeOwn ? &m_matrices[a * 16] : &matrices[b * 16];
+		mergedFrames.push_back(takeOwn ? m_frames[a++] : frames[b++]);
+		mergedMatrices.insert(mergedMatrices.end(), matrix, matrix + 16);
+	}
+
+	m_frames.swap(mergedFrames);
+	m_matrices.swap(mergedMatrices);
+}
+
+const double* ParentMatrices::find(double frame) const
+{
+	auto it = std::lower_bound(m_frames.begin(), m_frames.end(), frame - kFrameTolerance);
+	if (it == m_frames.end() || *it > frame + kFrameTolerance) {
+		return nullptr;
+	}
+	return &m_matrices[(size_t)(it - m_frames.begin()) * 16];
+}
+
+Vec3 transformPoint(const double matrix[16], const Vec3& point)
+{
+	return Vec3(
+		point.x * matrix[0] + point.y * matrix[4] + point.z * matrix[8] + matrix[12],
+		point.x * matrix[1] + point.y * matrix[5] + point.z * matrix[9] + matrix[13],
+		point.x * matrix[2] + point.y * matrix[6] + point.z * matrix[10] + matrix[14]);
+}
+
+Vec3 inverseTransformPoint(const double matrix[16], const Vec3& point)
+{
+	double inverse[3][3];
+	if (!invertLinear(matrix, inverse)) {
+		return point;
+	}
+
+	Vec3 p(point.x - matrix[12], point.y - matrix[13], point.z - matrix[14]);
+	return Vec3(
+		p.x * inverse[0][0] + p.y * inverse[1][0] + p.z * inverse[2][0],
+		p.x * inverse[0][1] + p.y * inverse[1][1] + p.z * inverse[2][1],
+		p.x * inverse[0][2] + p.y * inverse[1][2] + p.z * inverse[2][2]);
+}
+
+void reparentMatrix(const double world[16], const double parentFrom[16], const double parentTo[16], double out[16])
+{
+	double inverse[3][3];
+	if (!invertLinear(parentFrom, inverse)) {
+		std::copy(world, world + 16, out);
+		return;
+	}
+
+	// Local rows are the world rows taken back through the old parent, then out through the new one
+	for (int row = 0; row < 4; ++row) {
+		const double* w = &world[row * 4];
+		const double point = (row == 3) ? 1.0 : 0.0;
+		double local[3];
+		for (int column = 0; column < 3; ++column) {
+			local[column] = 0.0;
+			for (int k = 0; k < 3; ++k) {
+				local[column] += (w[k] - point * parentFrom[12 + k]) * inverse[k][column];
+			}
+		}
+
+		for (int column = 0; column < 4; ++column) {
+			out[row * 4 + column] = local[0] * parentTo[column] + local[1] * parentTo[4 + column]
+				+ local[2] * parentTo[8 + column] + point * parentTo[12 + column];
+		}
+	}
+}
+
+Vec3 inheritedVelocity(const ParentMatrices& parent, const Vec3& local, double frame, double step, double framesPerSecond)
+{
+	const double* before = parent.find(frame - step);
+	const double* after = parent.find(frame + step);
+	if (!before || !after || step <= 0.0) {
+		return Vec3();
+	}
+
+	return (transformPoint(after, local) - transformPoint(before, local)) * (framesPerSecond / (2.0 * step));
+}
+
+TrajectoryView LocalTrajectory::view() const
+{
+	TrajectoryView view;
+	view.count = frames.size();
+	view.frames = frames.data();
+	view.translateX = translateX.data();
+	view.translateY = translateY.data();
+	view.translateZ = translateZ.data();
+	view.rotateX = rotateX.data();
+	view.rotateY = rotateY.data();
+	view.rotateZ = rotateZ.data();
+	return view;
+}
+
+void toParentSpace(const TrajectoryView& world, const ParentMatrices& parent, RotateOrder order, LocalTrajectory& local)
+{
+	const size_t count = world.count;
+	local.frames.assign(world.frames, world.frames + count);
+	local.translateX.resize(count);
+	local.translateY.resize(count);
+	local.translateZ.resize(count);
+	local.rotateX.resize(count);
+	local.rotateY.resize(count);
+	local.rotateZ.resize(count);
+
+	Euler previous;
+	for (size_t s = 0; s < count; ++s) {
+		const double* matrix = parent.find(world.frames[s]);
+		if (!matrix) {
+			matrix = kIdentity;
+		}
+
+		Vec3 position = inverseTransformPoint(matrix, Vec3(world.translateX[s], world.translateY[s], world.translateZ[s]));
+		local.translateX[s] = position.x;
+		local.translateY[s] = position.y;
+		local.translateZ[s] = position.z;
+
+		// Parent rotation: its axes are the matrix rows, normalised to drop scale
+		double axes[3][3];
+		for (int row = 0; row < 3; ++row) {
+			Vec3 axis = Vec3(matrix[row * 4], matrix[row * 4 + 1], matrix[row * 4 + 2]).normal();
+			axes[row][0] = axis.x;
+			axes[row][1] = axis.y;
+			axes[row][2] = axis.z;
+		}
+
+		Euler worldEuler;
+		worldEuler.x = world.rotateX[s];
+		worldEuler.y = world.rotateY[s];
+		worldEuler.z = world.rotateZ ? world.rotateZ[s] : 0.0;
+
+		double rotation[3][3];
+		eulerToMatrix(worldEuler, order, rotation);
+
+		// Column-vector world = parent * local, so local = parent^T * world
+		double localRotation[3][3];
+		for (int i = 0; i < 3; ++i) {
+			for (int j = 0; j < 3; ++j) {
+				localRotation[i][j] = axes[i][0] * rotation[0][j] + axes[i][1] * rotation[1][j] + axes[i][2] * rotation[2][j];
+			}
+		}
+
+		// The first sample stays near its world angles, so an unrotated parent changes nothing
+		Euler localEuler = unwrapEuler(matrixToEuler(localRotation, order), (s == 0) ? worldEuler : previous, order);
+		local.rotateX[s] = localEuler.x;
+		local.rotateY[s] = localEuler.y;
+		local.rotateZ[s] = localEuler.z;
+		previous = localEuler;
+	}
+}
+
+}
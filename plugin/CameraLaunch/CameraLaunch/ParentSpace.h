@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "OrientationSolver.h"
+#include "TrajectoryCache.h"
+
+namespace LaunchCore {
+
+// World matrices of a launched object's parent, evaluated once per frame and kept in frame order.
+// Matrices are row-major 4x4 like MMatrix: points are row vectors and the translation is the last row.
+class ParentMatrices
+{
+public:
+	size_t size() const { return m_frames.size(); }
+	const std::vector<double>& frames() const { return m_frames; }
+
+	// Frames out of 'frames' that are not cached yet, sorted and without duplicates
+	void missingFrames(const double* frames, size_t count, std::vector<double>& missing) const;
+	// Adds one matrix per frame; 'frames' must be sorted and not cached yet
+	void insert(const std::vector<double>& frames, const std::vector<double>& matrices);
+
+	// Matrix cached for 'frame', or null
+	const double* find(double frame) const;
+
+private:
+	std::vector<double> m_frames;
+	// 16 values per frame
+	std::vector<double> m_matrices;
+};
+
+// 'point' moved by a row-major matrix, and back into its space by the inverse
+Vec3 transformPoint(const double matrix[16], const Vec3& point);
+Vec3 inverseTransformPoint(const double matrix[16], const Vec3& point);
+
+// 'world' moved from under 'parentFrom' to under 'parentTo' with its local matrix kept:
+// world * inverse(parentFrom) * parentTo. 'world' is returned unchanged when 'parentFrom' is singular.
+void reparentMatrix(const double world[16], const double parentFrom[16], const double parentTo[16], double out[16]);
+
+// Velocity in units per second of a point fixed in the parent's space at 'local', from the
+// parent matrices at frame - step and frame + step, both of which must be cached
+Vec3 inheritedVelocity(const ParentMatrices& parent, const Vec3& local, double frame, double step, double framesPerSecond);
+
+// Flight re-expressed in its parent's space, one array per channel
+struct LocalTrajectory {
+	std::vector<double> frames;
+	std::vector<double> translateX;
+	std::vector<double> translateY;
+	std::vector<double> translateZ;
+	std::vector<double> rotateX;
+	std::vector<double> rotateY;
+	std::vector<double> rotateZ;
+
+	TrajectoryView view() const;
+};
+
+// Moves every world-space sample into the parent's space at its own frame. Positions go through
+// the inverse parent matrix; rotations in 'order' have the parent's rotation, with scale
+// removed, taken off and are kept continuous from sample to sample. A world view without
+// rotateZ has no roll. Every sample frame must be cached.
+void toParentSpace(const TrajectoryView& world, const ParentMatrices& parent, RotateOrder order, LocalTrajectory& local);
+
+}
@@ -0,0 +1,76 @@
+#include "ThreadPool.h"
+
+namespace LaunchCore {
+
+ThreadPool::ThreadPool(size_t threadCount)
+	: m_running(0)
+	, m_stopping(false)
+{
+	if (threadCount == 0) {
+		threadCount = std::thread::hardware_concurrency();
+	}
+	if (threadCount == 0) {
+		threadCount = 1;
+	}
+
+	m_workers.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; ++i) {
+		m_workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_taskReady.notify_all();
+
+	for (std::thread& worker : m_workers) {
+		worker.join();
+	}
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tasks.push_back(std::move(task));
+	}
+	m_taskReady.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.wait(lock, [this] { return m_tasks.empty() && m_running == 0; });
+}
+
+void ThreadPool::workerLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;) {
+		m_taskReady.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+
+		// Queued tasks still run on shutdown, so nothing submitted is silently dropped
+		if (m_tasks.empty()) {
+			return;
+		}
+
+		std::function<void()> task = std::move(m_tasks.front());
+		m_tasks.pop_front();
+		++m_running;
+
+		lock.unlock();
+		task();
+		lock.lock();
+
+		--m_running;
+		if (m_tasks.empty() && m_running == 0) {
+			m_idle.notify_all();
+		}
+	}
+}
+
+}
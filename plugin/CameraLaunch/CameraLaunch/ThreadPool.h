@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LaunchCore {
+
+// Fixed set of worker threads draining a FIFO of tasks. Tasks must not throw; anything they
+// produce goes through state they own (eg. one output slot per job).
+class ThreadPool
+{
+public:
+	// Zero uses one thread per hardware thread
+	explicit ThreadPool(size_t threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	size_t threadCount() const { return m_workers.size(); }
+
+	void submit(std::function<void()> task);
+
+	// Blocks until every submitted task has finished
+	void wait();
+
+private:
+	void workerLoop();
+
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_taskReady;
+	std::condition_variable m_idle;
+	size_t m_running;
+	bool m_stopping;
+};
+
+}
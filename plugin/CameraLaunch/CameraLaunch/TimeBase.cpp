@@ -0,0 +1,16 @@
+#include "TimeBase.h"
+
+namespace LaunchCore {
+
+TimeBase::TimeBase() : TimeBase(24.0)
+{
+}
+
+TimeBase::TimeBase(double framesPerSecond, int samplesPerFrame)
+	: m_framesPerSecond(framesPerSecond)
+	, m_secondsPerFrame(1.0 / framesPerSecond)
+	, m_samplesPerFrame((samplesPerFrame > 0) ? samplesPerFrame : 1)
+{
+}
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace LaunchCore {
+
+// Scene frame rate and output sampling for one run of the command, resolved once up front so
+// nothing downstream converts through the host's time units per key. Frames are doubles
+// throughout: launches may start, and keys may land, between whole frames.
+class TimeBase
+{
+public:
+	TimeBase();
+	explicit TimeBase(double framesPerSecond, int samplesPerFrame = 1);
+
+	double framesPerSecond() const { return m_framesPerSecond; }
+	double secondsPerFrame() const { return m_secondsPerFrame; }
+	int samplesPerFrame() const { return m_samplesPerFrame; }
+
+	double toSeconds(double frames) const { return frames * m_secondsPerFrame; }
+	double toFrames(double seconds) const { return seconds * m_framesPerSecond; }
+
+	// Frames between baked samples for a bake step of 'frameStep' frames, split into
+	// samplesPerFrame sub-frame samples so motion blur sees the arc between frames
+	double sampleStep(double frameStep) const { return frameStep / m_samplesPerFrame; }
+
+private:
+	double m_framesPerSecond;
+	double m_secondsPerFrame;
+	int m_samplesPerFrame;
+};
+
+}
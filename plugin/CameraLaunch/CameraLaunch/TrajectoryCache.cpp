@@ -0,0 +1,376 @@
+#include "TrajectoryCache.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LaunchCore {
+
+namespace {
+
+const char CACHE_MAGIC[8] = { 'C', 'L', 'T', 'R', 'A', 'J', '\0', '\0' };
+const uint32_t CACHE_VERSION = 1;
+// Reads back as 0x04030201 on a host of the other byte order
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+const size_t CHANNEL_ALIGNMENT = 64;
+const size_t CHANNEL_COUNT = 7;
+
+struct CacheHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint64_t key;
+	uint64_t count;
+	double framesPerSecond;
+	// Bytes from the start of one channel to the next
+	uint64_t channelStride;
+	uint8_t reserved[16];
+};
+static_assert(sizeof(CacheHeader) == 64, "The cache header is exactly one channel alignment");
+
+uint64_t channelStride(uint64_t count)
+{
+	uint64_t bytes = count * sizeof(double);
+	return (bytes + CHANNEL_ALIGNMENT - 1) / CHANNEL_ALIGNMENT * CHANNEL_ALIGNMENT;
+}
+
+void setError(std::string* error, const std::string& message)
+{
+	if (error) {
+		*error = message;
+	}
+}
+
+// Temp file next to 'path' that no other writer uses: processes sharing a cache directory differ
+// by pid, bake threads by thread id, and repeated writes from one thread by the counter
+std::string partialPathFor(const std::string& path)
+{
+	static std::atomic<unsigned long long> counter(0);
+#ifdef _WIN32
+	unsigned long long pid = (unsigned long long)_getpid();
+#else
+	unsigned long long pid = (unsigned long long)getpid();
+#endif
+	unsigned long long thread = (unsigned long long)std::hash<std::thread::id>()(std::this_thread::get_id());
+
+	char suffix[80];
+	std::snprintf(suffix, sizeof(suffix), ".%llu.%llx.%llu.partial", pid, thread, counter++);
+	return path + suffix;
+}
+
+}
+
+TrajectoryView viewTrajectory(const TrajectorySamples& samples, const OrientationSamples* orientation)
+{
+	TrajectoryView view;
+	view.count = samples.size();
+	view.frames = samples.frames.data();
+	view.translateX = samples.translateX.data();
+	view.translateY = samples.translateY.data();
+	view.translateZ = samples.translateZ.data();
+
+	if (orientation && orientation->size() == samples.size()) {
+		view.rotateX = orientation->rotateX.data();
+		view.rotateY = orientation->rotateY.data();
+		view.rotateZ = orientation->rotateZ.data();
+	}
+	else {
+		view.rotateX = samples.rotateX.data();
+		view.rotateY = samples.rotateY.data();
+	}
+	return view;
+}
+
+CacheKey::CacheKey()
+	: m_hash(14695981039346656037ull)
+{
+}
+
+CacheKey& CacheKey::add(double value)
+{
+	if (value == 0.0) {
+		value = 0.0;
+	}
+
+	return addBytes(&value, sizeof(double));
+}
+
+CacheKey& CacheKey::add(int value)
+{
+	return add((double)value);
+}
+
+CacheKey& CacheKey::add(uint64_t value)
+{
+	return addBytes(&value, sizeof(uint64_t));
+}
+
+CacheKey& CacheKey::add(const Vec3& value)
+{
+	return add(value.x).add(value.y).add(value.z);
+}
+
+CacheKey& CacheKey::addBytes(const void* data, size_t size)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		m_hash = (m_hash ^ bytes[i]) * 1099511628211ull;
+	}
+	return *this;
+}
+
+std::string CacheKey::fileName() const
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.cltraj", (unsigned long long)m_hash);
+	return name;
+}
+
+CacheKey flightCacheKey(const LaunchParams& params, const double* startMatrix, const FlightOptions& options)
+{
+	CacheKey key;
+	key.add((int)CACHE_VERSION);
+	key.add(params.velocity).add(params.gravity).add(params.startFrame).add(params.framesPerSecond).add(params.flightTime);
+
+	if (startMatrix) {
+		for (int i = 0; i < 16; ++i) {
+			key.add(startMatrix[i]);
+		}
+	}
+	else {
+		key.add(params.startPosition);
+	}
+
+	key.add(options.frameStep);
+	key.add(options.drag.linear).add(options.drag.quadratic).add(options.drag.mass);
+	key.add(options.bounces.bounces).add(options.bounces.restitution).add(options.bounces.friction);
+	// Flights without a field keep the keys they had before fields existed
+	if (options.field.active()) {
+		key.add(options.field.field->fingerprint()).add((int)options.field.kind).add(options.field.scale);
+	}
+	if (options.wells.active()) {
+		const GravityWellSettings& wells = options.wells;
+		key.add(wells.attractors->fingerprint()).add(wells.strength).add(wells.softening).add(wells.theta);
+	}
+	return key;
+}
+
+void addOrientationToKey(CacheKey& key, const OrientationSettings& settings)
+{
+	key.add(settings.up).add(settings.banking).add(settings.gravity).add(settings.framesPerSecond).add((int)settings.rotateOrder);
+}
+
+bool writeTrajectoryCache(const std::string& path, uint64_t key, double framesPerSecond,
+	const TrajectoryView& trajectory, std::string* error)
+{
+	CacheHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+	header.version = CACHE_VERSION;
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.key = key;
+	header.count = trajectory.count;
+	header.framesPerSecond = framesPerSecond;
+	header.channelStride = channelStride(trajectory.count);
+
+	const double* channels[CHANNEL_COUNT] = {
+		trajectory.frames, trajectory.translateX, trajectory.translateY, trajectory.translateZ,
+		trajectory.rotateX, trajectory.rotateY, trajectory.rotateZ
+	};
+
+	std::string partialPath = partialPathFor(path);
+	{
+		std::ofstream out(partialPath, std::ios::binary | std::ios::trunc);
+		if (!out) {
+			setError(error, "Could not write " + partialPath);
+			return false;
+		}
+
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		const size_t bytes = trajectory.count * sizeof(double);
+		std::vector<char> padding(header.channelStride - bytes, 0);
+		std::vector<double> zeros;
+		for (const double* channel : channels) {
+			if (!channel) {
+				zeros.assign(trajectory.count, 0.0);
+				channel = zeros.data();
+			}
+			out.write(reinterpret_cast<const char*>(channel), (std::streamsize)bytes);
+			out.write(padding.data(), (std::streamsize)padding.size());
+		}
+
+		if (!out) {
+			setError(error, "Could not write " + partialPath);
+			out.close();
+			std::remove(partialPath.c_str());
+			return false;
+		}
+	}
+
+	bool moved = std::rename(partialPath.c_str(), path.c_str()) == 0;
+#ifdef _WIN32
+	// Windows will not rename over an existing file; only then is the old cache taken out of the way
+	if (!moved && errno == EEXIST) {
+		std::remove(path.c_str());
+		moved = std::rename(partialPath.c_str(), path.c_str()) == 0;
+	}
+#endif
+	if (!moved) {
+		setError(error, "Could not move the cache into place at " + path);
+		std::remove(partialPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+MappedTrajectoryCache::MappedTrajectoryCache()
+	: m_data(nullptr)
+	, m_size(0)
+	, m_key(0)
+	, m_framesPerSecond(0.0)
+#ifdef _WIN32
+	, m_file(nullptr)
+	, m_mapping(nullptr)
+#endif
+{
+}
+
+MappedTrajectoryCache::~MappedTrajectoryCache()
+{
+	close();
+}
+
+bool MappedTrajectoryCache::open(const std::string& path, std::string* error)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		setError(error, "Could not open " + path);
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	HANDLE mapping = nullptr;
+	const void* data = nullptr;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= (LONGLONG)sizeof(CacheHeader)) {
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping) {
+			data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		}
+	}
+	if (!data) {
+		if (mapping) CloseHandle(mapping);
+		CloseHandle(file);
+		setError(error, "Could not map " + path);
+		return false;
+	}
+
+	m_file = file;
+	m_mapping = mapping;
+	m_size = (size_t)fileSize.QuadPart;
+#else
+	int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		setError(error, "Could not open " + path);
+		return false;
+	}
+
+	struct stat status;
+	void* data = MAP_FAILED;
+	if (fstat(file, &status) == 0 && status.st_size >= (off_t)sizeof(CacheHeader)) {
+		data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	}
+	// The mapping keeps the file alive on its own
+	::close(file);
+	if (data == MAP_FAILED) {
+		setError(error, "Could not map " + path);
+		return false;
+	}
+
+	m_size = (size_t)status.st_size;
+#endif
+	m_data = static_cast<const unsigned char*>(data);
+
+	const CacheHeader* header = reinterpret_cast<const CacheHeader*>(m_data);
+	std::string problem;
+	if (std::memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) {
+		problem = " is not a trajectory cache";
+	}
+	else if (header->byteOrder != BYTE_ORDER_MARK) {
+		problem = " was written with a different byte order";
+	}
+	else if (header->version != CACHE_VERSION) {
+		problem = " is an unsupported cache version";
+	}
+	// A count too large for the file would overflow the stride below
+	else if (header->count > (m_size - sizeof(CacheHeader)) / (CHANNEL_COUNT * sizeof(double))
+		|| header->channelStride != channelStride(header->count)
+		|| m_size < sizeof(CacheHeader) + CHANNEL_COUNT * header->channelStride) {
+		problem = " is truncated";
+	}
+	if (!problem.empty()) {
+		close();
+		setError(error, path + problem);
+		return false;
+	}
+
+	m_key = header->key;
+	m_framesPerSecond = header->framesPerSecond;
+
+	const double* channels[CHANNEL_COUNT];
+	for (size_t i = 0; i < CHANNEL_COUNT; ++i) {
+		channels[i] = reinterpret_cast<const double*>(m_data + sizeof(CacheHeader) + i * header->channelStride);
+	}
+	m_view.count = (size_t)header->count;
+	m_view.frames = channels[0];
+	m_view.translateX = channels[1];
+	m_view.translateY = channels[2];
+	m_view.translateZ = channels[3];
+	m_view.rotateX = channels[4];
+	m_view.rotateY = channels[5];
+	m_view.rotateZ = channels[6];
+	return true;
+}
+
+void MappedTrajectoryCache::close()
+{
+	if (m_data) {
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle((HANDLE)m_mapping);
+		CloseHandle((HANDLE)m_file);
+		m_mapping = nullptr;
+		m_file = nullptr;
+#else
+		munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_key = 0;
+	m_framesPerSecond = 0.0;
+	m_view = TrajectoryView();
+}
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "FlightPath.h"
+#include "OrientationSolver.h"
+
+namespace LaunchCore {
+
+// Borrowed per-sample channels of a baked flight, each 'count' long. A null rotateZ reads as zero.
+struct TrajectoryView {
+	size_t count = 0;
+	const double* frames = nullptr;
+	const double* translateX = nullptr;
+	const double* translateY = nullptr;
+	const double* translateZ = nullptr;
+	const double* rotateX = nullptr;
+	const double* rotateY = nullptr;
+	const double* rotateZ = nullptr;
+};
+
+// Sampled flight with its look-along rotation, or the solved orientation when one is given
+TrajectoryView viewTrajectory(const TrajectorySamples& samples, const OrientationSamples* orientation = nullptr);
+
+// FNV-1a over every value added, in order. -0.0 hashes like 0.0.
+class CacheKey
+{
+public:
+	CacheKey();
+
+	CacheKey& add(double value);
+	CacheKey& add(int value);
+	CacheKey& add(uint64_t value);
+	CacheKey& add(const Vec3& value);
+	// Raw bytes as they are, eg. a packed float array
+	CacheKey& addBytes(const void* data, size_t size);
+
+	uint64_t value() const { return m_hash; }
+
+	// Sixteen hex digits and the cache extension, eg. "0123456789abcdef.cltraj"
+	std::string fileName() const;
+
+private:
+	uint64_t m_hash;
+};
+
+// Key over everything that shapes a sampled flight: velocity, gravity, start frame, fps, the
+// start matrix (row-major, or null to use the start position) and the drag, step, bounce, field
+// and gravity well options. Collision geometry is not covered; flights against geometry should not be cached.
+CacheKey flightCacheKey(const LaunchParams& params, const double* startMatrix, const FlightOptions& options);
+
+// Adds the settings of a per-frame orientation solve to 'key'
+void addOrientationToKey(CacheKey& key, const OrientationSettings& settings);
+
+// Writes 'trajectory' as a cache file: a 64 byte header followed by the frame, translate and
+// rotate channels as little-endian doubles, each starting on a 64 byte boundary. The file is
+// written next to 'path' and renamed into place, so readers never see a partial cache.
+bool writeTrajectoryCache(const std::string& path, uint64_t key, double framesPerSecond,
+	const TrajectoryView& trajectory, std::string* error = nullptr);
+
+// Read-only memory mapping of a cache file. The channels point straight into the mapping and
+// stay valid until close() or destruction; nothing is parsed or copied.
+class MappedTrajectoryCache
+{
+public:
+	MappedTrajectoryCache();
+	~MappedTrajectoryCache();
+
+	MappedTrajectoryCache(const MappedTrajectoryCache&) = delete;
+	MappedTrajectoryCache& operator=(const MappedTrajectoryCache&) = delete;
+
+	// Fails on a missing, truncated or foreign file, or one written with another byte order
+	bool open(const std::string& path, std::string* error = nullptr);
+	void close();
+
+	bool isOpen() const { return m_data != nullptr; }
+	uint64_t key() const { return m_key; }
+	double framesPerSecond() const { return m_framesPerSecond; }
+	const TrajectoryView& trajectory() const { return m_view; }
+
+private:
+	const unsigned char* m_data;
+	size_t m_size;
+	uint64_t m_key;
+	double m_framesPerSecond;
+	TrajectoryView m_view;
+#ifdef _WIN32
+	void* m_file;
+	void* m_mapping;
+#endif
+};
+
+}
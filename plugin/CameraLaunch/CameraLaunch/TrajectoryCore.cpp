@@ -0,0 +1,175 @@
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+Vec3 positionAtTime(const LaunchParams& params, double seconds)
+{
+	const Vec3& p = params.startPosition;
+	const Vec3& v = params.velocity;
+
+	return Vec3(
+		p.x + v.x * seconds,
+		p.y + v.y * seconds + 0.5 * params.gravity * seconds * seconds,
+		p.z + v.z * seconds);
+}
+
+Vec3 velocityAtTime(const LaunchParams& params, double seconds)
+{
+	const Vec3& v = params.velocity;
+	return Vec3(v.x, v.y + params.gravity * seconds, v.z);
+}
+
+double timeToApex(const LaunchParams& params)
+{
+	return -params.velocity.y / params.gravity;
+}
+
+double timeToHeight(const LaunchParams& params, double height)
+{
+	// 0.5 g t^2 + vy t + (y0 - height) = 0, taking the later (descending) root
+	double a = 0.5 * params.gravity;
+	double b = params.velocity.y;
+	double c = params.startPosition.y - height;
+
+	if (a >= 0.0) {
+		return -1.0;
+	}
+
+	double discriminant = b * b - 4.0 * a * c;
+	if (discriminant < 0.0) {
+		return -1.0;
+	}
+
+	double t = (-b - std::sqrt(discriminant)) / (2.0 * a);
+	return (t >= 0.0) ? t : -1.0;
+}
+
+double landingTime(const LaunchParams& params)
+{
+	// Explicit flight time, eg. from a target solve
+	if (params.flightTime > 0.0) {
+		return params.flightTime;
+	}
+
+	// Exact touchdown, not the whole frame after it
+	double touchdown = timeToHeight(params, params.startPosition.y);
+	if (touchdown > 0.0) {
+		return touchdown;
+	}
+
+	// No vertical velocity or positive gravity: it never comes back, so run for 120 frames
+	return 120.0 * params.secondsPerFrame();
+}
+
+double calculateFlightFrames(const LaunchParams& params)
+{
+	return landingTime(params) * params.framesPerSecond;
+}
+
+std::vector<double> getKeyFrameNumbers(const LaunchParams& params)
+{
+	std::vector<double> frameNumbers;
+
+	frameNumbers.push_back(params.startFrame);
+	frameNumbers.push_back(apexFrame(params));
+	frameNumbers.push_back(params.startFrame + landingTime(params) * params.framesPerSecond);
+
+	return frameNumbers;
+}
+
+std::vector<Vec3> calculateTrajectory(const LaunchParams& params)
+{
+	std::vector<Vec3> keyframes;
+
+	keyframes.push_back(params.startPosition);
+	keyframes.push_back(positionAtTime(params, timeToApex(params)));
+
+	keyframes.push_back(positionAtTime(params, landingTime(params)));
+
+	return keyframes;
+}
+
+std::vector<Euler> calculateRotations(const LaunchParams& params)
+{
+	std::vector<Euler> rotKeyframes;
+
+	Vec3 normalizeVelocity = params.velocity.normal();
+
+	// Set start rotation to be facing the direction of the input velocity
+	const double PI = std::atan(1.0) * 4;
+	double yaw = std::atan2(normalizeVelocity.x, normalizeVelocity.z) + PI;
+	double pitch = std::asin(normalizeVelocity.y);
+
+	rotKeyframes.push_back(Euler(pitch, yaw, 0));
+
+	// Set the middle rotation to be a pitch of zero, facing along the trajectory
+	rotKeyframes.push_back(Euler(0, yaw, 0));
+
+	// Set the end rotation to be the negation of the input velocity
+	Vec3 flippedNormalizedVelocity = -normalizeVelocity;
+	pitch = std::asin(flippedNormalizedVelocity.y);
+	rotKeyframes.push_back(Euler(pitch, yaw, 0));
+
+	return rotKeyframes;
+}
+
+Euler lookAlongVelocity(const Vec3& velocity, double previousYaw)
+{
+	const double PI = std::atan(1.0) * 4;
+	double horizontalSpeed = std::sqrt(velocity.x * velocity.x + velocity.z * velocity.z);
+	double pitch = (velocity.y == 0.0 && horizontalSpeed == 0.0) ? 0.0 : std::atan2(velocity.y, horizontalSpeed);
+
+	double yaw = (horizontalSpeed > 0.0) ? std::atan2(velocity.x, velocity.z) + PI : previousYaw;
+	yaw += 2.0 * PI * std::round((previousYaw - yaw) / (2.0 * PI));
+
+	return Euler(pitch, yaw, 0.0);
+}
+
+double apexFrame(const LaunchParams& params)
+{
+	return params.startFrame + timeToApex(params) * params.framesPerSecond;
+}
+
+std::vector<ParabolicKey> calculateParabolicKeys(const LaunchParams& params)
+{
+	const double PI = std::atan(1.0) * 4;
+	const double fps = params.framesPerSecond;
+	const double totalTime = landingTime(params);
+
+	double middleTime = timeToApex(params);
+	if (!(middleTime > 0.0 && middleTime < totalTime)) {
+		middleTime = 0.5 * totalTime;
+	}
+
+	const double times[3] = { 0.0, middleTime, totalTime };
+	const KeyframeType types[3] = { KeyframeType::START, KeyframeType::MIDDLE, KeyframeType::END };
+
+	// Same heading as calculateRotations, including the half turn of a vertical launch
+	Vec3 direction = params.velocity.normal();
+	double yaw = std::atan2(direction.x, direction.z) + PI;
+
+	std::vector<ParabolicKey> keys(3);
+	for (int i = 0; i < 3; ++i) {
+		Vec3 velocity = velocityAtTime(params, times[i]);
+
+		ParabolicKey& key = keys[i];
+		key.frame = params.startFrame + times[i] * fps;
+		key.type = types[i];
+		key.position = positionAtTime(params, times[i]);
+		key.rotation = lookAlongVelocity(velocity, yaw);
+		key.inSlope = key.outSlope = velocity * (1.0 / fps);
+	}
+
+	setParabolicWeights(keys);
+	return keys;
+}
+
+void setParabolicWeights(std::vector<ParabolicKey>& keys)
+{
+	for (size_t i = 0; i < keys.size(); ++i) {
+		keys[i].inWeight = (i > 0) ? (keys[i].frame - keys[i - 1].frame) / 3.0 : 0.0;
+		keys[i].outWeight = (i + 1 < keys.size()) ? (keys[i + 1].frame - keys[i].frame) / 3.0 : 0.0;
+	}
+}
+
+}
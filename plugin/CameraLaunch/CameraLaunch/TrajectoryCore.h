@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+// Maya-independent launch math. Everything in here works in plain doubles so it
+// can be built and tested without a Maya install (see CMakeLists.txt).
+namespace LaunchCore {
+
+struct Vec3 {
+	double x = 0.0;
+	double y = 0.0;
+	double z = 0.0;
+
+	Vec3() = default;
+	Vec3(double x, double y, double z) : x(x), y(y), z(z) {}
+
+	Vec3 operator+(const Vec3& o) const { return Vec3(x + o.x, y + o.y, z + o.z); }
+	Vec3 operator-(const Vec3& o) const { return Vec3(x - o.x, y - o.y, z - o.z); }
+	Vec3 operator*(double s) const { return Vec3(x * s, y * s, z * s); }
+	Vec3 operator-() const { return Vec3(-x, -y, -z); }
+	Vec3& operator+=(const Vec3& o) { x += o.x; y += o.y; z += o.z; return *this; }
+	Vec3& operator-=(const Vec3& o) { x -= o.x; y -= o.y; z -= o.z; return *this; }
+	Vec3& operator*=(double s) { x *= s; y *= s; z *= s; return *this; }
+
+	double dot(const Vec3& o) const { return x * o.x + y * o.y + z * o.z; }
+	Vec3 cross(const Vec3& o) const { return Vec3(y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x); }
+	double length() const { return std::sqrt(dot(*this)); }
+	Vec3 normal() const
+	{
+		double len = length();
+		return (len > 0.0) ? *this * (1.0 / len) : Vec3();
+	}
+};
+
+inline Vec3 operator*(double s, const Vec3& v) { return v * s; }
+
+// Euler angles in radians, matching MEulerRotation's x/y/z layout
+struct Euler {
+	double x = 0.0;
+	double y = 0.0;
+	double z = 0.0;
+
+	Euler() = default;
+	Euler(double x, double y, double z) : x(x), y(y), z(z) {}
+};
+
+enum class KeyframeType {
+	START,
+	MIDDLE,
+	END,
+	// Floor contact between two arcs of a bouncing flight
+	CONTACT
+};
+
+struct LaunchParams {
+	Vec3 startPosition;
+	Vec3 velocity;
+	double gravity = -9.81;
+	// May be fractional; every frame derived from it stays a double
+	double startFrame = 0.0;
+	double framesPerSecond = 24.0;
+	// Seconds from launch to landing; zero lands back at launch height
+	double flightTime = 0.0;
+
+	double secondsPerFrame() const { return 1.0 / framesPerSecond; }
+};
+
+// Key of a closed-form flight. Slopes are value units per frame on either side of the key (they
+// only differ on a bounce contact) and weights are the tangent handle lengths in frames. With
+// the weights from setParabolicWeights each weighted Bezier segment reproduces the arc exactly.
+// Rotations are keyed linearly; the pitch along an arc is not a polynomial.
+struct ParabolicKey {
+	double frame = 0.0;
+	KeyframeType type = KeyframeType::START;
+	Vec3 position;
+	Euler rotation;
+	Vec3 inSlope;
+	Vec3 outSlope;
+	double inWeight = 0.0;
+	double outWeight = 0.0;
+};
+
+// Closed-form position at 'seconds' after launch
+Vec3 positionAtTime(const LaunchParams& params, double seconds);
+
+// Closed-form velocity at 'seconds' after launch
+Vec3 velocityAtTime(const LaunchParams& params, double seconds);
+
+// Seconds from launch until the vertical velocity reaches zero
+double timeToApex(const LaunchParams& params);
+
+// Seconds until the camera comes down through 'height', or -1 when it never does
+double timeToHeight(const LaunchParams& params, double height);
+
+// Seconds from launch to landing: 'flightTime' when set, otherwise the exact moment the camera
+// comes back down through launch height, or 120 frames' worth for one that never does
+double landingTime(const LaunchParams& params);
+
+// landingTime in frames, not rounded to a whole frame
+double calculateFlightFrames(const LaunchParams& params);
+
+// Start, apex and end frames, all exact; the end is at landingTime
+std::vector<double> getKeyFrameNumbers(const LaunchParams& params);
+
+// Start, apex and end positions
+std::vector<Vec3> calculateTrajectory(const LaunchParams& params);
+
+// Start, apex and end orientations
+std::vector<Euler> calculateRotations(const LaunchParams& params);
+
+// Look-along-velocity pitch and yaw. Yaw is kept within half a turn of 'previousYaw', which is
+// also kept when moving straight up or down.
+Euler lookAlongVelocity(const Vec3& velocity, double previousYaw);
+
+// Frame the camera peaks at, not rounded to a whole frame
+double apexFrame(const LaunchParams& params);
+
+// Start, apex and landing keys at their exact frames, with weights set. The apex is keyed at
+// its own (usually fractional) frame; a flight that never rises gets its middle key halfway.
+// The landing is at landingTime.
+std::vector<ParabolicKey> calculateParabolicKeys(const LaunchParams& params);
+
+// Sets each handle to a third of the time to the neighbouring key, the cubic that matches a
+// quadratic between two keys exactly
+void setParabolicWeights(std::vector<ParabolicKey>& keys);
+
+}
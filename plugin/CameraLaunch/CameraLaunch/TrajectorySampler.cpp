@@ -0,0 +1,118 @@
+#include "TrajectorySampler.h"
+
+namespace LaunchCore {
+
+void TrajectorySamples::resize(size_t count)
+{
+	frames.resize(count);
+	translateX.resize(count);
+	translateY.resize(count);
+	translateZ.resize(count);
+	rotateX.resize(count);
+	rotateY.resize(count);
+}
+
+size_t countTrajectorySamples(const LaunchParams& params, double frameStep)
+{
+	return countTrajectorySamples(calculateFlightFrames(params), frameStep);
+}
+
+size_t countTrajectorySamples(double totalFrames, double frameStep)
+{
+	if (frameStep <= 0.0 || totalFrames < 0.0) {
+		return 0;
+	}
+
+	size_t count = (size_t)std::floor(totalFrames / frameStep) + 1;
+
+	// Make sure the landing frame gets its own sample
+	if ((count - 1) * frameStep < totalFrames - 1e-9) {
+		++count;
+	}
+
+	return count;
+}
+
+void sampleTrajectory(const LaunchParams& params, double frameStep, TrajectorySamples& samples)
+{
+	sampleTrajectory(params, frameStep, calculateFlightFrames(params), samples);
+}
+
+void sampleTrajectory(const LaunchParams& params, double frameStep, double totalFrames, TrajectorySamples& samples)
+{
+	size_t count = countTrajectorySamples(totalFrames, frameStep);
+	samples.resize(count);
+	if (count == 0) {
+		return;
+	}
+
+	const double startFrame = params.startFrame;
+	const double secondsPerFrame = params.secondsPerFrame();
+
+	const Vec3 p = params.startPosition;
+	const Vec3 v = params.velocity;
+	const double halfGravity = 0.5 * params.gravity;
+
+	double* frames = samples.frames.data();
+	double* tx = samples.translateX.data();
+	double* ty = samples.translateY.data();
+	double* tz = samples.translateZ.data();
+	double* rx = samples.rotateX.data();
+	double* ry = samples.rotateY.data();
+
+	// Each loop below only touches flat arrays with no cross-iteration dependency,
+	// which keeps them auto-vectorizable
+	for (size_t i = 0; i < count; ++i) {
+		double offset = (double)i * frameStep;
+		frames[i] = startFrame + (offset < totalFrames ? offset : totalFrames);
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		double t = (frames[i] - startFrame) * secondsPerFrame;
+		tx[i] = p.x + v.x * t;
+		ty[i] = p.y + v.y * t + halfGravity * t * t;
+		tz[i] = p.z + v.z * t;
+	}
+
+	// Horizontal velocity never changes, so yaw is constant and only pitch follows the arc
+	const double PI = std::atan(1.0) * 4;
+	const double horizontalSpeed = std::sqrt(v.x * v.x + v.z * v.z);
+	const Vec3 direction = v.normal();
+	const double yaw = std::atan2(direction.x, direction.z) + PI;
+
+	for (size_t i = 0; i < count; ++i) {
+		double t = (frames[i] - startFrame) * secondsPerFrame;
+		double vy = v.y + params.gravity * t;
+		rx[i] = (vy == 0.0 && horizontalSpeed == 0.0) ? 0.0 : std::atan2(vy, horizontalSpeed);
+		ry[i] = yaw;
+	}
+}
+
+void differentiateSamples(const double* x, const double* y, size_t count, std::vector<double>& slopes)
+{
+	slopes.assign(count, 0.0);
+	if (count < 2) {
+		return;
+	}
+	if (count == 2) {
+		slopes[0] = slopes[1] = (y[1] - y[0]) / (x[1] - x[0]);
+		return;
+	}
+
+	for (size_t k = 1; k + 1 < count; ++k) {
+		double h0 = x[k] - x[k - 1];
+		double h1 = x[k + 1] - x[k];
+		slopes[k] = (y[k + 1] - y[k]) * h0 / (h1 * (h0 + h1)) + (y[k] - y[k - 1]) * h1 / (h0 * (h0 + h1));
+	}
+
+	double h0 = x[1] - x[0];
+	double h1 = x[2] - x[1];
+	slopes[0] = -(2.0 * h0 + h1) / (h0 * (h0 + h1)) * y[0] + (h0 + h1) / (h0 * h1) * y[1] - h0 / (h1 * (h0 + h1)) * y[2];
+
+	size_t n = count - 1;
+	h0 = x[n - 1] - x[n - 2];
+	h1 = x[n] - x[n - 1];
+	slopes[n] = h1 / (h0 * (h0 + h1)) * y[n - 2] - (h0 + h1) / (h0 * h1) * y[n - 1] + (2.0 * h1 + h0) / (h1 * (h0 + h1)) * y[n];
+}
+
+}
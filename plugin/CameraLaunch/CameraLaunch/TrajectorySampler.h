@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+// Per-sample trajectory values laid out as one contiguous array per channel, so each
+// channel can be evaluated in a tight loop and handed straight to a bulk key insert.
+struct TrajectorySamples {
+	std::vector<double> frames;
+	std::vector<double> translateX;
+	std::vector<double> translateY;
+	std::vector<double> translateZ;
+	std::vector<double> rotateX;
+	std::vector<double> rotateY;
+
+	size_t size() const { return frames.size(); }
+	void resize(size_t count);
+};
+
+// Number of samples needed to cover the flight every 'frameStep' frames, landing frame included
+size_t countTrajectorySamples(const LaunchParams& params, double frameStep);
+size_t countTrajectorySamples(double totalFrames, double frameStep);
+
+// Evaluates position and look-along-velocity orientation from the launch frame to the
+// landing frame every 'frameStep' frames. The landing frame is always the last sample.
+void sampleTrajectory(const LaunchParams& params, double frameStep, TrajectorySamples& samples);
+
+// Same as above, but over 'totalFrames' frames after launch instead of up to the landing frame
+void sampleTrajectory(const LaunchParams& params, double frameStep, double totalFrames, TrajectorySamples& samples);
+
+// Derivative of 'y' with respect to 'x' at every sample, from the quadratic through each sample
+// and its neighbours. Exact for parabolic arcs and second order on uneven spacing such as the
+// short final step to a landing sample. 'x' must be increasing.
+void differentiateSamples(const double* x, const double* y, size_t count, std::vector<double>& slopes);
+
+}
@@ -0,0 +1,344 @@
+#include "TriangleBVH.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace LaunchCore {
+
+namespace {
+
+const uint32_t kLeafSize = 4;
+// Nodes this deep become leaves whatever their size. Traversal pushes both children of a node
+// and pops one, so its stack never holds more than kMaxDepth + 1 entries.
+const uint32_t kMaxDepth = 32;
+const uint32_t kBinCount = 16;
+
+struct Bounds {
+	Vec3 min = Vec3(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+	Vec3 max = Vec3(-std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max());
+
+	void grow(const Vec3& p)
+	{
+		min = Vec3(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+		max = Vec3(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+	}
+
+	void grow(const Bounds& b)
+	{
+		grow(b.min);
+		grow(b.max);
+	}
+
+	bool valid() const { return min.x <= max.x; }
+
+	double area() const
+	{
+		if (!valid()) return 0.0;
+		Vec3 e = max - min;
+		return 2.0 * (e.x * e.y + e.y * e.z + e.z * e.x);
+	}
+};
+
+inline double axisValue(const Vec3& v, int axis)
+{
+	return (axis == 0) ? v.x : (axis == 1) ? v.y : v.z;
+}
+
+Bounds triangleBounds(const Triangle& tri)
+{
+	Bounds b;
+	b.grow(tri.v0);
+	b.grow(tri.v1);
+	b.grow(tri.v2);
+	return b;
+}
+
+// Float bounds rounded outwards so the tree never rejects a ray the doubles would hit
+inline float roundDown(double value)
+{
+	float f = (float)value;
+	return ((double)f > value) ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+}
+
+inline float roundUp(double value)
+{
+	float f = (float)value;
+	return ((double)f < value) ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+}
+
+}
+
+void TriangleBVH::clear()
+{
+	m_nodes.clear();
+	m_triangles.clear();
+	m_sourceIndices.clear();
+}
+
+void TriangleBVH::build(const std::vector<Vec3>& vertices, const std::vector<uint32_t>& indices)
+{
+	std::vector<Triangle> triangles;
+	triangles.reserve(indices.size() / 3);
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		triangles.push_back(Triangle(vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]]));
+	}
+
+	build(triangles);
+}
+
+void TriangleBVH::build(const std::vector<Triangle>& triangles)
+{
+	clear();
+	if (triangles.empty()) {
+		return;
+	}
+
+	uint32_t count = (uint32_t)triangles.size();
+	std::vector<uint32_t> order(count);
+	std::vector<Vec3> centroids(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		order[i] = i;
+		centroids[i] = (triangles[i].v0 + triangles[i].v1 + triangles[i].v2) * (1.0 / 3.0);
+	}
+
+	m_nodes.reserve(2 * count / kLeafSize + 1);
+	buildNode(order, centroids, triangles, 0, count, 0);
+
+	// Lay the triangles out in leaf order so each leaf reads one contiguous block
+	m_triangles.resize(count);
+	m_sourceIndices = order;
+	for (uint32_t i = 0; i < count; ++i) {
+		const Triangle& tri = triangles[order[i]];
+		m_triangles[i].v0 = tri.v0;
+		m_triangles[i].edge1 = tri.v1 - tri.v0;
+		m_triangles[i].edge2 = tri.v2 - tri.v0;
+	}
+}
+
+uint32_t TriangleBVH::buildNode(std::vector<uint32_t>& order, std::vector<Vec3>& centroids,
+	const std::vector<Triangle>& triangles, uint32_t first, uint32_t count, uint32_t depth)
+{
+	Bounds bounds;
+	Bounds centroidBounds;
+	for (uint32_t i = first; i < first + count; ++i) {
+		bounds.grow(triangleBounds(triangles[order[i]]));
+		centroidBounds.grow(centroids[order[i]]);
+	}
+
+	uint32_t nodeIndex = (uint32_t)m_nodes.size();
+	Node node;
+	node.boundsMin[0] = roundDown(bounds.min.x);
+	node.boundsMin[1] = roundDown(bounds.min.y);
+	node.boundsMin[2] = roundDown(bounds.min.z);
+	node.boundsMax[0] = roundUp(bounds.max.x);
+	node.boundsMax[1] = roundUp(bounds.max.y);
+	node.boundsMax[2] = roundUp(bounds.max.z);
+	node.offset = first;
+	node.count = count;
+	m_nodes.push_back(node);
+
+	if (count <= kLeafSize || depth >= kMaxDepth) {
+		return nodeIndex;
+	}
+
+	// Split along the axis with the widest centroid spread
+	Vec3 extent = centroidBounds.max - centroidBounds.min;
+	int axis = 0;
+	if (extent.y > extent.x) axis = 1;
+	if (extent.z > axisValue(extent, axis)) axis = 2;
+
+	double axisMin = axisValue(centroidBounds.min, axis);
+	double axisExtent = axisValue(extent, axis);
+	if (axisExtent <= 0.0) {
+		return nodeIndex;
+	}
+
+	// Binned surface area heuristic
+	Bounds binBounds[kBinCount];
+	uint32_t binCounts[kBinCount] = {};
+	double binScale = kBinCount / axisExtent;
+
+	auto binOf = [&](uint32_t tri) {
+		uint32_t bin = (uint32_t)((axisValue(centroids[tri], axis) - axisMin) * binScale);
+		return std::min(bin, kBinCount - 1);
+	};
+
+	for (uint32_t i = first; i < first + count; ++i) {
+		uint32_t bin = binOf(order[i]);
+		binBounds[bin].grow(triangleBounds(triangles[order[i]]));
+		++binCounts[bin];
+	}
+
+	double leftArea[kBinCount - 1];
+	uint32_t leftCount[kBinCount - 1];
+	Bounds running;
+	uint32_t runningCount = 0;
+	for (uint32_t i = 0; i < kBinCount - 1; ++i) {
+		running.grow(binBounds[i]);
+		runningCount += binCounts[i];
+		leftArea[i] = running.area();
+		leftCount[i] = runningCount;
+	}
+
+	double bestCost = std::numeric_limits<double>::max();
+	uint32_t bestSplit = 0;
+	running = Bounds();
+	runningCount = 0;
+	for (uint32_t i = kBinCount - 1; i > 0; --i) {
+		running.grow(binBounds[i]);
+		runningCount += binCounts[i];
+		double cost = leftArea[i - 1] * leftCount[i - 1] + running.area() * runningCount;
+		if (cost < bestCost) {
+			bestCost = cost;
+			bestSplit = i;
+		}
+	}
+
+	uint32_t* begin = order.data() + first;
+	uint32_t* end = begin + count;
+	uint32_t* middle = std::partition(begin, end, [&](uint32_t tri) { return binOf(tri) < bestSplit; });
+
+	// Fall back to a median split when the bins could not separate anything
+	if (middle == begin || middle == end) {
+		middle = begin + count / 2;
+		std::nth_element(begin, middle, end, [&](uint32_t a, uint32_t b) {
+			return axisValue(centroids[a], axis) < axisValue(centroids[b], axis);
+		});
+	}
+
+	uint32_t leftSize = (uint32_t)(middle - begin);
+
+	buildNode(order, centroids, triangles, first, leftSize, depth + 1);
+	uint32_t rightIndex = buildNode(order, centroids, triangles, first + leftSize, count - leftSize, depth + 1);
+
+	m_nodes[nodeIndex].offset = rightIndex;
+	m_nodes[nodeIndex].count = 0;
+	return nodeIndex;
+}
+
+Vec3 TriangleBVH::boundsMin() const
+{
+	if (m_nodes.empty()) return Vec3();
+	const Node& root = m_nodes[0];
+	return Vec3(root.boundsMin[0], root.boundsMin[1], root.boundsMin[2]);
+}
+
+Vec3 TriangleBVH::boundsMax() const
+{
+	if (m_nodes.empty()) return Vec3();
+	const Node& root = m_nodes[0];
+	return Vec3(root.boundsMax[0], root.boundsMax[1], root.boundsMax[2]);
+}
+
+bool TriangleBVH::intersectSegment(const Vec3& a, const Vec3& b, SegmentHit& hit, double minFraction) const
+{
+	hit = SegmentHit();
+	if (m_nodes.empty()) {
+		return false;
+	}
+
+	const Vec3 dir = b - a;
+	const double inf = std::numeric_limits<double>::infinity();
+	const double invDir[3] = {
+		dir.x != 0.0 ? 1.0 / dir.x : inf,
+		dir.y != 0.0 ? 1.0 / dir.y : inf,
+		dir.z != 0.0 ? 1.0 / dir.z : inf
+	};
+	const double origin[3] = { a.x, a.y, a.z };
+
+	double closest = 1.0;
+	uint32_t closestTriangle = 0;
+	bool found = false;
+
+	// Slab test against [minFraction, closest]
+	auto hitsBox = [&](const Node& node) {
+		double tNear = minFraction;
+		double tFar = closest;
+		for (int axis = 0; axis < 3; ++axis) {
+			double t0 = (node.boundsMin[axis] - origin[axis]) * invDir[axis];
+			double t1 = (node.boundsMax[axis] - origin[axis]) * invDir[axis];
+			// 0 * inf when the segment lies on a slab plane; treat as inside
+			if (t0 != t0) t0 = -inf;
+			if (t1 != t1) t1 = inf;
+			if (t0 > t1) std::swap(t0, t1);
+			tNear = std::max(tNear, t0);
+			tFar = std::min(tFar, t1);
+			if (tNear > tFar) return false;
+		}
+		return true;
+	};
+
+	uint32_t stack[kMaxDepth + 1];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const Node& node = m_nodes[stack[--stackSize]];
+		if (!hitsBox(node)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+				// Moller-Trumbore
+				const PreparedTriangle& tri = m_triangles[i];
+				Vec3 p = dir.cross(tri.edge2);
+				double det = tri.edge1.dot(p);
+				if (std::fabs(det) < 1e-14) continue;
+
+				double invDet = 1.0 / det;
+				Vec3 s = a - tri.v0;
+				double u = s.dot(p) * invDet;
+				if (u < 0.0 || u > 1.0) continue;
+
+				Vec3 q = s.cross(tri.edge1);
+				double v = dir.dot(q) * invDet;
+				if (v < 0.0 || u + v > 1.0) continue;
+
+				double t = tri.edge2.dot(q) * invDet;
+				if (t >= minFraction && t <= closest) {
+					closest = t;
+					closestTriangle = i;
+					found = true;
+				}
+			}
+			continue;
+		}
+
+		// Visit the child nearer the segment start first by pushing it last
+		uint32_t firstChild = (uint32_t)(&node - m_nodes.data()) + 1;
+		uint32_t secondChild = node.offset;
+		const Node& first = m_nodes[firstChild];
+		const Node& second = m_nodes[secondChild];
+		double firstDist = (first.boundsMin[0] + first.boundsMax[0] - 2.0 * origin[0]) * dir.x
+			+ (first.boundsMin[1] + first.boundsMax[1] - 2.0 * origin[1]) * dir.y
+			+ (first.boundsMin[2] + first.boundsMax[2] - 2.0 * origin[2]) * dir.z;
+		double secondDist = (second.boundsMin[0] + second.boundsMax[0] - 2.0 * origin[0]) * dir.x
+			+ (second.boundsMin[1] + second.boundsMax[1] - 2.0 * origin[1]) * dir.y
+			+ (second.boundsMin[2] + second.boundsMax[2] - 2.0 * origin[2]) * dir.z;
+
+		if (firstDist <= secondDist) {
+			stack[stackSize++] = secondChild;
+			stack[stackSize++] = firstChild;
+		}
+		else {
+			stack[stackSize++] = firstChild;
+			stack[stackSize++] = secondChild;
+		}
+	}
+
+	if (!found) {
+		return false;
+	}
+
+	const PreparedTriangle& tri = m_triangles[closestTriangle];
+	hit.hit = true;
+	hit.fraction = closest;
+	hit.point = a + dir * closest;
+	hit.normal = tri.edge1.cross(tri.edge2).normal();
+	hit.triangle = m_sourceIndices[closestTriangle];
+	return true;
+}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+struct Triangle {
+	Vec3 v0;
+	Vec3 v1;
+	Vec3 v2;
+
+	Triangle() = default;
+	Triangle(const Vec3& v0, const Vec3& v1, const Vec3& v2) : v0(v0), v1(v1), v2(v2) {}
+};
+
+struct SegmentHit {
+	bool hit = false;
+	// Parameter along the segment, 0 at its start and 1 at its end
+	double fraction = 0.0;
+	Vec3 point;
+	Vec3 normal;
+	uint32_t triangle = 0;
+};
+
+// Bounding volume hierarchy over a triangle soup. Nodes are stored depth-first in one
+// flat array with float bounds (32 bytes each), and triangles are reordered so every
+// leaf references a contiguous range.
+class TriangleBVH
+{
+public:
+	TriangleBVH() = default;
+
+	void build(const std::vector<Triangle>& triangles);
+	void build(const std::vector<Vec3>& vertices, const std::vector<uint32_t>& indices);
+	void clear();
+
+	bool empty() const { return m_nodes.empty(); }
+	size_t triangleCount() const { return m_triangles.size(); }
+	size_t nodeCount() const { return m_nodes.size(); }
+
+	// World-space bounds of everything in the tree
+	Vec3 boundsMin() const;
+	Vec3 boundsMax() const;
+
+	// Closest hit along a -> b, ignoring hits closer than 'minFraction'
+	bool intersectSegment(const Vec3& a, const Vec3& b, SegmentHit& hit, double minFraction = 0.0) const;
+
+private:
+	struct Node {
+		float boundsMin[3];
+		float boundsMax[3];
+		// Leaves: first triangle index. Interior nodes: index of the second child (the first child follows this node).
+		uint32_t offset;
+		// Triangle count, zero for interior nodes
+		uint32_t count;
+	};
+
+	// Triangle stored as one vertex and two edges, ready for Moller-Trumbore
+	struct PreparedTriangle {
+		Vec3 v0;
+		Vec3 edge1;
+		Vec3 edge2;
+	};
+
+	std::vector<Node> m_nodes;
+	std::vector<PreparedTriangle> m_triangles;
+	std::vector<uint32_t> m_sourceIndices;
+
+	uint32_t buildNode(std::vector<uint32_t>& order, std::vector<Vec3>& centroids,
+		const std::vector<Triangle>& triangles, uint32_t first, uint32_t count, uint32_t depth);
+};
+
+}
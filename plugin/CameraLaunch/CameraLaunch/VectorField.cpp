@@ -0,0 +1,246 @@
+#include "VectorField.h"
+#include "TrajectoryCache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+
+namespace LaunchCore {
+
+namespace {
+
+// Grid coordinate clamped onto [0, n - 1], split into a lower index and a fraction
+inline void locate(double position, double origin, double inverseSpacing, int n, int& index, double& fraction)
+{
+	double u = (position - origin) * inverseSpacing;
+	double last = (double)(n - 1);
+	u = (u > 0.0) ? ((u < last) ? u : last) : 0.0;
+
+	index = std::min((int)u, std::max(n - 2, 0));
+	fraction = u - index;
+}
+
+}
+
+VectorField::VectorField()
+	: m_nx(0)
+	, m_ny(0)
+	, m_nz(0)
+	, m_bricksX(0)
+	, m_bricksY(0)
+	, m_fingerprint(0)
+{
+}
+
+bool VectorField::build(int nx, int ny, int nz, const Vec3& origin, const Vec3& spacing, const std::vector<Vec3>& values)
+{
+	clear();
+	if (nx < 1 || ny < 1 || nz < 1 || values.size() != (size_t)nx * ny * nz
+		|| spacing.x <= 0.0 || spacing.y <= 0.0 || spacing.z <= 0.0) {
+		return false;
+	}
+
+	m_nx = nx;
+	m_ny = ny;
+	m_nz = nz;
+	m_bricksX = (nx + BRICK - 1) / BRICK;
+	m_bricksY = (ny + BRICK - 1) / BRICK;
+	int bricksZ = (nz + BRICK - 1) / BRICK;
+	m_origin = origin;
+	m_spacing = spacing;
+	m_inverseSpacing = Vec3(1.0 / spacing.x, 1.0 / spacing.y, 1.0 / spacing.z);
+
+	// Bricks on the far edges are padded out to full size
+	m_cells.assign((size_t)m_bricksX * m_bricksY * bricksZ * BRICK * BRICK * BRICK * 3, 0.0f);
+	for (int k = 0; k < nz; ++k) {
+		for (int j = 0; j < ny; ++j) {
+			for (int i = 0; i < nx; ++i) {
+				const Vec3& value = values[((size_t)k * ny + j) * nx + i];
+				float* cell = &m_cells[cellOffset(i, j, k)];
+				cell[0] = (float)value.x;
+				cell[1] = (float)value.y;
+				cell[2] = (float)value.z;
+			}
+		}
+	}
+
+	CacheKey key;
+	key.add(nx).add(ny).add(nz).add(origin).add(spacing);
+	key.addBytes(m_cells.data(), m_cells.size() * sizeof(float));
+	m_fingerprint = key.value();
+	return true;
+}
+
+void VectorField::clear()
+{
+	m_nx = m_ny = m_nz = 0;
+	m_bricksX = m_bricksY = 0;
+	m_origin = Vec3();
+	m_spacing = Vec3();
+	m_inverseSpacing = Vec3();
+	m_cells.clear();
+	m_fingerprint = 0;
+}
+
+Vec3 VectorField::boundsMax() const
+{
+	return Vec3(
+		m_origin.x + (m_nx - 1) * m_spacing.x,
+		m_origin.y + (m_ny - 1) * m_spacing.y,
+		m_origin.z + (m_nz - 1) * m_spacing.z);
+}
+
+size_t VectorField::cellOffset(int i, int j, int k) const
+{
+	size_t brick = ((size_t)(k / BRICK) * m_bricksY + j / BRICK) * m_bricksX + i / BRICK;
+	size_t local = ((size_t)(k % BRICK) * BRICK + j % BRICK) * BRICK + i % BRICK;
+	return (brick * BRICK * BRICK * BRICK + local) * 3;
+}
+
+void VectorField::sampleOne(double x, double y, double z, double& outX, double& outY, double& outZ) const
+{
+	int i, j, k;
+	double fx, fy, fz;
+	locate(x, m_origin.x, m_inverseSpacing.x, m_nx, i, fx);
+	locate(y, m_origin.y, m_inverseSpacing.y, m_ny, j, fy);
+	locate(z, m_origin.z, m_inverseSpacing.z, m_nz, k, fz);
+
+	// A single-sample axis has nothing to blend with
+	const int i1 = std::min(i + 1, m_nx - 1);
+	const int j1 = std::min(j + 1, m_ny - 1);
+	const int k1 = std::min(k + 1, m_nz - 1);
+
+	const float* c000 = &m_cells[cellOffset(i, j, k)];
+	const float* c100 = &m_cells[cellOffset(i1, j, k)];
+	const float* c010 = &m_cells[cellOffset(i, j1, k)];
+	const float* c110 = &m_cells[cellOffset(i1, j1, k)];
+	const float* c001 = &m_cells[cellOffset(i, j, k1)];
+	const float* c101 = &m_cells[cellOffset(i1, j, k1)];
+	const float* c011 = &m_cells[cellOffset(i, j1, k1)];
+	const float* c111 = &m_cells[cellOffset(i1, j1, k1)];
+
+	double out[3];
+	for (int c = 0; c < 3; ++c) {
+		double x00 = c000[c] + (c100[c] - c000[c]) * fx;
+		double x10 = c010[c] + (c110[c] - c010[c]) * fx;
+		double x01 = c001[c] + (c101[c] - c001[c]) * fx;
+		double x11 = c011[c] + (c111[c] - c011[c]) * fx;
+		double y0 = x00 + (x10 - x00) * fy;
+		double y1 = x01 + (x11 - x01) * fy;
+		out[c] = y0 + (y1 - y0) * fz;
+	}
+	outX = out[0];
+	outY = out[1];
+	outZ = out[2];
+}
+
+Vec3 VectorField::sample(const Vec3& position) const
+{
+	Vec3 value;
+	if (!empty()) {
+		sampleOne(position.x, position.y, position.z, value.x, value.y, value.z);
+	}
+	return value;
+}
+
+void VectorField::sample(const double* x, const double* y, const double* z, size_t count,
+	double* outX, double* outY, double* outZ) const
+{
+	if (empty()) {
+		std::fill(outX, outX + count, 0.0);
+		std::fill(outY, outY + count, 0.0);
+		std::fill(outZ, outZ + count, 0.0);
+		return;
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		sampleOne(x[i], y[i], z[i], outX[i], outY[i], outZ[i]);
+	}
+}
+
+bool parseFgaField(std::istream& in, VectorField& field, std::string& error)
+{
+	field.clear();
+
+	// Numbers separated by commas and whitespace, in any line layout
+	std::vector<double> numbers;
+	std::string token;
+	char c;
+	auto flush = [&]() {
+		if (token.empty()) return true;
+		char* end = nullptr;
+		double value = std::strtod(token.c_str(), &end);
+		if (end != token.c_str() + token.size()) return false;
+		numbers.push_back(value);
+		token.clear();
+		return true;
+	};
+	while (in.get(c)) {
+		if (c == ',' || std::isspace((unsigned char)c)) {
+			if (!flush()) {
+				error = "Invalid number \"" + token + "\" in FGA field";
+				return false;
+			}
+		}
+		else {
+			token += c;
+		}
+	}
+	if (!flush()) {
+		error = "Invalid number \"" + token + "\" in FGA field";
+		return false;
+	}
+
+	if (numbers.size() < 9) {
+		error = "FGA field is missing its resolution and bounds";
+		return false;
+	}
+
+	int n[3];
+	for (int axis = 0; axis < 3; ++axis) {
+		n[axis] = (int)numbers[axis];
+		if (n[axis] < 1 || (double)n[axis] != numbers[axis]) {
+			error = "FGA field resolution must be whole numbers of at least 1";
+			return false;
+		}
+	}
+
+	size_t count = (size_t)n[0] * n[1] * n[2];
+	if (numbers.size() != 9 + 3 * count) {
+		error = "FGA field has " + std::to_string(numbers.size() - 9) + " values, expected " + std::to_string(3 * count);
+		return false;
+	}
+
+	Vec3 boundsMin(numbers[3], numbers[4], numbers[5]);
+	Vec3 boundsMax(numbers[6], numbers[7], numbers[8]);
+	Vec3 size = boundsMax - boundsMin;
+	if (!(size.x > 0.0 && size.y > 0.0 && size.z > 0.0)) {
+		error = "FGA field bounds must have a positive size";
+		return false;
+	}
+
+	Vec3 spacing(size.x / n[0], size.y / n[1], size.z / n[2]);
+	std::vector<Vec3> values(count);
+	for (size_t i = 0; i < count; ++i) {
+		values[i] = Vec3(numbers[9 + 3 * i], numbers[10 + 3 * i], numbers[11 + 3 * i]);
+	}
+	field.build(n[0], n[1], n[2], boundsMin + spacing * 0.5, spacing, values);
+	return true;
+}
+
+bool loadFgaField(const std::string& path, VectorField& field, std::string& error)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		error = "Could not open " + path;
+		return false;
+	}
+	if (!parseFgaField(in, field, error)) {
+		error = path + ": " + error;
+		return false;
+	}
+	return true;
+}
+
+}
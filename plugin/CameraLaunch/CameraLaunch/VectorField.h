@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "TrajectoryCore.h"
+
+namespace LaunchCore {
+
+// Dense vector field sampled on a regular grid, such as wind exported from an FX simulation.
+// Cells are stored as floats in 4x4x4 bricks, so the eight corners of a lookup are nearly
+// always in the same 768 bytes instead of spread across four rows of the grid.
+class VectorField
+{
+public:
+	VectorField();
+
+	// 'values' holds nx * ny * nz vectors, x varying fastest, then y, then z. Sample (i, j, k)
+	// sits at origin + (i * spacing.x, j * spacing.y, k * spacing.z).
+	bool build(int nx, int ny, int nz, const Vec3& origin, const Vec3& spacing, const std::vector<Vec3>& values);
+	void clear();
+
+	bool empty() const { return m_cells.empty(); }
+	int resolutionX() const { return m_nx; }
+	int resolutionY() const { return m_ny; }
+	int resolutionZ() const { return m_nz; }
+
+	// Positions of the first and last samples
+	Vec3 boundsMin() const { return m_origin; }
+	Vec3 boundsMax() const;
+
+	// Trilinear interpolation. Positions outside the grid read its boundary.
+	Vec3 sample(const Vec3& position) const;
+	// Samples 'count' positions given as one array per component
+	void sample(const double* x, const double* y, const double* z, size_t count,
+		double* outX, double* outY, double* outZ) const;
+
+	// Hash of the grid and every value, for cache keys
+	uint64_t fingerprint() const { return m_fingerprint; }
+
+private:
+	static const int BRICK = 4;
+
+	int m_nx, m_ny, m_nz;
+	int m_bricksX, m_bricksY;
+	Vec3 m_origin;
+	Vec3 m_inverseSpacing;
+	Vec3 m_spacing;
+	// Three floats per cell, brick by brick
+	std::vector<float> m_cells;
+	uint64_t m_fingerprint;
+
+	size_t cellOffset(int i, int j, int k) const;
+	void sampleOne(double x, double y, double z, double& outX, double& outY, double& outZ) const;
+};
+
+// How a field acts on the flight
+enum class FieldKind {
+	// Air velocity; drag acts on the camera's velocity relative to it
+	WIND,
+	// Force on the camera, divided by its mass
+	FORCE
+};
+
+struct FieldSettings {
+	const VectorField* field = nullptr;
+	FieldKind kind = FieldKind::WIND;
+	double scale = 1.0;
+
+	bool active() const { return field && !field->empty() && scale != 0.0; }
+};
+
+// Reads an FGA vector field: "nx,ny,nz," then the min and max corners of the volume, then one
+// vector per voxel, x fastest. Voxel centres sit half a voxel in from the volume's faces.
+bool parseFgaField(std::istream& in, VectorField& field, std::string& error);
+bool loadFgaField(const std::string& path, VectorField& field, std::string& error);
+
+}
@@ -2,6 +2,7 @@
 #include <maya/MGlobal.h>
 
 #include "CameraLaunchCmd.h"
+#include "CameraLaunchNode.h"
 
 MStatus initializePlugin(MObject obj)
 {
@@ -11,6 +12,7 @@ MStatus initializePlugin(MObject obj)
 	MFnPlugin fnPlugin(obj, pluginVendor, pluginVersion);
 
 	fnPlugin.registerCommand(CameraLaunchCmd::commandName, CameraLaunchCmd::creator, CameraLaunchCmd::newSyntax);
+	fnPlugin.registerNode(CameraLaunchNode::nodeName, CameraLaunchNode::id, CameraLaunchNode::creator, CameraLaunchNode::initialize);
 
 	MGlobal::displayInfo("Plugin has been initialized!");
 
@@ -21,8 +23,12 @@ MStatus uninitializePlugin(MObject obj)
 {
 
 	MFnPlugin fnPlugin(obj);
+
+	// Workers must be joined before the plugin's code is unloaded
+	CameraLaunchCmd::shutdownAsync();
 	
 	fnPlugin.deregisterCommand(CameraLaunchCmd::commandName);
+	fnPlugin.deregisterNode(CameraLaunchNode::id);
 
 	MGlobal::displayInfo("Plugin has been uninitialized!");
 
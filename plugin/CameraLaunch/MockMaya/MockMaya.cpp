@@ -0,0 +1,1824 @@
+#include "MockMaya.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+
+namespace MockMaya {
+
+struct AnimKey {
+	MTime time;
+	double value = 0.0;
+	MFnAnimCurve::TangentType inType = MFnAnimCurve::kTangentGlobal;
+	MFnAnimCurve::TangentType outType = MFnAnimCurve::kTangentGlobal;
+	double inX = 0.0;
+	double inY = 0.0;
+	double outX = 0.0;
+	double outY = 0.0;
+	bool tangentsLocked = true;
+	bool weightsLocked = true;
+};
+
+struct CurveData {
+	std::vector<AnimKey> keys;
+	bool weighted = false;
+};
+
+struct Node {
+	std::string name;
+	MFn::Type type = MFn::kInvalid;
+	bool inScene = true;
+	// Long and short names of every attribute, static and dynamic
+	std::set<std::string> attributes;
+	// Destination attribute -> anim curve driving it
+	std::map<std::string, std::shared_ptr<Node>> inputs;
+
+	// Transforms
+	std::shared_ptr<Node> shape;
+	MMatrix worldMatrix;
+	MTransformationMatrix::RotationOrder rotationOrder = MTransformationMatrix::kXYZ;
+
+	// Anim curves, and the plug they drive
+	CurveData curve;
+	std::weak_ptr<Node> destination;
+	std::string destinationAttribute;
+
+	// Meshes
+	std::vector<MPoint> points;
+	std::vector<int> triangleVertices;
+
+	// Transforms under an animated parent: its world matrix at a given time
+	std::function<MMatrix(const MTime&)> parentMatrix;
+
+	// Fluids
+	int resolution[3] = { 0, 0, 0 };
+	double dimensions[3] = { 0.0, 0.0, 0.0 };
+	std::vector<float> velocity[3];
+};
+
+struct CurveEdit {
+	std::shared_ptr<Node> curve;
+	CurveData before;
+	CurveData after;
+};
+
+struct Deletion {
+	std::shared_ptr<Node> node;
+	// Connection out of the node, restored on undo
+	std::shared_ptr<Node> destination;
+	std::string destinationAttribute;
+};
+
+namespace {
+
+struct Scene {
+	std::vector<std::shared_ptr<Node>> nodes;
+	std::vector<MDagPath> selection;
+	std::map<std::string, size_t> calls;
+	std::vector<std::string> messages[3];
+	CommandResult result;
+	std::map<std::string, CommandCreator> commands;
+	std::vector<std::unique_ptr<MPxCommand>> undoQueue;
+	std::vector<std::unique_ptr<MPxCommand>> redoQueue;
+	std::map<MCallbackId, std::pair<MMessage::MElapsedTimeFunction, void*>> timers;
+	MCallbackId nextTimer = 1;
+	MTime::Unit uiUnit = MTime::kFilm;
+	MDGContext context;
+};
+
+Scene& scene()
+{
+	static Scene instance;
+	return instance;
+}
+
+void countCall(const char* api)
+{
+	++scene().calls[api];
+}
+
+void setStatus(MStatus* status, MStatus value)
+{
+	if (status) {
+		*status = value;
+	}
+}
+
+std::shared_ptr<Node> findNode(const std::string& name)
+{
+	for (const std::shared_ptr<Node>& node : scene().nodes) {
+		if (node->name == name || (node->shape && node->shape->name == name)) {
+			return node;
+		}
+	}
+	return nullptr;
+}
+
+std::string uniqueName(const std::string& base)
+{
+	if (!findNode(base)) {
+		return base;
+	}
+	for (int i = 1;; ++i) {
+		std::string name = base + std::to_string(i);
+		if (!findNode(name)) {
+			return name;
+		}
+	}
+}
+
+// Transform and shape, not yet part of the scene
+std::shared_ptr<Node> makeTransform(const std::string& name, MFn::Type shapeType, double x, double y, double z)
+{
+	std::shared_ptr<Node> transform = std::make_shared<Node>();
+	transform->name = name;
+	transform->type = MFn::kTransform;
+	for (const char* axis : { "X", "Y", "Z" }) {
+		transform->attributes.insert(std::string("translate") + axis);
+		transform->attributes.insert(std::string("rotate") + axis);
+		transform->attributes.insert(std::string("scale") + axis);
+	}
+	transform->attributes.insert("visibility");
+	transform->attributes.insert("parentMatrix");
+	transform->attributes.insert("worldMatrix");
+	transform->worldMatrix.matrix[3][0] = x;
+	transform->worldMatrix.matrix[3][1] = y;
+	transform->worldMatrix.matrix[3][2] = z;
+
+	if (shapeType != MFn::kInvalid) {
+		transform->shape = std::make_shared<Node>();
+		transform->shape->name = name + "Shape";
+		transform->shape->type = shapeType;
+	}
+	return transform;
+}
+
+std::shared_ptr<Node> addTransform(const std::string& name, MFn::Type shapeType, double x, double y, double z)
+{
+	std::shared_ptr<Node> transform = makeTransform(name, shapeType, x, y, z);
+	scene().nodes.push_back(transform);
+	return transform;
+}
+
+void connect(const std::shared_ptr<Node>& curve, const std::shared_ptr<Node>& destination, const std::string& attribute)
+{
+	curve->destination = destination;
+	curve->destinationAttribute = attribute;
+	destination->inputs[attribute] = curve;
+}
+
+std::string formatNumber(double value)
+{
+	std::ostringstream stream;
+	stream.precision(17);
+	stream << value;
+	return stream.str();
+}
+
+bool parseNumber(const std::string& text, double& value)
+{
+	if (text.empty()) {
+		return false;
+	}
+	char* end = nullptr;
+	value = std::strtod(text.c_str(), &end);
+	return end == text.c_str() + text.size();
+}
+
+double unitsPerSecond(MTime::Unit unit)
+{
+	switch (unit) {
+	case MTime::kHours: return 1.0 / 3600.0;
+	case MTime::kMinutes: return 1.0 / 60.0;
+	case MTime::kMilliseconds: return 1000.0;
+	case MTime::kGames: return 15.0;
+	case MTime::kFilm: return 24.0;
+	case MTime::kPALFrame: return 25.0;
+	case MTime::kNTSCFrame: return 30.0;
+	case MTime::kShowScan: return 48.0;
+	case MTime::kPALField: return 50.0;
+	case MTime::kNTSCField: return 60.0;
+	default: return 1.0;
+	}
+}
+
+MMatrix multiply(const MMatrix& a, const MMatrix& b)
+{
+	MMatrix result;
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			double sum = 0.0;
+			for (int k = 0; k < 4; ++k) {
+				sum += a.matrix[row][k] * b.matrix[k][column];
+			}
+			result.matrix[row][column] = sum;
+		}
+	}
+	return result;
+}
+
+// Parent's world matrix at the current context's time, identity for transforms under the world
+MMatrix parentMatrixNow(const Node& transform)
+{
+	if (!transform.parentMatrix) {
+		return MMatrix();
+	}
+
+	MTime when;
+	scene().context.getTime(when);
+	return transform.parentMatrix(when);
+}
+
+// Keys of the anim curve a function set is attached to, or null
+Node* curveNode(const MObject& object)
+{
+	const std::shared_ptr<Node>& node = object.mockNode();
+	return (node && node->type == MFn::kAnimCurve) ? node.get() : nullptr;
+}
+
+}
+
+}
+
+using namespace MockMaya;
+
+// ---- Value types ----
+
+MString& MString::operator+=(const MString& other)
+{
+	m_text += other.m_text;
+	return *this;
+}
+
+MString& MString::operator+=(const char* other)
+{
+	m_text += other ? other : "";
+	return *this;
+}
+
+MString& MString::operator+=(int value)
+{
+	m_text += std::to_string(value);
+	return *this;
+}
+
+MString& MString::operator+=(double value)
+{
+	std::ostringstream stream;
+	stream << value;
+	m_text += stream.str();
+	return *this;
+}
+
+MString MString::operator+(const MString& other) const { MString result(*this); return result += other; }
+MString MString::operator+(const char* other) const { MString result(*this); return result += other; }
+MString MString::operator+(int value) const { MString result(*this); return result += value; }
+MString MString::operator+(double value) const { MString result(*this); return result += value; }
+
+MString operator+(const char* left, const MString& right)
+{
+	return MString(left) + right;
+}
+
+double MTime::as(Unit unit) const
+{
+	return m_value / unitsPerSecond(m_unit) * unitsPerSecond(unit);
+}
+
+MTime::Unit MTime::uiUnit()
+{
+	return scene().uiUnit;
+}
+
+MStatus MTime::setUIUnit(Unit unit)
+{
+	scene().uiUnit = unit;
+	return MS::kSuccess;
+}
+
+double MAngle::as(Unit unit) const
+{
+	const double pi = 3.14159265358979323846;
+	const double perRadian[] = { 1.0, 1.0, 180.0 / pi, 10800.0 / pi, 648000.0 / pi, 1.0 };
+	return m_value / perRadian[m_unit] * perRadian[unit];
+}
+
+const MPoint MPoint::origin;
+const MVector MVector::zero;
+const MMatrix MMatrix::identity;
+const MObject MObject::kNullObj;
+const MDGContext MDGContext::fsNormal;
+
+double MVector::length() const
+{
+	return std::sqrt(x * x + y * y + z * z);
+}
+
+MMatrix::MMatrix()
+{
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			matrix[row][column] = (row == column) ? 1.0 : 0.0;
+		}
+	}
+}
+
+MPoint operator*(const MPoint& point, const MMatrix& matrix)
+{
+	const double in[4] = { point.x, point.y, point.z, point.w };
+	double out[4];
+	for (int column = 0; column < 4; ++column) {
+		out[column] = 0.0;
+		for (int row = 0; row < 4; ++row) {
+			out[column] += in[row] * matrix.matrix[row][column];
+		}
+	}
+	return MPoint(out[0], out[1], out[2], out[3]);
+}
+
+MPoint operator*(const MMatrix& matrix, const MPoint& point)
+{
+	return point * matrix;
+}
+
+// ---- Nodes, plugs and paths ----
+
+bool MObject::hasFn(MFn::Type type) const
+{
+	if (!m_node) {
+		return false;
+	}
+
+	MFn::Type own = m_node->type;
+	bool attribute = (own == MFn::kNumericAttribute);
+	bool data = (own == MFn::kMatrixData);
+	bool dag = (own == MFn::kTransform || own == MFn::kCamera || own == MFn::kMesh || own == MFn::kFluid || own == MFn::kLocator);
+	return type == own || type == MFn::kBase
+		|| (type == MFn::kAttribute && attribute)
+		|| (type == MFn::kDependencyNode && !attribute && !data)
+		|| (type == MFn::kDagNode && dag);
+}
+
+MFn::Type MObject::apiType() const
+{
+	return m_node ? m_node->type : MFn::kInvalid;
+}
+
+MObject MPlug::node(MStatus* status) const
+{
+	setStatus(status, MS::kSuccess);
+	return m_node;
+}
+
+MString MPlug::name(MStatus* status) const
+{
+	countCall("MPlug::name");
+	setStatus(status, MS::kSuccess);
+	return m_node.isNull() ? MString() : MString((m_node.mockNode()->name + "." + m_attribute).c_str());
+}
+
+bool MPlug::isConnected(MStatus* status) const
+{
+	countCall("MPlug::isConnected");
+	setStatus(status, MS::kSuccess);
+	const std::shared_ptr<Node>& node = m_node.mockNode();
+	if (!node) {
+		return false;
+	}
+	bool drivesOut = node->type == MFn::kAnimCurve && m_attribute == "output" && !node->destination.expired();
+	return node->inputs.count(m_attribute) > 0 || drivesOut;
+}
+
+MPlug MPlug::elementByLogicalIndex(unsigned int index, MStatus* status) const
+{
+	setStatus(status, MS::kSuccess);
+	return MPlug(m_node, m_attribute + "[" + std::to_string(index) + "]");
+}
+
+MObject MPlug::asMObject(MStatus* status) const
+{
+	countCall("MPlug::asMObject");
+	const std::shared_ptr<Node>& node = m_node.mockNode();
+	bool world = node && m_attribute.compare(0, 12, "worldMatrix[") == 0;
+	if (!node || (!world && m_attribute.compare(0, 13, "parentMatrix[") != 0)) {
+		setStatus(status, MS::kFailure);
+		return MObject();
+	}
+
+	std::shared_ptr<Node> data = std::make_shared<Node>();
+	data->type = MFn::kMatrixData;
+	data->inScene = false;
+	data->worldMatrix = world ? multiply(node->worldMatrix, parentMatrixNow(*node)) : parentMatrixNow(*node);
+	setStatus(status, MS::kSuccess);
+	return MObject(data);
+}
+
+bool MPlug::connectedTo(MPlugArray& plugs, bool asDst, bool asSrc, MStatus* status) const
+{
+	countCall("MPlug::connectedTo");
+	setStatus(status, MS::kSuccess);
+	plugs.clear();
+
+	const std::shared_ptr<Node>& node = m_node.mockNode();
+	if (!node) {
+		return false;
+	}
+	if (asDst) {
+		auto input = node->inputs.find(m_attribute);
+		if (input != node->inputs.end()) {
+			plugs.append(MPlug(MObject(input->second), "output"));
+		}
+	}
+	if (asSrc && node->type == MFn::kAnimCurve && m_attribute == "output") {
+		std::shared_ptr<Node> destination = node->destination.lock();
+		if (destination) {
+			plugs.append(MPlug(MObject(destination), node->destinationAttribute));
+		}
+	}
+	return plugs.length() > 0;
+}
+
+MDagPath MDagPath::mockPath(const std::shared_ptr<Node>& transform, bool toShape)
+{
+	MDagPath path;
+	path.m_transform = transform;
+	path.m_toShape = toShape && transform && transform->shape;
+	return path;
+}
+
+bool MDagPath::isValid(MStatus* status) const
+{
+	setStatus(status, MS::kSuccess);
+	return m_transform && m_transform->inScene;
+}
+
+MObject MDagPath::node(MStatus* status) const
+{
+	countCall("MDagPath::node");
+	setStatus(status, m_transform ? MS::kSuccess : MS::kFailure);
+	return MObject(m_toShape ? m_transform->shape : m_transform);
+}
+
+MStatus MDagPath::getAPathTo(const MObject& node, MDagPath& path)
+{
+	countCall("MDagPath::getAPathTo");
+	const std::shared_ptr<Node>& object = node.mockNode();
+	if (!object || !node.hasFn(MFn::kDagNode)) {
+		return MS::kInvalidParameter;
+	}
+
+	// Shapes are found through the transform above them
+	for (const std::shared_ptr<Node>& transform : scene().nodes) {
+		if (transform == object || transform->shape == object) {
+			path = mockPath(transform, transform != object);
+			return MS::kSuccess;
+		}
+	}
+	return MS::kNotFound;
+}
+
+MObject MDagPath::transform(MStatus* status) const
+{
+	countCall("MDagPath::transform");
+	setStatus(status, m_transform ? MS::kSuccess : MS::kInvalidParameter);
+	return MObject(m_transform);
+}
+
+bool MDagPath::hasFn(MFn::Type type, MStatus* status) const
+{
+	countCall("MDagPath::hasFn");
+	setStatus(status, m_transform ? MS::kSuccess : MS::kFailure);
+	if (!m_transform) {
+		return false;
+	}
+
+	// A transform also answers for its shape, as a path to it does in Maya
+	bool shape = m_transform->shape && MObject(m_transform->shape).hasFn(type);
+	return shape || (!m_toShape && MObject(m_transform).hasFn(type));
+}
+
+MStatus MDagPath::extendToShape()
+{
+	countCall("MDagPath::extendToShape");
+	if (!m_transform || !m_transform->shape) {
+		return MS::kFailure;
+	}
+	m_toShape = true;
+	return MS::kSuccess;
+}
+
+MMatrix MDagPath::inclusiveMatrix(MStatus* status) const
+{
+	countCall("MDagPath::inclusiveMatrix");
+	setStatus(status, m_transform ? MS::kSuccess : MS::kFailure);
+	return m_transform ? multiply(m_transform->worldMatrix, parentMatrixNow(*m_transform)) : MMatrix();
+}
+
+MMatrix MDagPath::exclusiveMatrix(MStatus* status) const
+{
+	countCall("MDagPath::exclusiveMatrix");
+	setStatus(status, m_transform ? MS::kSuccess : MS::kFailure);
+	return m_transform ? parentMatrixNow(*m_transform) : MMatrix();
+}
+
+unsigned int MDagPath::length(MStatus* status) const
+{
+	setStatus(status, m_transform ? MS::kSuccess : MS::kFailure);
+	if (!m_transform) {
+		return 0;
+	}
+	return 1 + (m_transform->parentMatrix ? 1 : 0) + (m_toShape ? 1 : 0);
+}
+
+MString MDagPath::partialPathName(MStatus* status) const
+{
+	countCall("MDagPath::partialPathName");
+	setStatus(status, m_transform ? MS::kSuccess : MS::kFailure);
+	if (!m_transform) {
+		return MString();
+	}
+	return MString((m_toShape ? m_transform->shape->name : m_transform->name).c_str());
+}
+
+MString MDagPath::fullPathName(MStatus* status) const
+{
+	return MString("|") + partialPathName(status);
+}
+
+MStatus MSelectionList::add(const MString& name, bool)
+{
+	countCall("MSelectionList::add");
+	std::shared_ptr<Node> node = findNode(name.asChar());
+	if (!node) {
+		return MS::kInvalidParameter;
+	}
+	m_items.push_back(MDagPath::mockPath(node, node->name != name.asChar()));
+	return MS::kSuccess;
+}
+
+MStatus MSelectionList::add(const MDagPath& path, const MObject&, bool)
+{
+	countCall("MSelectionList::add");
+	m_items.push_back(path);
+	return MS::kSuccess;
+}
+
+MStatus MSelectionList::getDagPath(unsigned int index, MDagPath& path) const
+{
+	countCall("MSelectionList::getDagPath");
+	if (index >= m_items.size()) {
+		return MS::kInvalidParameter;
+	}
+	path = m_items[index];
+	return MS::kSuccess;
+}
+
+unsigned int MSelectionList::length(MStatus* status) const
+{
+	setStatus(status, MS::kSuccess);
+	return (unsigned int)m_items.size();
+}
+
+MStatus MSelectionList::clear()
+{
+	m_items.clear();
+	return MS::kSuccess;
+}
+
+// ---- Arguments ----
+
+MString MArgList::asString(unsigned int index, MStatus* status) const
+{
+	if (index >= m_args.size()) {
+		setStatus(status, MS::kInvalidParameter);
+		return MString();
+	}
+	setStatus(status, MS::kSuccess);
+	return MString(m_args[index].c_str());
+}
+
+double MArgList::asDouble(unsigned int index, MStatus* status) const
+{
+	double value = 0.0;
+	bool valid = index < m_args.size() && parseNumber(m_args[index], value);
+	setStatus(status, valid ? MS::kSuccess : MS::kInvalidParameter);
+	return valid ? value : 0.0;
+}
+
+int MArgList::asInt(unsigned int index, MStatus* status) const
+{
+	return (int)asDouble(index, status);
+}
+
+bool MArgList::asBool(unsigned int index, MStatus* status) const
+{
+	if (index < m_args.size() && (m_args[index] == "true" || m_args[index] == "on")) {
+		setStatus(status, MS::kSuccess);
+		return true;
+	}
+	if (index < m_args.size() && (m_args[index] == "false" || m_args[index] == "off")) {
+		setStatus(status, MS::kSuccess);
+		return false;
+	}
+	return asDouble(index, status) != 0.0;
+}
+
+MStatus MArgList::addArg(const MString& arg)
+{
+	m_args.push_back(arg.asChar());
+	return MS::kSuccess;
+}
+
+MStatus MArgList::addArg(double arg)
+{
+	m_args.push_back(formatNumber(arg));
+	return MS::kSuccess;
+}
+
+MStatus MArgList::addArg(int arg)
+{
+	m_args.push_back(std::to_string(arg));
+	return MS::kSuccess;
+}
+
+MStatus MSyntax::addFlag(const char* shortName, const char* longName,
+	MArgType argType1, MArgType argType2, MArgType argType3,
+	MArgType argType4, MArgType argType5, MArgType argType6)
+{
+	if (findFlag(shortName) || findFlag(longName)) {
+		return MS::kInvalidParameter;
+	}
+
+	Flag flag;
+	flag.shortName = shortName;
+	flag.longName = longName;
+	for (MArgType type : { argType1, argType2, argType3, argType4, argType5, argType6 }) {
+		if (type == kNoArg) break;
+		flag.arguments.push_back(type);
+	}
+	m_flags.push_back(flag);
+	return MS::kSuccess;
+}
+
+MStatus MSyntax::makeFlagMultiUse(const char* flag)
+{
+	for (Flag& entry : m_flags) {
+		if (entry.shortName == flag || entry.longName == flag) {
+			entry.multiUse = true;
+			return MS::kSuccess;
+		}
+	}
+	return MS::kInvalidParameter;
+}
+
+const MSyntax::Flag* MSyntax::findFlag(const std::string& name) const
+{
+	for (const Flag& flag : m_flags) {
+		if (flag.shortName == name || flag.longName == name) {
+			return &flag;
+		}
+	}
+	return nullptr;
+}
+
+MArgDatabase::MArgDatabase(const MSyntax& syntax, const MArgList& args, MStatus* status)
+	: m_syntax(syntax)
+{
+	setStatus(status, MS::kSuccess);
+
+	for (unsigned int i = 0; i < args.length();) {
+		std::string name = args.asString(i++).asChar();
+		const MSyntax::Flag* flag = m_syntax.findFlag(name);
+		if (!flag) {
+			MGlobal::displayError(MString("Invalid flag: ") + name.c_str());
+			setStatus(status, MS::kInvalidParameter);
+			return;
+		}
+
+		std::vector<MArgList>& uses = m_uses[flag->shortName];
+		if (!uses.empty() && !flag->multiUse) {
+			MGlobal::displayError(MString("Flag can only be used once: ") + name.c_str());
+			setStatus(status, MS::kInvalidParameter);
+			return;
+		}
+
+		MArgList use;
+		for (MSyntax::MArgType type : flag->arguments) {
+			MStatus argStatus;
+			if (i >= args.length()) {
+				argStatus = MS::kInvalidParameter;
+			}
+			else if (type == MSyntax::kDouble || type == MSyntax::kLong || type == MSyntax::kUnsigned) {
+				args.asDouble(i, &argStatus);
+			}
+			if (!argStatus) {
+				MGlobal::displayError(MString("Invalid argument for flag ") + name.c_str());
+				setStatus(status, MS::kInvalidParameter);
+				return;
+			}
+			use.addArg(args.asString(i++));
+		}
+		uses.push_back(use);
+	}
+}
+
+const std::vector<MArgList>* MArgDatabase::uses(const char* flag) const
+{
+	const MSyntax::Flag* entry = m_syntax.findFlag(flag);
+	if (!entry) {
+		return nullptr;
+	}
+	auto found = m_uses.find(entry->shortName);
+	return (found == m_uses.end()) ? nullptr : &found->second;
+}
+
+bool MArgDatabase::isFlagSet(const char* flag, MStatus* status) const
+{
+	setStatus(status, MS::kSuccess);
+	return uses(flag) != nullptr;
+}
+
+unsigned int MArgDatabase::numberOfFlagUses(const char* flag) const
+{
+	const std::vector<MArgList>* flagUses = uses(flag);
+	return flagUses ? (unsigned int)flagUses->size() : 0;
+}
+
+MStatus MArgDatabase::getFlagArgumentList(const char* flag, unsigned int use, MArgList& args) const
+{
+	const std::vector<MArgList>* flagUses = uses(flag);
+	if (!flagUses || use >= flagUses->size()) {
+		return MS::kInvalidParameter;
+	}
+	args = (*flagUses)[use];
+	return MS::kSuccess;
+}
+
+double MArgDatabase::flagArgumentDouble(const char* flag, unsigned int index, MStatus* status) const
+{
+	MArgList args;
+	MStatus found = getFlagArgumentList(flag, 0, args);
+	setStatus(status, found);
+	return found ? args.asDouble(index, status) : 0.0;
+}
+
+int MArgDatabase::flagArgumentInt(const char* flag, unsigned int index, MStatus* status) const
+{
+	return (int)flagArgumentDouble(flag, index, status);
+}
+
+bool MArgDatabase::flagArgumentBool(const char* flag, unsigned int index, MStatus* status) const
+{
+	MArgList args;
+	MStatus found = getFlagArgumentList(flag, 0, args);
+	setStatus(status, found);
+	return found ? args.asBool(index, status) : false;
+}
+
+MString MArgDatabase::flagArgumentString(const char* flag, unsigned int index, MStatus* status) const
+{
+	MArgList args;
+	MStatus found = getFlagArgumentList(flag, 0, args);
+	setStatus(status, found);
+	return found ? args.asString(index, status) : MString();
+}
+
+// ---- Commands and globals ----
+
+void MPxCommand::clearResult()
+{
+	scene().result = CommandResult();
+}
+
+void MPxCommand::setResult(bool result)
+{
+	clearResult();
+	scene().result.type = CommandResult::Type::BOOLEAN;
+	scene().result.number = result ? 1.0 : 0.0;
+}
+
+void MPxCommand::setResult(int result)
+{
+	clearResult();
+	scene().result.type = CommandResult::Type::INT;
+	scene().result.number = result;
+}
+
+void MPxCommand::setResult(double result)
+{
+	clearResult();
+	scene().result.type = CommandResult::Type::DOUBLE;
+	scene().result.number = result;
+}
+
+void MPxCommand::setResult(const MString& result)
+{
+	clearResult();
+	scene().result.type = CommandResult::Type::STRING;
+	scene().result.string = result.asChar();
+}
+
+void MPxCommand::setResult(const MDoubleArray& result)
+{
+	clearResult();
+	scene().result.type = CommandResult::Type::DOUBLE_ARRAY;
+	for (unsigned int i = 0; i < result.length(); ++i) {
+		scene().result.numbers.push_back(result[i]);
+	}
+}
+
+void MGlobal::displayInfo(const MString& message)
+{
+	countCall("MGlobal::displayInfo");
+	scene().messages[(int)MessageKind::INFO].push_back(message.asChar());
+}
+
+void MGlobal::displayWarning(const MString& message)
+{
+	countCall("MGlobal::displayWarning");
+	scene().messages[(int)MessageKind::WARNING].push_back(message.asChar());
+}
+
+void MGlobal::displayError(const MString& message)
+{
+	countCall("MGlobal::displayError");
+	scene().messages[(int)MessageKind::ERROR].push_back(message.asChar());
+}
+
+MStatus MGlobal::getActiveSelectionList(MSelectionList& list, bool)
+{
+	countCall("MGlobal::getActiveSelectionList");
+	list.clear();
+	for (const MDagPath& path : scene().selection) {
+		list.add(path);
+	}
+	return MS::kSuccess;
+}
+
+MStatus MGlobal::setActiveSelectionList(const MSelectionList& list, ListAdjustment)
+{
+	countCall("MGlobal::setActiveSelectionList");
+	scene().selection.clear();
+	for (unsigned int i = 0; i < list.length(); ++i) {
+		MDagPath path;
+		list.getDagPath(i, path);
+		scene().selection.push_back(path);
+	}
+	return MS::kSuccess;
+}
+
+MStatus MGlobal::executeCommand(const MString& command, bool, bool undoEnabled)
+{
+	countCall("MGlobal::executeCommand");
+	return runCommand(command.asChar(), undoEnabled);
+}
+
+M3dView M3dView::active3dView(MStatus* status)
+{
+	countCall("M3dView::active3dView");
+	setStatus(status, MS::kSuccess);
+	return M3dView();
+}
+
+MStatus M3dView::refresh(bool, bool)
+{
+	countCall("M3dView::refresh");
+	return MS::kSuccess;
+}
+
+MStatus MMessage::removeCallback(MCallbackId id)
+{
+	countCall("MMessage::removeCallback");
+	return scene().timers.erase(id) > 0 ? MS::kSuccess : MS::kInvalidParameter;
+}
+
+MCallbackId MTimerMessage::addTimerCallback(float, MElapsedTimeFunction callback, void* clientData, MStatus* status)
+{
+	countCall("MTimerMessage::addTimerCallback");
+	setStatus(status, MS::kSuccess);
+	MCallbackId id = scene().nextTimer++;
+	scene().timers[id] = std::make_pair(callback, clientData);
+	return id;
+}
+
+// ---- Undo ----
+
+MAnimCurveChange::MAnimCurveChange()
+{
+}
+
+MAnimCurveChange::~MAnimCurveChange()
+{
+}
+
+void MAnimCurveChange::record(const std::shared_ptr<Node>& curve)
+{
+	std::unique_ptr<CurveEdit> edit(new CurveEdit());
+	edit->curve = curve;
+	edit->before = curve->curve;
+	m_edits.push_back(std::move(edit));
+}
+
+MStatus MAnimCurveChange::undoIt()
+{
+	countCall("MAnimCurveChange::undoIt");
+	for (auto edit = m_edits.rbegin(); edit != m_edits.rend(); ++edit) {
+		(*edit)->after = (*edit)->curve->curve;
+		(*edit)->curve->curve = (*edit)->before;
+	}
+	return MS::kSuccess;
+}
+
+MStatus MAnimCurveChange::redoIt()
+{
+	countCall("MAnimCurveChange::redoIt");
+	for (const std::unique_ptr<CurveEdit>& edit : m_edits) {
+		edit->curve->curve = edit->after;
+	}
+	return MS::kSuccess;
+}
+
+MDGModifier::MDGModifier()
+{
+}
+
+MDGModifier::~MDGModifier()
+{
+}
+
+MStatus MDGModifier::deleteNode(const MObject& node)
+{
+	countCall("MDGModifier::deleteNode");
+	if (node.isNull()) {
+		return MS::kInvalidParameter;
+	}
+	m_queued.push_back(node);
+	return MS::kSuccess;
+}
+
+MStatus MDGModifier::doIt()
+{
+	countCall("MDGModifier::doIt");
+	for (const std::shared_ptr<Node>& node : m_queuedCreations) {
+		node->inScene = true;
+		scene().nodes.push_back(node);
+		m_created.push_back(node);
+	}
+	m_queuedCreations.clear();
+
+	for (const MObject& object : m_queued) {
+		std::shared_ptr<Node> node = object.mockNode();
+		if (!node->inScene) {
+			continue;
+		}
+
+		std::unique_ptr<Deletion> deletion(new Deletion());
+		deletion->node = node;
+		deletion->destination = node->destination.lock();
+		deletion->destinationAttribute = node->destinationAttribute;
+		if (deletion->destination) {
+			deletion->destination->inputs.erase(node->destinationAttribute);
+		}
+		node->destination.reset();
+		node->inScene = false;
+
+		std::vector<std::shared_ptr<Node>>& nodes = scene().nodes;
+		nodes.erase(std::remove(nodes.begin(), nodes.end(), node), nodes.end());
+		m_done.push_back(std::move(deletion));
+	}
+	m_queued.clear();
+	return MS::kSuccess;
+}
+
+MStatus MDGModifier::undoIt()
+{
+	countCall("MDGModifier::undoIt");
+	MStatus status;
+	for (auto deletion = m_done.rbegin(); deletion != m_done.rend(); ++deletion) {
+		const std::shared_ptr<Node>& node = (*deletion)->node;
+		node->inScene = true;
+		scene().nodes.push_back(node);
+		if ((*deletion)->destination) {
+			if ((*deletion)->destination->inputs.count((*deletion)->destinationAttribute) > 0) {
+				status = MS::kFailure;
+				continue;
+			}
+			connect(node, (*deletion)->destination, (*deletion)->destinationAttribute);
+		}
+		// Queued again so a later doIt repeats the deletion
+		m_queued.insert(m_queued.begin(), MObject(node));
+	}
+	m_done.clear();
+
+	// Created nodes keep their state while out of the scene, so a later doIt brings them back as they were
+	std::vector<std::shared_ptr<Node>>& nodes = scene().nodes;
+	for (auto node = m_created.rbegin(); node != m_created.rend(); ++node) {
+		(*node)->inScene = false;
+		nodes.erase(std::remove(nodes.begin(), nodes.end(), *node), nodes.end());
+	}
+	m_queuedCreations.insert(m_queuedCreations.begin(), m_created.begin(), m_created.end());
+	m_created.clear();
+	return status;
+}
+
+MObject MDagModifier::createNode(const MString& type, const MObject& parent, MStatus* status)
+{
+	countCall("MDagModifier::createNode");
+	if (std::string(type.asChar()) != "locator" || !parent.isNull()) {
+		setStatus(status, MS::kInvalidParameter);
+		return MObject();
+	}
+
+	// Named like Maya does, locator1, locator2 ..., skipping names already taken or queued
+	std::string name;
+	for (int i = 1; name.empty(); ++i) {
+		std::string candidate = "locator" + std::to_string(i);
+		bool queued = std::any_of(m_queuedCreations.begin(), m_queuedCreations.end(),
+			[&](const std::shared_ptr<Node>& node) { return node->name == candidate; });
+		if (!queued && !findNode(candidate)) {
+			name = candidate;
+		}
+	}
+
+	std::shared_ptr<Node> transform = makeTransform(name, MFn::kLocator, 0.0, 0.0, 0.0);
+	transform->shape->name = "locatorShape" + name.substr(7);
+	transform->inScene = false;
+	m_queuedCreations.push_back(transform);
+
+	setStatus(status, MS::kSuccess);
+	return MObject(transform);
+}
+
+// ---- Function sets ----
+
+MFnDependencyNode::MFnDependencyNode(const MObject& object, MStatus* status)
+{
+	setStatus(status, setObject(object));
+}
+
+MStatus MFnDependencyNode::setObject(const MObject& object)
+{
+	countCall("MFnDependencyNode::setObject");
+	m_object = object;
+	return object.hasFn(MFn::kDependencyNode) ? MS::kSuccess : MS::kInvalidParameter;
+}
+
+MString MFnDependencyNode::name(MStatus* status) const
+{
+	countCall("MFnDependencyNode::name");
+	setStatus(status, m_object.isNull() ? MS::kFailure : MS::kSuccess);
+	return m_object.isNull() ? MString() : MString(m_object.mockNode()->name.c_str());
+}
+
+MPlug MFnDependencyNode::findPlug(const MString& attribute, bool, MStatus* status) const
+{
+	countCall("MFnDependencyNode::findPlug");
+	if (!hasAttribute(attribute)) {
+		setStatus(status, MS::kInvalidParameter);
+		return MPlug();
+	}
+	setStatus(status, MS::kSuccess);
+	return MPlug(m_object, attribute.asChar());
+}
+
+bool MFnDependencyNode::hasAttribute(const MString& name, MStatus* status) const
+{
+	countCall("MFnDependencyNode::hasAttribute");
+	setStatus(status, m_object.isNull() ? MS::kFailure : MS::kSuccess);
+	return !m_object.isNull() && m_object.mockNode()->attributes.count(name.asChar()) > 0;
+}
+
+MStatus MFnDependencyNode::addAttribute(const MObject& attribute)
+{
+	countCall("MFnDependencyNode::addAttribute");
+	if (m_object.isNull() || !attribute.hasFn(MFn::kAttribute)) {
+		return MS::kInvalidParameter;
+	}
+
+	// An attribute object carries its long and short name in the node's attribute set
+	const std::set<std::string>& names = attribute.mockNode()->attributes;
+	std::set<std::string>& attributes = m_object.mockNode()->attributes;
+	for (const std::string& name : names) {
+		if (attributes.count(name) > 0) {
+			return MS::kFailure;
+		}
+	}
+	attributes.insert(names.begin(), names.end());
+	return MS::kSuccess;
+}
+
+MFnTransform::MFnTransform(const MObject& object, MStatus* status)
+{
+	setStatus(status, setObject(object));
+	if (!object.hasFn(MFn::kTransform)) {
+		setStatus(status, MS::kInvalidParameter);
+	}
+}
+
+MTransformationMatrix::RotationOrder MFnTransform::rotationOrder(MStatus* status) const
+{
+	countCall("MFnTransform::rotationOrder");
+	setStatus(status, m_object.hasFn(MFn::kTransform) ? MS::kSuccess : MS::kFailure);
+	return m_object.hasFn(MFn::kTransform) ? m_object.mockNode()->rotationOrder : MTransformationMatrix::kInvalid;
+}
+
+MStatus MFnTransform::setTranslation(const MVector& translation, MSpace::Space)
+{
+	countCall("MFnTransform::setTranslation");
+	if (!m_object.hasFn(MFn::kTransform)) {
+		return MS::kFailure;
+	}
+
+	MMatrix& matrix = m_object.mockNode()->worldMatrix;
+	matrix.matrix[3][0] = translation.x;
+	matrix.matrix[3][1] = translation.y;
+	matrix.matrix[3][2] = translation.z;
+	return MS::kSuccess;
+}
+
+MFnMatrixData::MFnMatrixData(const MObject& object, MStatus* status) : m_object(object)
+{
+	setStatus(status, object.hasFn(MFn::kMatrixData) ? MS::kSuccess : MS::kInvalidParameter);
+}
+
+MMatrix MFnMatrixData::matrix(MStatus* status) const
+{
+	setStatus(status, m_object.hasFn(MFn::kMatrixData) ? MS::kSuccess : MS::kFailure);
+	return m_object.hasFn(MFn::kMatrixData) ? m_object.mockNode()->worldMatrix : MMatrix();
+}
+
+MDGContextGuard::MDGContextGuard(const MDGContext& context) : m_previous(scene().context)
+{
+	countCall("MDGContextGuard");
+	scene().context = context;
+}
+
+MDGContextGuard::~MDGContextGuard()
+{
+	scene().context = m_previous;
+}
+
+MObject MFnNumericAttribute::create(const MString& fullName, const MString& briefName, MFnNumericData::Type,
+	double, MStatus* status)
+{
+	countCall("MFnNumericAttribute::create");
+	std::shared_ptr<Node> attribute = std::make_shared<Node>();
+	attribute->name = fullName.asChar();
+	attribute->type = MFn::kNumericAttribute;
+	attribute->inScene = false;
+	attribute->attributes.insert(fullName.asChar());
+	attribute->attributes.insert(briefName.asChar());
+
+	m_attribute = MObject(attribute);
+	setStatus(status, MS::kSuccess);
+	return m_attribute;
+}
+
+MStatus MFnNumericAttribute::setHidden(bool)
+{
+	countCall("MFnNumericAttribute::setHidden");
+	return m_attribute.isNull() ? MS::kFailure : MS::kSuccess;
+}
+
+MFnMesh::MFnMesh(const MDagPath& path, MStatus* status)
+	: m_path(path)
+{
+	countCall("MFnMesh::MFnMesh");
+	MObject transform = path.transform();
+	if (!transform.isNull() && transform.mockNode()->shape && transform.mockNode()->shape->type == MFn::kMesh) {
+		m_mesh = transform.mockNode()->shape;
+	}
+	setStatus(status, m_mesh ? MS::kSuccess : MS::kInvalidParameter);
+}
+
+MStatus MFnMesh::getPoints(MPointArray& points, MSpace::Space space) const
+{
+	countCall("MFnMesh::getPoints");
+	points.clear();
+	if (!m_mesh) {
+		return MS::kFailure;
+	}
+
+	MMatrix matrix = (space == MSpace::kWorld) ? m_path.inclusiveMatrix() : MMatrix();
+	for (const MPoint& point : m_mesh->points) {
+		points.append(point * matrix);
+	}
+	return MS::kSuccess;
+}
+
+MStatus MFnMesh::getTriangles(MIntArray& triangleCounts, MIntArray& triangleVertices) const
+{
+	countCall("MFnMesh::getTriangles");
+	triangleCounts.clear();
+	triangleVertices.clear();
+	if (!m_mesh) {
+		return MS::kFailure;
+	}
+
+	// Every polygon of a mock mesh is already a triangle
+	for (size_t i = 0; i + 2 < m_mesh->triangleVertices.size(); i += 3) {
+		triangleCounts.append(1);
+		for (size_t k = 0; k < 3; ++k) {
+			triangleVertices.append(m_mesh->triangleVertices[i + k]);
+		}
+	}
+	return MS::kSuccess;
+}
+
+MFnFluid::MFnFluid(const MDagPath& path, MStatus* status)
+{
+	countCall("MFnFluid::MFnFluid");
+	MObject transform = path.transform();
+	if (!transform.isNull() && transform.mockNode()->shape && transform.mockNode()->shape->type == MFn::kFluid) {
+		m_fluid = transform.mockNode()->shape;
+	}
+	setStatus(status, m_fluid ? MS::kSuccess : MS::kInvalidParameter);
+}
+
+MStatus MFnFluid::getResolution(unsigned& xres, unsigned& yres, unsigned& zres) const
+{
+	countCall("MFnFluid::getResolution");
+	if (!m_fluid) {
+		return MS::kFailure;
+	}
+
+	xres = (unsigned)m_fluid->resolution[0];
+	yres = (unsigned)m_fluid->resolution[1];
+	zres = (unsigned)m_fluid->resolution[2];
+	return MS::kSuccess;
+}
+
+MStatus MFnFluid::getDimensions(double& xdim, double& ydim, double& zdim) const
+{
+	countCall("MFnFluid::getDimensions");
+	if (!m_fluid) {
+		return MS::kFailure;
+	}
+
+	xdim = m_fluid->dimensions[0];
+	ydim = m_fluid->dimensions[1];
+	zdim = m_fluid->dimensions[2];
+	return MS::kSuccess;
+}
+
+MStatus MFnFluid::getVelocity(float*& xvel, float*& yvel, float*& zvel)
+{
+	countCall("MFnFluid::getVelocity");
+	if (!m_fluid) {
+		return MS::kFailure;
+	}
+
+	xvel = m_fluid->velocity[0].data();
+	yvel = m_fluid->velocity[1].data();
+	zvel = m_fluid->velocity[2].data();
+	return MS::kSuccess;
+}
+
+int MFnFluid::index(int xi, int yi, int zi, int, int yres, int zres) const
+{
+	return xi * yres * zres + yi * zres + zi;
+}
+
+MFnAnimCurve::MFnAnimCurve(const MObject& object, MStatus* status)
+{
+	setStatus(status, setObject(object));
+	if (!object.hasFn(MFn::kAnimCurve)) {
+		setStatus(status, MS::kInvalidParameter);
+	}
+}
+
+MObject MFnAnimCurve::create(const MPlug& plug, MDGModifier*, MStatus* status)
+{
+	countCall("MFnAnimCurve::create");
+	std::shared_ptr<Node> target = plug.node().mockNode();
+	std::string attribute = plug.partialName().asChar();
+	if (!target || !target->inScene || target->inputs.count(attribute) > 0) {
+		setStatus(status, MS::kFailure);
+		return MObject();
+	}
+
+	std::shared_ptr<Node> curve = std::make_shared<Node>();
+	curve->name = uniqueName(target->name + "_" + attribute);
+	curve->type = MFn::kAnimCurve;
+	curve->attributes = { "input", "output", "i", "o" };
+	connect(curve, target, attribute);
+	scene().nodes.push_back(curve);
+
+	m_object = MObject(curve);
+	setStatus(status, MS::kSuccess);
+	return m_object;
+}
+
+unsigned int MFnAnimCurve::numKeys(MStatus* status) const
+{
+	countCall("MFnAnimCurve::numKeys");
+	Node* curve = curveNode(m_object);
+	setStatus(status, curve ? MS::kSuccess : MS::kFailure);
+	return curve ? (unsigned int)curve->curve.keys.size() : 0;
+}
+
+// Shared by the per-key queries: the key, or null with status set
+static const AnimKey* keyAt(const MObject& object, unsigned int index, MStatus* status)
+{
+	Node* curve = curveNode(object);
+	if (!curve || index >= curve->curve.keys.size()) {
+		setStatus(status, MS::kInvalidParameter);
+		return nullptr;
+	}
+	setStatus(status, MS::kSuccess);
+	return &curve->curve.keys[index];
+}
+
+MTime MFnAnimCurve::time(unsigned int index, MStatus* status) const
+{
+	countCall("MFnAnimCurve::time");
+	const AnimKey* key = keyAt(m_object, index, status);
+	return key ? key->time : MTime();
+}
+
+double MFnAnimCurve::value(unsigned int index, MStatus* status) const
+{
+	countCall("MFnAnimCurve::value");
+	const AnimKey* key = keyAt(m_object, index, status);
+	return key ? key->value : 0.0;
+}
+
+MFnAnimCurve::TangentType MFnAnimCurve::inTangentType(unsigned int index, MStatus* status) const
+{
+	countCall("MFnAnimCurve::inTangentType");
+	const AnimKey* key = keyAt(m_object, index, status);
+	return key ? key->inType : kTangentGlobal;
+}
+
+MFnAnimCurve::TangentType MFnAnimCurve::outTangentType(unsigned int index, MStatus* status) const
+{
+	countCall("MFnAnimCurve::outTangentType");
+	const AnimKey* key = keyAt(m_object, index, status);
+	return key ? key->outType : kTangentGlobal;
+}
+
+bool MFnAnimCurve::isWeighted(MStatus* status) const
+{
+	countCall("MFnAnimCurve::isWeighted");
+	Node* curve = curveNode(m_object);
+	setStatus(status, curve ? MS::kSuccess : MS::kFailure);
+	return curve && curve->curve.weighted;
+}
+
+bool MFnAnimCurve::weightsLocked(unsigned int index, MStatus* status) const
+{
+	countCall("MFnAnimCurve::weightsLocked");
+	const AnimKey* key = keyAt(m_object, index, status);
+	return key && key->weightsLocked;
+}
+
+bool MFnAnimCurve::tangentsLocked(unsigned int index, MStatus* status) const
+{
+	countCall("MFnAnimCurve::tangentsLocked");
+	const AnimKey* key = keyAt(m_object, index, status);
+	return key && key->tangentsLocked;
+}
+
+MStatus MFnAnimCurve::getTangent(unsigned int index, double& x, double& y, bool inTangent) const
+{
+	countCall("MFnAnimCurve::getTangent");
+	MStatus status;
+	const AnimKey* key = keyAt(m_object, index, &status);
+	if (key) {
+		x = inTangent ? key->inX : key->outX;
+		y = inTangent ? key->inY : key->outY;
+	}
+	return status;
+}
+
+bool MFnAnimCurve::find(const MTime& time, unsigned int& index, MStatus* status) const
+{
+	countCall("MFnAnimCurve::find");
+	Node* curve = curveNode(m_object);
+	setStatus(status, curve ? MS::kSuccess : MS::kFailure);
+	if (!curve) {
+		return false;
+	}
+
+	const double seconds = time.as(MTime::kSeconds);
+	for (size_t i = 0; i < curve->curve.keys.size(); ++i) {
+		if (std::fabs(curve->curve.keys[i].time.as(MTime::kSeconds) - seconds) < 1e-9) {
+			index = (unsigned int)i;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Every edit goes through here: the curve, snapshotted into the change first
+static Node* editCurve(const MObject& object, MAnimCurveChange* change)
+{
+	Node* curve = curveNode(object);
+	if (curve && change) {
+		change->record(object.mockNode());
+	}
+	return curve;
+}
+
+// Keys sorted by time, as Maya keeps them
+static size_t insertKey(CurveData& data, const AnimKey& key)
+{
+	const double seconds = key.time.as(MTime::kSeconds);
+	size_t index = 0;
+	while (index < data.keys.size() && data.keys[index].time.as(MTime::kSeconds) < seconds - 1e-9) {
+		++index;
+	}
+
+	// Keying an existing time replaces that key's value
+	if (index < data.keys.size() && std::fabs(data.keys[index].time.as(MTime::kSeconds) - seconds) < 1e-9) {
+		data.keys[index].value = key.value;
+		return index;
+	}
+	data.keys.insert(data.keys.begin() + index, key);
+	return index;
+}
+
+MStatus MFnAnimCurve::addKeys(MTimeArray* times, MDoubleArray* values, TangentType inType, TangentType outType,
+	bool keepExistingKeys, MAnimCurveChange* change)
+{
+	countCall("MFnAnimCurve::addKeys");
+	if (!times || !values || times->length() != values->length()) {
+		return MS::kInvalidParameter;
+	}
+	Node* curve = editCurve(m_object, change);
+	if (!curve) {
+		return MS::kFailure;
+	}
+
+	// Without keepExistingKeys the keys in the span of the new ones are replaced
+	if (!keepExistingKeys && times->length() > 0) {
+		double first = (*times)[0].as(MTime::kSeconds);
+		double last = (*times)[times->length() - 1].as(MTime::kSeconds);
+		std::vector<AnimKey>& keys = curve->curve.keys;
+		keys.erase(std::remove_if(keys.begin(), keys.end(), [&](const AnimKey& key) {
+			double seconds = key.time.as(MTime::kSeconds);
+			return seconds >= first - 1e-9 && seconds <= last + 1e-9;
+		}), keys.end());
+	}
+
+	for (unsigned int i = 0; i < times->length(); ++i) {
+		AnimKey key;
+		key.time = (*times)[i];
+		key.value = (*values)[i];
+		key.inType = inType;
+		key.outType = outType;
+		insertKey(curve->curve, key);
+	}
+	return MS::kSuccess;
+}
+
+unsigned int MFnAnimCurve::addKey(const MTime& time, double value, TangentType inType, TangentType outType,
+	MAnimCurveChange* change, MStatus* status)
+{
+	countCall("MFnAnimCurve::addKey");
+	Node* curve = editCurve(m_object, change);
+	if (!curve) {
+		setStatus(status, MS::kFailure);
+		return 0;
+	}
+
+	AnimKey key;
+	key.time = time;
+	key.value = value;
+	key.inType = inType;
+	key.outType = outType;
+	setStatus(status, MS::kSuccess);
+	return (unsigned int)insertKey(curve->curve, key);
+}
+
+MStatus MFnAnimCurve::remove(unsigned int index, MAnimCurveChange* change)
+{
+	countCall("MFnAnimCurve::remove");
+	if (!keyAt(m_object, index, nullptr)) {
+		return MS::kInvalidParameter;
+	}
+	Node* curve = editCurve(m_object, change);
+	curve->curve.keys.erase(curve->curve.keys.begin() + index);
+	return MS::kSuccess;
+}
+
+MStatus MFnAnimCurve::setTime(unsigned int index, const MTime& time, MAnimCurveChange* change)
+{
+	countCall("MFnAnimCurve::setTime");
+	if (!keyAt(m_object, index, nullptr)) {
+		return MS::kInvalidParameter;
+	}
+
+	// A key cannot be moved onto or past its neighbours
+	const std::vector<AnimKey>& keys = curveNode(m_object)->curve.keys;
+	const double seconds = time.as(MTime::kSeconds);
+	if ((index > 0 && keys[index - 1].time.as(MTime::kSeconds) >= seconds - 1e-9)
+		|| (index + 1 < keys.size() && keys[index + 1].time.as(MTime::kSeconds) <= seconds + 1e-9)) {
+		return MS::kFailure;
+	}
+
+	editCurve(m_object, change)->curve.keys[index].time = time;
+	return MS::kSuccess;
+}
+
+MStatus MFnAnimCurve::setValue(unsigned int index, double value, MAnimCurveChange* change)
+{
+	countCall("MFnAnimCurve::setValue");
+	if (!keyAt(m_object, index, nullptr)) {
+		return MS::kInvalidParameter;
+	}
+	editCurve(m_object, change)->curve.keys[index].value = value;
+	return MS::kSuccess;
+}
+
+MStatus MFnAnimCurve::setInTangentType(unsigned int index, TangentType type, MAnimCurveChange* change)
+{
+	countCall("MFnAnimCurve::setInTangentType");
+	if (!keyAt(m_object, index, nullptr)) {
+		return MS::kInvalidParameter;
+	}
+	editCurve(m_object, change)->curve.keys[index].inType = type;
+	return MS::kSuccess;
+}
+
+MStatus MFnAnimCurve::setOutTangentType(unsigned int index, TangentType type, MAnimCurveChange* change)
+{
+	countCall("MFnAnimCurve::setOutTangentType");
+	if (!keyAt(m_object, index, nullptr)) {
+		return MS::kInvalidParameter;
+	}
+	editCurve(m_object, change)->curve.keys[index].outType = type;
+	return MS::kSuccess;
+}
+
+MStatus MFnAnimCurve::setIsWeighted(bool weighted, MAnimCurveChange* change)
+{
+	countCall("MFnAnimCurve::setIsWeighted");
+	Node* curve = editCurve(m_object, change);
+	if (!curve) {
+		return MS::kFailure;
+	}
+	curve->curve.weighted = weighted;
+	return MS::kSuccess;
+}
+
+MStatus MFnAnimCurve::setWeightsLocked(unsigned int index, bool locked, MAnimCurveChange* change)
+{
+	countCall("MFnAnimCurve::setWeightsLocked");
+	if (!keyAt(m_object, index, nullptr)) {
+		return MS::kInvalidParameter;
+	}
+	editCurve(m_object, change)->curve.keys[index].weightsLocked = locked;
+	return MS::kSuccess;
+}
+
+MStatus MFnAnimCurve::setTangentsLocked(unsigned int index, bool locked, MAnimCurveChange* change)
+{
+	countCall("MFnAnimCurve::setTangentsLocked");
+	if (!keyAt(m_object, index, nullptr)) {
+		return MS::kInvalidParameter;
+	}
+	editCurve(m_object, change)->curve.keys[index].tangentsLocked = locked;
+	return MS::kSuccess;
+}
+
+MStatus MFnAnimCurve::setTangent(unsigned int index, double x, double y, bool inTangent,
+	MAnimCurveChange* change, bool)
+{
+	countCall("MFnAnimCurve::setTangent");
+	if (!keyAt(m_object, index, nullptr)) {
+		return MS::kInvalidParameter;
+	}
+
+	// Locked tangents move together, as in Maya
+	AnimKey& key = editCurve(m_object, change)->curve.keys[index];
+	if (inTangent || key.tangentsLocked) {
+		key.inX = x;
+		key.inY = y;
+	}
+	if (!inTangent || key.tangentsLocked) {
+		key.outX = x;
+		key.outY = y;
+	}
+	return MS::kSuccess;
+}
+
+// ---- Scene helpers ----
+
+namespace MockMaya {
+
+void resetScene()
+{
+	Scene& state = scene();
+	state.undoQueue.clear();
+	state.redoQueue.clear();
+	state.nodes.clear();
+	state.selection.clear();
+	state.calls.clear();
+	for (std::vector<std::string>& list : state.messages) {
+		list.clear();
+	}
+	state.result = CommandResult();
+	state.timers.clear();
+	state.uiUnit = MTime::kFilm;
+	state.context = MDGContext();
+}
+
+MDagPath createCamera(const std::string& name, double x, double y, double z)
+{
+	return MDagPath::mockPath(addTransform(name, MFn::kCamera, x, y, z), false);
+}
+
+MDagPath createLocator(const std::string& name, double x, double y, double z)
+{
+	return MDagPath::mockPath(addTransform(name, MFn::kInvalid, x, y, z), false);
+}
+
+MDagPath createMesh(const std::string& name, const std::vector<MPoint>& points, const std::vector<int>& triangleVertices)
+{
+	std::shared_ptr<Node> transform = addTransform(name, MFn::kMesh, 0.0, 0.0, 0.0);
+	transform->shape->points = points;
+	transform->shape->triangleVertices = triangleVertices;
+	return MDagPath::mockPath(transform, false);
+}
+
+MDagPath createFluid(const std::string& name, int xres, int yres, int zres, double xdim, double ydim, double zdim,
+	double x, double y, double z, const MVector& velocity)
+{
+	std::shared_ptr<Node> transform = addTransform(name, MFn::kFluid, x, y, z);
+	Node& fluid = *transform->shape;
+	fluid.resolution[0] = xres;
+	fluid.resolution[1] = yres;
+	fluid.resolution[2] = zres;
+	fluid.dimensions[0] = xdim;
+	fluid.dimensions[1] = ydim;
+	fluid.dimensions[2] = zdim;
+	fluid.velocity[0].assign((size_t)(xres + 1) * yres * zres, (float)velocity.x);
+	fluid.velocity[1].assign((size_t)xres * (yres + 1) * zres, (float)velocity.y);
+	fluid.velocity[2].assign((size_t)xres * yres * (zres + 1), (float)velocity.z);
+	return MDagPath::mockPath(transform, false);
+}
+
+void setWorldMatrix(const MDagPath& path, const MMatrix& matrix)
+{
+	path.transform().mockNode()->worldMatrix = matrix;
+}
+
+void setParentMatrix(const MDagPath& path, std::function<MMatrix(const MTime&)> parentMatrix)
+{
+	path.transform().mockNode()->parentMatrix = parentMatrix;
+}
+
+void setRotationOrder(const MDagPath& path, MTransformationMatrix::RotationOrder order)
+{
+	path.transform().mockNode()->rotationOrder = order;
+}
+
+MObject inputCurve(const MDagPath& path, const char* attribute)
+{
+	std::shared_ptr<Node> node = path.transform().mockNode();
+	if (!node || node->inputs.count(attribute) == 0) {
+		return MObject();
+	}
+	return MObject(node->inputs[attribute]);
+}
+
+size_t nodeCount(MFn::Type type)
+{
+	size_t count = 0;
+	for (const std::shared_ptr<Node>& node : scene().nodes) {
+		count += MObject(node).hasFn(type) ? 1 : 0;
+		count += (node->shape && node->shape->type == type) ? 1 : 0;
+	}
+	return count;
+}
+
+bool inScene(const MObject& node)
+{
+	return !node.isNull() && node.mockNode()->inScene;
+}
+
+void resetCalls()
+{
+	scene().calls.clear();
+}
+
+size_t calls(const char* api)
+{
+	auto found = scene().calls.find(api);
+	return (found == scene().calls.end()) ? 0 : found->second;
+}
+
+size_t totalCalls()
+{
+	size_t total = 0;
+	for (const auto& entry : scene().calls) {
+		total += entry.second;
+	}
+	return total;
+}
+
+const std::map<std::string, size_t>& allCalls()
+{
+	return scene().calls;
+}
+
+const std::vector<std::string>& messages(MessageKind kind)
+{
+	return scene().messages[(int)kind];
+}
+
+const CommandResult& lastResult()
+{
+	return scene().result;
+}
+
+void registerCommand(const char* name, CommandCreator creator)
+{
+	scene().commands[name] = creator;
+}
+
+MStatus runCommand(const std::string& commandLine, bool undoable)
+{
+	std::istringstream stream(commandLine);
+	std::string name;
+	stream >> name;
+
+	auto creator = scene().commands.find(name);
+	if (creator == scene().commands.end()) {
+		MGlobal::displayError(MString("Unknown command: ") + name.c_str());
+		return MS::kFailure;
+	}
+
+	// Whitespace-separated arguments, with double quotes around strings
+	MArgList args;
+	std::string token;
+	while (stream >> token) {
+		if (token.size() >= 2 && token.front() == '"' && token.back() == '"') {
+			token = token.substr(1, token.size() - 2);
+		}
+		args.addArg(MString(token.c_str()));
+	}
+
+	std::unique_ptr<MPxCommand> command(static_cast<MPxCommand*>(creator->second()));
+	MPxCommand::clearResult();
+	MStatus status = command->doIt(args);
+	if (status && undoable && command->isUndoable()) {
+		scene().undoQueue.push_back(std::move(command));
+		scene().redoQueue.clear();
+	}
+	return status;
+}
+
+bool undo()
+{
+	Scene& state = scene();
+	if (state.undoQueue.empty()) {
+		return false;
+	}
+
+	std::unique_ptr<MPxCommand> command = std::move(state.undoQueue.back());
+	state.undoQueue.pop_back();
+	bool undone = command->undoIt();
+	state.redoQueue.push_back(std::move(command));
+	return undone;
+}
+
+bool redo()
+{
+	Scene& state = scene();
+	if (state.redoQueue.empty()) {
+		return false;
+	}
+
+	std::unique_ptr<MPxCommand> command = std::move(state.redoQueue.back());
+	state.redoQueue.pop_back();
+	bool redone = command->redoIt();
+	state.undoQueue.push_back(std::move(command));
+	return redone;
+}
+
+size_t undoQueueLength()
+{
+	return scene().undoQueue.size();
+}
+
+size_t timerCount()
+{
+	return scene().timers.size();
+}
+
+void fireTimers(float elapsedTime)
+{
+	// Callbacks may add or remove timers while they run
+	auto timers = scene().timers;
+	for (const auto& timer : timers) {
+		if (scene().timers.count(timer.first) > 0) {
+			timer.second.first(elapsedTime, 0.0f, timer.second.second);
+		}
+	}
+}
+
+}
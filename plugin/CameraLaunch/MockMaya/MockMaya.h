@@ -0,0 +1,770 @@
+#pragma once
+
+// Stand-in for the parts of the Maya API the command uses, so CameraLaunchCmd.cpp builds and
+// runs on Linux. Nodes, connections and anim curve keys live in an in-memory scene, and every
+// call into a function set, plug, modifier or MGlobal is counted under "Class::method" so tests
+// can pin down how many DG calls a launch makes. Value types (MString, MTime, arrays) are free.
+// The maya/ headers next to this file all forward here.
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MockMaya {
+struct Node;
+struct CurveEdit;
+struct Deletion;
+}
+
+namespace MS {
+enum MStatusCode {
+	kSuccess = 0,
+	kFailure,
+	kInvalidParameter,
+	kNotFound
+};
+}
+
+class MStatus
+{
+public:
+	MStatus() : m_code(MS::kSuccess) {}
+	MStatus(MS::MStatusCode code) : m_code(code) {}
+
+	operator bool() const { return m_code == MS::kSuccess; }
+	bool operator==(MS::MStatusCode code) const { return m_code == code; }
+	bool operator!=(MS::MStatusCode code) const { return m_code != code; }
+	bool operator==(const MStatus& other) const { return m_code == other.m_code; }
+	bool operator!=(const MStatus& other) const { return m_code != other.m_code; }
+	MS::MStatusCode statusCode() const { return m_code; }
+
+private:
+	MS::MStatusCode m_code;
+};
+
+class MString
+{
+public:
+	MString() {}
+	MString(const char* text) : m_text(text ? text : "") {}
+
+	const char* asChar() const { return m_text.c_str(); }
+	unsigned int length() const { return (unsigned int)m_text.size(); }
+
+	MString& operator+=(const MString& other);
+	MString& operator+=(const char* other);
+	MString& operator+=(int value);
+	MString& operator+=(double value);
+	MString operator+(const MString& other) const;
+	MString operator+(const char* other) const;
+	MString operator+(int value) const;
+	MString operator+(double value) const;
+
+	bool operator==(const MString& other) const { return m_text == other.m_text; }
+	bool operator==(const char* other) const { return m_text == (other ? other : ""); }
+	bool operator!=(const MString& other) const { return m_text != other.m_text; }
+
+private:
+	std::string m_text;
+};
+
+MString operator+(const char* left, const MString& right);
+
+class MTime
+{
+public:
+	enum Unit {
+		kInvalid,
+		kHours,
+		kMinutes,
+		kSeconds,
+		kMilliseconds,
+		kGames,
+		kFilm,
+		kPALFrame,
+		kNTSCFrame,
+		kShowScan,
+		kPALField,
+		kNTSCField,
+		kLast
+	};
+
+	MTime() : m_value(0.0), m_unit(kFilm) {}
+	MTime(double value, Unit unit = kFilm) : m_value(value), m_unit(unit) {}
+
+	double value() const { return m_value; }
+	Unit unit() const { return m_unit; }
+	double as(Unit unit) const;
+	double asUnits(Unit unit) const { return as(unit); }
+
+	bool operator==(const MTime& other) const { return as(kSeconds) == other.as(kSeconds); }
+	bool operator<(const MTime& other) const { return as(kSeconds) < other.as(kSeconds); }
+
+	static Unit uiUnit();
+	static MStatus setUIUnit(Unit unit);
+
+private:
+	double m_value;
+	Unit m_unit;
+};
+
+class MAngle
+{
+public:
+	enum Unit {
+		kInvalid,
+		kRadians,
+		kDegrees,
+		kAngMinutes,
+		kAngSeconds,
+		kLast
+	};
+
+	MAngle() : m_value(0.0), m_unit(kRadians) {}
+	MAngle(double value, Unit unit = kRadians) : m_value(value), m_unit(unit) {}
+
+	double as(Unit unit) const;
+	double asRadians() const { return as(kRadians); }
+	double asDegrees() const { return as(kDegrees); }
+
+private:
+	double m_value;
+	Unit m_unit;
+};
+
+class MPoint
+{
+public:
+	MPoint() : x(0.0), y(0.0), z(0.0), w(1.0) {}
+	MPoint(double x, double y, double z, double w = 1.0) : x(x), y(y), z(z), w(w) {}
+
+	static const MPoint origin;
+
+	double x, y, z, w;
+};
+
+class MVector
+{
+public:
+	MVector() : x(0.0), y(0.0), z(0.0) {}
+	MVector(double x, double y, double z = 0.0) : x(x), y(y), z(z) {}
+	MVector(const MPoint& point) : x(point.x), y(point.y), z(point.z) {}
+
+	double length() const;
+	MVector operator+(const MVector& other) const { return MVector(x + other.x, y + other.y, z + other.z); }
+	MVector operator-(const MVector& other) const { return MVector(x - other.x, y - other.y, z - other.z); }
+	MVector operator*(double scale) const { return MVector(x * scale, y * scale, z * scale); }
+	MVector& operator+=(const MVector& other) { x += other.x; y += other.y; z += other.z; return *this; }
+
+	static const MVector zero;
+
+	double x, y, z;
+};
+
+// Row-major with the translation in the last row, as in Maya
+class MMatrix
+{
+public:
+	MMatrix();
+
+	static const MMatrix identity;
+
+	double matrix[4][4];
+};
+
+// Points are row vectors: both orders give point * matrix
+MPoint operator*(const MPoint& point, const MMatrix& matrix);
+MPoint operator*(const MMatrix& matrix, const MPoint& point);
+
+class MTransformationMatrix
+{
+public:
+	enum RotationOrder {
+		kInvalid,
+		kXYZ,
+		kYZX,
+		kZXY,
+		kXZY,
+		kYXZ,
+		kZYX,
+		kLast
+	};
+};
+
+namespace MSpace {
+enum Space {
+	kInvalid,
+	kTransform,
+	kPreTransform,
+	kPostTransform,
+	kWorld,
+	kLast,
+	kObject = kPreTransform
+};
+}
+
+class MFn
+{
+public:
+	enum Type {
+		kInvalid,
+		kBase,
+		kDependencyNode,
+		kDagNode,
+		kTransform,
+		kCamera,
+		kMesh,
+		kFluid,
+		kLocator,
+		kAnimCurve,
+		kMatrixData,
+		kAttribute,
+		kNumericAttribute
+	};
+};
+
+class MFnNumericData
+{
+public:
+	enum Type {
+		kInvalid,
+		kBoolean,
+		kByte,
+		kChar,
+		kShort,
+		kInt,
+		kFloat,
+		kDouble,
+		kLast
+	};
+};
+
+namespace MockMaya {
+
+// Growable array with the MxxxArray interface
+template <typename T>
+class Array
+{
+public:
+	Array() {}
+	Array(unsigned int count, const T& initial) : m_items(count, initial) {}
+	Array(const T* items, unsigned int count) : m_items(items, items + count) {}
+
+	unsigned int length() const { return (unsigned int)m_items.size(); }
+	MStatus setLength(unsigned int count) { m_items.resize(count); return MS::kSuccess; }
+	MStatus append(const T& item) { m_items.push_back(item); return MS::kSuccess; }
+	MStatus remove(unsigned int index)
+	{
+		if (index >= m_items.size()) return MS::kInvalidParameter;
+		m_items.erase(m_items.begin() + index);
+		return MS::kSuccess;
+	}
+	MStatus clear() { m_items.clear(); return MS::kSuccess; }
+
+	T& operator[](unsigned int index) { return m_items[index]; }
+	const T& operator[](unsigned int index) const { return m_items[index]; }
+
+private:
+	std::vector<T> m_items;
+};
+
+}
+
+class MDoubleArray : public MockMaya::Array<double> { public: using Array::Array; };
+class MIntArray : public MockMaya::Array<int> { public: using Array::Array; };
+class MTimeArray : public MockMaya::Array<MTime> { public: using Array::Array; };
+class MPointArray : public MockMaya::Array<MPoint> { public: using Array::Array; };
+
+class MObject
+{
+public:
+	MObject() {}
+	explicit MObject(const std::shared_ptr<MockMaya::Node>& node) : m_node(node) {}
+
+	bool isNull() const { return !m_node; }
+	bool hasFn(MFn::Type type) const;
+	MFn::Type apiType() const;
+	bool operator==(const MObject& other) const { return m_node == other.m_node; }
+	bool operator!=(const MObject& other) const { return m_node != other.m_node; }
+
+	static const MObject kNullObj;
+
+	const std::shared_ptr<MockMaya::Node>& mockNode() const { return m_node; }
+
+private:
+	std::shared_ptr<MockMaya::Node> m_node;
+};
+
+class MObjectArray : public MockMaya::Array<MObject> { public: using Array::Array; };
+
+class MPlugArray;
+
+class MPlug
+{
+public:
+	MPlug() {}
+	MPlug(const MObject& node, const std::string& attribute) : m_node(node), m_attribute(attribute) {}
+
+	bool isNull() const { return m_node.isNull(); }
+	MObject node(MStatus* status = nullptr) const;
+	MString name(MStatus* status = nullptr) const;
+	MString partialName() const { return MString(m_attribute.c_str()); }
+	bool isConnected(MStatus* status = nullptr) const;
+	bool connectedTo(MPlugArray& plugs, bool asDst, bool asSrc, MStatus* status = nullptr) const;
+	MPlug elementByLogicalIndex(unsigned int index, MStatus* status = nullptr) const;
+	// Evaluated in the context of the innermost MDGContextGuard; only parentMatrix and worldMatrix plugs hold data
+	MObject asMObject(MStatus* status = nullptr) const;
+
+private:
+	MObject m_node;
+	std::string m_attribute;
+};
+
+class MPlugArray : public MockMaya::Array<MPlug> { public: using Array::Array; };
+
+class MDagPath
+{
+public:
+	MDagPath() {}
+
+	bool isValid(MStatus* status = nullptr) const;
+	MObject node(MStatus* status = nullptr) const;
+	MObject transform(MStatus* status = nullptr) const;
+	bool hasFn(MFn::Type type, MStatus* status = nullptr) const;
+	MStatus extendToShape();
+	MMatrix inclusiveMatrix(MStatus* status = nullptr) const;
+	MMatrix exclusiveMatrix(MStatus* status = nullptr) const;
+	unsigned int length(MStatus* status = nullptr) const;
+	unsigned int instanceNumber(MStatus* = nullptr) const { return 0; }
+	MString partialPathName(MStatus* status = nullptr) const;
+	MString fullPathName(MStatus* status = nullptr) const;
+
+	static MStatus getAPathTo(const MObject& node, MDagPath& path);
+
+	// Path to a transform, optionally extended to its shape
+	static MDagPath mockPath(const std::shared_ptr<MockMaya::Node>& transform, bool toShape);
+
+private:
+	std::shared_ptr<MockMaya::Node> m_transform;
+	bool m_toShape = false;
+};
+
+class MDagPathArray : public MockMaya::Array<MDagPath> { public: using Array::Array; };
+
+class MSelectionList
+{
+public:
+	MStatus add(const MString& name, bool searchChildNamespacesToo = false);
+	MStatus add(const MDagPath& path, const MObject& component = MObject::kNullObj, bool mergeWithExisting = false);
+	MStatus getDagPath(unsigned int index, MDagPath& path) const;
+	unsigned int length(MStatus* status = nullptr) const;
+	MStatus clear();
+
+private:
+	std::vector<MDagPath> m_items;
+};
+
+class MArgList
+{
+public:
+	unsigned int length(MStatus* = nullptr) const { return (unsigned int)m_args.size(); }
+	MString asString(unsigned int index, MStatus* status = nullptr) const;
+	double asDouble(unsigned int index, MStatus* status = nullptr) const;
+	int asInt(unsigned int index, MStatus* status = nullptr) const;
+	bool asBool(unsigned int index, MStatus* status = nullptr) const;
+
+	MStatus addArg(const MString& arg);
+	MStatus addArg(const char* arg) { return addArg(MString(arg)); }
+	MStatus addArg(double arg);
+	MStatus addArg(int arg);
+
+private:
+	std::vector<std::string> m_args;
+};
+
+class MSyntax
+{
+public:
+	enum MArgType {
+		kInvalidArgType,
+		kNoArg,
+		kBoolean,
+		kLong,
+		kDouble,
+		kString,
+		kUnsigned,
+		kDistance,
+		kAngle,
+		kTime,
+		kSelectionItem,
+		kLastArgType
+	};
+
+	MStatus addFlag(const char* shortName, const char* longName,
+		MArgType argType1 = kNoArg, MArgType argType2 = kNoArg, MArgType argType3 = kNoArg,
+		MArgType argType4 = kNoArg, MArgType argType5 = kNoArg, MArgType argType6 = kNoArg);
+	MStatus makeFlagMultiUse(const char* flag);
+
+	struct Flag {
+		std::string shortName;
+		std::string longName;
+		std::vector<MArgType> arguments;
+		bool multiUse = false;
+	};
+	const Flag* findFlag(const std::string& name) const;
+
+private:
+	std::vector<Flag> m_flags;
+};
+
+class MArgDatabase
+{
+public:
+	MArgDatabase(const MSyntax& syntax, const MArgList& args, MStatus* status = nullptr);
+
+	bool isFlagSet(const char* flag, MStatus* status = nullptr) const;
+	unsigned int numberOfFlagUses(const char* flag) const;
+	MStatus getFlagArgumentList(const char* flag, unsigned int use, MArgList& args) const;
+	double flagArgumentDouble(const char* flag, unsigned int index, MStatus* status = nullptr) const;
+	int flagArgumentInt(const char* flag, unsigned int index, MStatus* status = nullptr) const;
+	bool flagArgumentBool(const char* flag, unsigned int index, MStatus* status = nullptr) const;
+	MString flagArgumentString(const char* flag, unsigned int index, MStatus* status = nullptr) const;
+
+private:
+	MSyntax m_syntax;
+	// Arguments of every use, keyed by short flag name
+	std::map<std::string, std::vector<MArgList>> m_uses;
+
+	const std::vector<MArgList>* uses(const char* flag) const;
+};
+
+class MPxCommand
+{
+public:
+	MPxCommand() {}
+	virtual ~MPxCommand() {}
+
+	virtual MStatus doIt(const MArgList& args) = 0;
+	virtual MStatus undoIt() { return MS::kFailure; }
+	virtual MStatus redoIt() { return MS::kFailure; }
+	virtual bool isUndoable() const { return false; }
+
+	static void clearResult();
+	static void setResult(bool result);
+	static void setResult(int result);
+	static void setResult(double result);
+	static void setResult(const MString& result);
+	static void setResult(const MDoubleArray& result);
+};
+
+class MGlobal
+{
+public:
+	enum ListAdjustment {
+		kReplaceList,
+		kXORWithList,
+		kAddToList,
+		kRemoveFromList
+	};
+
+	static void displayInfo(const MString& message);
+	static void displayWarning(const MString& message);
+	static void displayError(const MString& message);
+	static MStatus getActiveSelectionList(MSelectionList& list, bool orderedSelectionIfAvailable = false);
+	static MStatus setActiveSelectionList(const MSelectionList& list, ListAdjustment mode = kReplaceList);
+	static MStatus executeCommand(const MString& command, bool displayEnabled = false, bool undoEnabled = false);
+};
+
+class M3dView
+{
+public:
+	static M3dView active3dView(MStatus* status = nullptr);
+	MStatus refresh(bool all = false, bool force = false);
+};
+
+typedef uint64_t MCallbackId;
+
+class MMessage
+{
+public:
+	typedef void (*MElapsedTimeFunction)(float elapsedTime, float lastTime, void* clientData);
+
+	static MStatus removeCallback(MCallbackId id);
+};
+
+class MTimerMessage : public MMessage
+{
+public:
+	static MCallbackId addTimerCallback(float period, MElapsedTimeFunction callback,
+		void* clientData = nullptr, MStatus* status = nullptr);
+};
+
+class MAnimCurveChange
+{
+public:
+	MAnimCurveChange();
+	~MAnimCurveChange();
+
+	MStatus undoIt();
+	MStatus redoIt();
+
+	// Snapshots the curve before an edit
+	void record(const std::shared_ptr<MockMaya::Node>& curve);
+
+private:
+	std::vector<std::unique_ptr<MockMaya::CurveEdit>> m_edits;
+};
+
+class MDGModifier
+{
+public:
+	MDGModifier();
+	virtual ~MDGModifier();
+
+	MStatus deleteNode(const MObject& node);
+	MStatus doIt();
+	MStatus undoIt();
+
+protected:
+	// Nodes created by the modifier, added to the scene by doIt
+	std::vector<std::shared_ptr<MockMaya::Node>> m_queuedCreations;
+	std::vector<std::shared_ptr<MockMaya::Node>> m_created;
+
+private:
+	std::vector<MObject> m_queued;
+	std::vector<std::unique_ptr<MockMaya::Deletion>> m_done;
+};
+
+class MDagModifier : public MDGModifier
+{
+public:
+	// Creates a shape under a new transform, which is returned; only "locator" shapes are known
+	MObject createNode(const MString& type, const MObject& parent = MObject::kNullObj, MStatus* status = nullptr);
+};
+
+class MFnDependencyNode
+{
+public:
+	MFnDependencyNode() {}
+	MFnDependencyNode(const MObject& object, MStatus* status = nullptr);
+	virtual ~MFnDependencyNode() {}
+
+	MStatus setObject(const MObject& object);
+	MObject object(MStatus* = nullptr) const { return m_object; }
+	MString name(MStatus* status = nullptr) const;
+	MPlug findPlug(const MString& attribute, bool wantNetworkedPlug, MStatus* status = nullptr) const;
+	bool hasAttribute(const MString& name, MStatus* status = nullptr) const;
+	MStatus addAttribute(const MObject& attribute);
+
+protected:
+	MObject m_object;
+};
+
+class MFnTransform : public MFnDependencyNode
+{
+public:
+	MFnTransform() {}
+	MFnTransform(const MObject& object, MStatus* status = nullptr);
+
+	MTransformationMatrix::RotationOrder rotationOrder(MStatus* status = nullptr) const;
+	// Transforms have no parents in the mock scene, so every space is world space
+	MStatus setTranslation(const MVector& translation, MSpace::Space space);
+};
+
+class MFnMatrixData
+{
+public:
+	MFnMatrixData(const MObject& object, MStatus* status = nullptr);
+
+	MMatrix matrix(MStatus* status = nullptr) const;
+
+private:
+	MObject m_object;
+};
+
+// Time a plug is evaluated at. The mock scene's current time is frame 0.
+class MDGContext
+{
+public:
+	MDGContext() : m_normal(true) {}
+	explicit MDGContext(const MTime& when) : m_time(when), m_normal(false) {}
+
+	bool isNormal() const { return m_normal; }
+	MStatus getTime(MTime& when) const { when = m_time; return MS::kSuccess; }
+
+	static const MDGContext fsNormal;
+
+private:
+	MTime m_time;
+	bool m_normal;
+};
+
+// Makes 'context' current until it goes out of scope
+class MDGContextGuard
+{
+public:
+	explicit MDGContextGuard(const MDGContext& context);
+	~MDGContextGuard();
+
+	MDGContextGuard(const MDGContextGuard&) = delete;
+	MDGContextGuard& operator=(const MDGContextGuard&) = delete;
+
+private:
+	MDGContext m_previous;
+};
+
+class MFnNumericAttribute
+{
+public:
+	MObject create(const MString& fullName, const MString& briefName, MFnNumericData::Type type,
+		double defaultValue = 0.0, MStatus* status = nullptr);
+	MStatus setHidden(bool hidden);
+
+private:
+	MObject m_attribute;
+};
+
+class MFnMesh
+{
+public:
+	MFnMesh(const MDagPath& path, MStatus* status = nullptr);
+
+	MStatus getPoints(MPointArray& points, MSpace::Space space = MSpace::kObject) const;
+	MStatus getTriangles(MIntArray& triangleCounts, MIntArray& triangleVertices) const;
+
+private:
+	MDagPath m_path;
+	std::shared_ptr<MockMaya::Node> m_mesh;
+};
+
+class MFnFluid
+{
+public:
+	MFnFluid(const MDagPath& path, MStatus* status = nullptr);
+
+	MStatus getResolution(unsigned& xres, unsigned& yres, unsigned& zres) const;
+	MStatus getDimensions(double& xdim, double& ydim, double& zdim) const;
+	// Face-centred grids: x has xres + 1 samples along x, y has yres + 1 along y, z has zres + 1 along z
+	MStatus getVelocity(float*& xvel, float*& yvel, float*& zvel);
+	// Offset of a voxel in a grid of the given resolution
+	int index(int xi, int yi, int zi, int xres, int yres, int zres) const;
+
+private:
+	std::shared_ptr<MockMaya::Node> m_fluid;
+};
+
+class MFnAnimCurve : public MFnDependencyNode
+{
+public:
+	enum TangentType {
+		kTangentGlobal,
+		kTangentFixed,
+		kTangentLinear,
+		kTangentFlat,
+		kTangentSmooth,
+		kTangentStep,
+		kTangentSlow,
+		kTangentFast,
+		kTangentClamped,
+		kTangentPlateau,
+		kTangentStepNext,
+		kTangentAuto
+	};
+
+	MFnAnimCurve() {}
+	MFnAnimCurve(const MObject& object, MStatus* status = nullptr);
+
+	MObject create(const MPlug& plug, MDGModifier* modifier = nullptr, MStatus* status = nullptr);
+
+	unsigned int numKeys(MStatus* status = nullptr) const;
+	MTime time(unsigned int index, MStatus* status = nullptr) const;
+	double value(unsigned int index, MStatus* status = nullptr) const;
+	TangentType inTangentType(unsigned int index, MStatus* status = nullptr) const;
+	TangentType outTangentType(unsigned int index, MStatus* status = nullptr) const;
+	bool isWeighted(MStatus* status = nullptr) const;
+	bool weightsLocked(unsigned int index, MStatus* status = nullptr) const;
+	bool tangentsLocked(unsigned int index, MStatus* status = nullptr) const;
+	MStatus getTangent(unsigned int index, double& x, double& y, bool inTangent) const;
+	bool find(const MTime& time, unsigned int& index, MStatus* status = nullptr) const;
+
+	MStatus addKeys(MTimeArray* times, MDoubleArray* values,
+		TangentType inType = kTangentGlobal, TangentType outType = kTangentGlobal,
+		bool keepExistingKeys = false, MAnimCurveChange* change = nullptr);
+	unsigned int addKey(const MTime& time, double value,
+		TangentType inType = kTangentGlobal, TangentType outType = kTangentGlobal,
+		MAnimCurveChange* change = nullptr, MStatus* status = nullptr);
+	MStatus remove(unsigned int index, MAnimCurveChange* change = nullptr);
+	MStatus setTime(unsigned int index, const MTime& time, MAnimCurveChange* change = nullptr);
+	MStatus setValue(unsigned int index, double value, MAnimCurveChange* change = nullptr);
+	MStatus setInTangentType(unsigned int index, TangentType type, MAnimCurveChange* change = nullptr);
+	MStatus setOutTangentType(unsigned int index, TangentType type, MAnimCurveChange* change = nullptr);
+	MStatus setIsWeighted(bool weighted, MAnimCurveChange* change = nullptr);
+	MStatus setWeightsLocked(unsigned int index, bool locked, MAnimCurveChange* change = nullptr);
+	MStatus setTangentsLocked(unsigned int index, bool locked, MAnimCurveChange* change = nullptr);
+	MStatus setTangent(unsigned int index, double x, double y, bool inTangent,
+		MAnimCurveChange* change = nullptr, bool convertUnits = true);
+};
+
+// Scene set-up and inspection for tests and benchmarks
+namespace MockMaya {
+
+// Empties the scene, selection, undo queue, timers, messages and call counts
+void resetScene();
+
+MDagPath createCamera(const std::string& name, double x = 0.0, double y = 0.0, double z = 0.0);
+MDagPath createLocator(const std::string& name, double x = 0.0, double y = 0.0, double z = 0.0);
+// One triangle per three entries of triangleVertices
+MDagPath createMesh(const std::string& name, const std::vector<MPoint>& points, const std::vector<int>& triangleVertices);
+// Fluid container centred on (x, y, z) with the same velocity in every voxel
+MDagPath createFluid(const std::string& name, int xres, int yres, int zres, double xdim, double ydim, double zdim,
+	double x, double y, double z, const MVector& velocity);
+void setWorldMatrix(const MDagPath& path, const MMatrix& matrix);
+// Puts the transform under an animated parent. Its matrix from setWorldMatrix or its creation
+// becomes the local one, and its world matrix is that times the parent's at the evaluated time.
+void setParentMatrix(const MDagPath& path, std::function<MMatrix(const MTime&)> parentMatrix);
+void setRotationOrder(const MDagPath& path, MTransformationMatrix::RotationOrder order);
+
+// Anim curve driving transform.attribute, or a null object
+MObject inputCurve(const MDagPath& path, const char* attribute);
+// Nodes of the type currently in the scene, shapes included and deleted ones excluded
+size_t nodeCount(MFn::Type type);
+bool inScene(const MObject& node);
+
+void resetCalls();
+size_t calls(const char* api);
+size_t totalCalls();
+const std::map<std::string, size_t>& allCalls();
+
+enum class MessageKind {
+	INFO,
+	WARNING,
+	ERROR
+};
+const std::vector<std::string>& messages(MessageKind kind);
+
+// Whatever the last command passed to setResult
+struct CommandResult {
+	enum class Type { NONE, BOOLEAN, INT, DOUBLE, STRING, DOUBLE_ARRAY };
+
+	Type type = Type::NONE;
+	double number = 0.0;
+	std::string string;
+	std::vector<double> numbers;
+};
+const CommandResult& lastResult();
+
+// Commands run through the mock undo queue the way Maya's command engine would
+typedef void* (*CommandCreator)();
+void registerCommand(const char* name, CommandCreator creator);
+MStatus runCommand(const std::string& commandLine, bool undoable = true);
+bool undo();
+bool redo();
+size_t undoQueueLength();
+
+size_t timerCount();
+void fireTimers(float elapsedTime = 0.1f);
+
+}
@@ -0,0 +1,80 @@
+#include "TestFramework.h"
+#include "AnimExport.h"
+
+#include <sstream>
+
+using namespace LaunchCore;
+
+static AnimClip makeLaunchClip()
+{
+	LaunchParams params;
+	params.velocity = Vec3(2.0, 9.0, 1.0);
+	params.startFrame = 5;
+
+	AnimClip clip;
+	buildLaunchClip("cam1", calculateParabolicKeys(params), params.framesPerSecond, clip);
+	return clip;
+}
+
+TEST_CASE(launchClipKeysFiveChannels)
+{
+	AnimClip clip = makeLaunchClip();
+	CHECK(clip.channels.size() == 5);
+	CHECK(clip.channels[1].leafAttribute == "translateY");
+	CHECK(!clip.channels[1].linear);
+	CHECK(clip.channels[3].angular && clip.channels[3].linear);
+
+	for (const AnimChannel& channel : clip.channels) {
+		CHECK(channel.keys.size() == 3);
+		CHECK_NEAR(channel.keys.front().frame, 5.0, 1e-12);
+	}
+
+	// Apex key of translateY is flat with handles a third of the way to its neighbours
+	const ReducedKey& apex = clip.channels[1].keys[1];
+	CHECK_NEAR(apex.inSlope, 0.0, 1e-12);
+	CHECK_NEAR(apex.inWeight, (apex.frame - 5.0) / 3.0, 1e-12);
+}
+
+TEST_CASE(timeUnitNamesMatchMaya)
+{
+	CHECK(timeUnitName(24.0) == "film");
+	CHECK(timeUnitName(30.0) == "ntsc");
+	CHECK(timeUnitName(60.0) == "ntscf");
+	CHECK(timeUnitName(29.97) == "29.97fps");
+}
+
+TEST_CASE(animFileListsEveryChannel)
+{
+	AnimClip clip = makeLaunchClip();
+	std::ostringstream out;
+	writeAnim(out, clip);
+	std::string text = out.str();
+
+	CHECK(text.find("animVersion 1.1;") == 0);
+	CHECK(text.find("timeUnit film;") != std::string::npos);
+	CHECK(text.find("startTime 5;") != std::string::npos);
+	CHECK(text.find("anim translate.translateY translateY cam1 0 0 1;") != std::string::npos);
+	CHECK(text.find("anim rotate.rotateY rotateY cam1 0 0 4;") != std::string::npos);
+	CHECK(text.find("output angular;") != std::string::npos);
+	CHECK(text.find(" linear linear 1 1 0;") != std::string::npos);
+
+	// The apex key's flat tangent is written as a zero angle
+	std::ostringstream apex;
+	apex << " fixed fixed 1 0 0 0 ";
+	CHECK(text.find(apex.str()) != std::string::npos);
+}
+
+TEST_CASE(atomFileWrapsTheNode)
+{
+	AnimClip clip = makeLaunchClip();
+	std::ostringstream out;
+	writeClip(out, clip, AnimFormat::ATOM);
+	std::string text = out.str();
+
+	CHECK(text.find("atomVersion 1.0;") == 0);
+	CHECK(text.find("dagNode {\n  cam1 0 0;\n") != std::string::npos);
+	CHECK(text.find("inputUnit film;") != std::string::npos);
+	CHECK(text.find("outputUnit deg;") != std::string::npos);
+	CHECK(text.back() == '\n');
+	CHECK(text.compare(text.size() - 2, 2, "}\n") == 0);
+}
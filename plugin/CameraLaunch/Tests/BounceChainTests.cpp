@@ -0,0 +1,162 @@
+#include "TestFramework.h"
+#include "BounceChain.h"
+#include "FlightPath.h"
+
+using namespace LaunchCore;
+
+TEST_CASE(bouncesLoseHeightByRestitution)
+{
+	LaunchParams params;
+	params.velocity = Vec3(3.0, 10.0, 0.0);
+	params.startPosition = Vec3(0.0, 2.0, 0.0);
+
+	BounceSettings settings;
+	settings.bounces = 3;
+	settings.restitution = 0.5;
+	settings.friction = 0.2;
+
+	std::vector<FlightSegment> segments;
+	chainBounces(params, settings, nullptr, 1.0, segments);
+	CHECK(segments.size() == 4);
+
+	for (size_t s = 0; s < segments.size(); ++s) {
+		const FlightSegment& segment = segments[s];
+		CHECK(segment.contact);
+		CHECK_NEAR(segment.endPosition.y, 2.0, 1e-9);
+
+		// Vertical speed halves and horizontal speed loses a fifth at every contact
+		CHECK_NEAR(segment.params.velocity.y, 10.0 * std::pow(0.5, (double)s), 1e-9);
+		CHECK_NEAR(segment.params.velocity.x, 3.0 * std::pow(0.8, (double)s), 1e-9);
+		CHECK_NEAR(segment.duration, 2.0 * segment.params.velocity.y / 9.81, 1e-9);
+		if (s > 0) {
+			const FlightSegment& previous = segments[s - 1];
+			CHECK_NEAR(segment.startTime, previous.startTime + previous.duration, 1e-12);
+			CHECK_NEAR(segment.params.startPosition.x, previous.endPosition.x, 1e-12);
+		}
+	}
+}
+
+TEST_CASE(zeroRestitutionSettlesOnFirstContact)
+{
+	LaunchParams params;
+	params.velocity = Vec3(1.0, 5.0, 0.0);
+
+	BounceSettings settings;
+	settings.bounces = 4;
+	settings.restitution = 0.0;
+
+	std::vector<FlightSegment> segments;
+	chainBounces(params, settings, nullptr, 1.0, segments);
+	CHECK(segments.size() == 1);
+}
+
+TEST_CASE(bounceKeysCarryExactTangents)
+{
+	LaunchParams params;
+	params.velocity = Vec3(0.0, 12.0, 5.0);
+	params.startFrame = 10;
+
+	BounceSettings settings;
+	settings.bounces = 2;
+	settings.restitution = 0.6;
+
+	std::vector<FlightSegment> segments;
+	chainBounces(params, settings, nullptr, 1.0, segments);
+
+	std::vector<ParabolicKey> keys;
+	buildBounceKeys(params, segments, keys);
+
+	// Start, then an apex and a contact (or the end) per arc
+	CHECK(keys.size() == 1 + 2 * segments.size());
+	CHECK(keys.front().type == KeyframeType::START);
+	CHECK(keys.back().type == KeyframeType::END);
+	CHECK_NEAR(keys.front().frame, 10.0, 1e-12);
+
+	const double fps = params.framesPerSecond;
+	for (size_t k = 1; k < keys.size(); ++k) {
+		CHECK(keys[k].frame > keys[k - 1].frame);
+	}
+
+	// Apex keys are flat, contacts break from the incoming to the outgoing slope
+	const ParabolicKey& apex = keys[1];
+	const ParabolicKey& contact = keys[2];
+	CHECK(apex.type == KeyframeType::MIDDLE);
+	CHECK_NEAR(apex.inSlope.y, 0.0, 1e-12);
+	CHECK_NEAR(apex.frame, 10.0 + 12.0 / 9.81 * fps, 1e-9);
+	CHECK(contact.type == KeyframeType::CONTACT);
+	CHECK_NEAR(contact.inSlope.y, -12.0 / fps, 1e-9);
+	CHECK_NEAR(contact.outSlope.y, 12.0 * 0.6 / fps, 1e-9);
+
+	// Contacts look down along the arc coming in
+	CHECK(contact.rotation.x < 0.0);
+	CHECK_NEAR(keys.front().rotation.x, std::atan2(12.0, 5.0), 1e-12);
+}
+
+TEST_CASE(bounceSamplesLandOnEveryContact)
+{
+	LaunchParams params;
+	params.velocity = Vec3(4.0, 8.0, 0.0);
+
+	FlightOptions options;
+	options.bounces.bounces = 2;
+	options.bounces.restitution = 0.7;
+
+	TrajectorySamples samples;
+	sampleFlight(params, options, samples);
+
+	std::vector<FlightSegment> segments;
+	chainBounces(params, options.bounces, nullptr, 1.0, segments);
+	CHECK(segments.size() == 3);
+
+	// Every contact frame is sampled exactly, everything else stays on the whole-frame grid
+	size_t contactsFound = 0;
+	for (size_t i = 0; i < samples.size(); ++i) {
+		CHECK(samples.translateY[i] > -1e-9);
+		if (i > 0) CHECK(samples.frames[i] > samples.frames[i - 1]);
+
+		double frame = samples.frames[i];
+		bool onGrid = std::fabs(frame - std::round(frame)) < 1e-9;
+		bool onContact = false;
+		for (const FlightSegment& segment : segments) {
+			onContact = onContact || std::fabs(frame - (segment.startTime + segment.duration) * 24.0) < 1e-9;
+		}
+		CHECK(onGrid || onContact);
+		if (onContact) {
+			++contactsFound;
+			CHECK_NEAR(samples.translateY[i], 0.0, 1e-9);
+		}
+	}
+	CHECK(contactsFound == 3);
+}
+
+TEST_CASE(bouncesOffCollisionGeometry)
+{
+	// A floor below the launch, sloping down along +X so bounces drift that way
+	std::vector<Vec3> vertices = {
+		Vec3(-50.0, -1.0, -50.0), Vec3(50.0, -2.0, -50.0), Vec3(50.0, -2.0, 50.0), Vec3(-50.0, -1.0, 50.0)
+	};
+	std::vector<uint32_t> indices = { 0, 2, 1, 0, 3, 2 };
+	TriangleBVH bvh;
+	bvh.build(vertices, indices);
+
+	LaunchParams params;
+	params.velocity = Vec3(0.0, 6.0, 0.0);
+
+	BounceSettings settings;
+	settings.bounces = 2;
+	settings.restitution = 0.8;
+
+	std::vector<FlightSegment> segments;
+	chainBounces(params, settings, &bvh, 0.5, segments);
+	CHECK(segments.size() == 3);
+
+	for (const FlightSegment& segment : segments) {
+		CHECK(segment.contact);
+		// Normals face back up at the camera
+		CHECK(segment.contactNormal.y > 0.99);
+		// Contact points sit on the plane y = -1.5 - x / 100
+		CHECK_NEAR(segment.endPosition.y, -1.5 - segment.endPosition.x / 100.0, 1e-6);
+	}
+	CHECK(segments[1].params.velocity.x > 0.0);
+	CHECK(segments[2].endPosition.x > segments[1].endPosition.x);
+}
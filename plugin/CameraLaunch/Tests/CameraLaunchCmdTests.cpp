@@ -0,0 +1,559 @@
+#include "TestFramework.h"
+#include "CameraLaunchCmd.h"
+#include "MockMaya.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+// Every test starts from an empty scene with the command registered
+static void resetCommandScene()
+{
+	CameraLaunchCmd::shutdownAsync();
+	MockMaya::resetScene();
+	MockMaya::registerCommand(CameraLaunchCmd::commandName, CameraLaunchCmd::creator);
+}
+
+static std::vector<double> keyFrames(const MDagPath& camera, const char* attribute)
+{
+	std::vector<double> frames;
+	MFnAnimCurve curve(MockMaya::inputCurve(camera, attribute));
+	for (unsigned int i = 0; i < curve.numKeys(); ++i) {
+		frames.push_back(curve.time(i).as(MTime::kFilm));
+	}
+	return frames;
+}
+
+static std::vector<double> keyValues(const MDagPath& camera, const char* attribute)
+{
+	std::vector<double> values;
+	MFnAnimCurve curve(MockMaya::inputCurve(camera, attribute));
+	for (unsigned int i = 0; i < curve.numKeys(); ++i) {
+		values.push_back(curve.value(i));
+	}
+	return values;
+}
+
+static const char* const launchChannels[] = { "translateX", "translateY", "translateZ", "rotateX", "rotateY" };
+
+TEST_CASE(parabolicLaunchKeysApexAndLanding)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1");
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 10 10 0"));
+	CHECK(MockMaya::undoQueueLength() == 1);
+
+	for (const char* channel : launchChannels) {
+		CHECK(keyFrames(camera, channel).size() == 3);
+	}
+
+	// Apex after vy / g seconds, landing keyed on the exact (fractional) frame of twice that
+	const double apexFrame = 10.0 / 9.81 * 24.0;
+	std::vector<double> frames = keyFrames(camera, "translateY");
+	std::vector<double> heights = keyValues(camera, "translateY");
+	CHECK_NEAR(frames[1], apexFrame, 1e-9);
+	CHECK_NEAR(frames[2], 2.0 * apexFrame, 1e-9);
+	CHECK_NEAR(heights[1], 100.0 / (2.0 * 9.81), 1e-9);
+	CHECK_NEAR(heights[2], 0.0, 1e-9);
+
+	// Translation is keyed on weighted handles, and tagged for the next launch to reuse
+	MObject curveY = MockMaya::inputCurve(camera, "translateY");
+	MFnAnimCurve curve(curveY);
+	CHECK(curve.isWeighted());
+	double x = 0.0, y = 0.0;
+	CHECK(curve.getTangent(0, x, y, false));
+	CHECK(x > 0.0 && y > 0.0);
+	CHECK(MFnDependencyNode(curveY).hasAttribute("cameraLaunchCurve"));
+	CHECK(!MFnAnimCurve(MockMaya::inputCurve(camera, "rotateX")).isWeighted());
+
+	MSelectionList selection;
+	MGlobal::getActiveSelectionList(selection);
+	MDagPath selected;
+	CHECK(selection.length() == 1);
+	CHECK(selection.getDagPath(0, selected) && selected.partialPathName() == "camera1");
+}
+
+TEST_CASE(undoRemovesCreatedCurvesAndRedoRestoresThem)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1", 1.0, 2.0, 3.0);
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 4 6 0"));
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 5);
+	std::vector<double> launched = keyValues(camera, "translateY");
+	CHECK_NEAR(launched.front(), 2.0, 1e-12);
+
+	CHECK(MockMaya::undo());
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 0);
+	for (const char* channel : launchChannels) {
+		CHECK(MockMaya::inputCurve(camera, channel).isNull());
+	}
+	MSelectionList selection;
+	MGlobal::getActiveSelectionList(selection);
+	CHECK(selection.length() == 0);
+
+	CHECK(MockMaya::redo());
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 5);
+	std::vector<double> redone = keyValues(camera, "translateY");
+	CHECK(redone == launched);
+}
+
+TEST_CASE(relaunchEditsTheSameCurvesAndUndoesBackToTheFirstFlight)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1");
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 10 10 0"));
+	MObject curveY = MockMaya::inputCurve(camera, "translateY");
+	std::vector<double> firstFrames = keyFrames(camera, "translateY");
+	std::vector<double> firstValues = keyValues(camera, "translateY");
+
+	MockMaya::resetCalls();
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 5 18 0"));
+	CHECK(MockMaya::inputCurve(camera, "translateY") == curveY);
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 5);
+	CHECK(MockMaya::calls("MFnAnimCurve::create") == 0);
+	CHECK(MockMaya::calls("MDGModifier::deleteNode") == 0);
+	// Three keys to three keys only moves them
+	CHECK(MockMaya::calls("MFnAnimCurve::addKey") == 0);
+	CHECK(MockMaya::calls("MFnAnimCurve::remove") == 0);
+	CHECK_NEAR(keyValues(camera, "translateY")[1], 324.0 / (2.0 * 9.81), 1e-9);
+
+	CHECK(MockMaya::undo());
+	CHECK(MockMaya::inputCurve(camera, "translateY") == curveY);
+	CHECK(keyFrames(camera, "translateY") == firstFrames);
+	CHECK(keyValues(camera, "translateY") == firstValues);
+
+	CHECK(MockMaya::undo());
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 0);
+}
+
+TEST_CASE(userCurvesAreReplacedAndComeBackOnUndo)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1");
+
+	MFnTransform transformFn(camera.transform());
+	MFnAnimCurve userCurve;
+	MObject userCurveObj = userCurve.create(transformFn.findPlug("translateX", false));
+	userCurve.addKey(MTime(1.0), 7.0);
+	userCurve.addKey(MTime(12.0), -3.0);
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 10 10 0"));
+	CHECK(!MockMaya::inScene(userCurveObj));
+	CHECK(MockMaya::inputCurve(camera, "translateX") != userCurveObj);
+	CHECK(keyFrames(camera, "translateX").size() == 3);
+
+	CHECK(MockMaya::undo());
+	CHECK(MockMaya::inScene(userCurveObj));
+	CHECK(MockMaya::inputCurve(camera, "translateX") == userCurveObj);
+	std::vector<double> values = keyValues(camera, "translateX");
+	CHECK(values.size() == 2 && values[0] == 7.0 && values[1] == -3.0);
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 1);
+
+	// Redo replaces it again
+	CHECK(MockMaya::redo());
+	CHECK(!MockMaya::inScene(userCurveObj));
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 5);
+}
+
+TEST_CASE(launchApiCallsScaleWithTheCameras)
+{
+	resetCommandScene();
+	MockMaya::createCamera("camera1");
+	MockMaya::createCamera("camera2", 5.0, 0.0, 0.0);
+	MockMaya::createCamera("camera3", 0.0, 0.0, 5.0);
+
+	MockMaya::resetCalls();
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -c camera2 -c camera3 -v 3 8 1"));
+
+	// Every camera resolves its five plugs once to key them, and those plus rotateZ to clear curves
+	CHECK(MockMaya::calls("MFnDependencyNode::findPlug") == 3 * 11);
+	CHECK(MockMaya::calls("MFnAnimCurve::create") == 3 * 5);
+	// Fresh curves take each channel in one addKeys call
+	CHECK(MockMaya::calls("MFnAnimCurve::addKeys") == 3 * 5);
+	CHECK(MockMaya::calls("MFnAnimCurve::addKey") == 0);
+	// One selection change and one redraw for the whole batch
+	CHECK(MockMaya::calls("MGlobal::setActiveSelectionList") == 1);
+	CHECK(MockMaya::calls("M3dView::refresh") == 1);
+}
+
+TEST_CASE(metricsQueryLeavesTheSceneAlone)
+{
+	resetCommandScene();
+	MockMaya::createCamera("camera1", 0.0, 3.0, 0.0);
+
+	MockMaya::resetCalls();
+	CHECK(MockMaya::runCommand("cameraLaunch -mt -c camera1 -v 10 10 0 -v 0 20 0"));
+	const MockMaya::CommandResult& result = MockMaya::lastResult();
+	CHECK(result.type == MockMaya::CommandResult::Type::DOUBLE_ARRAY);
+	CHECK(result.numbers.size() == 2 * LaunchCore::FLIGHT_METRIC_VALUES);
+	// Apex height of the second launch, from the camera's height
+	CHECK_NEAR(result.numbers[LaunchCore::FLIGHT_METRIC_VALUES + 2], 3.0 + 400.0 / (2.0 * 9.81), 1e-9);
+
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 0);
+	CHECK(MockMaya::undoQueueLength() == 0);
+	CHECK(MockMaya::calls("MFnDependencyNode::findPlug") == 0);
+}
+
+TEST_CASE(orientedBakeKeysRotateZ)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1");
+	MockMaya::setRotationOrder(camera, MTransformationMatrix::kZXY);
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 10 10 0 -ori"));
+	size_t frames = keyFrames(camera, "translateY").size();
+	CHECK(frames > 40);
+	CHECK(keyFrames(camera, "rotateZ").size() == frames);
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 6);
+
+	CHECK(MockMaya::undo());
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 0);
+}
+
+TEST_CASE(relaunchWithoutRollDropsTheOldRollCurve)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1");
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 10 10 0 -ori"));
+	CHECK(!MockMaya::inputCurve(camera, "rotateZ").isNull());
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 5 18 0"));
+	CHECK(MockMaya::inputCurve(camera, "rotateZ").isNull());
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 5);
+
+	CHECK(MockMaya::undo());
+	CHECK(keyFrames(camera, "rotateZ").size() == keyFrames(camera, "translateY").size());
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 6);
+}
+
+TEST_CASE(collisionMeshCutsTheFlightShort)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1");
+	// A wall across the flight at x = 5
+	std::vector<MPoint> points = {
+		MPoint(5.0, -10.0, -10.0), MPoint(5.0, 20.0, -10.0), MPoint(5.0, 20.0, 10.0), MPoint(5.0, -10.0, 10.0)
+	};
+	MockMaya::createMesh("wall", points, { 0, 1, 2, 0, 2, 3 });
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 10 10 0 -col wall"));
+	std::vector<double> x = keyValues(camera, "translateX");
+	CHECK(!x.empty());
+	CHECK_NEAR(x.back(), 5.0, 1e-6);
+	CHECK(!MockMaya::messages(MockMaya::MessageKind::INFO).empty());
+}
+
+TEST_CASE(fluidWindCarriesTheCameraDownwind)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1");
+	MockMaya::createFluid("fluid1", 4, 4, 4, 200.0, 200.0, 200.0, 0.0, 0.0, 0.0, MVector(4.0, 0.0, 0.0));
+
+	// Wind only acts through drag; a force field pushes the camera directly
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 0 10 0 -d 0.5 0 -wd fluid1"));
+	std::vector<double> downwind = keyValues(camera, "translateX");
+	CHECK(downwind.size() > 3);
+	CHECK(downwind.back() > 1.0);
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 0 10 0 -ff fluid1 -fs 0.5"));
+	std::vector<double> pushed = keyValues(camera, "translateX");
+	double flightTime = 20.0 / 9.81;
+	CHECK_NEAR(pushed.back(), 0.5 * 2.0 * flightTime * flightTime, 0.05);
+
+	CHECK(!MockMaya::runCommand("cameraLaunch -c camera1 -v 0 10 0 -wd fluid1 -ff fluid1"));
+	CHECK(!MockMaya::runCommand("cameraLaunch -c camera1 -v 0 10 0 -wd missingField.fga"));
+	CHECK(!MockMaya::messages(MockMaya::MessageKind::ERROR).empty());
+}
+
+TEST_CASE(attractorsBendTheFlightForItsFlightTime)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1", 10.0, 0.0, 0.0);
+	MockMaya::createLocator("planet");
+
+	// Without uniform gravity -flightTime sets how long the flight lasts
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 0 0 5 -g 0 -at planet 250 -ft 2"));
+	std::vector<double> frames = keyFrames(camera, "translateX");
+	std::vector<double> x = keyValues(camera, "translateX");
+	CHECK(!frames.empty());
+	CHECK_NEAR(frames.back(), 48.0, 1e-9);
+	// v = sqrt(250 / 10) = 5 is a circular orbit, so the camera stays 10 units from the planet
+	std::vector<double> z = keyValues(camera, "translateZ");
+	CHECK_NEAR(std::sqrt(x.back() * x.back() + z.back() * z.back()), 10.0, 0.01);
+	CHECK(x.back() < 9.0);
+
+	CHECK(!MockMaya::runCommand("cameraLaunch -c camera1 -v 0 0 5 -at planet -1"));
+	CHECK(!MockMaya::runCommand("cameraLaunch -c camera1 -v 0 0 5 -at moon 1"));
+}
+
+// Rig turning about Y while it drives along X, two units a frame
+static MMatrix rigMatrix(double frame)
+{
+	double c = std::cos(0.05 * frame), s = std::sin(0.05 * frame);
+	MMatrix matrix;
+	matrix.matrix[0][0] = c; matrix.matrix[0][2] = -s;
+	matrix.matrix[2][0] = s; matrix.matrix[2][2] = c;
+	matrix.matrix[3][0] = 2.0 * frame;
+	matrix.matrix[3][1] = 1.0;
+	return matrix;
+}
+
+TEST_CASE(launchOffAnAnimatedParentIsKeyedInItsSpace)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1", 0.0, 0.0, 3.0);
+	MockMaya::setParentMatrix(camera, [](const MTime& time) { return rigMatrix(time.as(MTime::kFilm)); });
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -s 10 -v 5 10 0"));
+	std::vector<double> frames = keyFrames(camera, "translateX");
+	std::vector<double> x = keyValues(camera, "translateX");
+	std::vector<double> y = keyValues(camera, "translateY");
+	std::vector<double> z = keyValues(camera, "translateZ");
+	CHECK(frames.size() > 40);
+	CHECK(keyFrames(camera, "rotateZ").size() == frames.size());
+	// The rig is evaluated once per frame, not once per channel or per key
+	CHECK(MockMaya::calls("MPlug::asMObject") <= frames.size() + 1);
+	CHECK(MockMaya::calls("MDGContextGuard") == MockMaya::calls("MPlug::asMObject"));
+
+	// Local keys carried by the rig give the world-space parabola from where the rig was at frame 10
+	MPoint start = MPoint(0.0, 0.0, 3.0) * rigMatrix(10.0);
+	bool onFlight = true;
+	for (size_t i = 0; i < frames.size(); ++i) {
+		double t = (frames[i] - 10.0) / 24.0;
+		MPoint world = MPoint(x[i], y[i], z[i]) * rigMatrix(frames[i]);
+		onFlight = onFlight && std::fabs(world.x - (start.x + 5.0 * t)) < 1e-6
+			&& std::fabs(world.y - (start.y + 10.0 * t - 0.5 * 9.81 * t * t)) < 1e-6
+			&& std::fabs(world.z - start.z) < 1e-6;
+	}
+	CHECK(onFlight);
+
+	// Inheriting the rig's velocity carries the flight along with it
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -s 10 -v 5 10 0 -iv"));
+	std::vector<double> carried = keyValues(camera, "translateX");
+	std::vector<double> carriedFrames = keyFrames(camera, "translateX");
+	MPoint landing = MPoint(carried.back(), keyValues(camera, "translateY").back(), keyValues(camera, "translateZ").back())
+		* rigMatrix(carriedFrames.back());
+	MPoint plain = MPoint(x.back(), y.back(), z.back()) * rigMatrix(frames.back());
+	CHECK(landing.x - plain.x > 50.0);
+
+	CHECK(MockMaya::messages(MockMaya::MessageKind::WARNING).empty());
+
+	CHECK(MockMaya::undo());
+	CHECK(MockMaya::undo());
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 0);
+
+	// Without a rig there is nothing to inherit, and the user is told so
+	MockMaya::createCamera("camera2");
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera2 -v 5 10 0 -iv"));
+	CHECK(MockMaya::messages(MockMaya::MessageKind::WARNING).size() == 1);
+}
+
+TEST_CASE(lookAtTracksAMovingTargetThroughTheFlight)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1", -10.0, 0.0, 5.0);
+	MockMaya::createCamera("camera2", 10.0, 0.0, 5.0);
+	// The hero walks along X, half a unit a frame
+	MDagPath hero = MockMaya::createLocator("hero");
+	MockMaya::setParentMatrix(hero, [](const MTime& time) {
+		MMatrix matrix;
+		matrix.matrix[3][0] = 0.5 * time.as(MTime::kFilm);
+		return matrix;
+	});
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -c camera2 -v 4 10 0 -la hero -fo 0 2 0"));
+	std::vector<double> frames = keyFrames(camera, "translateX");
+	CHECK(frames.size() > 40);
+	CHECK(keyFrames(camera, "rotateZ").size() == frames.size());
+	// The hero is sampled once per frame for both cameras together
+	CHECK(MockMaya::calls("MPlug::asMObject") == frames.size());
+
+	std::vector<double> x = keyValues(camera, "translateX");
+	std::vector<double> y = keyValues(camera, "translateY");
+	std::vector<double> z = keyValues(camera, "translateZ");
+	std::vector<double> rx = keyValues(camera, "rotateX");
+	std::vector<double> ry = keyValues(camera, "rotateY");
+	std::vector<double> rz = keyValues(camera, "rotateZ");
+	bool aimed = true;
+	for (size_t i = 0; i < frames.size(); ++i) {
+		LaunchCore::Euler euler;
+		euler.x = rx[i];
+		euler.y = ry[i];
+		euler.z = rz[i];
+		double m[3][3];
+		LaunchCore::eulerToMatrix(euler, LaunchCore::RotateOrder::XYZ, m);
+
+		LaunchCore::Vec3 toHero = (LaunchCore::Vec3(0.5 * frames[i], 2.0, 0.0) - LaunchCore::Vec3(x[i], y[i], z[i])).normal();
+		aimed = aimed && std::fabs(m[0][2] + toHero.x) < 1e-6 && std::fabs(m[1][2] + toHero.y) < 1e-6 && std::fabs(m[2][2] + toHero.z) < 1e-6;
+	}
+	CHECK(aimed);
+
+	CHECK(MockMaya::undo());
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 0);
+
+	CHECK(!MockMaya::runCommand("cameraLaunch -c camera1 -v 4 10 0 -la villain"));
+	CHECK(!MockMaya::runCommand("cameraLaunch -c camera1 -v 4 10 0 -la hero -uo nobody"));
+}
+
+static MDagPath findObject(const char* name)
+{
+	MSelectionList selList;
+	MDagPath path;
+	selList.add(name);
+	selList.getDagPath(0, path);
+	return path;
+}
+
+TEST_CASE(emitterLaunchesSeededLocatorsAndUndoesThem)
+{
+	resetCommandScene();
+	MockMaya::createLocator("spout", 0.0, 5.0, 0.0);
+	MockMaya::createLocator("crate", 3.0, 0.0, 0.0);
+
+	// Drag makes every flight bake, on the pool, before any key is written
+	CHECK(MockMaya::runCommand("cameraLaunch -obj crate -em 64 -ef spout -v 0 10 0 -ca 30 -sr 5 10 -sd 3 -d 0.1 0"));
+	CHECK(MockMaya::nodeCount(MFn::kLocator) == 64);
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 65 * 5);
+
+	std::vector<double> firstX, firstY;
+	for (int i = 1; i <= 64; ++i) {
+		MDagPath locator = findObject(("locator" + std::to_string(i)).c_str());
+		std::vector<double> y = keyValues(locator, "translateY");
+		std::vector<double> x = keyValues(locator, "translateX");
+		CHECK(y.size() > 2);
+		CHECK_NEAR(y[0], 5.0, 1e-9);
+		firstX.push_back(x[1]);
+		firstY.push_back(y[1] - y[0]);
+	}
+
+	// Each one leaves the spout inside the 30 degree cone, and not all along the same line
+	bool inCone = true;
+	for (size_t i = 0; i < firstX.size(); ++i) {
+		inCone = inCone && std::fabs(firstX[i]) <= std::tan(30.5 * 3.14159265358979323846 / 180.0) * firstY[i];
+	}
+	CHECK(inCone);
+	CHECK(*std::min_element(firstX.begin(), firstX.end()) < *std::max_element(firstX.begin(), firstX.end()));
+	CHECK(keyValues(findObject("crate"), "translateX")[0] == 3.0);
+
+	// Undo takes the locators away with their curves, and redo brings back the same flights
+	CHECK(MockMaya::undo());
+	CHECK(MockMaya::nodeCount(MFn::kLocator) == 0);
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 0);
+	CHECK(MockMaya::redo());
+	CHECK(MockMaya::nodeCount(MFn::kLocator) == 64);
+	CHECK(keyValues(findObject("locator17"), "translateX")[1] == firstX[16]);
+
+	CHECK(!MockMaya::runCommand("cameraLaunch -em 0 -v 0 10 0"));
+	CHECK(!MockMaya::runCommand("cameraLaunch -em 4 -v 0 10 0 -ca 200"));
+	CHECK(!MockMaya::runCommand("cameraLaunch -em 4 -v 0 10 0 -b -bg"));
+	CHECK(!MockMaya::runCommand("cameraLaunch -obj missing -v 0 10 0"));
+}
+
+TEST_CASE(backgroundLaunchIsKeyedFromTheTimer)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1");
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 10 10 0 -b -bg"));
+	CHECK(MockMaya::lastResult().type == MockMaya::CommandResult::Type::INT);
+	CHECK(MockMaya::undoQueueLength() == 0);
+	CHECK(MockMaya::timerCount() == 1);
+
+	// The timer applies the job through its own undoable command once it has baked
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (MockMaya::inputCurve(camera, "translateY").isNull() && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		MockMaya::fireTimers();
+	}
+	CHECK(keyFrames(camera, "translateY").size() > 40);
+	CHECK(MockMaya::undoQueueLength() == 1);
+	CHECK(MockMaya::timerCount() == 0);
+
+	CHECK(MockMaya::undo());
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 0);
+}
+
+TEST_CASE(finishedJobsAreAppliedOrCancelledWithoutTheTimer)
+{
+	resetCommandScene();
+	MDagPath camera = MockMaya::createCamera("camera1");
+	MDagPath other = MockMaya::createCamera("camera2");
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -v 10 10 0 -b -bg"));
+	int applied = (int)MockMaya::lastResult().number;
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera2 -v 10 10 0 -b -bg"));
+	int cancelled = (int)MockMaya::lastResult().number;
+
+	// Nothing fires the timer: -applyJob collects the job itself once it has baked
+	bool keyed = false;
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (!keyed && std::chrono::steady_clock::now() < deadline) {
+		keyed = MockMaya::runCommand("cameraLaunch -aj " + std::to_string(applied));
+		if (!keyed) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	CHECK(keyed);
+	CHECK(keyFrames(camera, "translateY").size() > 40);
+
+	// A job that finished baking but was never collected can still be dropped
+	double progress = 0.0;
+	while (progress != 1.0 && std::chrono::steady_clock::now() < deadline) {
+		CHECK(MockMaya::runCommand("cameraLaunch -jp " + std::to_string(cancelled)));
+		progress = MockMaya::lastResult().number;
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	CHECK(MockMaya::runCommand("cameraLaunch -cj " + std::to_string(cancelled)));
+	CHECK(MockMaya::lastResult().number != 0.0);
+	MockMaya::fireTimers();
+	CHECK(MockMaya::inputCurve(other, "translateY").isNull());
+	CHECK(!MockMaya::runCommand("cameraLaunch -aj " + std::to_string(cancelled)));
+}
+
+TEST_CASE(dragLaunchesAreBakedTogether)
+{
+	resetCommandScene();
+	MDagPath cameras[3] = {
+		MockMaya::createCamera("camera1"),
+		MockMaya::createCamera("camera2", 5.0, 0.0, 0.0),
+		MockMaya::createCamera("camera3", 0.0, 2.0, 5.0)
+	};
+
+	CHECK(MockMaya::runCommand("cameraLaunch -c camera1 -c camera2 -c camera3 -v 3 12 1 -d 0.3 0.02"));
+	std::vector<double> together[3];
+	for (int i = 0; i < 3; ++i) {
+		together[i] = keyValues(cameras[i], "translateY");
+		CHECK(together[i].size() > 20);
+	}
+
+	// The lanes give each camera the same flight it gets on its own
+	const char* names[3] = { "camera1", "camera2", "camera3" };
+	for (int i = 0; i < 3; ++i) {
+		CHECK(MockMaya::runCommand(std::string("cameraLaunch -c ") + names[i] + " -v 3 12 1 -d 0.3 0.02"));
+		std::vector<double> alone = keyValues(cameras[i], "translateY");
+		CHECK(alone.size() == together[i].size());
+		for (size_t j = 0; j < alone.size() && j < together[i].size(); ++j) {
+			CHECK_NEAR(alone[j], together[i][j], 1e-9);
+		}
+	}
+
+	CHECK(!MockMaya::runCommand("cameraLaunch -c camera1 -v 3 12 1 -d -0.3 0.0"));
+	CHECK(MockMaya::messages(MockMaya::MessageKind::ERROR).size() == 1);
+}
+
+TEST_CASE(unknownCameraFailsWithoutTouchingTheScene)
+{
+	resetCommandScene();
+	MockMaya::createCamera("camera1");
+	MockMaya::createLocator("notACamera");
+
+	CHECK(!MockMaya::runCommand("cameraLaunch -c missing -v 1 1 0"));
+	CHECK(!MockMaya::runCommand("cameraLaunch -c notACamera -v 1 1 0"));
+	CHECK(MockMaya::messages(MockMaya::MessageKind::ERROR).size() == 2);
+	CHECK(MockMaya::undoQueueLength() == 0);
+	CHECK(MockMaya::nodeCount(MFn::kAnimCurve) == 0);
+}
@@ -0,0 +1,163 @@
+#include "TestFramework.h"
+#include "FlightPath.h"
+
+using namespace LaunchCore;
+
+// Flat grid of quads at 'height', two triangles per cell
+static std::vector<Triangle> makeGrid(double height, double extent, int cells)
+{
+	std::vector<Triangle> triangles;
+	double cellSize = 2.0 * extent / cells;
+	for (int i = 0; i < cells; ++i) {
+		for (int j = 0; j < cells; ++j) {
+			double x0 = -extent + i * cellSize;
+			double z0 = -extent + j * cellSize;
+			Vec3 a(x0, height, z0);
+			Vec3 b(x0 + cellSize, height, z0);
+			Vec3 c(x0 + cellSize, height, z0 + cellSize);
+			Vec3 d(x0, height, z0 + cellSize);
+			triangles.push_back(Triangle(a, b, c));
+			triangles.push_back(Triangle(a, c, d));
+		}
+	}
+	return triangles;
+}
+
+// Reference answer: test every triangle
+static bool bruteForceHit(const std::vector<Triangle>& triangles, const Vec3& a, const Vec3& b, double& fraction)
+{
+	TriangleBVH single;
+	bool found = false;
+	fraction = 1.0;
+	for (const Triangle& tri : triangles) {
+		single.build(std::vector<Triangle>(1, tri));
+		SegmentHit hit;
+		if (single.intersectSegment(a, b, hit) && hit.fraction <= fraction) {
+			fraction = hit.fraction;
+			found = true;
+		}
+	}
+	return found;
+}
+
+TEST_CASE(bvhMatchesBruteForce)
+{
+	// Two stacked, offset grids so segments see overlapping candidates
+	std::vector<Triangle> triangles = makeGrid(0.0, 10.0, 12);
+	std::vector<Triangle> upper = makeGrid(2.0, 4.0, 5);
+	triangles.insert(triangles.end(), upper.begin(), upper.end());
+
+	TriangleBVH bvh;
+	bvh.build(triangles);
+	CHECK(bvh.triangleCount() == triangles.size());
+	CHECK(bvh.nodeCount() > 1);
+
+	for (int i = 0; i < 40; ++i) {
+		Vec3 a(-9.0 + i * 0.45, 5.0, -8.0 + i * 0.4);
+		Vec3 b(8.0 - i * 0.4, -1.0, 7.5 - i * 0.35);
+
+		SegmentHit hit;
+		double expected = 0.0;
+		bool expectedHit = bruteForceHit(triangles, a, b, expected);
+		CHECK(bvh.intersectSegment(a, b, hit) == expectedHit);
+		if (expectedHit) {
+			CHECK_NEAR(hit.fraction, expected, 1e-12);
+		}
+	}
+}
+
+TEST_CASE(bvhFindsEveryTriangleOfALopsidedTree)
+{
+	// Spacing that grows geometrically makes every split peel off only the few furthest
+	// triangles, so the tree would run past the depth cap if it were not enforced
+	std::vector<Triangle> triangles;
+	for (int i = 0; i < 1500; ++i) {
+		double x = std::pow(1.05, i);
+		double size = 0.02 * x;
+		triangles.emplace_back(Vec3(x - size, 0.0, -size), Vec3(x + size, 0.0, -size), Vec3(x, 0.0, size));
+	}
+
+	TriangleBVH bvh;
+	bvh.build(triangles);
+
+	bool allFound = true;
+	for (int i = 0; i < 1500; ++i) {
+		double x = std::pow(1.05, i);
+		SegmentHit hit;
+		allFound = allFound && bvh.intersectSegment(Vec3(x, 1.0, 0.0), Vec3(x, -1.0, 0.0), hit) && hit.triangle == (uint32_t)i;
+	}
+	CHECK(allFound);
+}
+
+TEST_CASE(segmentMissesAboveGeometry)
+{
+	TriangleBVH bvh;
+	bvh.build(makeGrid(0.0, 5.0, 4));
+
+	SegmentHit hit;
+	CHECK(!bvh.intersectSegment(Vec3(-3.0, 1.0, 0.0), Vec3(3.0, 0.5, 0.0), hit));
+	CHECK(bvh.intersectSegment(Vec3(-3.0, 1.0, 0.0), Vec3(3.0, -0.5, 0.0), hit));
+	CHECK_NEAR(hit.point.y, 0.0, 1e-12);
+	CHECK_NEAR(std::fabs(hit.normal.y), 1.0, 1e-12);
+}
+
+TEST_CASE(flightEndsOnRaisedGround)
+{
+	// A platform one unit above launch height, starting past the point where the camera climbs through y = 1
+	std::vector<Triangle> platform = makeGrid(1.0, 50.0, 8);
+	for (Triangle& tri : platform) {
+		tri.v0.x += 52.0;
+		tri.v1.x += 52.0;
+		tri.v2.x += 52.0;
+	}
+
+	TriangleBVH bvh;
+	bvh.build(platform);
+
+	LaunchParams params;
+	params.velocity = Vec3(3.0, 10.0, 0.0);
+	params.framesPerSecond = 24.0;
+
+	FlightOptions options;
+	options.collision = &bvh;
+
+	TrajectorySamples samples;
+	CollisionHit hit;
+	sampleFlight(params, options, samples, &hit);
+
+	double hitTime = timeToHeight(params, 1.0);
+	CHECK(hit.hit);
+	CHECK_NEAR(hit.position.y, 1.0, 1e-9);
+	CHECK_NEAR(hit.frame, hitTime * 24.0, 0.05);
+	CHECK_NEAR(samples.frames.back(), hit.frame, 1e-12);
+	CHECK_NEAR(samples.translateY.back(), 1.0, 1e-9);
+	CHECK(samples.frames.back() < calculateFlightFrames(params));
+}
+
+TEST_CASE(flightFallsToLowerGround)
+{
+	// Launched from a ledge: the ground is five units below launch height
+	TriangleBVH bvh;
+	bvh.build(makeGrid(-5.0, 100.0, 8));
+
+	LaunchParams params;
+	params.velocity = Vec3(2.0, 6.0, 1.0);
+
+	DragParams drag;
+	drag.quadratic = 0.02;
+
+	FlightOptions options;
+	options.collision = &bvh;
+
+	for (int mode = 0; mode < 2; ++mode) {
+		options.drag = (mode == 0) ? DragParams() : drag;
+
+		TrajectorySamples samples;
+		CollisionHit hit;
+		sampleFlight(params, options, samples, &hit);
+
+		CHECK(hit.hit);
+		CHECK_NEAR(hit.position.y, -5.0, 1e-9);
+		CHECK(samples.frames.back() > calculateFlightFrames(params));
+	}
+}
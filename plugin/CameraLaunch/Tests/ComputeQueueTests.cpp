@@ -0,0 +1,130 @@
+#include "TestFramework.h"
+#include "ComputeQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace LaunchCore;
+
+// Collects until 'count' jobs have ended
+static std::vector<std::pair<uint64_t, JobState>> collect(ComputeQueue& queue, size_t count)
+{
+	std::vector<std::pair<uint64_t, JobState>> finished;
+	while (finished.size() < count) {
+		queue.wait();
+		for (const auto& job : queue.takeFinished()) {
+			finished.push_back(job);
+		}
+	}
+	return finished;
+}
+
+TEST_CASE(jobsReportTheirOutcome)
+{
+	ComputeQueue queue(2);
+	uint64_t succeeds = queue.submit([](JobControl& control) {
+		control.setProgress(0.5);
+		return true;
+	});
+	uint64_t fails = queue.submit([](JobControl&) { return false; });
+	CHECK(succeeds == 1);
+	CHECK(fails == 2);
+
+	auto finished = collect(queue, 2);
+	for (const auto& job : finished) {
+		CHECK(job.second == (job.first == succeeds ? JobState::FINISHED : JobState::FAILED));
+	}
+
+	// Collected jobs are forgotten
+	JobState state;
+	double progress;
+	CHECK(!queue.status(succeeds, state, progress));
+	CHECK(queue.pending() == 0);
+	CHECK(!queue.cancel(fails));
+}
+
+TEST_CASE(finishedJobsReportFullProgress)
+{
+	ComputeQueue queue(1);
+	uint64_t id = queue.submit([](JobControl& control) {
+		control.setRange(0.0, 0.5);
+		control.setProgress(1.0);
+		return true;
+	});
+	queue.wait();
+
+	JobState state;
+	double progress = 0.0;
+	CHECK(queue.status(id, state, progress));
+	CHECK(state == JobState::FINISHED);
+	CHECK_NEAR(progress, 1.0, 1e-12);
+}
+
+TEST_CASE(progressIsScaledIntoItsRange)
+{
+	JobControl control;
+	control.setRange(0.25, 0.75);
+	control.setProgress(0.5);
+	CHECK_NEAR(control.progress(), 0.5, 1e-12);
+	control.setProgress(2.0);
+	CHECK_NEAR(control.progress(), 0.75, 1e-12);
+}
+
+TEST_CASE(cancelledJobsStopAtTheNextCheck)
+{
+	ComputeQueue queue(1);
+	std::atomic<bool> started(false);
+	std::atomic<bool> queuedRan(false);
+
+	uint64_t running = queue.submit([&](JobControl& control) {
+		started = true;
+		while (!control.cancelled()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return true;
+	});
+	uint64_t queued = queue.submit([&](JobControl&) {
+		queuedRan = true;
+		return true;
+	});
+
+	while (!started) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	JobState state;
+	double progress;
+	CHECK(queue.status(queued, state, progress));
+	CHECK(state == JobState::QUEUED);
+
+	CHECK(queue.cancel(queued));
+	CHECK(queue.cancel(running));
+
+	auto finished = collect(queue, 2);
+	CHECK(finished[0].first == running);
+	CHECK(finished[0].second == JobState::CANCELLED);
+	CHECK(finished[1].first == queued);
+	CHECK(finished[1].second == JobState::CANCELLED);
+	CHECK(!queuedRan);
+}
+
+TEST_CASE(destroyingTheQueueCancelsOutstandingJobs)
+{
+	std::atomic<int> completed(0);
+	{
+		ComputeQueue queue(1);
+		for (int i = 0; i < 4; ++i) {
+			queue.submit([&](JobControl& control) {
+				while (!control.cancelled()) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				++completed;
+				return true;
+			});
+		}
+	}
+
+	// Only the job already running gets to see its cancellation
+	CHECK(completed <= 1);
+}
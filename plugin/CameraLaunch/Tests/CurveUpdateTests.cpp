@@ -0,0 +1,124 @@
+#include "TestFramework.h"
+#include "CurveUpdate.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace LaunchCore;
+
+// Applies 'plan' the way an anim curve would take it, refusing any move that would reorder keys
+static bool applyPlan(std::vector<double>& frames, const std::vector<double>& targets, const KeyUpdatePlan& plan)
+{
+	for (size_t index : plan.removals) {
+		if (index >= frames.size()) return false;
+		frames.erase(frames.begin() + index);
+	}
+
+	for (const KeyUpdatePlan::Move& move : plan.moves) {
+		if (move.key >= frames.size()) return false;
+		double frame = targets[move.target];
+		if (move.key > 0 && frames[move.key - 1] >= frame) return false;
+		if (move.key + 1 < frames.size() && frames[move.key + 1] <= frame) return false;
+		frames[move.key] = frame;
+	}
+
+	for (size_t target : plan.additions) {
+		double frame = targets[target];
+		auto position = std::lower_bound(frames.begin(), frames.end(), frame);
+		if (position != frames.end() && *position == frame) return false;
+		frames.insert(position, frame);
+	}
+
+	return frames == targets;
+}
+
+TEST_CASE(identicalFramesNeedNoEdits)
+{
+	std::vector<double> frames = { 1.0, 13.5, 26.0 };
+	KeyUpdatePlan plan = planKeyUpdate(frames.data(), frames.size(), frames.data(), frames.size());
+	CHECK(plan.empty());
+}
+
+TEST_CASE(longerBakeOnlyAddsTrailingKeys)
+{
+	std::vector<double> current, target;
+	for (int frame = 0; frame < 50; ++frame) current.push_back(frame);
+	for (int frame = 0; frame < 53; ++frame) target.push_back(frame);
+
+	KeyUpdatePlan plan = planKeyUpdate(current.data(), current.size(), target.data(), target.size());
+	CHECK(plan.removals.empty());
+	CHECK(plan.moves.empty());
+	CHECK(plan.additions.size() == 3);
+	CHECK(applyPlan(current, target, plan));
+}
+
+TEST_CASE(shorterBakeOnlyRemovesTrailingKeys)
+{
+	std::vector<double> current, target;
+	for (int frame = 0; frame < 50; ++frame) current.push_back(frame);
+	for (int frame = 0; frame < 40; ++frame) target.push_back(frame);
+
+	KeyUpdatePlan plan = planKeyUpdate(current.data(), current.size(), target.data(), target.size());
+	CHECK(plan.removals.size() == 10);
+	CHECK(plan.removals.front() == 49);
+	CHECK(plan.moves.empty());
+	CHECK(plan.additions.empty());
+	CHECK(applyPlan(current, target, plan));
+}
+
+TEST_CASE(shiftedParabolaMovesKeys)
+{
+	std::vector<double> current = { 0.0, 24.46, 49.0 };
+	std::vector<double> target = { 0.0, 25.1, 50.2 };
+
+	KeyUpdatePlan plan = planKeyUpdate(current.data(), current.size(), target.data(), target.size());
+	CHECK(plan.removals.empty());
+	CHECK(plan.moves.size() == 2);
+	CHECK(plan.additions.empty());
+	CHECK(applyPlan(current, target, plan));
+}
+
+TEST_CASE(movesNeverCrossNeighbours)
+{
+	// Every key moves, some past where their neighbour started
+	std::vector<double> current = { 0.0, 1.0, 2.0, 3.0, 4.0 };
+	std::vector<double> target = { 1.5, 2.5, 3.5, 4.5, 5.5 };
+
+	KeyUpdatePlan plan = planKeyUpdate(current.data(), current.size(), target.data(), target.size());
+	CHECK(plan.moves.size() == 5);
+	CHECK(applyPlan(current, target, plan));
+
+	current = { 10.0, 11.0, 12.0, 13.0 };
+	target = { 0.5, 11.5, 12.25, 20.0 };
+	plan = planKeyUpdate(current.data(), current.size(), target.data(), target.size());
+	CHECK(applyPlan(current, target, plan));
+}
+
+TEST_CASE(randomCurvesReachTheirTargets)
+{
+	std::mt19937 random(7);
+	std::uniform_int_distribution<int> countDistribution(0, 12);
+	std::uniform_int_distribution<int> stepDistribution(1, 4);
+
+	for (int trial = 0; trial < 500; ++trial) {
+		// Quarter-frame grid so some keys coincide and some do not
+		auto makeFrames = [&](int count) {
+			std::vector<double> frames;
+			double frame = 0.0;
+			for (int i = 0; i < count; ++i) {
+				frame += 0.25 * stepDistribution(random);
+				frames.push_back(frame);
+			}
+			return frames;
+		};
+
+		std::vector<double> current = makeFrames(countDistribution(random));
+		std::vector<double> target = makeFrames(countDistribution(random));
+		KeyUpdatePlan plan = planKeyUpdate(current.data(), current.size(), target.data(), target.size());
+
+		size_t kept = current.size() - plan.removals.size();
+		CHECK(kept + plan.additions.size() == target.size());
+
+		CHECK(applyPlan(current, target, plan));
+	}
+}
@@ -0,0 +1,98 @@
+#include "TestFramework.h"
+#include "DragIntegrator.h"
+
+using namespace LaunchCore;
+
+static const LaunchParams dragParams = makeLaunchParams(Vec3(0.0, 3.0, 1.0), Vec3(8.0, 14.0, -5.0), -9.81, 1, 24.0);
+
+TEST_CASE(zeroDragMatchesAnalyticApexAndLanding)
+{
+	LaunchParams params = dragParams;
+	TrajectorySamples samples;
+	FlightEvents events = integrateFlight(params, DragParams(), IntegratorSettings(), &samples);
+
+	double apexTime = timeToApex(params);
+	Vec3 apex = positionAtTime(params, apexTime);
+	CHECK_NEAR(events.apexTime, apexTime, 1e-9);
+	CHECK_NEAR(events.apexPosition.y, apex.y, 1e-9);
+	CHECK_NEAR(events.apexPosition.x, apex.x, 1e-9);
+
+	double flightTime = 2.0 * 14.0 / 9.81;
+	CHECK(events.landed);
+	CHECK_NEAR(events.landingTime, flightTime, 1e-9);
+	CHECK_NEAR(events.landingPosition.x, 8.0 * flightTime, 1e-8);
+	CHECK_NEAR(events.landingPosition.z, 1.0 - 5.0 * flightTime, 1e-8);
+
+	// Whole-frame samples follow the closed form exactly when there is no drag
+	for (size_t i = 0; i + 1 < samples.size(); ++i) {
+		Vec3 expected = positionAtTime(params, (samples.frames[i] - 1.0) / 24.0);
+		CHECK_NEAR(samples.translateY[i], expected.y, 1e-9);
+	}
+	CHECK_NEAR(samples.frames.back(), 1.0 + flightTime * 24.0, 1e-8);
+}
+
+TEST_CASE(dragShortensFlight)
+{
+	LaunchParams params = dragParams;
+	DragParams drag;
+	drag.linear = 0.1;
+	drag.quadratic = 0.02;
+	drag.mass = 2.0;
+
+	FlightEvents withDrag = integrateFlight(params, drag, IntegratorSettings());
+	FlightEvents noDrag = integrateFlight(params, DragParams(), IntegratorSettings());
+
+	CHECK(withDrag.landed);
+	CHECK(withDrag.apexPosition.y < noDrag.apexPosition.y);
+	CHECK(withDrag.apexTime < noDrag.apexTime);
+	CHECK(withDrag.landingPosition.x < noDrag.landingPosition.x);
+}
+
+TEST_CASE(linearDragMatchesClosedForm)
+{
+	// With only linear drag the horizontal motion is x(t) = v0 * m / k * (1 - exp(-k t / m))
+	LaunchParams params = dragParams;
+	DragParams drag;
+	drag.linear = 0.5;
+	drag.mass = 1.5;
+
+	FlightEvents events = integrateFlight(params, drag, IntegratorSettings());
+	double rate = drag.linear / drag.mass;
+	double expectedX = 8.0 / rate * (1.0 - std::exp(-rate * events.landingTime));
+	CHECK_NEAR(events.landingPosition.x, expectedX, 1e-6);
+}
+
+TEST_CASE(batchLanesMatchSingleLaunches)
+{
+	std::vector<LaunchParams> launches;
+	for (int i = 0; i < 7; ++i) {
+		LaunchParams params = dragParams;
+		params.velocity.y = 5.0 + i * 3.0;
+		launches.push_back(params);
+	}
+
+	DragParams drag;
+	drag.quadratic = 0.05;
+
+	std::vector<FlightEvents> events;
+	integrateFlights(launches, std::vector<DragParams>(1, drag), IntegratorSettings(), events);
+	CHECK(events.size() == launches.size());
+
+	for (size_t i = 0; i < launches.size(); ++i) {
+		FlightEvents single = integrateFlight(launches[i], drag, IntegratorSettings());
+		CHECK_NEAR(events[i].landingTime, single.landingTime, 1e-12);
+		CHECK_NEAR(events[i].apexPosition.y, single.apexPosition.y, 1e-12);
+	}
+}
+
+TEST_CASE(nonReturningLaunchStopsAt120Frames)
+{
+	LaunchParams params = dragParams;
+	params.velocity.y = -1.0;
+
+	TrajectorySamples samples;
+	FlightEvents events = integrateFlight(params, DragParams(), IntegratorSettings(), &samples);
+	CHECK(!events.landed);
+	CHECK_NEAR(events.landingTime, 120.0 / 24.0, 1e-9);
+	CHECK(samples.size() == 121);
+}
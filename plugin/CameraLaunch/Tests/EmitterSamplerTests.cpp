@@ -0,0 +1,97 @@
+#include "TestFramework.h"
+#include "EmitterSampler.h"
+#include "ThreadPool.h"
+
+using namespace LaunchCore;
+
+TEST_CASE(counterRandomDependsOnlyOnItsInputs)
+{
+	CHECK(counterRandom(7, 100, 0) == counterRandom(7, 100, 0));
+	CHECK(counterRandom(7, 100, 0) != counterRandom(7, 101, 0));
+	CHECK(counterRandom(7, 100, 0) != counterRandom(8, 100, 0));
+	CHECK(counterRandom(7, 100, 0) != counterRandom(7, 100, 1));
+
+	// Roughly uniform: the mean of many draws is near one half, and none reach 1
+	double sum = 0.0;
+	bool inRange = true;
+	for (uint64_t i = 0; i < 100000; ++i) {
+		double u = counterUniform(3, i, 0);
+		inRange = inRange && u >= 0.0 && u < 1.0;
+		sum += u;
+	}
+	CHECK(inRange);
+	CHECK_NEAR(sum / 100000.0, 0.5, 0.01);
+}
+
+TEST_CASE(emitterVelocitiesStayInsideConeAndSpeedRange)
+{
+	EmitterSettings settings;
+	settings.direction = Vec3(1.0, 1.0, 0.0);
+	settings.coneAngle = 0.3;
+	settings.minSpeed = 5.0;
+	settings.maxSpeed = 8.0;
+	settings.seed = 12;
+
+	std::vector<Vec3> velocities;
+	sampleEmitterVelocities(settings, 0, 5000, velocities);
+
+	Vec3 axis = settings.direction.normal();
+	double widest = 0.0;
+	double slowest = 1e9, fastest = 0.0;
+	Vec3 mean;
+	for (const Vec3& v : velocities) {
+		double speed = v.length();
+		slowest = std::min(slowest, speed);
+		fastest = std::max(fastest, speed);
+		widest = std::max(widest, std::acos(std::min(1.0, v.dot(axis) / speed)));
+		mean += v.normal();
+	}
+	CHECK(widest <= 0.3 + 1e-9);
+	CHECK(widest > 0.28);
+	CHECK(slowest >= 5.0);
+	CHECK(fastest <= 8.0);
+	CHECK(fastest - slowest > 2.9);
+	// Symmetric around the axis
+	CHECK(mean.normal().dot(axis) > 0.9999);
+
+	settings.coneAngle = 0.0;
+	settings.minSpeed = settings.maxSpeed = 4.0;
+	Vec3 straight = sampleEmitterVelocity(settings, 99);
+	CHECK_NEAR(straight.x, 4.0 * axis.x, 1e-12);
+	CHECK_NEAR(straight.y, 4.0 * axis.y, 1e-12);
+	CHECK_NEAR(straight.z, 0.0, 1e-12);
+}
+
+TEST_CASE(emitterSamplesDoNotDependOnThreadOrOrder)
+{
+	EmitterSettings settings;
+	settings.coneAngle = 1.0;
+	settings.minSpeed = 1.0;
+	settings.maxSpeed = 20.0;
+	settings.seed = 2024;
+
+	std::vector<Vec3> serial;
+	sampleEmitterVelocities(settings, 0, 4096, serial);
+
+	// Blocks sampled concurrently, in whatever order the pool runs them
+	std::vector<Vec3> parallel(serial.size());
+	ThreadPool pool(4);
+	for (size_t first = 0; first < parallel.size(); first += 256) {
+		pool.submit([&, first] {
+			std::vector<Vec3> block;
+			sampleEmitterVelocities(settings, first, 256, block);
+			std::copy(block.begin(), block.end(), parallel.begin() + first);
+		});
+	}
+	pool.wait();
+
+	bool same = true;
+	for (size_t i = 0; i < serial.size(); ++i) {
+		same = same && serial[i].x == parallel[i].x && serial[i].y == parallel[i].y && serial[i].z == parallel[i].z;
+	}
+	CHECK(same);
+
+	// A different seed gives a different spread
+	settings.seed = 2025;
+	CHECK(sampleEmitterVelocity(settings, 0).x != serial[0].x);
+}
@@ -0,0 +1,158 @@
+#include "TestFramework.h"
+#include "FlightBake.h"
+#include "ThreadPool.h"
+
+using namespace LaunchCore;
+
+static BakeRequest makeBakeRequest()
+{
+	BakeRequest request;
+	request.params.startPosition = Vec3(0.0, 2.0, 0.0);
+	request.params.velocity = Vec3(4.0, 15.0, -1.0);
+	request.options.drag.linear = 0.2;
+	return request;
+}
+
+TEST_CASE(bakeMatchesSampledFlight)
+{
+	BakeRequest request = makeBakeRequest();
+
+	TrajectorySamples expected;
+	sampleFlight(request.params, request.options, expected);
+
+	BakedFlight flight;
+	CHECK(bakeFlight(request, flight));
+	CHECK(!flight.cache);
+
+	TrajectoryView view = flight.trajectory();
+	CHECK(view.count == expected.size());
+	CHECK(view.count > 2);
+	CHECK_NEAR(view.translateY[view.count / 2], expected.translateY[expected.size() / 2], 1e-12);
+	CHECK(view.rotateZ == nullptr);
+}
+
+TEST_CASE(orientedBakeKeysTheSolvedRotation)
+{
+	BakeRequest request = makeBakeRequest();
+	request.orient = true;
+	request.orientation.banking = 0.5;
+
+	BakedFlight flight;
+	CHECK(bakeFlight(request, flight));
+	CHECK(flight.orientation.size() == flight.samples.size());
+
+	TrajectoryView view = flight.trajectory();
+	CHECK(view.rotateX == flight.orientation.rotateX.data());
+	CHECK(view.rotateZ == flight.orientation.rotateZ.data());
+}
+
+TEST_CASE(secondBakeIsMappedFromTheCache)
+{
+	TempDirectory directory("bakeCache");
+	BakeRequest request = makeBakeRequest();
+	request.cacheDirectory = directory.path().string();
+	std::string path = directory.file(flightCacheKey(request.params, request.startMatrix, request.options).fileName());
+
+	BakedFlight sampled;
+	CHECK(bakeFlight(request, sampled));
+	CHECK(!sampled.cache);
+	CHECK(sampled.cacheError.empty());
+	CHECK(std::filesystem::exists(path));
+
+	BakedFlight cached;
+	CHECK(bakeFlight(request, cached));
+	CHECK(cached.cache && cached.cache->isOpen());
+
+	TrajectoryView a = sampled.trajectory();
+	TrajectoryView b = cached.trajectory();
+	CHECK(a.count == b.count);
+	for (size_t i = 0; i < a.count; ++i) {
+		CHECK(a.frames[i] == b.frames[i]);
+		CHECK(a.translateX[i] == b.translateX[i]);
+		CHECK(a.rotateX[i] == b.rotateX[i]);
+	}
+
+	cached.cache.reset();
+}
+
+TEST_CASE(cancelledBakeStopsEarly)
+{
+	BakeRequest request = makeBakeRequest();
+
+	JobControl control;
+	control.cancel();
+
+	BakedFlight flight;
+	CHECK(!bakeFlight(request, flight, &control));
+	CHECK(flight.samples.size() == 0);
+}
+
+TEST_CASE(bakeReportsProgress)
+{
+	BakeRequest request = makeBakeRequest();
+
+	JobControl control;
+	control.setRange(0.5, 0.75);
+
+	BakedFlight flight;
+	CHECK(bakeFlight(request, flight, &control));
+	CHECK_NEAR(control.progress(), 0.75, 1e-12);
+}
+
+TEST_CASE(batchedBakeMatchesOneFlightAtATime)
+{
+	// Drag flights share lanes; the closed-form one and the one with its own step are baked alone
+	std::vector<BakeRequest> requests(6, makeBakeRequest());
+	for (size_t i = 0; i < requests.size(); ++i) {
+		requests[i].params.velocity = Vec3(1.0 + i, 10.0 + 2.0 * i, -0.5 * i);
+		requests[i].options.drag.quadratic = 0.01 * i;
+	}
+	requests[2].options.drag = DragParams();
+	requests[4].options.frameStep = 0.5;
+	requests[5].orient = true;
+
+	std::vector<BakedFlight> expected(requests.size());
+	for (size_t i = 0; i < requests.size(); ++i) {
+		CHECK(bakeFlight(requests[i], expected[i]));
+	}
+
+	ThreadPool pool(3);
+	for (int mode = 0; mode < 2; ++mode) {
+		std::vector<BakedFlight> flights;
+		bakeFlights(requests, flights, (mode == 0) ? nullptr : &pool);
+		CHECK(flights.size() == requests.size());
+
+		for (size_t i = 0; i < requests.size() && i < flights.size(); ++i) {
+			TrajectoryView a = expected[i].trajectory();
+			TrajectoryView b = flights[i].trajectory();
+			CHECK(a.count == b.count);
+			CHECK((a.rotateZ != nullptr) == (b.rotateZ != nullptr));
+			for (size_t j = 0; j < a.count && j < b.count; ++j) {
+				CHECK_NEAR(a.frames[j], b.frames[j], 1e-12);
+				CHECK_NEAR(a.translateX[j], b.translateX[j], 1e-12);
+				CHECK_NEAR(a.translateY[j], b.translateY[j], 1e-12);
+				CHECK_NEAR(a.rotateY[j], b.rotateY[j], 1e-12);
+			}
+		}
+	}
+}
+
+TEST_CASE(batchedBakeMapsCachedFlights)
+{
+	TempDirectory directory("batchCache");
+	std::vector<BakeRequest> requests(3, makeBakeRequest());
+	for (size_t i = 0; i < requests.size(); ++i) {
+		requests[i].params.velocity.y += i;
+		requests[i].cacheDirectory = directory.path().string();
+	}
+
+	std::vector<BakedFlight> first, second;
+	bakeFlights(requests, first);
+	bakeFlights(requests, second);
+	for (size_t i = 0; i < requests.size(); ++i) {
+		CHECK(!first[i].cache);
+		CHECK(first[i].cacheError.empty());
+		CHECK(second[i].cache && second[i].cache->isOpen());
+		CHECK(first[i].trajectory().count == second[i].trajectory().count);
+	}
+}
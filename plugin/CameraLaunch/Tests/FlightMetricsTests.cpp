@@ -0,0 +1,92 @@
+#include "TestFramework.h"
+#include "FlightMetrics.h"
+
+using namespace LaunchCore;
+
+TEST_CASE(metricsMatchTheParabolicKeys)
+{
+	LaunchParams params;
+	params.startPosition = Vec3(1.0, 2.0, 3.0);
+	params.velocity = Vec3(4.0, 12.0, -2.0);
+	params.startFrame = 10.5;
+
+	FlightMetrics metrics = computeFlightMetrics(params);
+	std::vector<ParabolicKey> keys = calculateParabolicKeys(params);
+
+	CHECK_NEAR(metrics.apexFrame, keys[1].frame, 1e-9);
+	CHECK_NEAR(metrics.apexPosition.y, keys[1].position.y, 1e-9);
+	CHECK_NEAR(metrics.landingFrame, keys[2].frame, 1e-9);
+	CHECK_NEAR(metrics.landingPosition.x, keys[2].position.x, 1e-9);
+	CHECK_NEAR(metrics.landingPosition.z, keys[2].position.z, 1e-9);
+	CHECK_NEAR(metrics.flightFrames, landingTime(params) * params.framesPerSecond, 1e-9);
+
+	std::vector<double> frames = getKeyFrameNumbers(params);
+	CHECK_NEAR(metrics.apexFrame, frames[1], 1e-9);
+	CHECK_NEAR(metrics.landingFrame, frames[2], 1e-9);
+
+	std::vector<Vec3> positions = calculateTrajectory(params);
+	CHECK_NEAR(metrics.apexPosition.x, positions[1].x, 1e-9);
+	CHECK_NEAR(metrics.landingPosition.y, positions[2].y, 1e-9);
+}
+
+TEST_CASE(landingIsTheExactTouchdown)
+{
+	LaunchParams params;
+	params.startPosition = Vec3(0.0, 3.0, 0.0);
+	params.velocity = Vec3(2.0, 7.0, 1.0);
+	params.startFrame = 4.0;
+
+	// 2 vy / |g| = 1.427s = 34.25 frames, between two whole frames
+	double touchdown = 2.0 * 7.0 / 9.81;
+	FlightMetrics metrics = computeFlightMetrics(params);
+	CHECK_NEAR(metrics.flightFrames, touchdown * 24.0, 1e-9);
+	CHECK_NEAR(metrics.landingFrame, 4.0 + touchdown * 24.0, 1e-9);
+	CHECK_NEAR(metrics.landingPosition.x, 2.0 * touchdown, 1e-9);
+	CHECK_NEAR(metrics.landingPosition.y, 3.0, 1e-9);
+	CHECK_NEAR(metrics.landingPosition.z, touchdown, 1e-9);
+}
+
+TEST_CASE(flightTimeSetsTheLanding)
+{
+	LaunchParams params;
+	params.velocity = Vec3(3.0, 8.0, 0.0);
+	params.flightTime = 1.3;
+
+	FlightMetrics metrics = computeFlightMetrics(params);
+	CHECK_NEAR(metrics.flightFrames, 1.3 * 24.0, 1e-9);
+	CHECK_NEAR(metrics.landingPosition.x, 3.0 * 1.3, 1e-9);
+}
+
+TEST_CASE(fallingFlightPeaksAtTheStart)
+{
+	LaunchParams params;
+	params.startPosition = Vec3(0.0, 5.0, 0.0);
+	params.velocity = Vec3(2.0, -1.0, 0.0);
+
+	FlightMetrics metrics = computeFlightMetrics(params);
+	CHECK_NEAR(metrics.apexFrame, params.startFrame, 1e-12);
+	CHECK_NEAR(metrics.apexPosition.y, 5.0, 1e-12);
+	CHECK(metrics.landingFrame > metrics.apexFrame);
+}
+
+TEST_CASE(batchMetricsArePackedInOrder)
+{
+	std::vector<LaunchParams> params(3);
+	for (size_t i = 0; i < params.size(); ++i) {
+		params[i].velocity = Vec3(1.0, 5.0 + i, 0.0);
+	}
+
+	std::vector<FlightMetrics> metrics;
+	computeFlightMetrics(params, metrics);
+	CHECK(metrics.size() == 3);
+	CHECK(metrics[2].apexPosition.y > metrics[0].apexPosition.y);
+
+	std::vector<double> packed(FLIGHT_METRIC_VALUES * metrics.size());
+	for (size_t i = 0; i < metrics.size(); ++i) {
+		packFlightMetrics(metrics[i], &packed[i * FLIGHT_METRIC_VALUES]);
+	}
+	CHECK(packed[FLIGHT_METRIC_VALUES + 0] == metrics[1].apexFrame);
+	CHECK(packed[FLIGHT_METRIC_VALUES + 2] == metrics[1].apexPosition.y);
+	CHECK(packed[FLIGHT_METRIC_VALUES + 4] == metrics[1].flightFrames);
+	CHECK(packed[2 * FLIGHT_METRIC_VALUES + 8] == metrics[2].landingPosition.z);
+}
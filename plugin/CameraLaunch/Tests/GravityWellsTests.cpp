@@ -0,0 +1,146 @@
+#include "TestFramework.h"
+#include "FlightPath.h"
+#include "GravityWells.h"
+#include "TrajectoryCache.h"
+
+#include <random>
+
+using namespace LaunchCore;
+
+static std::vector<Attractor> makeAsteroidField(size_t count, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> coordinate(-50.0, 50.0);
+	std::uniform_real_distribution<double> mass(0.5, 4.0);
+
+	std::vector<Attractor> attractors;
+	for (size_t i = 0; i < count; ++i) {
+		attractors.push_back(Attractor(Vec3(coordinate(rng), coordinate(rng) * 0.2, coordinate(rng)), mass(rng)));
+	}
+	return attractors;
+}
+
+TEST_CASE(zeroThetaMatchesDirectSum)
+{
+	AttractorTree tree;
+	tree.build(makeAsteroidField(500, 7));
+	CHECK(tree.attractorCount() == 500);
+	CHECK(tree.nodeCount() > 1);
+
+	Vec3 p(3.0, 20.0, -8.0);
+	Vec3 exact = tree.directAcceleration(p, 0.1);
+	Vec3 visited = tree.acceleration(p, 0.1, 0.0);
+	CHECK_NEAR(visited.x, exact.x, 1e-12);
+	CHECK_NEAR(visited.y, exact.y, 1e-12);
+	CHECK_NEAR(visited.z, exact.z, 1e-12);
+}
+
+TEST_CASE(barnesHutStaysCloseToDirectSum)
+{
+	AttractorTree tree;
+	tree.build(makeAsteroidField(4000, 11));
+
+	const Vec3 points[] = { Vec3(0.0, 30.0, 0.0), Vec3(-45.0, 2.0, 12.0), Vec3(80.0, -5.0, 80.0), Vec3(10.0, 0.0, 10.0) };
+	for (const Vec3& p : points) {
+		Vec3 exact = tree.directAcceleration(p, 0.5);
+		Vec3 approximate = tree.acceleration(p, 0.5, 0.5);
+		CHECK((approximate - exact).length() < 0.05 * exact.length());
+	}
+}
+
+TEST_CASE(batchAccelerationMatchesSinglePositions)
+{
+	AttractorTree tree;
+	tree.build(makeAsteroidField(300, 3));
+
+	double x[] = { 0.0, 12.0, -30.0 };
+	double y[] = { 5.0, -1.0, 8.0 };
+	double z[] = { 1.0, 40.0, -2.0 };
+	double ox[3], oy[3], oz[3];
+	tree.acceleration(x, y, z, 3, 0.1, 0.5, ox, oy, oz);
+	for (int i = 0; i < 3; ++i) {
+		Vec3 single = tree.acceleration(Vec3(x[i], y[i], z[i]), 0.1, 0.5);
+		CHECK(ox[i] == single.x);
+		CHECK(oy[i] == single.y);
+		CHECK(oz[i] == single.z);
+	}
+}
+
+TEST_CASE(coincidentAndMasslessAttractors)
+{
+	// Identical positions cannot be split and end up in one leaf
+	std::vector<Attractor> attractors(40, Attractor(Vec3(1.0, 2.0, 3.0), 1.0));
+	attractors.push_back(Attractor(Vec3(9.0, 9.0, 9.0), 0.0));
+
+	AttractorTree tree;
+	tree.build(attractors);
+	CHECK(tree.attractorCount() == 40);
+
+	Vec3 pull = tree.acceleration(Vec3(1.0, 12.0, 3.0), 0.0, 0.5);
+	CHECK_NEAR(pull.y, -40.0 / 100.0, 1e-12);
+
+	tree.build(std::vector<Attractor>(1, Attractor(Vec3(), -1.0)));
+	CHECK(tree.empty());
+	CHECK(!GravityWellSettings().active());
+}
+
+TEST_CASE(singleWellHoldsCircularOrbit)
+{
+	// v = sqrt(G M / r) keeps a circular orbit; after one period the camera is back at the start
+	AttractorTree tree;
+	tree.build(std::vector<Attractor>(1, Attractor(Vec3(0.0, 10.0, 0.0), 1000.0)));
+
+	const double radius = 20.0;
+	const double speed = std::sqrt(1000.0 / radius);
+	const double period = 2.0 * 3.14159265358979323846 * radius / speed;
+
+	LaunchParams params;
+	params.startPosition = Vec3(radius, 10.0, 0.0);
+	params.velocity = Vec3(0.0, 0.0, speed);
+	params.gravity = 0.0;
+	params.framesPerSecond = 24.0;
+	params.flightTime = period;
+
+	FlightOptions options;
+	options.wells.attractors = &tree;
+	options.wells.softening = 0.0;
+
+	TrajectorySamples samples;
+	sampleFlight(params, options, samples);
+	CHECK_NEAR(samples.frames.back(), period * 24.0, 1e-9);
+	CHECK_NEAR(samples.translateX.back(), radius, 1e-3);
+	CHECK_NEAR(samples.translateZ.back(), 0.0, 1e-3);
+	for (size_t i = 0; i < samples.size(); ++i) {
+		double x = samples.translateX[i];
+		double z = samples.translateZ[i];
+		CHECK_NEAR(std::sqrt(x * x + z * z), radius, 1e-3);
+		CHECK_NEAR(samples.translateY[i], 10.0, 1e-9);
+
+		// The camera turns with the orbit, a whole turn over the period without wrapping
+		double angle = speed * (samples.frames[i] / 24.0) / radius;
+		CHECK_NEAR(samples.rotateY[i], 3.14159265358979323846 - angle, 1e-3);
+	}
+	CHECK_NEAR(samples.rotateY.front() - samples.rotateY.back(), 2.0 * 3.14159265358979323846, 1e-3);
+}
+
+TEST_CASE(wellsChangeFlightCacheKey)
+{
+	LaunchParams params;
+	params.velocity = Vec3(5.0, 9.0, 0.0);
+
+	AttractorTree near, far;
+	near.build(std::vector<Attractor>(1, Attractor(Vec3(5.0, 0.0, 0.0), 10.0)));
+	far.build(std::vector<Attractor>(1, Attractor(Vec3(50.0, 0.0, 0.0), 10.0)));
+
+	FlightOptions plain;
+	FlightOptions nearWells;
+	nearWells.wells.attractors = &near;
+	FlightOptions farWells;
+	farWells.wells.attractors = &far;
+
+	uint64_t plainKey = flightCacheKey(params, nullptr, plain).value();
+	CHECK(flightCacheKey(params, nullptr, nearWells).value() != plainKey);
+	CHECK(flightCacheKey(params, nullptr, nearWells).value() != flightCacheKey(params, nullptr, farWells).value());
+	nearWells.wells.strength = 0.0;
+	CHECK(flightCacheKey(params, nullptr, nearWells).value() == plainKey);
+}
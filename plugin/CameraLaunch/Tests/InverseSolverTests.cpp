@@ -0,0 +1,109 @@
+#include "TestFramework.h"
+#include "FlightPath.h"
+#include "InverseSolver.h"
+
+using namespace LaunchCore;
+
+static TargetRequest makeTargetRequest(TargetConstraint constraint, double value)
+{
+	TargetRequest request;
+	request.start = Vec3(1.0, 2.0, -3.0);
+	request.target = Vec3(21.0, 0.5, 9.0);
+	request.constraint = constraint;
+	request.value = value;
+	return request;
+}
+
+TEST_CASE(flightTimeSolveHitsTarget)
+{
+	TargetRequest request = makeTargetRequest(TargetConstraint::FLIGHT_TIME, 2.5);
+	TargetSolution solution = solveTarget(request, -9.81);
+	CHECK(solution.solved);
+	CHECK_NEAR(solution.flightTime, 2.5, 1e-12);
+
+	LaunchParams params;
+	params.startPosition = request.start;
+	params.velocity = solution.velocity;
+	Vec3 end = positionAtTime(params, 2.5);
+	CHECK_NEAR(end.x, request.target.x, 1e-9);
+	CHECK_NEAR(end.y, request.target.y, 1e-9);
+	CHECK_NEAR(end.z, request.target.z, 1e-9);
+}
+
+TEST_CASE(apexHeightSolveReachesApexAndTarget)
+{
+	TargetRequest request = makeTargetRequest(TargetConstraint::APEX_HEIGHT, 6.0);
+	TargetSolution solution = solveTarget(request, -9.81);
+	CHECK(solution.solved);
+
+	LaunchParams params;
+	params.startPosition = request.start;
+	params.velocity = solution.velocity;
+	Vec3 apex = positionAtTime(params, timeToApex(params));
+	CHECK_NEAR(apex.y, request.start.y + 6.0, 1e-9);
+
+	Vec3 end = positionAtTime(params, solution.flightTime);
+	CHECK_NEAR(end.x, request.target.x, 1e-9);
+	CHECK_NEAR(end.y, request.target.y, 1e-9);
+	CHECK_NEAR(end.z, request.target.z, 1e-9);
+
+	// The apex can never sit below the target
+	request.value = -2.0;
+	CHECK(!solveTarget(request, -9.81).solved);
+}
+
+TEST_CASE(dragSolveConvergesForBothConstraints)
+{
+	DragParams drag;
+	drag.linear = 0.05;
+	drag.quadratic = 0.02;
+
+	TargetSolverSettings settings;
+	settings.tolerance = 1e-6;
+
+	TargetRequest timed = makeTargetRequest(TargetConstraint::FLIGHT_TIME, 2.5);
+	TargetSolution timedSolution = solveTarget(timed, -9.81, drag, settings);
+	CHECK(timedSolution.solved);
+	CHECK(timedSolution.iterations > 0);
+
+	// The solved launch followed through the flight sampler ends on the target
+	LaunchParams params;
+	params.startPosition = timed.start;
+	params.velocity = timedSolution.velocity;
+	params.flightTime = timedSolution.flightTime;
+	FlightOptions options;
+	options.drag = drag;
+	TrajectorySamples samples;
+	sampleFlight(params, options, samples);
+	size_t last = samples.size() - 1;
+	CHECK_NEAR(samples.translateX[last], timed.target.x, 1e-4);
+	CHECK_NEAR(samples.translateY[last], timed.target.y, 1e-4);
+	CHECK_NEAR(samples.translateZ[last], timed.target.z, 1e-4);
+
+	TargetRequest arced = makeTargetRequest(TargetConstraint::APEX_HEIGHT, 6.0);
+	TargetSolution arcedSolution = solveTarget(arced, -9.81, drag, settings);
+	CHECK(arcedSolution.solved);
+	CHECK(arcedSolution.error < 1e-5);
+}
+
+TEST_CASE(batchSolveMatchesSingleSolves)
+{
+	std::vector<TargetRequest> requests;
+	for (int i = 0; i < 2000; ++i) {
+		TargetRequest request = makeTargetRequest((i % 2) ? TargetConstraint::APEX_HEIGHT : TargetConstraint::FLIGHT_TIME, 1.0 + 0.01 * i);
+		request.target = Vec3(0.1 * i, -1.0 + 0.001 * i, 5.0);
+		requests.push_back(request);
+	}
+
+	std::vector<TargetSolution> solutions;
+	solveTargets(requests, -9.81, DragParams(), TargetSolverSettings(), solutions);
+	CHECK(solutions.size() == requests.size());
+
+	bool allMatch = true;
+	for (size_t i = 0; i < requests.size(); ++i) {
+		TargetSolution single = solveTarget(requests[i], -9.81);
+		allMatch = allMatch && solutions[i].solved == single.solved
+			&& (solutions[i].velocity - single.velocity).length() == 0.0;
+	}
+	CHECK(allMatch);
+}
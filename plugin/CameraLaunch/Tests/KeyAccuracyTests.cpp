@@ -0,0 +1,94 @@
+#include "TestFramework.h"
+#include "BounceChain.h"
+#include "KeyAccuracy.h"
+
+using namespace LaunchCore;
+
+TEST_CASE(threeKeyCurvesMatchTheArcExactly)
+{
+	const Vec3 velocities[] = { Vec3(4.0, 10.0, -2.0), Vec3(-7.5, 3.3, 1.0), Vec3(0.0, 21.7, 0.0), Vec3(2.0, -1.0, 5.0) };
+	const double rates[] = { 24.0, 30.0, 29.97 };
+
+	for (const Vec3& velocity : velocities) {
+		for (double fps : rates) {
+			LaunchParams params;
+			params.startPosition = Vec3(1.0, 3.0, -2.0);
+			params.velocity = velocity;
+			params.startFrame = 7;
+			params.framesPerSecond = fps;
+
+			std::vector<ParabolicKey> keys = calculateParabolicKeys(params);
+			CHECK(keys.size() == 3);
+
+			KeyDeviation deviation = measureKeyDeviation(keys, params, 16);
+			CHECK(deviation.evaluations > 16);
+			CHECK(deviation.translate < 1e-9);
+		}
+	}
+}
+
+TEST_CASE(apexKeyStaysOnItsFractionalFrame)
+{
+	LaunchParams params;
+	params.velocity = Vec3(1.0, 10.0, 0.0);
+	params.startFrame = 3;
+
+	std::vector<ParabolicKey> keys = calculateParabolicKeys(params);
+	double apex = 3.0 + 10.0 / 9.81 * 24.0;
+	CHECK_NEAR(apexFrame(params), apex, 1e-9);
+	CHECK_NEAR(keys[1].frame, apex, 1e-9);
+	CHECK(std::fabs(keys[1].frame - std::round(keys[1].frame)) > 0.1);
+	CHECK_NEAR(keys[1].inSlope.y, 0.0, 1e-12);
+	CHECK_NEAR(keys[1].position.y, 100.0 / (2.0 * 9.81), 1e-9);
+
+	// Handles are a third of the time to each neighbour
+	CHECK_NEAR(keys[1].inWeight, (keys[1].frame - keys[0].frame) / 3.0, 1e-12);
+	CHECK_NEAR(keys[1].outWeight, (keys[2].frame - keys[1].frame) / 3.0, 1e-12);
+}
+
+TEST_CASE(harnessCatchesUnitWeights)
+{
+	LaunchParams params;
+	params.velocity = Vec3(3.0, 12.0, 0.0);
+
+	// The old fixed weight of one frame bends the arc away from the parabola
+	std::vector<ParabolicKey> keys = calculateParabolicKeys(params);
+	for (ParabolicKey& key : keys) {
+		key.inWeight = key.outWeight = 1.0;
+	}
+
+	KeyDeviation deviation = measureKeyDeviation(keys, params, 8);
+	CHECK(deviation.translate > 0.1);
+	CHECK(deviation.translateFrame > keys.front().frame);
+	CHECK(deviation.translateFrame < keys.back().frame);
+}
+
+TEST_CASE(bounceKeysMatchTheChainExactly)
+{
+	LaunchParams params;
+	params.velocity = Vec3(2.0, 9.0, 1.0);
+	params.startFrame = 12;
+
+	BounceSettings settings;
+	settings.bounces = 3;
+	settings.restitution = 0.55;
+	settings.friction = 0.3;
+
+	std::vector<FlightSegment> segments;
+	chainBounces(params, settings, nullptr, 1.0, segments);
+
+	std::vector<ParabolicKey> keys;
+	buildBounceKeys(params, segments, keys);
+
+	PoseFunction chain = [&](double frame, Vec3& position, Euler& rotation) {
+		double t = (frame - params.startFrame) / params.framesPerSecond;
+		size_t s = 0;
+		while (s + 1 < segments.size() && t > segments[s].startTime + segments[s].duration) ++s;
+		t -= segments[s].startTime;
+		position = positionAtTime(segments[s].params, t);
+		rotation = lookAlongVelocity(velocityAtTime(segments[s].params, t), keys.front().rotation.y);
+	};
+
+	KeyDeviation deviation = measureKeyDeviation(keys, chain, 16);
+	CHECK(deviation.translate < 1e-9);
+}
@@ -0,0 +1,83 @@
+#include "TestFramework.h"
+#include "DragIntegrator.h"
+#include "KeyReducer.h"
+
+#include <algorithm>
+
+using namespace LaunchCore;
+
+static double maxReductionError(const std::vector<ReducedKey>& keys, const std::vector<double>& frames, const std::vector<double>& values)
+{
+	double maxError = 0.0;
+	for (size_t i = 0; i < frames.size(); ++i) {
+		maxError = std::max(maxError, std::fabs(evaluateKeys(keys, frames[i]) - values[i]));
+	}
+	return maxError;
+}
+
+TEST_CASE(parabolaReducesToTwoKeys)
+{
+	LaunchParams params;
+	params.velocity = Vec3(3.0, 12.0, 0.0);
+
+	TrajectorySamples samples;
+	sampleTrajectory(params, 1.0, samples);
+
+	std::vector<ReducedKey> keys;
+	reduceKeys(samples.frames.data(), samples.translateY.data(), samples.size(), 1e-6, keys);
+	CHECK(keys.size() == 2);
+	CHECK_NEAR(keys.front().frame, samples.frames.front(), 1e-12);
+	CHECK_NEAR(keys.back().frame, samples.frames.back(), 1e-12);
+	CHECK(maxReductionError(keys, samples.frames, samples.translateY) <= 1e-6);
+}
+
+TEST_CASE(dragFlightStaysWithinTolerance)
+{
+	LaunchParams params;
+	params.startPosition = Vec3(0.0, 1.0, 0.0);
+	params.velocity = Vec3(20.0, 25.0, -4.0);
+
+	DragParams drag;
+	drag.linear = 0.1;
+	drag.quadratic = 0.05;
+
+	TrajectorySamples samples;
+	integrateFlight(params, drag, IntegratorSettings(), &samples);
+
+	const double tolerance = 1e-3;
+	const std::vector<double>* channels[] = { &samples.translateX, &samples.translateY, &samples.translateZ, &samples.rotateX };
+	for (const std::vector<double>* channel : channels) {
+		std::vector<ReducedKey> keys;
+		reduceKeys(samples.frames.data(), channel->data(), samples.size(), tolerance, keys);
+		CHECK(keys.size() >= 2);
+		CHECK(keys.size() * 4 < samples.size());
+		CHECK(maxReductionError(keys, samples.frames, *channel) <= tolerance);
+
+		// Handles never overshoot their segment, so the curve stays a function of time
+		bool weightsInRange = true;
+		for (size_t i = 0; i + 1 < keys.size(); ++i) {
+			double length = keys[i + 1].frame - keys[i].frame;
+			weightsInRange = weightsInRange && keys[i].outWeight > 0.0 && keys[i].outWeight <= length
+				&& keys[i + 1].inWeight > 0.0 && keys[i + 1].inWeight <= length;
+		}
+		CHECK(weightsInRange);
+	}
+}
+
+TEST_CASE(reductionHandlesTinyInputs)
+{
+	std::vector<ReducedKey> keys;
+	double frames[] = { 4.0, 6.0 };
+	double values[] = { 1.0, 2.0 };
+
+	reduceKeys(frames, values, 0, 1e-3, keys);
+	CHECK(keys.empty());
+
+	reduceKeys(frames, values, 1, 1e-3, keys);
+	CHECK(keys.size() == 1);
+	CHECK_NEAR(evaluateKeys(keys, 10.0), 1.0, 1e-12);
+
+	reduceKeys(frames, values, 2, 1e-3, keys);
+	CHECK(keys.size() == 2);
+	CHECK_NEAR(evaluateKeys(keys, 5.0), 1.5, 1e-12);
+}
@@ -0,0 +1,45 @@
+#include "TestFramework.h"
+#include "LaunchEvaluator.h"
+#include "TrajectorySampler.h"
+
+using namespace LaunchCore;
+
+static const LaunchParams evaluatorParams = makeLaunchParams(Vec3(1.0, 0.5, 2.0), Vec3(-4.0, 11.0, 6.0), -9.81, 12, 30.0);
+
+TEST_CASE(evaluatorMatchesSampler)
+{
+	LaunchParams params = evaluatorParams;
+	LaunchEvaluator evaluator(params);
+
+	TrajectorySamples samples;
+	sampleTrajectory(params, 0.5, samples);
+
+	for (size_t i = 0; i < samples.size(); ++i) {
+		Vec3 position;
+		Euler rotation;
+		evaluator.evaluate(samples.frames[i], position, rotation);
+		CHECK_NEAR(position.x, samples.translateX[i], 1e-12);
+		CHECK_NEAR(position.y, samples.translateY[i], 1e-12);
+		CHECK_NEAR(position.z, samples.translateZ[i], 1e-12);
+		CHECK_NEAR(rotation.x, samples.rotateX[i], 1e-12);
+		CHECK_NEAR(rotation.y, samples.rotateY[i], 1e-12);
+	}
+}
+
+TEST_CASE(evaluatorHoldsOutsideFlight)
+{
+	LaunchParams params = evaluatorParams;
+	LaunchEvaluator evaluator(params);
+
+	Vec3 before, start, after, landing;
+	Euler rotation;
+	evaluator.evaluate(0.0, before, rotation);
+	evaluator.evaluate(12.0, start, rotation);
+	evaluator.evaluate(evaluator.landingFrame() + 50.0, after, rotation);
+	evaluator.evaluate(evaluator.landingFrame(), landing, rotation);
+
+	CHECK_NEAR(before.y, start.y, 1e-12);
+	CHECK_NEAR(before.x, 1.0, 1e-12);
+	CHECK_NEAR(after.x, landing.x, 1e-12);
+	CHECK_NEAR(after.y, landing.y, 1e-12);
+}
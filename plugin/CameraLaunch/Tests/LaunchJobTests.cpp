@@ -0,0 +1,99 @@
+#include "TestFramework.h"
+#include "LaunchJob.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <sstream>
+
+using namespace LaunchCore;
+
+TEST_CASE(csvJobsFillDefaults)
+{
+	std::istringstream in(
+		"camera, vx, vy, vz, gravity, startFrame\n"
+		"# comment\n"
+		"cam1, 1, 10, -2\n"
+		"\n"
+		"|rig|cam2, 0.5, 4, 0, -20, 12.5\n"
+		"cam3,1,2,3,-9.81,0,1,0,0,0,0,1,0,0,0,0,1,0,4,5,6,1\n");
+
+	std::vector<LaunchJob> jobs;
+	std::string error;
+	CHECK(parseJobsCsv(in, jobs, error));
+	CHECK(jobs.size() == 3);
+
+	CHECK(jobs[0].camera == "cam1");
+	CHECK_NEAR(jobs[0].velocity.y, 10.0, 1e-12);
+	CHECK_NEAR(jobs[0].gravity, -9.81, 1e-12);
+	CHECK_NEAR(jobs[0].startFrame, 0.0, 1e-12);
+
+	CHECK(jobs[1].camera == "|rig|cam2");
+	CHECK_NEAR(jobs[1].gravity, -20.0, 1e-12);
+	CHECK_NEAR(jobs[1].startFrame, 12.5, 1e-12);
+
+	Vec3 start = jobs[2].startPosition();
+	CHECK_NEAR(start.x, 4.0, 1e-12);
+	CHECK_NEAR(start.y, 5.0, 1e-12);
+	CHECK_NEAR(start.z, 6.0, 1e-12);
+}
+
+TEST_CASE(csvJobsReportTheBadLine)
+{
+	std::istringstream in("cam1, 1, 2, 3\ncam2, 1, x, 3\n");
+
+	std::vector<LaunchJob> jobs;
+	std::string error;
+	CHECK(!parseJobsCsv(in, jobs, error));
+	CHECK(error.find("Line 2") == 0);
+}
+
+TEST_CASE(jsonJobsMatchCsvJobs)
+{
+	std::istringstream in(
+		"{ \"jobs\": [\n"
+		"  { \"camera\": \"cam1\", \"velocity\": [1, 10, -2] },\n"
+		"  { \"camera\": \"cam\\\"2\", \"velocity\": [0.5, 4e0, 0], \"gravity\": -20, \"startFrame\": 12.5,\n"
+		"    \"startMatrix\": [1,0,0,0, 0,1,0,0, 0,0,1,0, 4,5,6,1], \"note\": [true, null] }\n"
+		"] }");
+
+	std::vector<LaunchJob> jobs;
+	std::string error;
+	CHECK(parseJobsJson(in, jobs, error));
+	CHECK(jobs.size() == 2);
+	CHECK(jobs[0].camera == "cam1");
+	CHECK_NEAR(jobs[0].velocity.z, -2.0, 1e-12);
+	CHECK(jobs[1].camera == "cam\"2");
+	CHECK_NEAR(jobs[1].velocity.y, 4.0, 1e-12);
+	CHECK_NEAR(jobs[1].startFrame, 12.5, 1e-12);
+
+	LaunchParams params = jobs[1].launchParams(30.0);
+	CHECK_NEAR(params.startPosition.z, 6.0, 1e-12);
+	CHECK_NEAR(params.gravity, -20.0, 1e-12);
+	CHECK_NEAR(params.framesPerSecond, 30.0, 1e-12);
+
+	std::istringstream bad("[ { \"camera\": \"cam1\", \"velocity\": [1, 2] } ]");
+	CHECK(!parseJobsJson(bad, jobs, error));
+	CHECK(error.find("velocity") != std::string::npos);
+
+	std::istringstream broken("[ { \"camera\": ");
+	CHECK(!parseJobsJson(broken, jobs, error));
+}
+
+TEST_CASE(threadPoolRunsEveryTask)
+{
+	std::atomic<int> sum(0);
+	{
+		ThreadPool pool(4);
+		CHECK(pool.threadCount() == 4);
+		for (int i = 1; i <= 1000; ++i) {
+			pool.submit([&sum, i]() { sum += i; });
+		}
+		pool.wait();
+		CHECK(sum == 500500);
+
+		// The pool is reusable after a wait
+		pool.submit([&sum]() { sum += 1; });
+		pool.wait();
+	}
+	CHECK(sum == 500501);
+}
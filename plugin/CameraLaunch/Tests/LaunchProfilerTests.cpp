@@ -0,0 +1,73 @@
+#include "TestFramework.h"
+#include "LaunchProfiler.h"
+
+using namespace LaunchCore;
+
+TEST_CASE(phasesAccumulateByName)
+{
+	ProfileRecord record;
+	record.addPhase("clearCurves", 1.5);
+	record.addPhase("generateKeyframes", 2.0);
+	record.addPhase("clearCurves", 0.5);
+
+	CHECK(record.phases.size() == 2);
+	CHECK(record.phases[0].name == "clearCurves");
+	CHECK_NEAR(record.phaseMilliseconds("clearCurves"), 2.0, 1e-12);
+	CHECK_NEAR(record.phaseMilliseconds("missing"), 0.0, 1e-12);
+
+	{
+		ScopedPhase phase(&record, "refresh");
+	}
+	CHECK(record.phases.size() == 3);
+	CHECK(record.phaseMilliseconds("refresh") >= 0.0);
+
+	// A null record is a no-op
+	{
+		ScopedPhase phase(nullptr, "refresh");
+	}
+	CHECK(record.phases.size() == 3);
+}
+
+TEST_CASE(recordSerializesToJson)
+{
+	ProfileRecord record;
+	record.command = "redoIt";
+	record.totalMilliseconds = 3.25;
+	record.addPhase("generateKeyframes", 3.0);
+	record.keysWritten = 15;
+	record.curvesCreated = 5;
+	record.curvesReused = 2;
+
+	std::string json = record.toJson();
+	CHECK(json.find("\"command\":\"redoIt\"") != std::string::npos);
+	CHECK(json.find("\"totalMs\":3.250000") != std::string::npos);
+	CHECK(json.find("{\"name\":\"generateKeyframes\",\"ms\":3.000000}") != std::string::npos);
+	CHECK(json.find("\"keysWritten\":15") != std::string::npos);
+	CHECK(json.find("\"curvesCreated\":5") != std::string::npos);
+	CHECK(json.find("\"curvesReused\":2") != std::string::npos);
+	CHECK(json.front() == '{' && json.back() == '}');
+}
+
+TEST_CASE(historyKeepsMostRecentRecords)
+{
+	ProfileHistory history(3);
+	for (int i = 0; i < 5; ++i) {
+		ProfileRecord record;
+		record.command = "redoIt";
+		record.cameras = (size_t)i;
+		history.push(record);
+	}
+
+	std::vector<ProfileRecord> records = history.records();
+	CHECK(records.size() == 3);
+	CHECK(records[0].cameras == 2);
+	CHECK(records[1].cameras == 3);
+	CHECK(records[2].cameras == 4);
+
+	std::string json = history.toJson();
+	CHECK(json.front() == '[' && json.back() == ']');
+
+	history.clear();
+	CHECK(history.records().empty());
+	CHECK(history.toJson() == "[]");
+}
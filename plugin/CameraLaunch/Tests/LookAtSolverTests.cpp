@@ -0,0 +1,131 @@
+#include "TestFramework.h"
+#include "LookAtSolver.h"
+
+#include <algorithm>
+
+using namespace LaunchCore;
+
+// Target turned a quarter turn about Y, driving along X one unit per frame
+static void targetMatrix(double frame, double matrix[16])
+{
+	const double rows[16] = {
+		0.0, 0.0, -1.0, 0.0,
+		0.0, 1.0, 0.0, 0.0,
+		1.0, 0.0, 0.0, 0.0,
+		frame, 2.0, -20.0, 1.0
+	};
+	std::copy(rows, rows + 16, matrix);
+}
+
+static void cacheTarget(ParentMatrices& target, const TrajectoryView& flight, double x, double y, double z, bool moving)
+{
+	std::vector<double> frames;
+	target.missingFrames(flight.frames, flight.count, frames);
+
+	std::vector<double> matrices(frames.size() * 16);
+	for (size_t i = 0; i < frames.size(); ++i) {
+		double* matrix = &matrices[i * 16];
+		if (moving) {
+			targetMatrix(frames[i], matrix);
+		}
+		else {
+			const double rows[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, x, y, z, 1 };
+			std::copy(rows, rows + 16, matrix);
+		}
+	}
+	target.insert(frames, matrices);
+}
+
+// Camera axis 'column' (0 right, 1 up, 2 backwards) of a sample
+static Vec3 cameraAxis(const OrientationSamples& orientation, size_t n, RotateOrder order, int column)
+{
+	Euler euler;
+	euler.x = orientation.rotateX[n];
+	euler.y = orientation.rotateY[n];
+	euler.z = orientation.rotateZ[n];
+	double m[3][3];
+	eulerToMatrix(euler, order, m);
+	return Vec3(m[0][column], m[1][column], m[2][column]);
+}
+
+static TrajectoryView sampleFlight(TrajectorySamples& samples)
+{
+	LaunchParams params;
+	params.startPosition = Vec3(-5.0, 1.0, 4.0);
+	params.velocity = Vec3(6.0, 12.0, -2.0);
+	sampleTrajectory(params, 1.0, samples);
+	return viewTrajectory(samples);
+}
+
+TEST_CASE(lookAtKeepsAStillTargetDeadAhead)
+{
+	TrajectorySamples samples;
+	TrajectoryView flight = sampleFlight(samples);
+	ParentMatrices target;
+	cacheTarget(target, flight, 3.0, 0.0, -15.0, false);
+
+	LookAtSettings settings;
+	settings.rotateOrder = RotateOrder::ZXY;
+	OrientationSamples orientation;
+	solveLookAt(flight, target, nullptr, settings, orientation);
+	CHECK(orientation.size() == flight.count);
+
+	bool aimed = true, level = true, continuous = true;
+	for (size_t n = 0; n < flight.count; ++n) {
+		Vec3 toTarget = (Vec3(3.0, 0.0, -15.0) - Vec3(flight.translateX[n], flight.translateY[n], flight.translateZ[n])).normal();
+		Vec3 forward = cameraAxis(orientation, n, settings.rotateOrder, 2) * -1.0;
+		aimed = aimed && (forward - toTarget).length() < 1e-9;
+		// World up keeps the horizon level
+		level = level && std::fabs(cameraAxis(orientation, n, settings.rotateOrder, 0).y) < 1e-9;
+		if (n > 0) {
+			continuous = continuous && std::fabs(orientation.rotateY[n] - orientation.rotateY[n - 1]) < 0.5;
+		}
+	}
+	CHECK(aimed);
+	CHECK(level);
+	CHECK(continuous);
+}
+
+TEST_CASE(lookAtFollowsAMovingTargetAndItsFramingOffset)
+{
+	TrajectorySamples samples;
+	TrajectoryView flight = sampleFlight(samples);
+	ParentMatrices target;
+	cacheTarget(target, flight, 0.0, 0.0, 0.0, true);
+
+	// One unit along the target's own X, which the target's turn points down world -Z
+	LookAtSettings settings;
+	settings.offset = Vec3(1.0, 0.0, 0.0);
+	OrientationSamples orientation;
+	solveLookAt(flight, target, nullptr, settings, orientation);
+
+	bool aimed = true;
+	for (size_t n = 0; n < flight.count; ++n) {
+		Vec3 aimPoint(flight.frames[n], 2.0, -21.0);
+		Vec3 toTarget = (aimPoint - Vec3(flight.translateX[n], flight.translateY[n], flight.translateZ[n])).normal();
+		Vec3 forward = cameraAxis(orientation, n, settings.rotateOrder, 2) * -1.0;
+		aimed = aimed && (forward - toTarget).length() < 1e-9;
+	}
+	CHECK(aimed);
+}
+
+TEST_CASE(lookAtUpObjectRollsTheCameraTowardsIt)
+{
+	TrajectorySamples samples;
+	TrajectoryView flight = sampleFlight(samples);
+	ParentMatrices target, upObject;
+	cacheTarget(target, flight, 0.0, 5.0, -200.0, false);
+	cacheTarget(upObject, flight, 1000.0, 5.0, 0.0, false);
+
+	LookAtSettings settings;
+	OrientationSamples orientation;
+	solveLookAt(flight, target, &upObject, settings, orientation);
+
+	// Looking down -Z with the up object far off along +X puts the camera's up along +X
+	bool rolled = true;
+	for (size_t n = 0; n < flight.count; ++n) {
+		rolled = rolled && cameraAxis(orientation, n, settings.rotateOrder, 1).x > 0.95;
+	}
+	CHECK(rolled);
+	CHECK(std::fabs(orientation.rotateZ[0]) > 1.0);
+}
@@ -0,0 +1,127 @@
+#include "TestFramework.h"
+#include "OrientationSolver.h"
+
+using namespace LaunchCore;
+
+static double matrixDifference(const double a[3][3], const double b[3][3])
+{
+	double difference = 0.0;
+	for (int row = 0; row < 3; ++row) {
+		for (int col = 0; col < 3; ++col) {
+			difference = std::max(difference, std::fabs(a[row][col] - b[row][col]));
+		}
+	}
+	return difference;
+}
+
+TEST_CASE(eulerRoundTripsInEveryOrder)
+{
+	const RotateOrder orders[] = { RotateOrder::XYZ, RotateOrder::YZX, RotateOrder::ZXY,
+		RotateOrder::XZY, RotateOrder::YXZ, RotateOrder::ZYX };
+	const Euler angles[] = { Euler(0.3, -1.1, 2.4), Euler(-2.0, 0.7, -0.2), Euler(0.5, 1.5707963267948966, 0.25) };
+
+	bool allMatch = true;
+	for (RotateOrder order : orders) {
+		for (const Euler& euler : angles) {
+			double m[3][3], back[3][3];
+			eulerToMatrix(euler, order, m);
+			eulerToMatrix(matrixToEuler(m, order), order, back);
+			allMatch = allMatch && matrixDifference(m, back) < 1e-9;
+		}
+	}
+	CHECK(allMatch);
+}
+
+TEST_CASE(levelFlightMatchesSamplerPitchAndYaw)
+{
+	LaunchParams params;
+	params.velocity = Vec3(-6.0, 12.0, 4.0);
+
+	TrajectorySamples samples;
+	sampleTrajectory(params, 1.0, samples);
+
+	OrientationSettings settings;
+	OrientationSamples orientation;
+	solveOrientations(samples, settings, orientation);
+	CHECK(orientation.size() == samples.size());
+
+	const double twoPi = 8.0 * std::atan(1.0);
+	for (size_t i = 0; i < samples.size(); ++i) {
+		CHECK_NEAR(orientation.rotateX[i], samples.rotateX[i], 1e-9);
+		double yaw = orientation.rotateY[i] - samples.rotateY[i];
+		CHECK_NEAR(yaw - twoPi * std::round(yaw / twoPi), 0.0, 1e-9);
+		CHECK_NEAR(orientation.rotateZ[i], 0.0, 1e-9);
+	}
+}
+
+TEST_CASE(orientationStaysContinuous)
+{
+	// A spiral keeps turning, so yaw has to keep unwinding past a full turn
+	TrajectorySamples samples;
+	for (int i = 0; i <= 240; ++i) {
+		double t = i * 0.05;
+		samples.frames.push_back((double)i);
+		samples.translateX.push_back(10.0 * std::cos(t));
+		samples.translateY.push_back(0.5 * t);
+		samples.translateZ.push_back(10.0 * std::sin(t));
+	}
+	samples.rotateX.resize(samples.size());
+	samples.rotateY.resize(samples.size());
+
+	OrientationSettings settings;
+	settings.banking = 1.0;
+	settings.rotateOrder = RotateOrder::ZXY;
+	OrientationSamples orientation;
+	solveOrientations(samples, settings, orientation);
+
+	double maxStep = 0.0;
+	double quaternionDot = 1.0;
+	for (size_t i = 1; i < orientation.size(); ++i) {
+		maxStep = std::max(maxStep, std::fabs(orientation.rotateX[i] - orientation.rotateX[i - 1]));
+		maxStep = std::max(maxStep, std::fabs(orientation.rotateY[i] - orientation.rotateY[i - 1]));
+		maxStep = std::max(maxStep, std::fabs(orientation.rotateZ[i] - orientation.rotateZ[i - 1]));
+
+		const Quaternion& a = orientation.rotations[i - 1];
+		const Quaternion& b = orientation.rotations[i];
+		quaternionDot = std::min(quaternionDot, a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+	}
+	CHECK(maxStep < 0.1);
+	CHECK(quaternionDot > 0.0);
+	CHECK(std::fabs(orientation.rotateY.back() - orientation.rotateY.front()) > 8.0);
+
+	// Turning left around the spiral banks the camera into the turn
+	CHECK(std::fabs(orientation.rotateZ[120]) > 0.1);
+
+	// The camera looks along the path
+	double m[3][3];
+	size_t i = 100;
+	eulerToMatrix(Euler(orientation.rotateX[i], orientation.rotateY[i], orientation.rotateZ[i]), settings.rotateOrder, m);
+	Vec3 forward(-m[0][2], -m[1][2], -m[2][2]);
+	Vec3 tangent = Vec3(samples.translateX[i + 1] - samples.translateX[i - 1],
+		samples.translateY[i + 1] - samples.translateY[i - 1],
+		samples.translateZ[i + 1] - samples.translateZ[i - 1]).normal();
+	CHECK(forward.dot(tangent) > 0.999);
+}
+
+TEST_CASE(verticalLaunchKeepsAUsableFrame)
+{
+	LaunchParams params;
+	params.velocity = Vec3(0.0, 10.0, 0.0);
+
+	TrajectorySamples samples;
+	sampleTrajectory(params, 1.0, samples);
+
+	OrientationSamples orientation;
+	solveOrientations(samples, OrientationSettings(), orientation);
+
+	bool finite = true;
+	for (size_t i = 0; i < orientation.size(); ++i) {
+		finite = finite && std::isfinite(orientation.rotateX[i]) && std::isfinite(orientation.rotateY[i]) && std::isfinite(orientation.rotateZ[i]);
+	}
+	CHECK(finite);
+
+	// Looking straight up at launch
+	double m[3][3];
+	eulerToMatrix(Euler(orientation.rotateX[0], orientation.rotateY[0], orientation.rotateZ[0]), RotateOrder::XYZ, m);
+	CHECK_NEAR(-m[1][2], 1.0, 1e-9);
+}
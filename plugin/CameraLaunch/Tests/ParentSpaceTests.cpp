@@ -0,0 +1,171 @@
+#include "TestFramework.h"
+#include "ParentSpace.h"
+#include "TrajectorySampler.h"
+
+#include <algorithm>
+
+using namespace LaunchCore;
+
+// Parent turning about Y by 'yaw' radians per frame while driving along X, scaled by 2
+static void vehicleMatrix(double frame, double yaw, double matrix[16])
+{
+	double angle = yaw * frame;
+	double c = std::cos(angle), s = std::sin(angle);
+	const double rows[16] = {
+		2.0 * c, 0.0, -2.0 * s, 0.0,
+		0.0, 2.0, 0.0, 0.0,
+		2.0 * s, 0.0, 2.0 * c, 0.0,
+		3.0 * frame, 1.0, -4.0, 1.0
+	};
+	std::copy(rows, rows + 16, matrix);
+}
+
+static void cacheVehicle(ParentMatrices& parent, const double* frames, size_t count, double yaw)
+{
+	std::vector<double> missing;
+	parent.missingFrames(frames, count, missing);
+
+	std::vector<double> matrices(missing.size() * 16);
+	for (size_t i = 0; i < missing.size(); ++i) {
+		vehicleMatrix(missing[i], yaw, &matrices[i * 16]);
+	}
+	parent.insert(missing, matrices);
+}
+
+TEST_CASE(parentMatricesAreEvaluatedOncePerFrame)
+{
+	ParentMatrices parent;
+	const double first[] = { 4.0, 1.0, 2.0, 1.0 };
+	cacheVehicle(parent, first, 4, 0.0);
+	CHECK(parent.size() == 3);
+
+	// Only frames not seen before are missing, and the cache stays in frame order
+	const double second[] = { 2.0, 3.0, 0.5, 4.0 };
+	std::vector<double> missing;
+	parent.missingFrames(second, 4, missing);
+	CHECK(missing.size() == 2);
+	CHECK(missing[0] == 0.5);
+	CHECK(missing[1] == 3.0);
+
+	cacheVehicle(parent, second, 4, 0.0);
+	CHECK(parent.size() == 5);
+	CHECK(std::is_sorted(parent.frames().begin(), parent.frames().end()));
+	CHECK(parent.find(3.0) != nullptr);
+	CHECK(parent.find(3.0)[12] == 9.0);
+	CHECK(parent.find(3.5) == nullptr);
+}
+
+TEST_CASE(parentSpaceRoundTripsThroughTheParentMatrix)
+{
+	LaunchParams params;
+	params.startPosition = Vec3(2.0, 5.0, 1.0);
+	params.velocity = Vec3(4.0, 12.0, -3.0);
+
+	TrajectorySamples samples;
+	sampleTrajectory(params, 1.0, samples);
+	TrajectoryView world = viewTrajectory(samples);
+
+	ParentMatrices parent;
+	cacheVehicle(parent, world.frames, world.count, 0.05);
+
+	LocalTrajectory local;
+	toParentSpace(world, parent, RotateOrder::XYZ, local);
+	CHECK(local.view().count == world.count);
+
+	for (size_t i = 0; i < world.count; ++i) {
+		const double* matrix = parent.find(world.frames[i]);
+		Vec3 back = transformPoint(matrix, Vec3(local.translateX[i], local.translateY[i], local.translateZ[i]));
+		CHECK_NEAR(back.x, world.translateX[i], 1e-9);
+		CHECK_NEAR(back.y, world.translateY[i], 1e-9);
+		CHECK_NEAR(back.z, world.translateZ[i], 1e-9);
+
+		// The parent's rotation composed with the local one gives the world rotation back
+		double worldRotation[3][3], localRotation[3][3];
+		Euler worldEuler, localEuler;
+		worldEuler.x = world.rotateX[i];
+		worldEuler.y = world.rotateY[i];
+		localEuler.x = local.rotateX[i];
+		localEuler.y = local.rotateY[i];
+		localEuler.z = local.rotateZ[i];
+		eulerToMatrix(worldEuler, RotateOrder::XYZ, worldRotation);
+		eulerToMatrix(localEuler, RotateOrder::XYZ, localRotation);
+
+		double angle = 0.05 * world.frames[i];
+		double c = std::cos(angle), s = std::sin(angle);
+		const double parentRotation[3][3] = { { c, 0.0, s }, { 0.0, 1.0, 0.0 }, { -s, 0.0, c } };
+		for (int row = 0; row < 3; ++row) {
+			for (int column = 0; column < 3; ++column) {
+				double composed = 0.0;
+				for (int k = 0; k < 3; ++k) {
+					composed += parentRotation[row][k] * localRotation[k][column];
+				}
+				CHECK_NEAR(composed, worldRotation[row][column], 1e-9);
+			}
+		}
+
+		// Continuous from sample to sample
+		if (i > 0) {
+			CHECK(std::fabs(local.rotateY[i] - local.rotateY[i - 1]) < 0.5);
+		}
+	}
+}
+
+TEST_CASE(reparentingKeepsTheLocalMatrix)
+{
+	// Local matrix: turned a quarter about Z and offset from the parent
+	const double local[16] = {
+		0.0, 1.0, 0.0, 0.0,
+		-1.0, 0.0, 0.0, 0.0,
+		0.0, 0.0, 1.0, 0.0,
+		1.0, 2.0, 3.0, 1.0
+	};
+
+	double now[16], then[16], world[16], expected[16], moved[16];
+	vehicleMatrix(4.0, 0.2, now);
+	vehicleMatrix(10.0, 0.2, then);
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			world[row * 4 + column] = 0.0;
+			expected[row * 4 + column] = 0.0;
+			for (int k = 0; k < 4; ++k) {
+				world[row * 4 + column] += local[row * 4 + k] * now[k * 4 + column];
+				expected[row * 4 + column] += local[row * 4 + k] * then[k * 4 + column];
+			}
+		}
+	}
+
+	reparentMatrix(world, now, then, moved);
+	for (int i = 0; i < 16; ++i) {
+		CHECK_NEAR(moved[i], expected[i], 1e-9);
+	}
+
+	// The translation is the local point carried by the new parent
+	Vec3 start = transformPoint(then, Vec3(1.0, 2.0, 3.0));
+	CHECK_NEAR(moved[12], start.x, 1e-9);
+	CHECK_NEAR(moved[13], start.y, 1e-9);
+	CHECK_NEAR(moved[14], start.z, 1e-9);
+}
+
+TEST_CASE(inheritedVelocityFollowsTheParentAtLaunch)
+{
+	ParentMatrices parent;
+	const double frames[] = { 9.0, 11.0 };
+	cacheVehicle(parent, frames, 2, 0.0);
+
+	// Driving 3 units per frame along X at 24 fps
+	Vec3 velocity = inheritedVelocity(parent, Vec3(1.0, 0.0, 0.0), 10.0, 1.0, 24.0);
+	CHECK_NEAR(velocity.x, 72.0, 1e-9);
+	CHECK_NEAR(velocity.y, 0.0, 1e-9);
+	CHECK_NEAR(velocity.z, 0.0, 1e-9);
+
+	// Frames that were never evaluated give no velocity rather than a guess
+	velocity = inheritedVelocity(parent, Vec3(), 20.0, 1.0, 24.0);
+	CHECK(velocity.length() == 0.0);
+
+	// A turning parent swings a point off its axis sideways
+	ParentMatrices turning;
+	cacheVehicle(turning, frames, 2, 0.1);
+	Vec3 swing = inheritedVelocity(turning, Vec3(0.0, 0.0, 5.0), 10.0, 1.0, 24.0);
+	Vec3 still = inheritedVelocity(turning, Vec3(), 10.0, 1.0, 24.0);
+	CHECK(std::fabs(swing.x - still.x) > 1.0);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "TrajectoryCore.h"
+
+// Minimal self-registering test harness so the core tests build without extra dependencies.
+struct TestCase {
+	const char* name;
+	std::function<void()> body;
+};
+
+std::vector<TestCase>& testRegistry();
+void reportFailure(const char* file, int line, const char* expression);
+
+// Fresh directory under the system temp directory for tests that write files; it is removed,
+// with everything in it, when this goes out of scope
+class TempDirectory
+{
+public:
+	explicit TempDirectory(const char* name);
+	~TempDirectory();
+
+	TempDirectory(const TempDirectory&) = delete;
+	TempDirectory& operator=(const TempDirectory&) = delete;
+
+	const std::filesystem::path& path() const { return m_path; }
+	// 'name' inside the directory
+	std::string file(const std::string& name) const { return (m_path / name).string(); }
+
+private:
+	std::filesystem::path m_path;
+};
+
+struct TestRegistrar {
+	TestRegistrar(const char* name, std::function<void()> body)
+	{
+		testRegistry().push_back({ name, body });
+	}
+};
+
+#define TEST_CASE(name) \
+	static void name(); \
+	static TestRegistrar name##_registrar(#name, name); \
+	static void name()
+
+#define CHECK(expr) \
+	do { if (!(expr)) reportFailure(__FILE__, __LINE__, #expr); } while (0)
+
+#define CHECK_NEAR(a, b, tolerance) \
+	do { if (!(std::fabs((a) - (b)) <= (tolerance))) reportFailure(__FILE__, __LINE__, #a " ~= " #b); } while (0)
+
+// Launch shared by the core tests; each test only spells out the values it depends on
+inline LaunchCore::LaunchParams makeLaunchParams(const LaunchCore::Vec3& start, const LaunchCore::Vec3& velocity,
+	double gravity, double startFrame, double fps)
+{
+	LaunchCore::LaunchParams params;
+	params.startPosition = start;
+	params.velocity = velocity;
+	params.gravity = gravity;
+	params.startFrame = startFrame;
+	params.framesPerSecond = fps;
+	return params;
+}
@@ -0,0 +1,50 @@
+#include "TestFramework.h"
+
+#include <chrono>
+
+static int s_failures = 0;
+
+std::vector<TestCase>& testRegistry()
+{
+	static std::vector<TestCase> registry;
+	return registry;
+}
+
+void reportFailure(const char* file, int line, const char* expression)
+{
+	std::cerr << file << "(" << line << "): check failed: " << expression << std::endl;
+	++s_failures;
+}
+
+TempDirectory::TempDirectory(const char* name)
+{
+	// The clock keeps runs started side by side from sharing a directory
+	long long stamp = (long long)std::chrono::steady_clock::now().time_since_epoch().count();
+	m_path = std::filesystem::temp_directory_path() / ("CameraLaunchTests_" + std::string(name) + "_" + std::to_string(stamp));
+	std::filesystem::create_directories(m_path);
+}
+
+TempDirectory::~TempDirectory()
+{
+	std::error_code error;
+	std::filesystem::remove_all(m_path, error);
+}
+
+int main()
+{
+	int failedTests = 0;
+
+	for (const TestCase& test : testRegistry()) {
+		int failuresBefore = s_failures;
+		test.body();
+
+		bool passed = (s_failures == failuresBefore);
+		if (!passed) {
+			++failedTests;
+		}
+		std::cout << (passed ? "[PASS] " : "[FAIL] ") << test.name << std::endl;
+	}
+
+	std::cout << testRegistry().size() - failedTests << "/" << testRegistry().size() << " tests passed" << std::endl;
+	return (failedTests == 0) ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+#include "TestFramework.h"
+#include "TimeBase.h"
+#include "TrajectorySampler.h"
+
+using namespace LaunchCore;
+
+TEST_CASE(timeBaseConvertsBothWays)
+{
+	TimeBase timeBase(30.0);
+	CHECK_NEAR(timeBase.secondsPerFrame(), 1.0 / 30.0, 1e-15);
+	CHECK_NEAR(timeBase.toSeconds(45.0), 1.5, 1e-12);
+	CHECK_NEAR(timeBase.toFrames(1.5), 45.0, 1e-12);
+	CHECK_NEAR(timeBase.toFrames(timeBase.toSeconds(12.375)), 12.375, 1e-12);
+	CHECK(timeBase.samplesPerFrame() == 1);
+
+	// Anything below one sample per frame falls back to one
+	CHECK(TimeBase(24.0, 0).samplesPerFrame() == 1);
+}
+
+TEST_CASE(samplesPerFrameSplitsTheBakeStep)
+{
+	TimeBase timeBase(24.0, 4);
+	CHECK_NEAR(timeBase.sampleStep(1.0), 0.25, 1e-15);
+	CHECK_NEAR(timeBase.sampleStep(2.0), 0.5, 1e-15);
+
+	LaunchParams params;
+	params.velocity = Vec3(3.0, 8.0, 0.0);
+	params.startFrame = 10.5;
+	params.framesPerSecond = timeBase.framesPerSecond();
+
+	TrajectorySamples coarse, fine;
+	sampleTrajectory(params, TimeBase(24.0).sampleStep(1.0), coarse);
+	sampleTrajectory(params, timeBase.sampleStep(1.0), fine);
+
+	// Same flight, four samples to every frame, all on the launch's own (fractional) grid, and
+	// both end on the same sub-frame touchdown
+	CHECK(fine.size() == 4 * (coarse.size() - 2) + 2);
+	CHECK_NEAR(fine.frames.front(), 10.5, 1e-12);
+	CHECK_NEAR(fine.frames.back(), coarse.frames.back(), 1e-12);
+	CHECK_NEAR(fine.translateY.back(), coarse.translateY.back(), 1e-9);
+	for (size_t i = 0; i + 1 < coarse.size(); ++i) {
+		CHECK_NEAR(fine.frames[4 * i], coarse.frames[i], 1e-9);
+		CHECK_NEAR(fine.translateY[4 * i], coarse.translateY[i], 1e-9);
+	}
+
+	Vec3 between = positionAtTime(params, timeBase.toSeconds(fine.frames[1] - params.startFrame));
+	CHECK_NEAR(fine.translateY[1], between.y, 1e-12);
+}
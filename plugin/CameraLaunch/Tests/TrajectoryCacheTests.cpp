@@ -0,0 +1,173 @@
+#include "TestFramework.h"
+#include "TrajectoryCache.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+using namespace LaunchCore;
+
+static TrajectorySamples makeCacheSamples()
+{
+	LaunchParams params;
+	params.velocity = Vec3(3.0, 9.0, -1.0);
+	params.startFrame = 4.5;
+
+	TrajectorySamples samples;
+	sampleTrajectory(params, 0.5, samples);
+	return samples;
+}
+
+TEST_CASE(cacheRoundTripsThroughMapping)
+{
+	TempDirectory directory("roundTrip");
+	TrajectorySamples samples = makeCacheSamples();
+	std::string path = directory.file("roundTrip.cltraj");
+
+	std::string error;
+	CHECK(writeTrajectoryCache(path, 0x1234abcdull, 24.0, viewTrajectory(samples), &error));
+
+	MappedTrajectoryCache cache;
+	CHECK(cache.open(path, &error));
+	CHECK(cache.key() == 0x1234abcdull);
+	CHECK_NEAR(cache.framesPerSecond(), 24.0, 0.0);
+
+	const TrajectoryView& view = cache.trajectory();
+	CHECK(view.count == samples.size());
+	for (size_t i = 0; i < view.count; ++i) {
+		CHECK(view.frames[i] == samples.frames[i]);
+		CHECK(view.translateY[i] == samples.translateY[i]);
+		CHECK(view.rotateX[i] == samples.rotateX[i]);
+		CHECK(view.rotateZ[i] == 0.0);
+	}
+
+	// Every channel starts on a 64 byte boundary of the mapping
+	CHECK(reinterpret_cast<uintptr_t>(view.frames) % 64 == 0);
+	CHECK(reinterpret_cast<uintptr_t>(view.rotateZ) % 64 == 0);
+
+	cache.close();
+	CHECK(!cache.isOpen());
+}
+
+TEST_CASE(cacheRejectsForeignAndTruncatedFiles)
+{
+	TempDirectory directory("rejects");
+	std::string path = directory.file("rejects.cltraj");
+	MappedTrajectoryCache cache;
+	std::string error;
+
+	CHECK(!cache.open(directory.file("missing.cltraj"), &error));
+
+	{
+		std::ofstream out(path, std::ios::binary);
+		out << std::string(128, 'x');
+	}
+	CHECK(!cache.open(path, &error));
+	CHECK(error.find("not a trajectory cache") != std::string::npos);
+
+	// A valid header over channels that were cut short
+	TrajectorySamples samples = makeCacheSamples();
+	CHECK(writeTrajectoryCache(path, 1, 24.0, viewTrajectory(samples)));
+	std::string bytes;
+	{
+		std::ifstream in(path, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), (std::streamsize)(bytes.size() - 8));
+	}
+	CHECK(!cache.open(path, &error));
+	CHECK(error.find("truncated") != std::string::npos);
+
+	// A count whose byte size wraps around to a zero stride
+	{
+		std::string header = bytes.substr(0, 64);
+		uint64_t count = 1ull << 61;
+		uint64_t stride = 0;
+		std::memcpy(&header[24], &count, sizeof(count));
+		std::memcpy(&header[40], &stride, sizeof(stride));
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(header.data(), (std::streamsize)header.size());
+		out.write(bytes.data() + 64, (std::streamsize)(bytes.size() - 64));
+	}
+	CHECK(!cache.open(path, &error));
+	CHECK(error.find("truncated") != std::string::npos);
+}
+
+TEST_CASE(concurrentWritersOfOneKeyLeaveAValidCache)
+{
+	TempDirectory directory("concurrent");
+	std::string path = directory.file("shared.cltraj");
+	TrajectorySamples samples = makeCacheSamples();
+
+	// Identical launches baked side by side publish the same key at once
+	std::vector<std::thread> writers;
+	std::atomic<int> written(0);
+	for (int i = 0; i < 8; ++i) {
+		writers.emplace_back([&]() {
+			for (int j = 0; j < 20; ++j) {
+				written += writeTrajectoryCache(path, 42, 24.0, viewTrajectory(samples)) ? 1 : 0;
+			}
+		});
+	}
+	for (std::thread& writer : writers) {
+		writer.join();
+	}
+	CHECK(written == 8 * 20);
+
+	MappedTrajectoryCache cache;
+	CHECK(cache.open(path));
+	CHECK(cache.trajectory().count == samples.size());
+	cache.close();
+
+	// Nothing but the published cache is left behind
+	size_t files = 0;
+	for (const auto& entry : std::filesystem::directory_iterator(directory.path())) {
+		files += entry.is_regular_file() ? 1 : 0;
+	}
+	CHECK(files == 1);
+}
+
+TEST_CASE(cacheKeyCoversLaunchInputs)
+{
+	LaunchParams params;
+	params.velocity = Vec3(3.0, 9.0, -1.0);
+	FlightOptions options;
+
+	double matrix[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 2, 0, 5, 1 };
+	CacheKey base = flightCacheKey(params, matrix, options);
+	CHECK(base.value() == flightCacheKey(params, matrix, options).value());
+	CHECK(base.fileName().size() == 16 + 7);
+
+	LaunchParams faster = params;
+	faster.velocity.y = 9.5;
+	CHECK(flightCacheKey(faster, matrix, options).value() != base.value());
+
+	LaunchParams heavier = params;
+	heavier.gravity = -20.0;
+	CHECK(flightCacheKey(heavier, matrix, options).value() != base.value());
+
+	LaunchParams pal = params;
+	pal.framesPerSecond = 25.0;
+	CHECK(flightCacheKey(pal, matrix, options).value() != base.value());
+
+	double moved[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 2, 0, 6, 1 };
+	CHECK(flightCacheKey(params, moved, options).value() != base.value());
+
+	FlightOptions dragged = options;
+	dragged.drag.quadratic = 0.1;
+	CHECK(flightCacheKey(params, matrix, dragged).value() != base.value());
+
+	// Negative zero is the same launch
+	LaunchParams negativeZero = params;
+	negativeZero.startFrame = -0.0;
+	CHECK(flightCacheKey(negativeZero, matrix, options).value() == base.value());
+
+	CacheKey oriented = base;
+	addOrientationToKey(oriented, OrientationSettings());
+	CHECK(oriented.value() != base.value());
+}
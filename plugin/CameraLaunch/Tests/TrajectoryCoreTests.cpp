@@ -0,0 +1,80 @@
+#include "TestFramework.h"
+#include "TrajectoryCore.h"
+
+using namespace LaunchCore;
+
+TEST_CASE(apexMatchesClosedForm)
+{
+	LaunchParams params = makeLaunchParams(Vec3(1.0, 2.0, 3.0), Vec3(10.0, 10.0, 3.0), -9.81, 1, 24.0);
+	std::vector<Vec3> points = calculateTrajectory(params);
+	CHECK(points.size() == 3);
+
+	// t = vy / |g|, h = vy^2 / (2|g|)
+	double apexTime = 10.0 / 9.81;
+	CHECK_NEAR(points[1].x, 1.0 + 10.0 * apexTime, 1e-9);
+	CHECK_NEAR(points[1].y, 2.0 + 100.0 / (2.0 * 9.81), 1e-9);
+	CHECK_NEAR(points[1].z, 3.0 + 3.0 * apexTime, 1e-9);
+}
+
+TEST_CASE(landingMatchesClosedForm)
+{
+	LaunchParams params = makeLaunchParams(Vec3(0.0, 5.0, 0.0), Vec3(4.0, 12.0, -2.0), -9.81, 0, 24.0);
+	std::vector<Vec3> points = calculateTrajectory(params);
+
+	// Landing is the exact touchdown back at launch height
+	double flightTime = 2.0 * 12.0 / 9.81;
+	CHECK_NEAR(landingTime(params), flightTime, 1e-12);
+	CHECK_NEAR(points[2].x, 4.0 * flightTime, 1e-9);
+	CHECK_NEAR(points[2].y, 5.0, 1e-9);
+	CHECK_NEAR(points[2].z, -2.0 * flightTime, 1e-9);
+}
+
+TEST_CASE(keyFrameNumbersFollowStartFrame)
+{
+	LaunchParams params = makeLaunchParams(Vec3(), Vec3(0.0, 9.81, 0.0), -9.81, 10, 30.0);
+	std::vector<double> frames = getKeyFrameNumbers(params);
+	CHECK(frames.size() == 3);
+	CHECK_NEAR(frames[0], 10.0, 1e-12);
+	CHECK_NEAR(frames[1], 10.0 + 30.0, 1e-9);
+	CHECK_NEAR(frames[2], 10.0 + 60.0, 1e-9);
+}
+
+TEST_CASE(keyFrameNumbersKeepFractionalFrames)
+{
+	// The apex is 12.5 frames in; a fractional start carries through to every key
+	LaunchParams params = makeLaunchParams(Vec3(), Vec3(0.0, 9.81 * 12.5 / 24.0, 0.0), -9.81, 0, 24.0);
+	params.startFrame = 3.25;
+
+	std::vector<double> frames = getKeyFrameNumbers(params);
+	CHECK_NEAR(frames[0], 3.25, 1e-12);
+	CHECK_NEAR(frames[1], 3.25 + 12.5, 1e-9);
+	CHECK_NEAR(frames[2], 3.25 + 25.0, 1e-9);
+}
+
+TEST_CASE(flightFramesAreNotRoundedToWholeFrames)
+{
+	LaunchParams params = makeLaunchParams(Vec3(), Vec3(0.0, 5.0, 0.0), -9.81, 0, 30.0);
+	CHECK_NEAR(calculateFlightFrames(params), 2.0 * 5.0 / 9.81 * 30.0, 1e-9);
+
+	params.flightTime = 0.51;
+	CHECK_NEAR(calculateFlightFrames(params), 0.51 * 30.0, 1e-9);
+}
+
+TEST_CASE(nonReturningLaunchDefaultsTo120Frames)
+{
+	CHECK_NEAR(calculateFlightFrames(makeLaunchParams(Vec3(), Vec3(1.0, 0.0, 0.0), -9.81, 0, 24.0)), 120.0, 1e-9);
+	CHECK_NEAR(calculateFlightFrames(makeLaunchParams(Vec3(), Vec3(1.0, 5.0, 0.0), 9.81, 0, 24.0)), 120.0, 1e-9);
+}
+
+TEST_CASE(rotationsFaceAlongVelocity)
+{
+	LaunchParams params = makeLaunchParams(Vec3(), Vec3(0.0, 1.0, 1.0), -9.81, 0, 24.0);
+	std::vector<Euler> rots = calculateRotations(params);
+	CHECK(rots.size() == 3);
+
+	const double PI = std::atan(1.0) * 4;
+	CHECK_NEAR(rots[0].x, PI / 4.0, 1e-9);
+	CHECK_NEAR(rots[0].y, PI, 1e-9);
+	CHECK_NEAR(rots[1].x, 0.0, 1e-12);
+	CHECK_NEAR(rots[2].x, -PI / 4.0, 1e-9);
+}
@@ -0,0 +1,63 @@
+#include "TestFramework.h"
+#include "TrajectorySampler.h"
+
+using namespace LaunchCore;
+
+static const LaunchParams samplerParams = makeLaunchParams(Vec3(2.0, 1.0, -3.0), Vec3(6.0, 15.0, 4.0), -9.81, 5, 24.0);
+
+TEST_CASE(samplesEveryFrameThroughLanding)
+{
+	LaunchParams params = samplerParams;
+	TrajectorySamples samples;
+	sampleTrajectory(params, 1.0, samples);
+
+	// Lands 73.4 frames in: a sample on every whole frame, then one on the exact touchdown
+	double flightFrames = calculateFlightFrames(params);
+	CHECK_NEAR(flightFrames, 2.0 * 15.0 / 9.81 * 24.0, 1e-9);
+	CHECK(samples.size() == (size_t)std::floor(flightFrames) + 2);
+	CHECK_NEAR(samples.frames.front(), 5.0, 1e-12);
+	CHECK_NEAR(samples.frames.back(), 5.0 + flightFrames, 1e-12);
+	CHECK_NEAR(samples.translateY.back(), 1.0, 1e-9);
+
+	for (size_t i = 0; i < samples.size(); ++i) {
+		Vec3 expected = positionAtTime(params, (samples.frames[i] - 5.0) / 24.0);
+		CHECK_NEAR(samples.translateX[i], expected.x, 1e-9);
+		CHECK_NEAR(samples.translateY[i], expected.y, 1e-9);
+		CHECK_NEAR(samples.translateZ[i], expected.z, 1e-9);
+	}
+}
+
+TEST_CASE(subFrameStepKeepsLandingSample)
+{
+	LaunchParams params = samplerParams;
+	TrajectorySamples samples;
+	sampleTrajectory(params, 0.4, samples);
+
+	double flightFrames = calculateFlightFrames(params);
+	CHECK(samples.size() == countTrajectorySamples(params, 0.4));
+	CHECK_NEAR(samples.frames[1] - samples.frames[0], 0.4, 1e-12);
+	CHECK_NEAR(samples.frames.back(), 5.0 + flightFrames, 1e-12);
+	CHECK(samples.frames[samples.size() - 2] < samples.frames.back());
+}
+
+TEST_CASE(sampledRotationsMatchThreeKeyRotations)
+{
+	LaunchParams params = samplerParams;
+	TrajectorySamples samples;
+	sampleTrajectory(params, 1.0, samples);
+
+	std::vector<Euler> keys = calculateRotations(params);
+	CHECK_NEAR(samples.rotateX.front(), keys[0].x, 1e-9);
+	CHECK_NEAR(samples.rotateY.front(), keys[0].y, 1e-9);
+
+	// The landing frame is snapped past the analytic landing, so allow a frame of pitch change
+	CHECK_NEAR(samples.rotateX.back(), keys[2].x, 0.05);
+	CHECK_NEAR(samples.rotateY.back(), keys[2].y, 1e-9);
+}
+
+TEST_CASE(invalidStepProducesNoSamples)
+{
+	TrajectorySamples samples;
+	sampleTrajectory(samplerParams, 0.0, samples);
+	CHECK(samples.size() == 0);
+}
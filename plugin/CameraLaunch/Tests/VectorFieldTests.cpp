@@ -0,0 +1,234 @@
+#include "TestFramework.h"
+#include "FlightPath.h"
+#include "TrajectoryCache.h"
+#include "VectorField.h"
+
+#include <sstream>
+
+using namespace LaunchCore;
+
+// Field whose value is an affine function of position, which trilinear interpolation reproduces exactly
+static Vec3 affineValue(const Vec3& p)
+{
+	return Vec3(1.0 + 2.0 * p.x - p.z, 0.5 * p.y + 3.0, p.x + p.y + p.z);
+}
+
+static VectorField makeAffineField(int nx, int ny, int nz)
+{
+	Vec3 origin(-2.0, 0.5, 1.0);
+	Vec3 spacing(0.5, 0.25, 1.0);
+	std::vector<Vec3> values;
+	for (int k = 0; k < nz; ++k) {
+		for (int j = 0; j < ny; ++j) {
+			for (int i = 0; i < nx; ++i) {
+				values.push_back(affineValue(origin + Vec3(i * spacing.x, j * spacing.y, k * spacing.z)));
+			}
+		}
+	}
+
+	VectorField field;
+	field.build(nx, ny, nz, origin, spacing, values);
+	return field;
+}
+
+static VectorField makeUniformField(const Vec3& value)
+{
+	VectorField field;
+	field.build(2, 2, 2, Vec3(-1000.0, -1000.0, -1000.0), Vec3(2000.0, 2000.0, 2000.0), std::vector<Vec3>(8, value));
+	return field;
+}
+
+TEST_CASE(trilinearReproducesAffineField)
+{
+	// Sizes that are not a multiple of the brick size
+	VectorField field = makeAffineField(7, 5, 6);
+	CHECK(!field.empty());
+
+	const Vec3 points[] = { Vec3(-2.0, 0.5, 1.0), Vec3(-0.3, 1.1, 3.7), Vec3(0.99, 1.5, 6.0), Vec3(1.0, 0.5001, 5.5) };
+	for (const Vec3& p : points) {
+		Vec3 value = field.sample(p);
+		Vec3 expected = affineValue(p);
+		CHECK_NEAR(value.x, expected.x, 1e-5);
+		CHECK_NEAR(value.y, expected.y, 1e-5);
+		CHECK_NEAR(value.z, expected.z, 1e-5);
+	}
+}
+
+TEST_CASE(sampleOutsideGridReadsBoundary)
+{
+	VectorField field = makeAffineField(5, 5, 5);
+	Vec3 outside = field.sample(Vec3(-10.0, 0.75, 100.0));
+	Vec3 boundary = field.sample(Vec3(-2.0, 0.75, 5.0));
+	CHECK_NEAR(outside.x, boundary.x, 1e-12);
+	CHECK_NEAR(outside.y, boundary.y, 1e-12);
+	CHECK_NEAR(outside.z, boundary.z, 1e-12);
+}
+
+TEST_CASE(batchSampleMatchesSingleSamples)
+{
+	VectorField field = makeAffineField(9, 4, 3);
+	std::vector<double> x, y, z;
+	for (int i = 0; i < 37; ++i) {
+		x.push_back(-3.0 + 0.17 * i);
+		y.push_back(0.2 + 0.05 * i);
+		z.push_back(0.5 + 0.09 * i);
+	}
+
+	std::vector<double> ox(x.size()), oy(x.size()), oz(x.size());
+	field.sample(x.data(), y.data(), z.data(), x.size(), ox.data(), oy.data(), oz.data());
+	for (size_t i = 0; i < x.size(); ++i) {
+		Vec3 single = field.sample(Vec3(x[i], y[i], z[i]));
+		CHECK(ox[i] == single.x);
+		CHECK(oy[i] == single.y);
+		CHECK(oz[i] == single.z);
+	}
+}
+
+TEST_CASE(singleSampleAxisIsConstantAlongIt)
+{
+	VectorField field;
+	std::vector<Vec3> values = { Vec3(1.0, 0.0, 0.0), Vec3(3.0, 0.0, 0.0) };
+	CHECK(field.build(2, 1, 1, Vec3(), Vec3(1.0, 1.0, 1.0), values));
+	CHECK_NEAR(field.sample(Vec3(0.5, 7.0, -3.0)).x, 2.0, 1e-12);
+	CHECK(!field.build(2, 1, 1, Vec3(), Vec3(1.0, 0.0, 1.0), values));
+}
+
+TEST_CASE(parsesFgaField)
+{
+	std::istringstream in(
+		"2,1,1,\n"
+		"0,0,0,\n"
+		"4,2,2,\n"
+		"1,0,0,\n"
+		"3,0,-1,\n");
+
+	VectorField field;
+	std::string error;
+	CHECK(parseFgaField(in, field, error));
+	CHECK(field.resolutionX() == 2 && field.resolutionY() == 1 && field.resolutionZ() == 1);
+	// Voxel centres sit half a voxel in from the bounds
+	CHECK_NEAR(field.boundsMin().x, 1.0, 1e-12);
+	CHECK_NEAR(field.boundsMax().x, 3.0, 1e-12);
+	CHECK_NEAR(field.boundsMin().y, 1.0, 1e-12);
+	Vec3 mid = field.sample(Vec3(2.0, 1.0, 1.0));
+	CHECK_NEAR(mid.x, 2.0, 1e-6);
+	CHECK_NEAR(mid.z, -0.5, 1e-6);
+
+	std::istringstream shortFile("2,1,1,0,0,0,4,2,2,1,0,0,");
+	CHECK(!parseFgaField(shortFile, field, error));
+	CHECK(field.empty());
+
+	std::istringstream badNumber("1,1,1,0,0,0,1,1,1,x,0,0");
+	CHECK(!parseFgaField(badNumber, field, error));
+}
+
+TEST_CASE(uniformWindMatchesLinearDragClosedForm)
+{
+	LaunchParams params;
+	params.velocity = Vec3(0.0, 10.0, 0.0);
+	params.gravity = -9.81;
+	params.framesPerSecond = 24.0;
+
+	DragParams drag;
+	drag.linear = 0.5;
+
+	VectorField wind = makeUniformField(Vec3(3.0, 0.0, 0.0));
+	IntegratorSettings settings;
+	settings.field.field = &wind;
+
+	// With linear drag the camera relaxes towards the wind speed: x(t) = w t - w (1 - e^-kt) / k
+	FlightEvents events = integrateFlight(params, drag, settings);
+	FlightEvents still = integrateFlight(params, drag, IntegratorSettings());
+	double t = events.landingTime;
+	CHECK(events.landed);
+	CHECK_NEAR(t, still.landingTime, 1e-9);
+	CHECK_NEAR(events.landingPosition.x, 3.0 * t - 3.0 * (1.0 - std::exp(-0.5 * t)) / 0.5, 1e-6);
+	CHECK_NEAR(events.landingPosition.z, 0.0, 1e-12);
+}
+
+TEST_CASE(crosswindTurnsTheCameraWithTheFlight)
+{
+	LaunchParams params;
+	params.velocity = Vec3(0.0, 10.0, 5.0);
+
+	VectorField wind = makeUniformField(Vec3(30.0, 0.0, 0.0));
+	FlightOptions options;
+	options.drag.linear = 1.0;
+	options.field.field = &wind;
+
+	TrajectorySamples samples;
+	sampleFlight(params, options, samples);
+	CHECK(samples.size() > 20);
+
+	// Launched along +Z, so the camera starts facing back along -Z and is swung round towards +X
+	const double PI = std::atan(1.0) * 4;
+	CHECK_NEAR(samples.rotateY.front(), PI, 1e-12);
+	CHECK(samples.rotateY.back() > 1.4 * PI);
+
+	// Every sample looks along its own motion
+	for (size_t i = 1; i + 1 < samples.size(); ++i) {
+		double dx = samples.translateX[i + 1] - samples.translateX[i - 1];
+		double dz = samples.translateZ[i + 1] - samples.translateZ[i - 1];
+		CHECK_NEAR(samples.rotateY[i], std::atan2(dx, dz) + PI, 0.05);
+	}
+}
+
+TEST_CASE(uniformForceFieldActsLikeExtraGravity)
+{
+	LaunchParams params;
+	params.startPosition = Vec3(1.0, 2.0, 3.0);
+	params.velocity = Vec3(4.0, 12.0, -2.0);
+	params.gravity = -9.81;
+
+	DragParams drag;
+	drag.mass = 2.0;
+
+	VectorField force = makeUniformField(Vec3(0.0, -2.0, 0.0));
+	FlightOptions options;
+	options.drag = drag;
+	options.field.field = &force;
+	options.field.kind = FieldKind::FORCE;
+
+	TrajectorySamples withField;
+	sampleFlight(params, options, withField);
+
+	LaunchParams heavier = params;
+	heavier.gravity = -10.81;
+	TrajectorySamples expected;
+	integrateFlight(heavier, DragParams(), IntegratorSettings(), &expected);
+
+	// sampleFlight integrates when there is a field, even without drag
+	CHECK(withField.size() == expected.size());
+	for (size_t i = 0; i < withField.size() && i < expected.size(); ++i) {
+		CHECK_NEAR(withField.frames[i], expected.frames[i], 1e-6);
+		CHECK_NEAR(withField.translateX[i], expected.translateX[i], 1e-6);
+		CHECK_NEAR(withField.translateY[i], expected.translateY[i], 1e-6);
+	}
+
+	// Zero scale switches the field off
+	options.field.scale = 0.0;
+	CHECK(!options.field.active());
+}
+
+TEST_CASE(fieldChangesFlightCacheKey)
+{
+	LaunchParams params;
+	params.velocity = Vec3(5.0, 9.0, 0.0);
+
+	VectorField wind = makeUniformField(Vec3(1.0, 0.0, 0.0));
+	VectorField gust = makeUniformField(Vec3(2.0, 0.0, 0.0));
+
+	FlightOptions plain;
+	FlightOptions windy;
+	windy.field.field = &wind;
+	FlightOptions gusty;
+	gusty.field.field = &gust;
+	FlightOptions empty;
+	VectorField nothing;
+	empty.field.field = &nothing;
+
+	uint64_t plainKey = flightCacheKey(params, nullptr, plain).value();
+	CHECK(flightCacheKey(params, nullptr, windy).value() != plainKey);
+	CHECK(flightCacheKey(params, nullptr, gusty).value() != flightCacheKey(params, nullptr, windy).value());
+	CHECK(flightCacheKey(params, nullptr, empty).value() == plainKey);
+}
@@ -0,0 +1,160 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "AnimExport.h"
+#include "LaunchJob.h"
+#include "ThreadPool.h"
+
+using namespace LaunchCore;
+
+namespace {
+
+void printUsage()
+{
+	std::fprintf(stderr,
+		"usage: CameraLaunchBatch [options] <jobs.json|jobs.csv>\n"
+		"  -out <dir>         directory for the curve files (default: .)\n"
+		"  -format anim|atom  file format (default: anim)\n"
+		"  -fps <rate>        scene frame rate (default: 24)\n"
+		"  -threads <n>       worker threads (default: one per hardware thread)\n");
+}
+
+// Camera names may be DAG paths or carry namespaces, neither of which belongs in a file name
+std::string fileStem(const std::string& camera)
+{
+	std::string stem = camera;
+	for (char& c : stem) {
+		if (c == '|' || c == ':' || c == '/' || c == '\\') c = '_';
+	}
+	size_t first = stem.find_first_not_of('_');
+	return (first == std::string::npos) ? std::string("camera") : stem.substr(first);
+}
+
+struct JobResult {
+	std::string path;
+	bool written = false;
+};
+
+}
+
+// Keys every launch in a job file the way the cameraLaunch command does and writes one curve
+// file per camera, without starting Maya
+int main(int argc, char** argv)
+{
+	std::string outputDirectory = ".";
+	std::string jobPath;
+	AnimFormat format = AnimFormat::ANIM;
+	double framesPerSecond = 24.0;
+	size_t threadCount = 0;
+
+	for (int i = 1; i < argc; ++i) {
+		const char* arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (std::strcmp(arg, "-out") == 0 && hasValue) {
+			outputDirectory = argv[++i];
+		}
+		else if (std::strcmp(arg, "-format") == 0 && hasValue) {
+			std::string name = argv[++i];
+			if (name == "anim") format = AnimFormat::ANIM;
+			else if (name == "atom") format = AnimFormat::ATOM;
+			else {
+				std::fprintf(stderr, "Unknown format %s\n", name.c_str());
+				return 1;
+			}
+		}
+		else if (std::strcmp(arg, "-fps") == 0 && hasValue) {
+			framesPerSecond = std::atof(argv[++i]);
+			if (framesPerSecond <= 0.0) {
+				std::fprintf(stderr, "-fps must be greater than zero\n");
+				return 1;
+			}
+		}
+		else if (std::strcmp(arg, "-threads") == 0 && hasValue) {
+			int threads = std::atoi(argv[++i]);
+			threadCount = (threads > 0) ? (size_t)threads : 0;
+		}
+		else if (arg[0] != '-' && jobPath.empty()) {
+			jobPath = arg;
+		}
+		else {
+			printUsage();
+			return 1;
+		}
+	}
+
+	if (jobPath.empty()) {
+		printUsage();
+		return 1;
+	}
+
+	std::vector<LaunchJob> jobs;
+	std::string error;
+	if (!loadJobFile(jobPath, jobs, error)) {
+		std::fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	std::error_code directoryError;
+	std::filesystem::create_directories(outputDirectory, directoryError);
+	if (directoryError) {
+		std::fprintf(stderr, "Could not create %s: %s\n", outputDirectory.c_str(), directoryError.message().c_str());
+		return 1;
+	}
+
+	// File names are settled up front so workers never race on the same path
+	const char* extension = (format == AnimFormat::ATOM) ? ".atom" : ".anim";
+	std::vector<JobResult> results(jobs.size());
+	std::set<std::string> usedStems;
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		// A suffixed name can itself be taken, eg. "cam", "cam_2", "cam"
+		const std::string base = fileStem(jobs[i].camera);
+		std::string stem = base;
+		for (int suffix = 2; !usedStems.insert(stem).second; ++suffix) {
+			stem = base + "_" + std::to_string(suffix);
+		}
+		results[i].path = (std::filesystem::path(outputDirectory) / (stem + extension)).string();
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	{
+		ThreadPool pool(threadCount);
+		for (size_t i = 0; i < jobs.size(); ++i) {
+			pool.submit([&jobs, &results, i, framesPerSecond, format]() {
+				const LaunchJob& job = jobs[i];
+				AnimClip clip;
+				buildLaunchClip(job.camera, calculateParabolicKeys(job.launchParams(framesPerSecond)), framesPerSecond, clip);
+
+				// Each worker streams through its own 64 KiB buffer, set before the file is opened
+				std::vector<char> buffer(1 << 16);
+				std::ofstream out;
+				out.rdbuf()->pubsetbuf(buffer.data(), (std::streamsize)buffer.size());
+				out.open(results[i].path, std::ios::binary);
+				if (!out) return;
+
+				writeClip(out, clip, format);
+				out.close();
+				results[i].written = !out.fail();
+			});
+		}
+		pool.wait();
+	}
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	int failures = 0;
+	for (const JobResult& result : results) {
+		if (!result.written) {
+			std::fprintf(stderr, "Failed to write %s\n", result.path.c_str());
+			++failures;
+		}
+	}
+
+	std::printf("%zu launch(es) written to %s in %.1f ms\n", jobs.size() - failures, outputDirectory.c_str(), milliseconds);
+	return (failures == 0) ? 0 : 1;
+}